@@ -36,7 +36,7 @@ CONFIG += qt thread debug qxt
 QXT += core gui
 DEFINES += BOOST_THREAD_USE_LIB QT_GUI_LIB QT_CORE_LIB USE_SOFA
 
-QT += core gui sql network printsupport uitools widgets svg
+QT += core gui sql network printsupport uitools widgets svg concurrent
 
 QTPLUGIN += qsqlmysql \
 #            qtiff \
@@ -96,7 +96,21 @@ SOURCES += \
     source/dockWidgets/dockWidgetMessage.cpp \
     source/dockWidgets/dockWidgetNavigator.cpp \
     source/dockWidgets/dockWidgetPhotometry.cpp \
+    source/dockWidgets/observationModels.cpp \
+    source/imaging/combineKernels.cpp \
+    source/imaging/displayRenderer.cpp \
+    source/imaging/frameLoader.cpp \
+    source/imaging/imageCalibrator.cpp \
     source/imaging/imageControl.cpp \
+    source/imaging/imageStacker.cpp \
+    source/imaging/liveStacker.cpp \
+    source/imaging/masterFrameBuilder.cpp \
+    source/imaging/masterFrameLibrary.cpp \
+    source/imaging/pixelBuffer.cpp \
+    source/imaging/skyFootprint.cpp \
+    source/imaging/sourceMeasure.cpp \
+    source/imaging/starRegistration.cpp \
+    source/imaging/tiledImageItem.cpp \
     source/astrometry/astrometryObservation.cpp \
     source/photometry/photometryObservation.cpp \
     source/dockWidgets/dockWidgetWeather.cpp \
@@ -104,6 +118,7 @@ SOURCES += \
     source/windowWeather/windowWeather.cpp \
     source/windowImage/windowImageDisplay.cpp \
     source/windowImage/windowImage.cpp \
+    source/windowImage/windowImageOpen.cpp \
     source/windowCalibration/windowCalibration.cpp \
     source/windowCalibration/ImageCalibration.cpp \
     source/database/databaseATID.cpp \
@@ -184,7 +199,22 @@ HEADERS  += \
     include/dockWidgets/dockWidgetMessage.h \
     include/dockWidgets/dockWidgetNavigator.h \
     include/dockWidgets/dockWidgetPhotometry.h \
+    include/dockWidgets/observationModels.h \
+    include/imaging/combineKernels.h \
+    include/imaging/displayRenderer.h \
+    include/imaging/frameLoader.h \
+    include/imaging/imageCalibrator.h \
     include/imaging/imageControl.h \
+    include/imaging/imageStacker.h \
+    include/imaging/liveStacker.h \
+    include/imaging/masterFrameBuilder.h \
+    include/imaging/masterFrameLibrary.h \
+    include/imaging/pixelBuffer.h \
+    include/imaging/skyFootprint.h \
+    include/imaging/sourceMeasure.h \
+    include/imaging/spatialIndex.h \
+    include/imaging/starRegistration.h \
+    include/imaging/tiledImageItem.h \
     include/astrometry/astrometryObservation.h \
     include/photometry/photometryObservation.h \
     include/dockWidgets/dockWidgetWeather.h \
@@ -192,6 +222,7 @@ HEADERS  += \
     include/windowWeather/windowWeather.h \
     include/windowImage/windowImage.h \
     include/windowImage/windowImageDisplay.h \
+    include/windowImage/windowImageOpen.h \
     include/windowCalibration/windowCalibration.h \
     include/windowCalibration/ImageCalibration.h \
     include/database/databaseARID.h \
@@ -27,19 +27,26 @@
 // OVERVIEW:						A class for in-memory management of FITS files.
 //
 // CLASSES INCLUDED:		CFITSMemoryFileArray
+//                      CMemoryBufferPool
 //
 // CLASS HIERARCHY:     ACL::CFITSMemoryFile
 //                        AstroManager::CFITSMemoryFileArray
+//                      CMemoryBufferPool
 //
-// HISTORY:             2017-08-13 GGB - Started development of classes.
+// HISTORY:             2026-10-17 GGB - Added CMemoryBufferPool.
+//                      2017-08-13 GGB - Started development of classes.
 //
 //*********************************************************************************************************************************
 
 #ifndef FITSMEMORYFILEARRAY
 #define FITSMEMORYFILEARRAY
 
-  // astroManager includes
+  // Standard C++ library header files
 
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
 
   // Miscellaneous libraries
 
@@ -48,10 +55,68 @@
 
 namespace astroManager
 {
+  /// @brief    Pool of reusable byte buffers for in-memory FITS files and image uploads.
+  /// @details  Buffers that are released to the pool keep their capacity and are handed out again by acquire(). This avoids
+  ///           allocating (and page faulting) tens of MB for every save or upload of an image. Only buffers that are not shared
+  ///           with another QByteArray are retained. The pool is limited by the number of buffers and by the total capacity of the
+  ///           buffers retained.
+
+  class CMemoryBufferPool
+  {
+  public:
+    struct SStatistics
+    {
+      std::size_t allocations;              ///< Number of new buffers allocated.
+      std::size_t poolHits;                 ///< Number of buffers served from the pool.
+      std::size_t reallocations;            ///< Number of times a buffer had to be grown.
+      std::size_t bytesCopied;              ///< Number of bytes copied while growing buffers.
+    };
+
+  private:
+    mutable std::mutex poolMutex;
+    std::vector<QByteArray> pool;
+    std::size_t poolLimit_ = 4;             ///< Maximum number of buffers to retain.
+    std::size_t poolByteLimit_ = 256 * 1024 * 1024;   ///< Maximum total capacity (bytes) of the buffers retained.
+    std::size_t poolBytes_ = 0;             ///< Total capacity (bytes) of the buffers retained.
+
+    std::atomic<std::size_t> allocations_;
+    std::atomic<std::size_t> poolHits_;
+    std::atomic<std::size_t> reallocations_;
+    std::atomic<std::size_t> bytesCopied_;
+
+    CMemoryBufferPool();
+    CMemoryBufferPool(CMemoryBufferPool const &) = delete;
+    CMemoryBufferPool &operator=(CMemoryBufferPool const &) = delete;
+
+    void trim();
+
+  public:
+    static CMemoryBufferPool &instance();
+
+    QByteArray acquire(std::size_t);
+    void release(QByteArray &&);
+    void recordReallocation(std::size_t);
+
+    void poolLimit(std::size_t);
+    void poolByteLimit(std::size_t);
+    void clear();
+
+    SStatistics statistics() const;
+  };
+
   class CFITSMemoryFileArray : public ACL::CFITSMemoryFile
   {
   private:
+    static std::size_t const GROWTH_FACTOR = 2;
+
     QByteArray byteArray_;
+    std::size_t capacityHint_ = 0;
+    std::size_t allocations_ = 0;
+    std::size_t reallocations_ = 0;
+    std::size_t bytesCopied_ = 0;
+
+    CFITSMemoryFileArray(CFITSMemoryFileArray const &) = delete;
+    CFITSMemoryFileArray &operator=(CFITSMemoryFileArray const &) = delete;
 
   protected:
     virtual void memory_allocate(std::size_t);
@@ -62,8 +127,15 @@ namespace astroManager
     CFITSMemoryFileArray();
     CFITSMemoryFileArray(boost::filesystem::path const &);
     CFITSMemoryFileArray(std::size_t);
+    virtual ~CFITSMemoryFileArray();
+
+    void reserve(std::size_t);
 
     QByteArray const &byteArray() const { return byteArray_; }
+
+    std::size_t allocations() const noexcept { return allocations_; }
+    std::size_t reallocations() const noexcept { return reallocations_; }
+    std::size_t bytesCopied() const noexcept { return bytesCopied_; }
   };
 
 } // namespace AstroManager
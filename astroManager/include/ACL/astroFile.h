@@ -31,7 +31,13 @@
 // CLASS HIERARCHY:     ACL::CAstroFile
 //                        AstroManager::CAstroFile
 //
-// HISTORY:             2017-07-24 GGB - File created
+// HISTORY:             2026-10-17 GGB - Documented the scope of EHDUSelection.
+//                      2026-10-17 GGB - Renamed the batched WCS transforms pix2wcsList() and wcs2pixList().
+//                      2026-10-17 GGB - Objects can be removed and renamed by pointer.
+//                      2026-10-17 GGB - Added invalidateObjectIndexes().
+//                      2026-10-17 GGB - Added the batched WCS transforms.
+//                      2026-10-17 GGB - Added the spatial index of the astrometry and photometry objects.
+//                      2017-07-24 GGB - File created
 //
 //*********************************************************************************************************************************
 
@@ -39,10 +45,12 @@
 #define ASTROFILE
 
 #include "../astroManager.h"
+#include "../imaging/spatialIndex.h"
 
   // Standard C++ Library header files.
 
 #include <memory>
+#include <optional>
 #include <vector>
 
   // Miscellaneous libraries
@@ -54,6 +62,25 @@ namespace astroManager
 {
   class CAstroFile : public ACL::CAstroFile
   {
+  public:
+    enum ELoadMode
+    {
+      LM_IMMEDIATE,                   ///< Load the image during construction.
+      LM_DEFERRED,                    ///< Image data is loaded by calling loadData() and completeLoad().
+    };
+
+      /// @brief Selects the HDU's that are loaded when the file is opened.
+      /// @details All the selected HDU's are loaded (headers and data) when the file is opened. The HDB store is part of ACL, so
+      ///          the data of an HDU cannot be read on first access and cannot be released later. HS_PRIMARY is used for the
+      ///          frames of the stacking and comparison windows, which only use the primary image. The image window always uses
+      ///          HS_ALL. A file loaded without its extensions cannot be saved.
+
+    enum EHDUSelection
+    {
+      HS_ALL,                         ///< Load all the HDU's in the file.
+      HS_PRIMARY,                     ///< Only load the primary HDU. The extensions are not read.
+    };
+
   private:
     enum ELastSave
     {
@@ -69,15 +96,25 @@ namespace astroManager
     database::imageID_t imageID_;
     database::imageVersion_t imageVersion_;
     bool imageIDValid_;
+    QByteArray databaseImage_;                    ///< Image downloaded from the database, waiting to be decoded.
+    bool loadMemoryMapped_;
+    EHDUSelection hduSelection_ = HS_ALL;
+    bool extensionsSkipped_ = false;              ///< true if extensions were present but were not loaded.
 
     bool syntheticImage_ = false;
 
     ELastSave lastSaveAs_ = LS_NONE;
 
+    imaging::TSpatialIndex<ACL::CAstrometryObservation> astrometryIndex_;
+    bool astrometryIndexValid_ = false;           ///< false if the index must be rebuilt before it is used.
+    imaging::TSpatialIndex<ACL::CPhotometryObservation> photometryIndex_;
+    bool photometryIndexValid_ = false;
 
     CAstroFile() = delete;
 
     void cleanLocationKeywords();
+    bool isFITSFile() const;
+    std::size_t estimatedFITSSize();
     virtual void preLoadActions();
     virtual void postLoadActions();
     void registerImage();
@@ -85,22 +122,67 @@ namespace astroManager
   protected:
     void processFile();
     void loadFromDatabase();
+    void loadFromByteArray(QByteArray &);
+    void loadFromMappedFile();
+    void loadFromMemory(void *, std::size_t, std::string const &);
     virtual void load();                          // Load file
 
     virtual bool saveToFile();
     virtual bool saveToDatabase();
 
   public:
-    CAstroFile(QWidget *, boost::filesystem::path const &);
-    CAstroFile(QWidget *, database::imageID_t, database::imageVersion_t);
+    CAstroFile(QWidget *, boost::filesystem::path const &, ELoadMode = LM_IMMEDIATE, EHDUSelection = HS_ALL);
+    CAstroFile(QWidget *, database::imageID_t, database::imageVersion_t, ELoadMode = LM_IMMEDIATE,
+               EHDUSelection = HS_ALL);
     CAstroFile(QWidget *, ACL::CAstroFile const &);
+    CAstroFile(QWidget *, QByteArray &, EHDUSelection = HS_ALL);
     CAstroFile(CAstroFile const &);
 
     virtual std::unique_ptr<ACL::CAstroFile> createCopy() const;
 
+    std::size_t encodedSize() const;
+
     virtual bool save();                                      // Save file
     virtual bool saveAs();
 
+    void loadData();
+    void completeLoad();
+
+    static bool isFITSFile(boost::filesystem::path const &);
+
+      // Astrometry and photometry objects. The objects are also added to a spatial index to allow the close objects to be found
+      // quickly.
+
+    virtual void astrometryObjectAdd(std::shared_ptr<ACL::CAstrometryObservation>);
+    ACL::CAstrometryObservation *astrometryObjectClose(MCL::TPoint2D<FP_t> const &, FP_t);
+    virtual void astrometryObjectRemove(std::string const &);
+    void astrometryObjectRemove(ACL::CAstrometryObservation *);
+    virtual void astrometryObjectRemoveAll();
+    void astrometryObjectRename(ACL::CAstrometryObservation *, std::string const &);
+
+    virtual void photometryObjectAdd(std::shared_ptr<ACL::CPhotometryObservation>);
+    ACL::CPhotometryObservation *photometryObjectClose(MCL::TPoint2D<FP_t> const &, FP_t);
+    virtual void photometryObjectRemove(std::string const &);
+    void photometryObjectRemove(ACL::CPhotometryObservation *);
+    virtual void photometryObjectRemoveAll();
+    void photometryObjectRename(ACL::CPhotometryObservation *, std::string const &);
+
+    /// @brief Marks the spatial indexes as out of date. They are rebuilt from the objects in the file when they are next used.
+    /// @details Must be called after the objects have been moved or deleted by the ACL functions. (Transforms of the image)
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void invalidateObjectIndexes() noexcept { astrometryIndexValid_ = photometryIndexValid_ = false; }
+
+      // WCS functions. The list versions look up the HDB once and convert each point in turn.
+
+    std::vector<std::optional<ACL::CAstronomicalCoordinates>> pix2wcsList(ACL::DHDBStore::size_type,
+                                                                          std::vector<MCL::TPoint2D<FP_t>> const &);
+    std::vector<std::optional<MCL::TPoint2D<FP_t>>> wcs2pixList(ACL::DHDBStore::size_type,
+                                                                std::vector<ACL::CAstronomicalCoordinates> const &);
+
+    bool extensionsSkipped() const noexcept { return extensionsSkipped_; }
+
     void fileNameValid(bool valid) { fileNameValid_ = valid; }
     bool fileNameValid() const { return fileNameValid_; }
 
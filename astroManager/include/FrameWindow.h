@@ -50,6 +50,7 @@
 
   // Standard C++ Library header files
 
+#include <exception>
 #include <list>
 #include <map>
 #include <memory>
@@ -290,6 +291,8 @@ namespace astroManager
 
 
       void loadFromFile(boost::filesystem::path &);
+      void imageOpenAsync(std::shared_ptr<CAstroFile>);
+      void recentFileAdd(boost::filesystem::path const &);
 
       void setBaseActionStates();
 
@@ -316,6 +319,8 @@ namespace astroManager
       void enableDockWidgetsImage(bool);
 
       void imageCreateWindow(std::shared_ptr<CAstroFile>);
+      void imageOpenComplete(std::shared_ptr<CAstroFile>);
+      void imageOpenError(std::exception_ptr);
       void imageOpenFromDatabase(database::imageID_t);
 
       private slots:
@@ -59,6 +59,7 @@
 #include "ACL/astroFile.h"
 #include "astrometry/astrometryObservation.h"
 #include "FrameWindow.h"
+#include "imaging/frameLoader.h"
 #include "windowImage/windowImageStacking.h"
 #include "photometry/photometryObservation.h"
 
@@ -116,6 +117,8 @@ namespace astroManager
 
       QTimer *blinkTimer;
 
+      CFrameLoader *frameLoader;            ///< Loads the images in the background. The control blocks are used as the keys.
+
       QGraphicsScene *graphicsSceneImageInput;
       QGraphicsScene *graphicsSceneImageOutput;
 
@@ -199,6 +202,9 @@ namespace astroManager
 
       void signalItemClickedImageList(QListWidgetItem *);
 
+      void eventFrameLoaded(quint64);
+      void eventFrameFailed(quint64, QString);
+
       void eventTabCurrentChanged(int);
 
       void eventIntervalChange(double);
@@ -33,7 +33,8 @@
 //                        - CInstrumentDockwidget
 //                        - CMessageWidget
 //
-// HISTORY:             2015-09-22 GGB - astroManager 2015.09 release
+// HISTORY:             2026-10-17 GGB - Reference list changed to a QTableView over CAstrometryObservationModel.
+//                      2015-09-22 GGB - astroManager 2015.09 release
 //                      2013-09-30 GGB - astroManager 2013.09 release.
 //                      2013-03-22 GGB - astroManager 2013.03 release.
 //                      2013-02-01 GGB - Removed CAstrometryDockWidget into this file
@@ -45,10 +46,12 @@
 
 #include "../astrometry/astrometryObservation.h"
 #include "dockWidgetImage.h"
+#include "observationModels.h"
 #include "../FrameWindow.h"
 
   // Standard libraries
 
+#include <cstddef>
 #include <memory>
 
   // libAstroImages Library
@@ -73,7 +76,8 @@ namespace astroManager
       Q_OBJECT
 
     private:
-      QTableWidget *tableWidgetAstrometry;
+      QTableView *tableViewAstrometry;
+      CAstrometryObservationModel *astrometryModel_;
       QPushButton *pushButtonReferenceSelect;
       QPushButton *pushButtonReferenceEdit;
       QPushButton *pushButtonReferenceDelete;
@@ -93,10 +97,6 @@ namespace astroManager
 
       void redraw();    // Redraws all the information in the window.
 
-    protected:
-
-      void insertRow(int, astrometry::CAstrometryObservation *);
-
     public:
       CAstrometryDockWidget(QWidget *, QAction *);
 
@@ -110,11 +110,12 @@ namespace astroManager
 
       void referenceCompleted(astrometry::CAstrometryObservation *);
       void addNewObject(astrometry::CAstrometryObservation *);
+      void addObjects(std::size_t);
       void displayAstrometry(astrometry::CAstrometryObservation *);
 
     private slots:
       void eventButtonReferenceSelect(bool);
-      void eventTableRowReferenceSelected(int, int);
+      void eventTableRowReferenceSelected(QModelIndex const &);
       void eventButtonReferenceDelete(bool);
 
       void eventAssociateObject(bool);
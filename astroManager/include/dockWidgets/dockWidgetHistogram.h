@@ -52,7 +52,6 @@
   // Standard library
 
 #include <memory>
-#include <tuple>
 #include <vector>
 
   // Qxt Library
@@ -73,8 +72,6 @@ namespace astroManager
 {
   namespace dockwidgets
   {
-    typedef std::shared_ptr<std::vector<size_t> > PHistogramSlice;
-
     class CHistogram : public CDockWidgetImage
     {
       Q_OBJECT
@@ -90,13 +87,19 @@ namespace astroManager
       QDoubleSpinBox *doubleSpinBoxGamma;
 
       bool bInternalCall;
+      QTimer *renderTimer;                  ///< Delays the full resolution render while the stretch is being changed.
 
       QwtPlotHistogram histogramData;
       QwtPlot *histogramPlot;
 
       void setupUI();
+      imaging::SDisplayStretch displayStretch(FP_t, FP_t) const;
+      bool renderScreenImage();
+      bool renderProxyImage();
+      bool renderACLImage();
+      bool rendersWithLUT() const;
+      void notifyImageDockWidgets();
 
-      void displayHistogramThread(ACL::CAstroImage *, std::tuple<ACL::INDEX_t, ACL::INDEX_t, ACL::FP_t, ACL::FP_t>, PHistogramSlice);
       void DisplayHistogram();
 
     protected:
@@ -124,6 +127,7 @@ namespace astroManager
       void eventInvertChanged(int);
       void eventGammaChanged(double);
       void eventTranferFunctionChanged(QString const &);
+      void eventRenderImage();
     };
   }
 }  // namespace AstroManager
@@ -66,6 +66,8 @@ namespace astroManager
     protected:
       static imaging::SControlImage *currentImage;
 
+      QGraphicsPixmapItem *addImageToScene(QGraphicsScene *);
+
     public:
       CDockWidgetImage(QString const &, QWidget *, QAction *, QString const &);
 
@@ -56,6 +56,8 @@ namespace astroManager
       QGraphicsView *graphicsView;
       QGraphicsScene *graphicsScene;
       QGraphicsRectItem *viewRectangle;
+      QGraphicsPixmapItem *thumbnailItem;         ///< Displays the thumbnail, scaled to the size of the image.
+      qint64 thumbnailKey;                        ///< cacheKey() of the thumbnail image displayed by thumbnailItem.
 
       void setupUI();
 
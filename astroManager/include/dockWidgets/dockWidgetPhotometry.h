@@ -35,7 +35,8 @@
 //                        - CInstrumentDockwidget
 //                        - CMessageWidget
 //
-// HISTORY:             2015-09-22 GGB - astroManager 2015.09 release
+// HISTORY:             2026-10-17 GGB - Photometry list changed to a QTableView over CPhotometryObservationModel.
+//                      2015-09-22 GGB - astroManager 2015.09 release
 //                      2013-09-30 GGB - astroManager 2013.09 release.
 //                      2013-03-22 GGB - astroManager 2013.03 release.
 //                      2013-01-28 GGB - Split PhotometryDockWidgets from DockWidgets.
@@ -52,11 +53,13 @@
   // astroManager files
 
 #include "dockWidgetImage.h"
+#include "observationModels.h"
 #include "../photometry/photometryObservation.h"
 #include "../FrameWindow.h"
 
   // Standard libraries
 
+#include <cstddef>
 #include <memory>
 
   // Miscellaneous library header files.
@@ -108,7 +111,8 @@ namespace astroManager
           QwtPlot *profilePlot;
           QwtPlotCurve *profileCurve;
 
-      QTableWidget *tableWidgetPhotometry;
+      QTableView *tableViewPhotometry;
+      CPhotometryObservationModel *photometryModel_;
 
       QPushButton *pushButtonSelect;
       QPushButton *pushButtonRemove;
@@ -120,7 +124,6 @@ namespace astroManager
       void setupUI();
 
       void redraw();    // Redraws all the information in the window.
-      void insertRow(int, photometry::CPhotometryObservation *);
       void drawProfile(MCL::TPoint2D<ACL::FP_t> const &);
 
     protected:
@@ -136,6 +139,7 @@ namespace astroManager
 
       void referenceCompleted(photometry::CPhotometryObservation *);
       void addNewObject(photometry::CPhotometryObservation *);
+      void addObjects(std::size_t);
       void displayPhotometry(photometry::CPhotometryObservation *);
 
       ACL::AXIS_t getRadius1() const { return uiRadius1; }
@@ -153,7 +157,7 @@ namespace astroManager
       void eventRadius2Changed(int);
       void eventRadius3Changed(int);
 
-      void eventReferenceSelected(int, int);
+      void eventReferenceSelected(QModelIndex const &);
     };
 
   }  // namespace dockwidgets
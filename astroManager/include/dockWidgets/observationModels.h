@@ -0,0 +1,147 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								observationModels
+// SUBSYSTEM:						Dock Widgets
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt
+// NAMESPACE:						astroManager::dockwidgets
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Table models over the astrometry and photometry observations of an image. Used by the astrometry and
+//                      photometry dock widgets.
+//
+// CLASSES INCLUDED:    CAstrometryObservationModel
+//                      CPhotometryObservationModel
+//
+// CLASS HIERARCHY:     QAbstractTableModel
+//                        - CAstrometryObservationModel
+//                        - CPhotometryObservationModel
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef OBSERVATIONMODELS_H
+#define OBSERVATIONMODELS_H
+
+  // Standard C++ library header files
+
+#include <cstddef>
+
+  // astroManager header files
+
+#include "../astrometry/astrometryObservation.h"
+#include "../photometry/photometryObservation.h"
+
+  // Miscellaneous library header files.
+
+#include <QCL>
+
+namespace astroManager
+{
+  namespace dockwidgets
+  {
+    /// @brief Table model over the astrometry observations of an image.
+    /// @details The observations are owned by the control image. The model keeps its own row count, so the rows are only visible
+    ///          to the view once they have been announced with addObjects().
+
+    class CAstrometryObservationModel : public QAbstractTableModel
+    {
+      Q_OBJECT
+
+    public:
+      enum EColumn
+      {
+        COLUMN_OBJECT,
+        COLUMN_TYPE,
+        COLUMN_COUNT
+      };
+
+    private:
+      astrometry::DAstrometryObservationStore *observations_ = nullptr;
+      int rowCount_ = 0;
+
+      CAstrometryObservationModel(CAstrometryObservationModel const &) = delete;
+      CAstrometryObservationModel &operator=(CAstrometryObservationModel const &) = delete;
+
+      static bool boldColumn(int);
+
+    public:
+      explicit CAstrometryObservationModel(QObject *);
+
+      void observations(astrometry::DAstrometryObservationStore *);
+      void addObjects(std::size_t);
+      void objectChanged(int);
+      void removeObject(int);
+      astrometry::CAstrometryObservation *observation(int) const;
+
+      virtual int rowCount(QModelIndex const & = QModelIndex()) const override;
+      virtual int columnCount(QModelIndex const & = QModelIndex()) const override;
+      virtual QVariant data(QModelIndex const &, int = Qt::DisplayRole) const override;
+      virtual QVariant headerData(int, Qt::Orientation, int = Qt::DisplayRole) const override;
+    };
+
+    /// @brief Table model over the photometry observations of an image.
+    /// @details The observations are owned by the control image. The model keeps its own row count, so the rows are only visible
+    ///          to the view once they have been announced with addObjects().
+
+    class CPhotometryObservationModel : public QAbstractTableModel
+    {
+      Q_OBJECT
+
+    public:
+      enum EColumn
+      {
+        COLUMN_OBJECT,
+        COLUMN_MAGNITUDE,
+        COLUMN_MAGNITUDEERROR,
+        COLUMN_COUNT
+      };
+
+    private:
+      photometry::DPhotometryObservationStore *observations_ = nullptr;
+      int rowCount_ = 0;
+      FP_t zmag_ = 0;                     ///< Added to the instrument magnitude.
+
+      CPhotometryObservationModel(CPhotometryObservationModel const &) = delete;
+      CPhotometryObservationModel &operator=(CPhotometryObservationModel const &) = delete;
+
+      static bool boldColumn(int);
+
+    public:
+      explicit CPhotometryObservationModel(QObject *);
+
+      void observations(photometry::DPhotometryObservationStore *);
+      void addObjects(std::size_t);
+      void objectChanged(int);
+      void removeObject(int);
+      photometry::CPhotometryObservation *observation(int) const;
+      void zmag(FP_t);
+
+      virtual int rowCount(QModelIndex const & = QModelIndex()) const override;
+      virtual int columnCount(QModelIndex const & = QModelIndex()) const override;
+      virtual QVariant data(QModelIndex const &, int = Qt::DisplayRole) const override;
+      virtual QVariant headerData(int, Qt::Orientation, int = Qt::DisplayRole) const override;
+    };
+
+  } // namespace dockwidgets
+} // namespace astroManager
+
+#endif // OBSERVATIONMODELS_H
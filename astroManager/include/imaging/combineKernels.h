@@ -0,0 +1,109 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								combineKernels
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Combine kernels for stacking. The values of a tile of output pixels are held frame interleaved (the values
+//                      of each pixel are contiguous), so each pixel is combined from one contiguous run of values. Small sets
+//                      of values are ordered with a sorting network, larger sets with nth_element. The sigma clip combine can
+//                      reject values around the median (MAD), with winsorized sigma clipping or with linear fit clipping.
+//
+// CLASSES INCLUDED:    CCombineTile
+//
+// CLASS HIERARCHY:     CCombineTile
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef COMBINEKERNELS_H
+#define COMBINEKERNELS_H
+
+  // Standard C++ library header files
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+  // Miscellaneous library header files.
+
+#include <ACL>
+
+  // astroManager header files.
+
+#include "../astroManager.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+      /// Rejection used by the sigma clip combine.
+
+    enum ERejection
+    {
+      RJ_MAD,                                   ///< Clip around the median, using the median absolute deviation.
+      RJ_WINSORIZED,                            ///< Winsorized sigma clipping.
+      RJ_LINEARFIT                              ///< Clip around a line fitted to the sorted values.
+    };
+
+    float combineValues(float *, float *, std::size_t, ACL::CImageStack::EStackMode, ERejection = RJ_MAD);
+
+    class CCombineTile
+    {
+    private:
+      std::size_t frameCount_;                  ///< Maximum number of values for each pixel.
+      std::size_t pixelCapacity_;
+      std::size_t pixelCount_ = 0;
+      std::vector<float> values_;               ///< Frame interleaved. The values of pixel n start at n * frameCount_.
+      std::vector<std::uint32_t> counts_;       ///< Number of values of each pixel.
+      std::vector<float> scratch_;
+
+    protected:
+    public:
+      CCombineTile(std::size_t, std::size_t);
+
+      /// @brief Adds the value of a frame to a pixel. NaN values are ignored.
+      /// @param[in] pixel: The pixel in the tile.
+      /// @param[in] value: The value.
+      /// @pre Each frame adds at most one value to each pixel.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void addValue(std::size_t pixel, float value) noexcept
+      {
+        if (!std::isnan(value))
+        {
+          values_[pixel * frameCount_ + counts_[pixel]++] = value;
+        };
+      }
+
+      void clear(std::size_t);
+      void combine(ACL::CImageStack::EStackMode, float *, ERejection = RJ_MAD);
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // COMBINEKERNELS_H
@@ -0,0 +1,101 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								displayRenderer
+// SUBSYSTEM:						Rendering of images for display.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Implements the display stretch of images. The stretch (black point, white point, transfer function, gamma
+//                      and invert) is converted into a look-up table once. The look-up table is then applied to the contiguous
+//                      pixel buffer of the image by row kernels that are split between the threads of the global thread pool. The
+//                      8 bit output image is reused between renders and the render is skipped if nothing has changed.
+//                      Poly (RGB) images are stretched one plane at a time and the planes are interleaved directly into a 32 bit
+//                      RGB image.
+//
+// CLASSES INCLUDED:    SDisplayStretch, CDisplayRenderer
+//
+// CLASS HIERARCHY:     CDisplayRenderer
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef DISPLAYRENDERER_H
+#define DISPLAYRENDERER_H
+
+  // Standard C++ library header files
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+  // astroManager header files.
+
+#include "pixelBuffer.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    struct SDisplayStretch
+    {
+      FP_t blackPoint = 0;
+      FP_t whitePoint = 0;
+      bool invert = false;
+      ACL::ETransferFunction transferFunction = ACL::ETF_LINEAR;
+      FP_t gamma = 1;
+
+      bool operator==(SDisplayStretch const &) const noexcept;
+      bool operator!=(SDisplayStretch const &rhs) const noexcept { return !(*this == rhs); }
+    };
+
+    class CDisplayRenderer
+    {
+    private:
+      std::vector<std::uint8_t> lut_;
+      bool lutValid_;
+      SDisplayStretch lutStretch_;                        ///< The stretch that the LUT was built for.
+      CPixelBuffer::EPixelType lutPixelType_;             ///< The pixel type that the LUT was built for.
+      std::weak_ptr<CPixelBuffer const> renderedBuffer_;  ///< The buffer that was last rendered.
+      SDisplayStretch renderedStretch_;                   ///< The stretch that was last rendered.
+      qint64 renderedKey_;                                ///< cacheKey() of the image after the last render.
+
+      void buildLUT(CPixelBuffer::EPixelType, SDisplayStretch const &);
+      static FP_t transfer(FP_t, SDisplayStretch const &);
+      static void stretchRow(CPixelBuffer const &, std::size_t, std::size_t, std::uint8_t const *, float, float, std::uint8_t *);
+
+    protected:
+    public:
+      static constexpr std::size_t LUT_SIZE = 65536;      ///< One entry for each 16 bit value.
+
+      CDisplayRenderer();
+
+      bool render(std::shared_ptr<CPixelBuffer const> const &, SDisplayStretch const &, QImage &);
+
+      static bool rendersTransfer(ACL::ETransferFunction) noexcept;
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // DISPLAYRENDERER_H
@@ -0,0 +1,138 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								frameLoader
+// SUBSYSTEM:						Image loading.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Loads a list of frames concurrently. Requests are queued and decoded on the global thread pool. The number of
+//                      frames being decoded is limited by the number of threads and by a memory budget, so that long lists of
+//                      frames do not exhaust memory. Completed frames are handed back on the GUI thread by signals, in the order
+//                      that they finish.
+//
+// CLASSES INCLUDED:    CFrameLoader
+//
+// CLASS HIERARCHY:     QObject
+//                        - CFrameLoader
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef FRAMELOADER_H
+#define FRAMELOADER_H
+
+  // Standard C++ library header files
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+
+  // Qt library header files
+
+#include <QtConcurrent/QtConcurrent>
+
+  // astroManager header files.
+
+#include "../ACL/astroFile.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CFrameLoader : public QObject
+    {
+      Q_OBJECT
+
+    private:
+      struct SRequest
+      {
+        quint64 key;
+        boost::filesystem::path fileName;             ///< The file to load. Empty if the frame is loaded from the database.
+        database::imageID_t imageID = 0;
+        database::imageVersion_t imageVersion = 0;
+      };
+
+      struct SLoadState
+      {
+        std::atomic<bool> cancelled { false };
+        std::exception_ptr exception;
+      };
+
+      struct SLoad
+      {
+        std::shared_ptr<CAstroFile> astroFile;
+        std::shared_ptr<SLoadState> loadState;        ///< Shared with the worker. The worker may outlive the loader.
+        QFutureWatcher<void> *futureWatcher;
+        std::size_t memoryEstimate;
+      };
+
+      static constexpr std::size_t DECODE_FACTOR = 4; ///< Decoded size as a multiple of the encoded size.
+
+      QWidget *parentWidget_;                         ///< Parent of the astroFiles that are created.
+      std::size_t memoryBudget_;                      ///< Memory (bytes) that may be used by frames being decoded.
+      std::size_t memoryInFlight_ = 0;
+      std::deque<SRequest> requestQueue_;
+      std::map<quint64, SLoad> inFlight_;
+      std::map<quint64, std::shared_ptr<CAstroFile>> loadedFrames_;
+
+      void addRequest(SRequest &&);
+      void startLoads();
+      void startLoad(SRequest const &);
+      QString errorText(std::exception_ptr) const;
+
+    protected:
+    public:
+      explicit CFrameLoader(QWidget *);
+      virtual ~CFrameLoader();
+
+      void addFile(quint64, boost::filesystem::path const &);
+      void addImage(quint64, database::imageID_t, database::imageVersion_t);
+      void cancel(quint64) noexcept;
+      void cancelAll() noexcept;
+      bool isPending(quint64) const;
+      void prioritise(quint64);
+      std::shared_ptr<CAstroFile> takeFrame(quint64);
+
+      /// @brief Returns the number of frames that are queued or being loaded.
+      /// @returns The number of frames still to be loaded.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t pendingCount() const noexcept { return requestQueue_.size() + inFlight_.size(); }
+
+    private slots:
+      void eventLoadFinished();
+
+    signals:
+      void frameLoaded(quint64);
+      void frameFailed(quint64, QString);
+      void finished();
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // FRAMELOADER_H
@@ -0,0 +1,98 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								imageCalibrator
+// SUBSYSTEM:						Image calibration.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Calibrates images using master bias, dark and flat frames. The master frames are read once and are then shared
+//                      (read only) by all the images being calibrated, so calibrateFile() can be called concurrently from a
+//                      number of threads. Each call reads an image, applies the master frames and writes the calibrated image.
+//
+// CLASSES INCLUDED:    CImageCalibrator
+//
+// CLASS HIERARCHY:     CImageCalibrator
+//
+// HISTORY:             2026-10-17 GGB - Master darks may have the bias subtracted. (BIASSUB keyword.)
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef IMAGECALIBRATOR_H
+#define IMAGECALIBRATOR_H
+
+  // Standard C++ library header files
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+  // Miscellaneous library header files.
+
+#include <ACL>
+#include "boost/filesystem.hpp"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CImageCalibrator
+    {
+    private:
+      struct SMasterFrame
+      {
+        std::size_t width = 0;
+        std::size_t height = 0;
+        std::vector<float> data;
+        FP_t exposure = 0;                            ///< Exposure time (s). Zero if not known.
+        bool biasSubtracted = false;                  ///< The bias has been subtracted. (BIASSUB keyword.)
+      };
+
+      std::optional<SMasterFrame> masterBias_;
+      std::optional<SMasterFrame> masterDark_;
+      std::optional<SMasterFrame> masterFlat_;        ///< Stored as the reciprocal of the normalised flat.
+      bool overwrite_ = false;
+      bool backup_ = false;
+      bool saveOriginal_ = false;
+
+      static SMasterFrame readMasterFrame(boost::filesystem::path const &);
+      static void readImage(fitsfile *, std::size_t &, std::size_t &, std::vector<float> &);
+      static FP_t readExposure(fitsfile *);
+      static void checkSize(std::optional<SMasterFrame> const &, std::size_t, std::size_t);
+      void applyMasters(std::vector<float> &, FP_t) const;
+
+    protected:
+    public:
+      CImageCalibrator() = default;
+
+      void masterBias(boost::filesystem::path const &);
+      void masterDark(boost::filesystem::path const &);
+      void masterFlat(boost::filesystem::path const &);
+      void options(bool, bool, bool) noexcept;
+
+      bool calibrateFile(boost::filesystem::path const &, boost::filesystem::path const &) const;
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // IMAGECALIBRATOR_H
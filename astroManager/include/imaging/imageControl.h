@@ -30,7 +30,8 @@
 //
 // CLASS HIERARCHY:     SControlImage
 //
-// HISTORY:             2017-07-24 GGB - File created
+// HISTORY:             2026-10-17 GGB - Added the pixel buffer, display renderer, proxy image and thumbnail image.
+//                      2017-07-24 GGB - File created
 //
 //*********************************************************************************************************************************
 
@@ -44,6 +45,8 @@
   // astroManager header files.
 
 #include "../ACL/astroFile.h"
+#include "displayRenderer.h"
+#include "pixelBuffer.h"
 #include "../astrometry/astrometryObservation.h"
 #include "../photometry/photometryObservation.h"
 #include "../astroManager.h"
@@ -69,6 +72,14 @@ namespace astroManager
       ACL::DHDBStore::size_type currentHDB = 0;
       QImage *ScreenImage = nullptr;
       QPixmap *pixmap = new QPixmap();
+      std::shared_ptr<CPixelBuffer const> pixelBuffer;  ///< Contiguous copy of the pixel data. Created when first needed.
+      CDisplayRenderer displayRenderer;
+      SDisplayStretch displayStretch;             ///< The stretch that the image must be displayed with.
+      bool renderPending = false;                 ///< ScreenImage and pixmap have not been rendered with displayStretch.
+      QImage proxyImage;                          ///< Reduced resolution render, used while renderPending is true.
+      CDisplayRenderer proxyRenderer;
+      QImage thumbnailImage;                      ///< Small render of the image, used by the navigator.
+      CDisplayRenderer thumbnailRenderer;
       ACL::ERenderMode renderMode;                ///< The mode that the image must be rendered to.
       boost::optional<FP_t> whitePoint;
       boost::optional<FP_t> blackPoint;
@@ -81,6 +92,11 @@ namespace astroManager
       explicit SControlImage(imaging::CAstroImageWindow *);
       explicit SControlImage(SControlImage const &);
       virtual ~SControlImage();
+
+      std::shared_ptr<CPixelBuffer const> const &pixelData();
+      std::shared_ptr<CPixelBuffer const> proxyData();
+      std::shared_ptr<CPixelBuffer const> thumbnailData();
+      void invalidatePixelData();
     };
 
   } // namespace imaging
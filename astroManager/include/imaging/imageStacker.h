@@ -0,0 +1,142 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								imageStacker
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Stacks images without holding the images in memory. The output image is processed in bands of rows. For
+//                      each band, only the rows of each input frame that map onto the band are read from disk. The band is then
+//                      combined (in parallel) and written to the output file. The height of the bands is chosen so that the
+//                      input rows of all the frames fit within the memory budget. The memory used therefore depends on the
+//                      memory budget and not on the number of frames.
+//
+// CLASSES INCLUDED:    CImageStacker
+//
+// CLASS HIERARCHY:     CImageStacker
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef IMAGESTACKER_H
+#define IMAGESTACKER_H
+
+  // Standard C++ library header files
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+  // astroManager header files.
+
+#include "../ACL/astroFile.h"
+#include "combineKernels.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CImageStacker
+    {
+    public:
+        /// Progress of a stack. Shared between the thread stacking the images and the thread displaying the progress.
+
+      struct SProgress
+      {
+        std::atomic<std::size_t> rowsDone{0};           ///< Number of output rows stacked.
+        std::atomic<bool> cancel{false};                ///< Set to stop stacking.
+        std::mutex previewMutex;                        ///< Protects the preview.
+        std::size_t width = 0;
+        std::size_t height = 0;
+        std::vector<float> preview;                     ///< The output image. Rows that have not been stacked are NaN.
+      };
+
+    private:
+      struct SFrame
+      {
+        boost::filesystem::path fileName;             ///< The FITS file containing the frame. Empty if the frame is in memory.
+        std::shared_ptr<CAstroFile> astroFile;        ///< The frame if it is held in memory.
+        ACL::DHDBStore::size_type hdb = 0;
+        std::size_t width = 0;
+        std::size_t height = 0;
+        MCL::TPoint2D<FP_t> align1;
+        MCL::TPoint2D<FP_t> align2;
+        FP_t cosTerm = 1;                             ///< Rotation and scale from the output image to the frame.
+        FP_t sinTerm = 0;
+        std::vector<float> bandData;                  ///< The rows of the frame needed for the current band.
+        long bandFirstRow = 0;
+        long bandLastRow = -1;
+      };
+
+      std::size_t memoryBudget_;                      ///< Memory (bytes) available for the input rows and output band.
+      std::vector<SFrame> frames_;
+      ERejection rejection_ = RJ_MAD;                 ///< Rejection used by the sigma clip combine.
+      std::shared_ptr<SProgress> progress_;           ///< Progress of the stack. May be nullptr.
+
+      void calculateTransforms();
+      std::size_t bandHeight() const;
+      void frameRows(SFrame const &, std::size_t, std::size_t, long &, long &) const;
+      void readBand(SFrame &, std::size_t, std::size_t);
+      void combineBand(std::size_t, std::size_t, ACL::CImageStack::EStackMode, std::vector<float> &) const;
+
+    protected:
+    public:
+      explicit CImageStacker(std::size_t);
+
+      void addFile(boost::filesystem::path const &, MCL::TPoint2D<FP_t> const &, MCL::TPoint2D<FP_t> const &);
+      void addImage(std::shared_ptr<CAstroFile>, ACL::DHDBStore::size_type, MCL::TPoint2D<FP_t> const &,
+                    MCL::TPoint2D<FP_t> const &);
+      void clearFrames() noexcept;
+
+      /// @brief Returns the number of frames to be stacked.
+      /// @returns The number of frames.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t frameCount() const noexcept { return frames_.size(); }
+
+      /// @brief Sets the rejection used by the sigma clip combine.
+      /// @param[in] rejection: The rejection.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void rejection(ERejection rejection) noexcept { rejection_ = rejection; }
+
+      /// @brief Sets the progress that is updated as the frames are stacked. The progress can also cancel the stack.
+      /// @param[in] progress: The progress. nullptr if the progress is not needed.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void progress(std::shared_ptr<SProgress> progress) noexcept { progress_ = progress; }
+
+      bool stackImages(ACL::CImageStack::EStackMode, boost::filesystem::path const &);
+
+      static void copyKeywords(boost::filesystem::path const &, fitsfile *);
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // IMAGESTACKER_H
@@ -0,0 +1,103 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								liveStacker
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Incremental (live) stacking. Each frame is aligned to the reference (first) frame and folded into running
+//                      accumulators (count, Welford mean and variance, an approximate median and a clipped mean). Adding a
+//                      frame, and creating the current result, therefore only costs the size of one frame and not the number of
+//                      frames already stacked.
+//
+// CLASSES INCLUDED:    CLiveStacker
+//
+// CLASS HIERARCHY:     CLiveStacker
+//
+// HISTORY:             2026-10-17 GGB - Added resultFITS() to create the result in memory.
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef LIVESTACKER_H
+#define LIVESTACKER_H
+
+  // Standard C++ library header files
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+  // astroManager header files.
+
+#include "../ACL/astroFile.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CLiveStacker
+    {
+    private:
+      bool medianSketch_;                       ///< Maintain the approximate median of each pixel.
+      std::size_t width_ = 0;                   ///< Size of the reference frame (and the result).
+      std::size_t height_ = 0;
+      MCL::TPoint2D<FP_t> align1_;              ///< Alignment points of the reference frame.
+      MCL::TPoint2D<FP_t> align2_;
+      std::size_t frameCount_ = 0;
+
+        // Accumulators. One value per pixel of the result.
+
+      std::vector<std::uint32_t> count_;        ///< Number of frames covering the pixel.
+      std::vector<float> mean_;
+      std::vector<float> m2_;                   ///< Sum of the squared differences from the mean. (Welford)
+      std::vector<float> median_;               ///< Approximate median. Only used if medianSketch_ is true.
+      std::vector<std::uint32_t> clippedCount_; ///< Number of frames not rejected from the clipped mean.
+      std::vector<float> clippedMean_;
+
+      void writeFITS(fitsfile *, ACL::CImageStack::EStackMode, boost::filesystem::path const &) const;
+
+    protected:
+    public:
+      explicit CLiveStacker(bool);
+
+      void addFrame(std::shared_ptr<CAstroFile>, ACL::DHDBStore::size_type, MCL::TPoint2D<FP_t> const &,
+                    MCL::TPoint2D<FP_t> const &);
+      void clear() noexcept;
+
+      /// @brief Returns the number of frames that have been stacked.
+      /// @returns The number of frames.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t frameCount() const noexcept { return frameCount_; }
+
+      void resultImage(ACL::CImageStack::EStackMode, std::vector<float> &) const;
+      void writeImage(ACL::CImageStack::EStackMode, boost::filesystem::path const &, boost::filesystem::path const &) const;
+      QByteArray resultFITS(ACL::CImageStack::EStackMode, boost::filesystem::path const &) const;
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // LIVESTACKER_H
@@ -0,0 +1,128 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								masterFrameBuilder
+// SUBSYSTEM:						Image calibration.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Creates master calibration frames (bias, dark and flat) from a list of FITS files without holding all the
+//                      frames in memory. A mean combine is calculated with a running mean and variance, so each frame is read
+//                      once and only two frames are held in memory. Median and sigma clip combines are calculated in bands of
+//                      rows. The height of the bands is chosen so that the rows of all the frames fit within the memory budget.
+//                      The pixels are combined in parallel. The combine can be cancelled from another thread.
+//
+// CLASSES INCLUDED:    CMasterFrameBuilder
+//
+// CLASS HIERARCHY:     CMasterFrameBuilder
+//
+// HISTORY:             2026-10-17 GGB - Added cancel() and the BIASSUB keyword.
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef MASTERFRAMEBUILDER_H
+#define MASTERFRAMEBUILDER_H
+
+  // Standard C++ library header files
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+  // Miscellaneous library header files.
+
+#include <ACL>
+#include "boost/filesystem.hpp"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CMasterFrameBuilder
+    {
+    private:
+      std::size_t memoryBudget_;                      ///< Memory (bytes) available for the rows of the frames.
+      std::vector<boost::filesystem::path> frames_;
+      std::vector<FP_t> frameScales_;                 ///< Scale applied to each frame. (Normalisation of flat frames.)
+      std::size_t width_ = 0;
+      std::size_t height_ = 0;
+      std::vector<float> subtractFrame_;              ///< Master frame subtracted from each frame. Empty if none.
+      bool normalise_ = false;
+      bool biasSubtracted_ = false;                   ///< Value of the BIASSUB keyword written to the master frame.
+      std::atomic<bool> cancelled_ {false};
+
+      void readRows(std::size_t, std::size_t, std::size_t, float *) const;
+      void calculateScales();
+      std::size_t bandHeight() const;
+      void combineMean(fitsfile *);
+      void combineBands(fitsfile *, ACL::CImageStack::EStackMode);
+
+    protected:
+    public:
+      explicit CMasterFrameBuilder(std::size_t);
+
+      void addFile(boost::filesystem::path const &);
+      void subtractFrame(boost::filesystem::path const &);
+
+      /// @brief Sets normalisation of the frames. Used for flat frames, so that changes in the illumination between the frames
+      ///        do not affect the combine.
+      /// @param[in] normalise: true if each frame should be scaled to the mean level of the first frame.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void normalise(bool normalise) noexcept { normalise_ = normalise; }
+
+      /// @brief Sets whether the master frame has had the bias removed. This is written to the master frame as the BIASSUB
+      ///        keyword, so that the calibration can tell whether a master dark still contains the bias.
+      /// @param[in] biasSubtracted: true if the bias has been removed from the frames.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void biasSubtracted(bool biasSubtracted) noexcept { biasSubtracted_ = biasSubtracted; }
+
+      /// @brief Requests that the combine stops. May be called from any thread. createMasterFrame() returns false once the
+      ///        current frame or band has been completed.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void cancel() noexcept { cancelled_ = true; }
+
+      /// @brief Returns true if the combine has been cancelled.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      bool cancelled() const noexcept { return cancelled_; }
+
+      /// @brief Returns the number of frames to be combined.
+      /// @returns The number of frames.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t frameCount() const noexcept { return frames_.size(); }
+
+      bool createMasterFrame(ACL::CImageStack::EStackMode, boost::filesystem::path const &);
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // MASTERFRAMEBUILDER_H
@@ -0,0 +1,117 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								masterFrameLibrary
+// SUBSYSTEM:						Image calibration.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						An on disk library of master calibration frames. Each master is stored in the library directory and is indexed
+//                      (library.ini) by frame type, instrument, binning, exposure, CCD temperature, filter and date. The
+//                      frames that the master was created from are recorded with their sizes and modification times. A master
+//                      is invalidated (and removed from the library) when any of its source frames change. Masters can be
+//                      found either for an image to be calibrated, or for a set of source frames so that the master does not need
+//                      to be created again.
+//
+// CLASSES INCLUDED:    CMasterFrameLibrary
+//
+// CLASS HIERARCHY:     CMasterFrameLibrary
+//
+// HISTORY:             2026-10-17 GGB - Record whether the bias has been subtracted from a master.
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef MASTERFRAMELIBRARY_H
+#define MASTERFRAMELIBRARY_H
+
+  // Standard C++ library header files
+
+#include <string>
+#include <vector>
+
+  // Miscellaneous library header files.
+
+#include <ACL>
+#include "boost/filesystem.hpp"
+
+  // Qt library header files
+
+#include <QSettings>
+#include <QStringList>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CMasterFrameLibrary
+    {
+    public:
+      enum EFrameType
+      {
+        FT_BIAS,
+        FT_DARK,
+        FT_FLAT
+      };
+
+      struct SFrameKey
+      {
+        std::string instrument;
+        int xBinning = 1;
+        int yBinning = 1;
+        FP_t exposure = 0;
+        bool hasTemperature = false;
+        FP_t temperature = 0;
+        std::string filter;
+        std::string date;                       ///< Date of the observation (YYYY-MM-DD). Empty if not known.
+        bool biasSubtracted = false;            ///< The bias has been subtracted. (BIASSUB keyword.)
+      };
+
+    private:
+      boost::filesystem::path libraryDirectory_;
+      QSettings index_;
+      FP_t temperatureTolerance_;               ///< Maximum difference (C) between the CCD temperatures.
+      int maximumAge_;                          ///< Maximum difference (days) between the dates.
+
+      static QString fingerprint(boost::filesystem::path const &);
+      static QStringList fingerprints(std::vector<boost::filesystem::path> const &, boost::filesystem::path const &);
+      bool isValid(QString const &);
+      void removeMaster(QString const &);
+      bool matches(EFrameType, SFrameKey const &, SFrameKey const &, bool) const;
+      SFrameKey indexKey(QString const &);
+
+    protected:
+    public:
+      CMasterFrameLibrary();
+
+      static SFrameKey readFrameKey(boost::filesystem::path const &);
+
+      boost::filesystem::path findMaster(EFrameType, SFrameKey const &, bool);
+      boost::filesystem::path findMaster(EFrameType, std::vector<boost::filesystem::path> const &,
+                                         boost::filesystem::path const &, int);
+      boost::filesystem::path addMaster(EFrameType, boost::filesystem::path const &,
+                                        std::vector<boost::filesystem::path> const &, boost::filesystem::path const &, int);
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // MASTERFRAMELIBRARY_H
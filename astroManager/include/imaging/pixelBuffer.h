@@ -0,0 +1,191 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								pixelBuffer
+// SUBSYSTEM:						Contiguous copies of image data for the display and analysis code.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Implements a contiguous, typed copy of the pixel data of an image HDB. The ACL image planes are
+//                      only accessible through virtual, per pixel, accessors. The display and analysis code works on large
+//                      images and needs to access the pixels through tight loops that can be vectorised and split between
+//                      threads. Images that only contain integer values in the range 0-65535 are stored as 16 bit unsigned
+//                      integers, all other images are stored as single precision floating point values. Poly images are
+//                      stored as three planes (red, green, blue).
+//                      The buffer is a snapshot. It is created when first needed and must be discarded when the pixel data of
+//                      the image changes. Values derived from the pixel data (such as the histogram and the reduced resolution
+//                      proxy) are cached by the buffer and are discarded with it.
+//
+// CLASSES INCLUDED:    CPixelBuffer
+//
+// CLASS HIERARCHY:     CPixelBuffer
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef PIXELBUFFER_H
+#define PIXELBUFFER_H
+
+  // Standard C++ library header files
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+  // astroManager header files.
+
+#include "../ACL/astroFile.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    void parallelFor(std::size_t, std::function<void(std::size_t, std::size_t)> const &);
+
+    class CPixelBuffer : public std::enable_shared_from_this<CPixelBuffer>
+    {
+    public:
+      enum EPixelType
+      {
+        PT_UINT16,                                ///< Integer data in the range 0-65535.
+        PT_FLOAT                                  ///< All other data.
+      };
+
+    private:
+      ACL::CAstroImage const *source_;            ///< The image that the buffer was created from. Only used for comparison.
+      ACL::DHDBStore::size_type hdb_;
+      std::size_t width_;
+      std::size_t height_;
+      std::size_t planes_;                        ///< 1 for mono images, 3 (RGB) for poly images.
+      std::size_t binning_;                       ///< Number of image pixels (in each axis) averaged into each buffer pixel.
+      EPixelType pixelType_;
+      std::vector<std::uint16_t> data16_;
+      std::vector<float> dataFloat_;
+      FP_t minValue_;
+      FP_t maxValue_;
+      mutable std::vector<std::size_t> histogram_;  ///< Cached result of histogram().
+      mutable std::shared_ptr<CPixelBuffer const> proxy_; ///< Cached result of proxy().
+
+      CPixelBuffer() = delete;
+      CPixelBuffer(CPixelBuffer const &) = delete;
+      CPixelBuffer &operator=(CPixelBuffer const &) = delete;
+
+      CPixelBuffer(CPixelBuffer const &, std::size_t);
+
+      bool copyInteger(ACL::CAstroImage *);
+      void copyFloat(ACL::CAstroImage *);
+      FP_t imageValue(ACL::CAstroImage *, std::size_t, std::size_t) const;
+      void histogram16(std::vector<std::size_t> &, FP_t) const;
+      void histogramFloat(std::vector<std::size_t> &, FP_t) const;
+
+    protected:
+    public:
+      CPixelBuffer(CAstroFile &, ACL::DHDBStore::size_type);
+
+      bool isCopyOf(CAstroFile &, ACL::DHDBStore::size_type) const;
+      std::vector<std::size_t> const &histogram(std::size_t) const;
+      std::shared_ptr<CPixelBuffer const> proxy(std::size_t) const;
+
+      /// @brief Returns the type of the stored pixels.
+      /// @returns The pixel type.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      EPixelType pixelType() const noexcept { return pixelType_; }
+
+      /// @brief Returns the width of the image.
+      /// @returns The image width (pixels)
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t width() const noexcept { return width_; }
+
+      /// @brief Returns the height of the image.
+      /// @returns The image height (pixels)
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t height() const noexcept { return height_; }
+
+      /// @brief Returns the number of planes.
+      /// @returns 1 for mono images, 3 (red, green, blue) for poly images.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t planes() const noexcept { return planes_; }
+
+      /// @brief Returns the number of image pixels (in each axis) that were averaged into each buffer pixel.
+      /// @returns The binning. (1 for a full resolution buffer)
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t binning() const noexcept { return binning_; }
+
+      /// @brief Returns the minimum pixel value.
+      /// @returns The minimum value.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      FP_t minValue() const noexcept { return minValue_; }
+
+      /// @brief Returns the maximum pixel value.
+      /// @returns The maximum value.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      FP_t maxValue() const noexcept { return maxValue_; }
+
+      /// @brief Returns a pointer to the start of a row of 16 bit data.
+      /// @param[in] row: The row to return.
+      /// @param[in] plane: The plane.
+      /// @returns Pointer to the first pixel in the row.
+      /// @pre pixelType() == PT_UINT16
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Added the plane parameter.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::uint16_t const *row16(std::size_t row, std::size_t plane = 0) const noexcept
+      {
+        return data16_.data() + (plane * height_ + row) * width_;
+      }
+
+      /// @brief Returns a pointer to the start of a row of floating point data.
+      /// @param[in] row: The row to return.
+      /// @param[in] plane: The plane.
+      /// @returns Pointer to the first pixel in the row.
+      /// @pre pixelType() == PT_FLOAT
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Added the plane parameter.
+      /// @version 2026-10-17/GGB - Function created.
+
+      float const *rowFloat(std::size_t row, std::size_t plane = 0) const noexcept
+      {
+        return dataFloat_.data() + (plane * height_ + row) * width_;
+      }
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // PIXELBUFFER_H
@@ -0,0 +1,88 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								skyFootprint
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	MCL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						The intersection of the sky footprints of a set of images. Each footprint is the polygon formed by the
+//                      coordinates of the image corners, projected onto the plane tangent to the sky at a reference point.
+//                      The footprints are intersected (convex polygon clipping) as they are added, so the common overlap of a
+//                      set of images is found in a single pass. Points inside the overlap are used to align the images.
+//
+// CLASSES INCLUDED:    CSkyFootprint
+//
+// CLASS HIERARCHY:     CSkyFootprint
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef SKYFOOTPRINT_H
+#define SKYFOOTPRINT_H
+
+  // Standard C++ library header files
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+  // Miscellaneous library header files.
+
+#include <ACL>
+#include <MCL>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CSkyFootprint
+    {
+    private:
+      FP_t ra0_;                                ///< Tangent point (radians)
+      FP_t dec0_;                               ///< Tangent point (radians)
+      bool hasFootprint_ = false;
+      std::vector<MCL::TPoint2D<FP_t>> overlap_;  ///< Common overlap in the tangent plane. (Counter clockwise)
+
+      MCL::TPoint2D<FP_t> project(MCL::TPoint2D<FP_t> const &) const;
+      MCL::TPoint2D<FP_t> deproject(MCL::TPoint2D<FP_t> const &) const;
+
+    protected:
+    public:
+      CSkyFootprint(FP_t, FP_t);
+
+      void intersect(std::vector<MCL::TPoint2D<FP_t>> const &);
+
+      /// @brief Determines if the footprints have a common overlap.
+      /// @returns true if there is no common overlap.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      bool isEmpty() const noexcept { return overlap_.size() < 3; }
+
+      std::optional<std::pair<MCL::TPoint2D<FP_t>, MCL::TPoint2D<FP_t>>> alignmentPoints(FP_t) const;
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // SKYFOOTPRINT_H
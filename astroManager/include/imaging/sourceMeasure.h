@@ -0,0 +1,88 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								sourceMeasure
+// SUBSYSTEM:						Measurement of the sources in an image.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	MCL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Measures the sources in an image using a pixel buffer (a snapshot of the image) rather than the ACL image.
+//                      The pixel buffer is not changed after it is created, so the measurements can be made concurrently on
+//                      worker threads while the image is owned by the GUI thread. The first plane of the buffer is used.
+//
+// CLASSES INCLUDED:    CSourceMeasure
+//
+// CLASS HIERARCHY:     CSourceMeasure
+//
+// HISTORY:             2026-10-17 GGB - Added FWHM() and aperture().
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef SOURCEMEASURE_H
+#define SOURCEMEASURE_H
+
+  // Standard C++ library header files
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+  // astroManager header files.
+
+#include "pixelBuffer.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CSourceMeasure
+    {
+    public:
+      struct SAperture
+      {
+        FP_t sourceADU;                           ///< Sum of the pixels in the aperture.
+        AXIS_t sourceArea;                        ///< Number of pixels in the aperture.
+        FP_t skyADU;                              ///< Sum of the pixels in the sky annulus.
+        AXIS_t skyArea;                           ///< Number of pixels in the sky annulus.
+      };
+
+    private:
+      std::shared_ptr<CPixelBuffer const> pixelBuffer_;
+
+      CSourceMeasure() = delete;
+
+      FP_t value(AXIS_t, AXIS_t) const noexcept;
+      bool contains(AXIS_t, AXIS_t, AXIS_t) const noexcept;
+
+    protected:
+    public:
+      explicit CSourceMeasure(std::shared_ptr<CPixelBuffer const>);
+
+      std::optional<MCL::TPoint2D<FP_t>> centroid(MCL::TPoint2D<FP_t> const &, AXIS_t, int, std::vector<float> &) const;
+      std::optional<FP_t> FWHM(MCL::TPoint2D<FP_t> const &, std::vector<float> &) const;
+      std::optional<SAperture> aperture(MCL::TPoint2D<FP_t> const &, FP_t, FP_t, FP_t) const noexcept;
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // SOURCEMEASURE_H
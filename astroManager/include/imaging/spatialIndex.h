@@ -0,0 +1,267 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								spatialIndex
+// SUBSYSTEM:						Spatial index of the objects in an image.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	MCL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Uniform grid index of objects by their CCD coordinates. Allows the objects close to a point to be
+//                      found without testing every object in the image.
+//
+// CLASSES INCLUDED:    TSpatialIndex
+//
+// CLASS HIERARCHY:     TSpatialIndex
+//
+// HISTORY:             2026-10-17 GGB - Added count().
+//                      2026-10-17 GGB - Objects are also indexed by name.
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+  // Standard C++ library header files
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+  // astroManager header files.
+
+#include "../astroManager.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    /// @brief Uniform grid index of objects by their CCD coordinates.
+    /// @details The objects are not owned by the index. The position and name of an object are taken when it is inserted, so
+    ///          the owner must rebuild the index (or insert the object again) if an object is moved, renamed or deleted other
+    ///          than through erase(). T must provide CCDCoordinates(), isClose(MCL::TPoint2D<FP_t> const &, FP_t) and
+    ///          objectName().
+
+    template<typename T>
+    class TSpatialIndex
+    {
+    private:
+      typedef std::int64_t key_t;
+
+      struct SEntry
+      {
+        key_t key;                                          ///< Cell of the object.
+        std::string name;                                   ///< Name of the object when it was inserted.
+      };
+
+      FP_t cellSize_;
+      std::unordered_map<key_t, std::vector<T *>> cells_;
+      std::unordered_map<T const *, SEntry> objects_;
+      std::unordered_multimap<std::string, T const *> names_;
+
+      TSpatialIndex(TSpatialIndex const &) = delete;
+      TSpatialIndex &operator=(TSpatialIndex const &) = delete;
+
+      /// @brief Returns the cell index of a coordinate.
+      /// @param[in] coordinate: The x or y coordinate.
+      /// @returns The cell index.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::int32_t cellIndex(FP_t coordinate) const noexcept
+      {
+        return static_cast<std::int32_t>(std::floor(coordinate / cellSize_));
+      }
+
+      /// @brief Returns the key of a cell.
+      /// @param[in] cellX: Cell index in the x axis.
+      /// @param[in] cellY: Cell index in the y axis.
+      /// @returns The key.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      static key_t cellKey(std::int32_t cellX, std::int32_t cellY) noexcept
+      {
+        return (static_cast<key_t>(cellX) << 32) | static_cast<std::uint32_t>(cellY);
+      }
+
+    public:
+      /// @brief Constructor.
+      /// @param[in] cellSize: The size of the grid cells. (pixels)
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      explicit TSpatialIndex(FP_t cellSize = 32) : cellSize_(cellSize) {}
+
+      /// @brief Removes all the objects from the index.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void clear() noexcept
+      {
+        cells_.clear();
+        objects_.clear();
+        names_.clear();
+      }
+
+      /// @brief Removes an object from the index.
+      /// @param[in] object: The object to remove.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Remove the name of the object.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void erase(T const *object)
+      {
+        auto objectIterator = objects_.find(object);
+
+        if (objectIterator != objects_.end())
+        {
+          auto names = names_.equal_range(objectIterator->second.name);
+
+          for (auto nameIterator = names.first; nameIterator != names.second; ++nameIterator)
+          {
+            if (nameIterator->second == object)
+            {
+              names_.erase(nameIterator);
+              break;
+            };
+          };
+
+          std::vector<T *> &cell = cells_[objectIterator->second.key];
+
+          for (auto cellIterator = cell.begin(); cellIterator != cell.end(); ++cellIterator)
+          {
+            if (*cellIterator == object)
+            {
+              cell.erase(cellIterator);
+              break;
+            };
+          };
+
+          if (cell.empty())
+          {
+            cells_.erase(objectIterator->second.key);
+          };
+          objects_.erase(objectIterator);
+        };
+      }
+
+      /// @brief Removes the objects with the specified name from the index.
+      /// @param[in] objectName: The name of the objects to remove.
+      /// @returns The number of objects removed.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - The objects are found by name without testing every object. All the objects are removed.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t erase(std::string const &objectName)
+      {
+        std::size_t returnValue = 0;
+        auto nameIterator = names_.find(objectName);
+
+        while (nameIterator != names_.end())
+        {
+          erase(nameIterator->second);
+          ++returnValue;
+          nameIterator = names_.find(objectName);
+        };
+
+        return returnValue;
+      }
+
+      /// @brief Returns the number of objects in the index with a name.
+      /// @param[in] objectName: The name of the objects.
+      /// @returns The number of objects with the name when they were inserted.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t count(std::string const &objectName) const { return names_.count(objectName); }
+
+      /// @brief Finds an object that is close to a point.
+      /// @param[in] point: The point to test.
+      /// @param[in] radius: The radius to search. Objects are tested with their isClose() function.
+      /// @returns The first object found that is close to the point. nullptr if there is no close object.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      T *findClose(MCL::TPoint2D<FP_t> const &point, FP_t radius) const
+      {
+        T *returnValue = nullptr;
+        std::int32_t firstX = cellIndex(point.x() - radius), lastX = cellIndex(point.x() + radius);
+        std::int32_t firstY = cellIndex(point.y() - radius), lastY = cellIndex(point.y() + radius);
+
+        for (std::int32_t cellX = firstX; (cellX <= lastX) && !returnValue; ++cellX)
+        {
+          for (std::int32_t cellY = firstY; (cellY <= lastY) && !returnValue; ++cellY)
+          {
+            auto cellIterator = cells_.find(cellKey(cellX, cellY));
+
+            if (cellIterator != cells_.end())
+            {
+              for (T *object : cellIterator->second)
+              {
+                if (object->isClose(point, radius))
+                {
+                  returnValue = object;
+                  break;
+                };
+              };
+            };
+          };
+        };
+
+        return returnValue;
+      }
+
+      /// @brief Adds an object to the index. If the object is already in the index, it is moved to its current position (and
+      ///        name).
+      /// @param[in] object: The object to add.
+      /// @throws std::bad_alloc
+      /// @version 2026-10-17/GGB - The object is also indexed by name.
+      /// @version 2026-10-17/GGB - Function created.
+
+      void insert(T *object)
+      {
+        MCL::TPoint2D<FP_t> point = object->CCDCoordinates();
+        key_t key = cellKey(cellIndex(point.x()), cellIndex(point.y()));
+        std::string name = object->objectName();
+
+        erase(object);
+        cells_[key].push_back(object);
+        names_.emplace(name, object);
+        objects_[object] = SEntry{ key, std::move(name) };
+      }
+
+      /// @brief Returns the number of objects in the index.
+      /// @returns The number of objects.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      std::size_t size() const noexcept { return objects_.size(); }
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // SPATIALINDEX_H
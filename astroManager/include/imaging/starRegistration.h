@@ -0,0 +1,123 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								starRegistration
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL, MCL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Registers images using the stars in the images, so that images without WCS information can be aligned. Stars
+//                      are extracted from each image and triangles are formed from the brightest stars. The triangles are
+//                      described by the ratios of their sides, which do not change with translation, rotation or scale. The
+//                      triangles of the reference image are held in a k-d tree, and matching triangles vote for matching
+//                      stars. An affine transform is then fitted (least squares) to the matching stars.
+//
+// CLASSES INCLUDED:    CStarRegistration
+//
+// CLASS HIERARCHY:     CStarRegistration
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef STARREGISTRATION_H
+#define STARREGISTRATION_H
+
+  // Standard C++ library header files
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+  // Miscellaneous library header files.
+
+#include <ACL>
+#include <MCL>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CStarRegistration
+    {
+    public:
+      struct SStar
+      {
+        FP_t x;
+        FP_t y;
+        FP_t flux;                              ///< Sum of the pixel values above the background.
+      };
+
+        /// Affine transform. x' = a * x + b * y + c; y' = d * x + e * y + f
+
+      struct STransform
+      {
+        FP_t a = 1;
+        FP_t b = 0;
+        FP_t c = 0;
+        FP_t d = 0;
+        FP_t e = 1;
+        FP_t f = 0;
+
+        /// @brief Applies the transform to a point.
+        /// @param[in] point: The point to transform.
+        /// @returns The transformed point.
+        /// @throws None.
+        /// @version 2026-10-17/GGB - Function created.
+
+        MCL::TPoint2D<FP_t> operator()(MCL::TPoint2D<FP_t> const &point) const
+        {
+          return MCL::TPoint2D<FP_t>(a * point.x() + b * point.y() + c, d * point.x() + e * point.y() + f);
+        }
+      };
+
+    private:
+      struct STriangle
+      {
+        FP_t u;                                 ///< Shortest side / longest side.
+        FP_t v;                                 ///< Middle side / longest side.
+        std::size_t vertex[3];                  ///< Stars opposite the shortest, middle and longest sides.
+      };
+
+      FP_t matchTolerance_;                     ///< Maximum difference (pixels) between matched stars.
+      std::vector<SStar> referenceStars_;
+      std::vector<STriangle> referenceTriangles_; ///< Ordered as a k-d tree. (Median of each range is the node.)
+
+      static std::vector<STriangle> makeTriangles(std::vector<SStar> const &);
+      static void buildTree(std::vector<STriangle>::iterator, std::vector<STriangle>::iterator, std::size_t);
+      void searchTree(std::size_t, std::size_t, std::size_t, STriangle const &, std::vector<std::size_t> &) const;
+      static std::optional<STransform> fitTransform(std::vector<SStar> const &, std::vector<SStar> const &,
+                                                    std::vector<std::pair<std::size_t, std::size_t>> const &);
+
+    protected:
+    public:
+      explicit CStarRegistration(FP_t);
+
+      static std::vector<SStar> extractStars(ACL::CAstroImage *, std::size_t, FP_t);
+
+      void referenceStars(std::vector<SStar> const &);
+      std::optional<STransform> registerStars(std::vector<SStar> const &) const;
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // STARREGISTRATION_H
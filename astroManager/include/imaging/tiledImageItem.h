@@ -0,0 +1,99 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								tiledImageItem
+// SUBSYSTEM:						Tiled, multi-resolution graphics item for displaying images.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Implements a QGraphicsItem that displays a rendered image as a pyramid of tiles. Level 0 of the pyramid
+//                      is the full resolution image, each following level is half the size of the previous level. When the item
+//                      is painted, only the tiles that intersect the exposed area are drawn, from the level that best matches the
+//                      current zoom. The levels and the tiles are created when they are first needed. The tiles are held in an
+//                      LRU cache with a limited size. While the image is being rendered again, a reduced resolution preview
+//                      can be displayed in place of the tiles.
+//
+// CLASSES INCLUDED:    CTiledImageItem
+//
+// CLASS HIERARCHY:     QGraphicsItem
+//                        CTiledImageItem
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#ifndef TILEDIMAGEITEM_H
+#define TILEDIMAGEITEM_H
+
+  // Standard C++ library header files
+
+#include <cstdint>
+#include <vector>
+
+  // Miscellaneous library header files.
+
+#include <QCL>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CTiledImageItem : public QGraphicsItem
+    {
+    private:
+      std::vector<QImage> imageLevels_;           ///< The pyramid. Level 0 is the full resolution image.
+      qint64 sourceKey_;                          ///< cacheKey() of the image the item was constructed from.
+      int maximumLevel_;
+      QCache<quint64, QPixmap> tileCache_;        ///< Cost is the size of the tile in kB.
+      QImage previewImage_;                       ///< Reduced resolution image displayed instead of the tiles when not null.
+
+      CTiledImageItem() = delete;
+      CTiledImageItem(CTiledImageItem const &) = delete;
+      CTiledImageItem &operator=(CTiledImageItem const &) = delete;
+
+      QImage const &imageLevel(int);
+      QPixmap *tile(int, int, int);
+      int selectLevel(qreal) const;
+
+    protected:
+    public:
+      static int const TILE_SIZE = 256;           ///< Tile size (pixels) in the level coordinates.
+
+      CTiledImageItem(QImage const &, QGraphicsItem * = nullptr);
+
+      virtual QRectF boundingRect() const override;
+      virtual void paint(QPainter *, QStyleOptionGraphicsItem const *, QWidget * = nullptr) override;
+
+      bool setImage(QImage const &);
+      void setPreview(QImage const &);
+
+      /// @brief Returns the cacheKey() of the image that the item was constructed from.
+      /// @returns The cache key of the source image.
+      /// @throws None.
+      /// @version 2026-10-17/GGB - Function created.
+
+      qint64 sourceKey() const noexcept { return sourceKey_; }
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // TILEDIMAGEITEM_H
@@ -73,6 +73,7 @@ namespace astroManager
     SWT_CALC_GREG2JD,
     SWT_CALC_JD2GREG,
     SWT_UTILITY_PLANNING,
+    SWT_IMAGE_OPEN,
   };
 
   class CMdiSubWindow : public QMdiSubWindow
@@ -141,6 +141,9 @@ namespace astroManager
     QString const IMAGING_DATABASE_REGISTERONOPEN                   ("Imaging/Database/RegisterOnOpen");
     QString const IMAGING_DATABASE_UPLOAD_DIRECTORY                 ("Imaging/Database/Directory");
     QString const IMAGING_KEYWORDS_CLEAN                            ("Imaging/Keywords/Clean");
+    QString const IMAGING_LOAD_MEMORYMAPPED                         ("Imaging/Load/MemoryMapped");          ///< Map FITS files when opening.
+    QString const IMAGING_LOAD_MEMORYBUDGET                         ("Imaging/Load/MemoryBudget");          ///< Memory (MB) for frames being loaded.
+    QString const IMAGING_DISPLAY_TILECACHE                         ("Imaging/Display/TileCache");          ///< Tile cache size (MB) per image.
 
       // Definitions for image stacking
 
@@ -152,6 +155,12 @@ namespace astroManager
     QString const IMAGESTACK_AUTO_DISTANCE                          ("ImageStack/Auto/Distance");
     QString const IMAGESTACK_AUTO_NOWCSACTION                       ("ImageStack/Auto/NoWCSAction");
     QString const IMAGESTACK_AUTO_SAVEOUTPUT                        ("ImageStack/Auto/AutoSaveOutput");
+    QString const IMAGESTACK_AUTO_STARREGISTRATION                  ("ImageStack/Auto/StarRegistration");   ///< Register images without WCS.
+    QString const IMAGESTACK_MEMORYBUDGET                           ("ImageStack/MemoryBudget");            ///< Memory (MB) used for stacking.
+    QString const IMAGESTACK_LIVE_DIRECTORY                         ("ImageStack/Live/Directory");          ///< Folder watched by the live stack.
+    QString const IMAGESTACK_LIVE_MEDIANSKETCH                      ("ImageStack/Live/MedianSketch");       ///< Live stack maintains the median.
+    QString const IMAGESTACK_REJECTION                              ("ImageStack/Rejection");               ///< Sigma clip rejection. (ERejection)
+    QString const IMAGESTACK_PREVIEWINTERVAL                        ("ImageStack/PreviewInterval");         ///< Seconds between stack previews.
 
       // Definitions for Window Planning
 
@@ -285,6 +294,11 @@ namespace astroManager
     QString const IMAGE_CALIBRATION_CREATEFLAT_DARKSELECTION        ("Image/Calibration/CreateFlat/DarkSelection");
     QString const IMAGE_CALIBRATION_CREATEFLAT_DARKSAVEAS           ("Image/Calibration/CreateFlat/DarkSaveAs");
 
+    QString const IMAGE_CALIBRATION_MEMORYBUDGET                    ("Image/Calibration/MemoryBudget");     ///< Memory (MB) for master frames.
+    QString const IMAGE_CALIBRATION_LIBRARY_DIRECTORY               ("Image/Calibration/Library/Directory");
+    QString const IMAGE_CALIBRATION_LIBRARY_TEMPERATURE             ("Image/Calibration/Library/Temperature"); ///< Tolerance (C).
+    QString const IMAGE_CALIBRATION_LIBRARY_MAXIMUMAGE              ("Image/Calibration/Library/MaximumAge");  ///< Days.
+
     QString const IMAGE_CALIBRATION_RAWIMAGESDIRECTORY              ("Image/Calibration/Raw Images/Directory");
     QString const IMAGE_CALIBRATION_PROCESSEDDIRECTORY              ("Image/Calibration/Processed Images/Directory");
 
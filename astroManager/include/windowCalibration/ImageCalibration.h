@@ -48,6 +48,10 @@
 
 #include "windowCalibration.h"
 
+  // Standard C++ library header files
+
+#include <vector>
+
 #include <QCL>
 
 namespace astroManager
@@ -182,6 +186,13 @@ namespace astroManager
       Q_OBJECT
 
     private:
+      struct SImageMasters                      ///< The master frames used to calibrate an image. (Empty if none.)
+      {
+        QString bias;
+        QString dark;
+        QString flat;
+      };
+
       QStringList imagesList;
       QString masterDarkFrame;
       QString masterBiasFrame;
@@ -195,6 +206,8 @@ namespace astroManager
       virtual void closeEvent(QCloseEvent *);
 
       void setupUI();
+      std::vector<SImageMasters> matchMasterFrames(bool, bool, bool);
+      QStringList duplicateOutputFiles() const;
 
     protected:
     public:
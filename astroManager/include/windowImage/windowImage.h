@@ -103,6 +103,8 @@ namespace astroManager
 
       virtual SControlImage *getControlImage() = 0;
       virtual void repaintImage() = 0;
+      virtual bool displaysPixmap() const { return true; }    ///< true if the window displays SControlImage::pixmap.
+      virtual void repaintPreview() {}                        ///< Displays SControlImage::proxyImage, if supported.
 
         // Astrometry functions
 
@@ -59,6 +59,7 @@
 #include "../dialogs/dialogs.h"
 #include "../error.h"
 #include "../FrameWindow.h"
+#include "../imaging/tiledImageItem.h"
 #include "../qtExtensions/MdiSubWindow.h"
 #include "../photometry/photometryObservation.h"
 
@@ -121,6 +122,7 @@ namespace astroManager
 
       QGraphicsScene *gsImage;
       CAstroGraphicsView *gvImage;
+      CTiledImageItem *imageItem = nullptr;             ///< Owned by gsImage.
 
       QAction *menuActions[IDA_MENUMAX];
       QMenu *popupMenu;
@@ -196,6 +198,8 @@ namespace astroManager
       void calibrateImage();
       void redrawImage();
       virtual void repaintImage();
+      virtual bool displaysPixmap() const override { return false; }  ///< The image is displayed from the ScreenImage.
+      virtual void repaintPreview() override;
 
         // File functions
 
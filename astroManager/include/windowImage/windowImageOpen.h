@@ -0,0 +1,105 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								windowImageOpen
+// SUBSYSTEM:						Placeholder window displayed while an image is opened.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, boost
+// NAMESPACE:						AstroManager::imaging
+// AUTHOR:							Gavin Blakeman (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:            The image data is decoded on a worker thread from the global thread pool. The placeholder window shows the
+//                      progress of the load and allows the user to cancel the load. When the load is complete the placeholder
+//                      window closes and the frame window opens the image window.
+//
+// CLASSES INCLUDED:    CImageOpenWindow
+//
+// CLASS HIERARCHY:     QMdiSubWindow
+//                        CMdiSubWindow
+//                          CImageOpenWindow
+//
+// HISTORY:             2026-10-17/GGB - File Created
+//
+//*********************************************************************************************************************************
+
+#ifndef WINDOWIMAGEOPEN_H
+#define WINDOWIMAGEOPEN_H
+
+  // Standard C++ library header files
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+  // Qt library header files
+
+#include <QtConcurrent/QtConcurrent>
+
+  // astroManager header files
+
+#include "../ACL/astroFile.h"
+#include "../qtExtensions/MdiSubWindow.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    class CImageOpenWindow : public CMdiSubWindow
+    {
+      Q_OBJECT
+
+    private:
+      struct SLoadState
+      {
+        std::atomic<bool> cancelled { false };
+        std::exception_ptr exception;
+      };
+
+      std::shared_ptr<CAstroFile> astroFile_;
+      std::shared_ptr<SLoadState> loadState_;       ///< Shared with the worker. The worker may outlive the window.
+      QFutureWatcher<void> futureWatcher;
+
+      QLabel *labelFileName;
+      QProgressBar *progressBar;
+      QPushButton *pushButtonCancel;
+
+      void setupUI();
+
+    protected:
+      virtual void closeEvent(QCloseEvent *);
+
+    public:
+      CImageOpenWindow(std::shared_ptr<CAstroFile>, QWidget *);
+
+      virtual ESubWindowType getWindowType() const { return SWT_IMAGE_OPEN; }
+
+      void startLoad();
+
+    private slots:
+      void eventButtonCancel(bool);
+      void eventLoadFinished();
+
+    public slots:
+      virtual void windowActivating() {}
+    };
+
+  } // namespace imaging
+} // namespace astroManager
+
+#endif // WINDOWIMAGEOPEN_H
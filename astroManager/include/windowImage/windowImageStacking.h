@@ -48,9 +48,22 @@
 
 #include "../astrometry/astrometryObservation.h"
 #include "windowImage.h"
+#include "../imaging/frameLoader.h"
 #include "../imaging/imageControl.h"
+#include "../imaging/imageStacker.h"
+#include "../imaging/liveStacker.h"
+#include "../imaging/starRegistration.h"
 #include "../photometry/photometryObservation.h"
 
+  // Standard C++ library header files
+
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <optional>
+
+  // Miscellaneous library header files.
 
 #include <QCL>
 
@@ -74,6 +87,49 @@ namespace astroManager
       Q_OBJECT
 
     private:
+        // A frame waiting to be added to the live stack by the worker thread.
+
+      struct SLiveFrame
+      {
+        std::shared_ptr<CAstroFile> astroFile;
+        ACL::DHDBStore::size_type hdb;
+        MCL::TPoint2D<FP_t> align1;
+        MCL::TPoint2D<FP_t> align2;
+      };
+
+        // State of the live stack. (liveStacker is nullptr when not live stacking)
+
+      struct SLiveStack
+      {
+        std::unique_ptr<CLiveStacker> liveStacker;                          ///< Only accessed by the worker while it is running.
+        std::size_t frameCount = 0;                                         ///< Frames added. (Including the queued frames)
+        std::unique_ptr<CStarRegistration> starRegistration;                 ///< Stars of the reference image.
+        MCL::TPoint2D<FP_t> align1;                                         ///< Alignment points of the reference image.
+        MCL::TPoint2D<FP_t> align2;
+        std::optional<ACL::CAstronomicalCoordinates> align1Coordinates;     ///< Only if the reference image has WCS.
+        std::optional<ACL::CAstronomicalCoordinates> align2Coordinates;
+        boost::filesystem::path keywordFile;                                ///< FITS file of the reference image.
+        QFileSystemWatcher *directoryWatcher = nullptr;
+        std::map<QString, std::pair<qint64, QDateTime>> pendingFiles;      ///< New files that are still being written.
+        QTimer *settleTimer = nullptr;
+        bool retryLoad = false;                                             ///< Images that failed to load are queued again.
+        std::deque<SLiveFrame> frameQueue;                                  ///< Frames waiting for the worker.
+        QFutureWatcher<void> *liveWatcher = nullptr;
+        std::shared_ptr<CAstroFile> liveResult;                             ///< Result created by the worker.
+        std::exception_ptr liveException;                                   ///< Exception thrown by the worker.
+      };
+
+        // A stack that runs on a worker thread.
+
+      struct SStackJob
+      {
+        std::unique_ptr<CImageStacker> imageStack;
+        ACL::CImageStack::EStackMode stackMode;
+        boost::filesystem::path outputFile;
+        std::shared_ptr<CImageStacker::SProgress> progress;
+        QString name;                                                       ///< Description for the progress.
+      };
+
       std::vector<database::imageID_t> imageIDList;
       QStringList imageList;
       std::string darkFrameFilename;
@@ -103,14 +159,25 @@ namespace astroManager
 
       QAction *actionSelectFromFolder;
       QAction *actionSelectFromDatabase;
+      QAction *actionLiveStack;
 
       QMenu *addImagesMenu;
 
-      ACL::CImageStack imageStack;
+      CFrameLoader *frameLoader;              ///< Loads the images concurrently. The list items are used as the keys.
 
       imaging::SControlImage outputControlImage;
       bool outputControlImageValid_ = false;
 
+      SLiveStack liveStack_;
+
+      std::deque<SStackJob> stackQueue_;      ///< Stacks waiting to run. The stack at the front is running.
+      QFutureWatcher<void> *stackWatcher_;
+      std::exception_ptr stackException_;     ///< Exception thrown by the running stack.
+      QTimer *stackTimer_;                    ///< Updates the progress and preview of the running stack.
+      std::size_t stackPreviewRows_ = 0;      ///< Number of rows in the preview.
+      QProgressBar *progressBarStack_;
+      QPushButton *pushButtonCancelStack_;
+
       bool isDirty;						// true if the resulting image has not been saved.
       std::string fileName;		// Filename of the resulting stacked images. Used by save and saveAs
 
@@ -131,10 +198,22 @@ namespace astroManager
       void displayAlignmentGraphics(QListWidgetItem *);
       void removeAlignmentGraphics();
 
+      void addFileItem(QString const &);
+      bool alignImagesWCS(FP_t);
       void clearImageList() noexcept;
       void deleteListItem(QListWidgetItem *);
+      void displayOutputImage(boost::filesystem::path const &);
+      void displayOutputImage(std::shared_ptr<CAstroFile>);
+      void liveStackImage(QListWidgetItem *);
       imaging::SControlImage *loadImage(QListWidgetItem *);
+      bool loadImages();
+      void queueImages();
+      bool registerImages(FP_t, int);
+      void releaseImage(QListWidgetItem *);
+      ACL::CImageStack::EStackMode selectedStackMode();
       void stackImages();
+      void startLiveStack();
+      void startStack();
 
       void createActions();
 
@@ -190,6 +269,18 @@ namespace astroManager
       void eventOpenInWindow(bool);
 
       void eventTabChanged(int);
+
+      void eventFrameLoaded(quint64);
+      void eventFrameFailed(quint64, QString);
+
+      void eventLiveStack(bool);
+      void eventLiveDirectoryChanged(QString const &);
+      void eventLiveSettleTimer();
+      void eventLiveStackFinished();
+
+      void eventButtonCancelStack(bool);
+      void eventStackFinished();
+      void eventStackTimer();
     };
 
   }  // namespace imagestacking
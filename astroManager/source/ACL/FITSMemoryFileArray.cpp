@@ -28,18 +28,218 @@
 // OVERVIEW:						A class for in-memory management of FITS files.
 //
 // CLASSES INCLUDED:		CFITSMemoryFileArray
+//                      CMemoryBufferPool
 //
 // CLASS HIERARCHY:     ACL::CFITSMemoryFile
 //                        AstroManager::CFITSMemoryFileArray
+//                      CMemoryBufferPool
 //
-// HISTORY:             2017-08-13 GGB - Started development of classes.
+// HISTORY:             2026-10-17 GGB - Limited CMemoryBufferPool by the total capacity retained.
+//                      2026-10-17 GGB - Added CMemoryBufferPool.
+//                      2017-08-13 GGB - Started development of classes.
 //
 //*********************************************************************************************************************************
 
 #include "include/ACL/FITSMemoryFileArray.h"
 
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cstring>
+
 namespace astroManager
 {
+  //*******************************************************************************************************************************
+  //
+  // CMemoryBufferPool
+  //
+  //*******************************************************************************************************************************
+
+  /// @brief      Constructor for the class.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  CMemoryBufferPool::CMemoryBufferPool() : poolMutex(), pool(), allocations_(0), poolHits_(0), reallocations_(0), bytesCopied_(0)
+  {
+  }
+
+  /// @brief      Returns the application wide instance of the buffer pool.
+  /// @returns    Reference to the buffer pool.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  CMemoryBufferPool &CMemoryBufferPool::instance()
+  {
+    static CMemoryBufferPool bufferPool;
+
+    return bufferPool;
+  }
+
+  /// @brief      Acquires a buffer with at least the requested capacity.
+  /// @param[in]  capacity: The minimum capacity of the buffer (bytes).
+  /// @returns    An empty buffer with at least the requested capacity.
+  /// @details    The smallest pooled buffer that is large enough is returned. If there is no suitable buffer in the pool, a new
+  ///             buffer is allocated.
+  /// @throws     std::bad_alloc
+  /// @version    2026-10-17/GGB - Function created.
+
+  QByteArray CMemoryBufferPool::acquire(std::size_t capacity)
+  {
+    QByteArray returnValue;
+
+    {
+      std::lock_guard<std::mutex> lock(poolMutex);
+
+      auto bestFit = pool.end();
+
+      for (auto iter = pool.begin(); iter != pool.end(); ++iter)
+      {
+        if ( (static_cast<std::size_t>(iter->capacity()) >= capacity) &&
+             ( (bestFit == pool.end()) || (iter->capacity() < bestFit->capacity()) ) )
+        {
+          bestFit = iter;
+        };
+      };
+
+      if (bestFit != pool.end())
+      {
+        poolBytes_ -= static_cast<std::size_t>(bestFit->capacity());
+        returnValue = std::move(*bestFit);
+        pool.erase(bestFit);
+      };
+    };
+
+    if (returnValue.capacity() == 0)
+    {
+      returnValue.reserve(static_cast<int>(capacity));   // Sets the capacity reserved flag, resize() will not shrink the buffer.
+      ++allocations_;
+    }
+    else
+    {
+      returnValue.resize(0);
+      ++poolHits_;
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Removes all the buffers from the pool.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CMemoryBufferPool::clear()
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    pool.clear();
+    poolBytes_ = 0;
+  }
+
+  /// @brief      Sets the maximum total capacity of the buffers that will be retained by the pool.
+  /// @param[in]  newLimit: The maximum total capacity (bytes).
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CMemoryBufferPool::poolByteLimit(std::size_t newLimit)
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    poolByteLimit_ = newLimit;
+    trim();
+  }
+
+  /// @brief      Sets the maximum number of buffers that will be retained by the pool.
+  /// @param[in]  newLimit: The maximum number of buffers to retain.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CMemoryBufferPool::poolLimit(std::size_t newLimit)
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    poolLimit_ = newLimit;
+    trim();
+  }
+
+  /// @brief      Records that a buffer had to be grown.
+  /// @param[in]  bytesCopied: The number of bytes that were copied into the new buffer.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CMemoryBufferPool::recordReallocation(std::size_t bytesCopied)
+  {
+    ++reallocations_;
+    bytesCopied_ += bytesCopied;
+  }
+
+  /// @brief      Returns a buffer to the pool.
+  /// @param[in]  buffer: The buffer to return.
+  /// @details    Buffers that are shared (for example still bound to a query) are not retained, as reusing them would cause
+  ///             a deep copy. Buffers larger than the byte limit are never retained. The pool is then trimmed to its limits.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Limit the pool by the total capacity retained.
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CMemoryBufferPool::release(QByteArray &&buffer)
+  {
+    if ( (buffer.capacity() != 0) && buffer.isDetached())
+    {
+      std::lock_guard<std::mutex> lock(poolMutex);
+
+      if (static_cast<std::size_t>(buffer.capacity()) <= poolByteLimit_)
+      {
+        poolBytes_ += static_cast<std::size_t>(buffer.capacity());
+        pool.emplace_back(std::move(buffer));
+        trim();
+      };
+    };
+
+    buffer = QByteArray();
+  }
+
+  /// @brief      Returns the statistics for the pool.
+  /// @returns    The statistics.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  CMemoryBufferPool::SStatistics CMemoryBufferPool::statistics() const
+  {
+    return { allocations_, poolHits_, reallocations_, bytesCopied_ };
+  }
+
+  /// @brief      Discards buffers until the pool is within its limits.
+  /// @details    If there are too many buffers, the smallest buffers are discarded. If the total capacity is too large, the
+  ///             largest buffers are discarded.
+  /// @pre        The pool mutex must be held by the caller.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CMemoryBufferPool::trim()
+  {
+    auto capacityLess = [] (QByteArray const &lhs, QByteArray const &rhs) { return lhs.capacity() < rhs.capacity(); };
+
+    while (pool.size() > poolLimit_)
+    {
+      auto iter = std::min_element(pool.begin(), pool.end(), capacityLess);
+
+      poolBytes_ -= static_cast<std::size_t>(iter->capacity());
+      pool.erase(iter);
+    };
+
+    while (poolBytes_ > poolByteLimit_)
+    {
+      auto iter = std::max_element(pool.begin(), pool.end(), capacityLess);
+
+      poolBytes_ -= static_cast<std::size_t>(iter->capacity());
+      pool.erase(iter);
+    };
+  }
+
+  //*******************************************************************************************************************************
+  //
+  // CFITSMemoryFileArray
+  //
+  //*******************************************************************************************************************************
 
   /// @brief      Default constructor for the class.
   /// @throws     std::bad_alloc
@@ -69,39 +269,101 @@ namespace astroManager
     memory_allocate(memorySize);
   }
 
+  /// @brief      Destructor. Returns the buffer to the pool.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  CFITSMemoryFileArray::~CFITSMemoryFileArray()
+  {
+    CMemoryBufferPool::instance().release(std::move(byteArray_));
+  }
+
   /// @brief      Function to allocate memory.
   /// @param[in]  newMemorySize: The number of bytes to allocate.
+  /// @details    The buffer is taken from the buffer pool and is sized to the larger of the request and the capacity hint.
   /// @throws     std::bad_alloc
+  /// @version    2026-10-17/GGB - Use the buffer pool and capacity hint.
   /// @version    2017-08-13/GGB - Function created.
 
   void CFITSMemoryFileArray::memory_allocate(std::size_t newMemorySize)
   {
-    byteArray_.resize(newMemorySize);
+    CMemoryBufferPool::instance().release(std::move(byteArray_));
+
+    byteArray_ = CMemoryBufferPool::instance().acquire(std::max(newMemorySize, capacityHint_));
+    byteArray_.resize(static_cast<int>(newMemorySize));
+    ++allocations_;
+
     memorySize(byteArray_.size());
     memoryPointer(byteArray_.data());
   }
 
   /// @brief      Frees the allocated memory
+  /// @details    The buffer is returned to the pool for reuse.
   /// @throws     None.
+  /// @version    2026-10-17/GGB - Return the buffer to the pool.
   /// @version    2017-08-13/GGB - Function created.
 
   void CFITSMemoryFileArray::memory_free()
   {
-    byteArray_.resize(0);
+    CMemoryBufferPool::instance().release(std::move(byteArray_));
     memorySize(byteArray_.size());
     memoryPointer(byteArray_.data());
   }
 
   /// @brief      Reallocates memory
   /// @param[in]  newMemorySize: Number of bytes to allocate.
+  /// @details    If the request fits into the current capacity, the size is changed without moving the data. Otherwise the
+  ///             capacity is grown geometrically so that a file that is written sequentially only needs log(n) copies.
   /// @throws     std::bad_alloc
+  /// @version    2026-10-17/GGB - Grow geometrically using the buffer pool.
   /// @version    2017-08-13/GGB - Function created.
 
   void CFITSMemoryFileArray::memory_reallocate(std::size_t newMemorySize)
   {
-    byteArray_.resize(newMemorySize);
+    std::size_t capacity = static_cast<std::size_t>(byteArray_.capacity());
+
+    if (newMemorySize > capacity)
+    {
+      std::size_t bytesToCopy = static_cast<std::size_t>(byteArray_.size());
+      QByteArray newArray = CMemoryBufferPool::instance().acquire(std::max({newMemorySize, capacity * GROWTH_FACTOR,
+                                                                            capacityHint_}));
+
+      newArray.resize(static_cast<int>(newMemorySize));
+
+      if (capacity == 0)
+      {
+        ++allocations_;
+      }
+      else
+      {
+        std::memcpy(newArray.data(), byteArray_.constData(), bytesToCopy);
+        ++reallocations_;
+        bytesCopied_ += bytesToCopy;
+        CMemoryBufferPool::instance().recordReallocation(bytesToCopy);
+      };
+
+      CMemoryBufferPool::instance().release(std::move(byteArray_));
+      byteArray_ = std::move(newArray);
+    }
+    else
+    {
+      byteArray_.resize(static_cast<int>(newMemorySize));
+    };
+
     memorySize(byteArray_.size());
     memoryPointer(byteArray_.data());
   }
 
+  /// @brief      Sets the capacity that will be allocated when the memory file is first allocated.
+  /// @param[in]  capacity: The expected size of the file (bytes).
+  /// @details    If the expected size of the file is known (for example from the sizes of the HDU's) the whole file can be
+  ///             written without any reallocations.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CFITSMemoryFileArray::reserve(std::size_t capacity)
+  {
+    capacityHint_ = capacity;
+  }
+
 }
@@ -32,7 +32,10 @@
 // CLASS HIERARCHY:     ACL::CAstroFile
 //                        AstroManager::CAstroFile
 //
-// HISTORY:             2017-07-24 GGB - File created
+// HISTORY:             2026-10-17 GGB - The batched WCS transforms renamed pix2wcsList() and wcs2pixList(). Converted serially.
+//                      2026-10-17 GGB - Added the batched WCS transforms.
+//                      2026-10-17 GGB - Added the spatial index of the astrometry and photometry objects.
+//                      2017-07-24 GGB - File created
 //
 //*********************************************************************************************************************************
 
@@ -40,6 +43,7 @@
 
   // Miscellaneous library header files.
 
+#include "boost/algorithm/string.hpp"
 #include "boost/locale.hpp"
 #include <QCL>
 
@@ -61,18 +65,27 @@ namespace astroManager
 
   CAstroFile::CAstroFile(CAstroFile const &toCopy) : ACL::CAstroFile(toCopy), parent_(toCopy.parent_),
     fileNameValid_(toCopy.fileNameValid_), fileName_(toCopy.fileName_), imageIDValid_(toCopy.imageIDValid_),
-    imageID_(toCopy.imageID_), imageVersion_(toCopy.imageVersion_)
+    imageID_(toCopy.imageID_), imageVersion_(toCopy.imageVersion_), loadMemoryMapped_(toCopy.loadMemoryMapped_),
+    hduSelection_(toCopy.hduSelection_), extensionsSkipped_(toCopy.extensionsSkipped_)
   {
   }
 
   /// @brief Constructor for the class. Calls the parent constructor.
   /// @param[in] filename: The filename to associate with this file.
+  /// @param[in] loadMode: LM_DEFERRED if the data will be loaded later by calling loadData() and completeLoad().
+  /// @param[in] hduSelection: HS_PRIMARY if only the primary HDU is required.
   /// @details  Substitutes the observationLocation to a AstroManager::CObservatory rather than a ACL::CGeographicLocation.
   /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Added hduSelection parameter to allow only the primary HDU to be loaded.
+  /// @version 2026-10-17/GGB - Added loadMode parameter to allow the image to be loaded on a worker thread.
   /// @version 2017-07-24/GGB - Function created.
 
-  CAstroFile::CAstroFile(QWidget *parent, boost::filesystem::path const &filename) : ACL::CAstroFile(filename.filename().string()),
-    parent_(parent), fileNameValid_(true), fileName_(filename), imageIDValid_(false), imageID_(0), imageVersion_(0)
+  CAstroFile::CAstroFile(QWidget *parent, boost::filesystem::path const &filename, ELoadMode loadMode,
+                         EHDUSelection hduSelection)
+    : ACL::CAstroFile(filename.filename().string()), parent_(parent), fileNameValid_(true), fileName_(filename),
+      imageIDValid_(false), imageID_(0), imageVersion_(0),
+      loadMemoryMapped_(settings::astroManagerSettings->value(settings::IMAGING_LOAD_MEMORYMAPPED, QVariant(true)).toBool()),
+      hduSelection_(hduSelection)
   {
       // First change the object stored by the astroFile into a AstroManager::CObservatory type.
       // and the telescope into an astroManagerCTelescope() type.
@@ -80,18 +93,29 @@ namespace astroManager
     observationLocation.reset(new CObservatory());
     observationTelescope.reset(new CTelescope());
 
-    load();
+    if (loadMode == LM_IMMEDIATE)
+    {
+      load();
+    };
   }
 
   /// @brief Constructor to construct from a database object.
   /// @param[in] imageID: The imageID to load from the database.
   /// @param[in] imageVersion: The version of the image to load.
+  /// @param[in] loadMode: LM_DEFERRED if the data will be decoded later by calling loadData() and completeLoad().
+  /// @param[in] hduSelection: HS_PRIMARY if only the primary HDU is required.
+  /// @details When the load is deferred, the image is still downloaded from the database by the constructor. (The database
+  ///          connection can only be used from the thread that created it.) Only the decoding of the image is deferred.
   /// @throws std::bad_alloc
+  /// @throws GCL::CCodeError(astroManager)
+  /// @version 2026-10-17/GGB - Added hduSelection parameter to allow only the primary HDU to be loaded.
+  /// @version 2026-10-17/GGB - Added loadMode parameter to allow the image to be decoded on a worker thread.
   /// @version 2017-08-12/GGB - Function created.
 
-  CAstroFile::CAstroFile(QWidget *parent, database::imageID_t imageID, database::imageVersion_t imageVersion)
+  CAstroFile::CAstroFile(QWidget *parent, database::imageID_t imageID, database::imageVersion_t imageVersion, ELoadMode loadMode,
+                         EHDUSelection hduSelection)
     : ACL::CAstroFile(), parent_(parent), fileNameValid_(false), fileName_(), imageIDValid_(true), imageID_(imageID),
-      imageVersion_(imageVersion)
+      imageVersion_(imageVersion), loadMemoryMapped_(false), hduSelection_(hduSelection)
   {
       // First change the object stored by the astroFile into a AstroManager::CObservatory type.
       // and the telescope into an astroManagerCTelescope() type.
@@ -99,7 +123,14 @@ namespace astroManager
     observationLocation.reset(new CObservatory());
     observationTelescope.reset(new CTelescope());
 
-    load();
+    if (loadMode == LM_IMMEDIATE)
+    {
+      load();
+    }
+    else if (!database::databaseARID->downLoadImage(imageID_, imageVersion_, databaseImage_))
+    {
+      CODE_ERROR;
+    };
   }
 
   /// Constructor to construct from a ACL::CAstroFile
@@ -109,7 +140,7 @@ namespace astroManager
   /// @version 2017-08-18/GGB - Function created.
 
   CAstroFile::CAstroFile(QWidget *parent, ACL::CAstroFile const &astroFile) : ACL::CAstroFile(astroFile), parent_(parent),
-    fileNameValid_(false), fileName_(), imageIDValid_(false), imageID_(0), imageVersion_(0)
+    fileNameValid_(false), fileName_(), imageIDValid_(false), imageID_(0), imageVersion_(0), loadMemoryMapped_(false)
   {
       // First change the object stored by the astroFile into a AstroManager::CObservatory type.
       // and the telescope into an astroManagerCTelescope() type.
@@ -120,6 +151,146 @@ namespace astroManager
     load();
   }
 
+  /// @brief Constructor to construct from a FITS file held in memory.
+  /// @param[in] parent: The parent (owner) of the astroFile.
+  /// @param[in] byteArray: The FITS file. Only used during construction.
+  /// @param[in] hduSelection: HS_PRIMARY if only the primary HDU is required.
+  /// @details The image is a synthetic image. It has no file name or database image and is not saved to the database when it
+  ///          is loaded. The database and the GUI are not accessed, so the instance can be constructed on a worker thread.
+  /// @throws std::bad_alloc
+  /// @throws ACL::CFITSException
+  /// @version 2026-10-17/GGB - Function created.
+
+  CAstroFile::CAstroFile(QWidget *parent, QByteArray &byteArray, EHDUSelection hduSelection)
+    : ACL::CAstroFile(), parent_(parent), fileNameValid_(false), fileName_(), imageIDValid_(false), imageID_(0), imageVersion_(0),
+      loadMemoryMapped_(false), hduSelection_(hduSelection)
+  {
+      // First change the object stored by the astroFile into a AstroManager::CObservatory type.
+      // and the telescope into an astroManagerCTelescope() type.
+
+    observationLocation.reset(new CObservatory());
+    observationTelescope.reset(new CTelescope());
+
+    syntheticImage_ = true;
+
+    preLoadActions();
+    loadFromByteArray(byteArray);
+  }
+
+  /// @brief Adds an astrometry object to the file and to the spatial index.
+  /// @param[in] astrometryObservation: The object to add.
+  /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::astrometryObjectAdd(std::shared_ptr<ACL::CAstrometryObservation> astrometryObservation)
+  {
+    ACL::CAstroFile::astrometryObjectAdd(astrometryObservation);
+
+    if (astrometryIndexValid_)
+    {
+      astrometryIndex_.insert(astrometryObservation.get());
+    };
+  }
+
+  /// @brief Finds an astrometry object that is close to a point.
+  /// @param[in] point: The point to test. (CCD coordinates)
+  /// @param[in] radius: The search radius. (pixels)
+  /// @returns The close object. nullptr if there is no close object.
+  /// @details The spatial index is rebuilt from the objects in the file if it is not valid. Only the objects in the grid cells
+  ///          covered by the radius are tested.
+  /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Function created.
+
+  ACL::CAstrometryObservation *CAstroFile::astrometryObjectClose(MCL::TPoint2D<FP_t> const &point, FP_t radius)
+  {
+    if (!astrometryIndexValid_)
+    {
+      astrometryIndex_.clear();
+
+      if (hasAstrometryHDB())
+      {
+        ACL::CAstrometryObservation *astrometryObservation = astrometryObjectFirst();
+
+        while (astrometryObservation)
+        {
+          astrometryIndex_.insert(astrometryObservation);
+          astrometryObservation = astrometryObjectNext();
+        };
+      };
+      astrometryIndexValid_ = true;
+    };
+
+    return astrometryIndex_.findClose(point, radius);
+  }
+
+  /// @brief Removes an astrometry object from the file and from the spatial index.
+  /// @param[in] objectName: The name of the object to remove.
+  /// @details Unless exactly one object in the index has the name, the index is rebuilt when it is next used, as the object
+  ///          removed from the file is not known.
+  /// @throws None.
+  /// @version 2026-10-17/GGB - Rebuild the index unless the name is found exactly once.
+  /// @version 2026-10-17/GGB - Rebuild the index if the name is not unique.
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::astrometryObjectRemove(std::string const &objectName)
+  {
+    if (astrometryIndex_.erase(objectName) != 1)
+    {
+      astrometryIndexValid_ = false;
+    };
+    ACL::CAstroFile::astrometryObjectRemove(objectName);
+  }
+
+  /// @brief Removes an astrometry object from the file and from the spatial index.
+  /// @param[in] astrometryObservation: The object to remove.
+  /// @details The object is removed from the index by pointer. The file removes the object by name, so if another object has
+  ///          the same name the index is rebuilt when it is next used.
+  /// @throws None.
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::astrometryObjectRemove(ACL::CAstrometryObservation *astrometryObservation)
+  {
+    std::string objectName = astrometryObservation->objectName();
+
+    if (astrometryIndexValid_)
+    {
+      astrometryIndex_.erase(astrometryObservation);
+
+      if (astrometryIndex_.count(objectName) != 0)
+      {
+        astrometryIndexValid_ = false;
+      };
+    };
+    ACL::CAstroFile::astrometryObjectRemove(objectName);
+  }
+
+  /// @brief Removes all the astrometry objects from the file and from the spatial index.
+  /// @throws None.
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::astrometryObjectRemoveAll()
+  {
+    ACL::CAstroFile::astrometryObjectRemoveAll();
+    astrometryIndex_.clear();
+    astrometryIndexValid_ = true;
+  }
+
+  /// @brief Renames an astrometry object. The object is re-keyed in the spatial index.
+  /// @param[in] astrometryObservation: The object to rename.
+  /// @param[in] objectName: The new name of the object.
+  /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::astrometryObjectRename(ACL::CAstrometryObservation *astrometryObservation, std::string const &objectName)
+  {
+    astrometryObservation->objectName(objectName);
+
+    if (astrometryIndexValid_)
+    {
+      astrometryIndex_.insert(astrometryObservation);
+    };
+  }
+
   /// @brief Removes unnecessary location keywords.
   /// @throws None.
   /// @version 2017-07-25/GGB - Function created.
@@ -196,6 +367,66 @@ namespace astroManager
     return std::make_unique<ACL::CAstroFile>(*this);
   }
 
+  /// @brief      Returns the size of the encoded image. This is the size of the file, or of the image downloaded from the
+  ///             database.
+  /// @returns    The encoded size (bytes). Zero if the size is not known.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  std::size_t CAstroFile::encodedSize() const
+  {
+    std::size_t returnValue = 0;
+
+    if (fileNameValid_)
+    {
+      boost::system::error_code errorCode;
+      std::uintmax_t fileSize = boost::filesystem::file_size(fileName_, errorCode);
+
+      if (!errorCode)
+      {
+        returnValue = static_cast<std::size_t>(fileSize);
+      };
+    }
+    else
+    {
+      returnValue = static_cast<std::size_t>(databaseImage_.size());
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Estimates the size of the file when written in FITS format.
+  /// @returns    The estimated size (bytes), rounded up to a whole number of FITS blocks for each HDU.
+  /// @details    The header of each HDB is estimated from the number of keywords plus the mandatory keywords. The data size of
+  ///             image HDB's is calculated from the image dimensions and BITPIX. Table HDB's are not sized, if they are present
+  ///             the memory file will grow to accommodate them.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  std::size_t CAstroFile::estimatedFITSSize()
+  {
+    std::size_t const CARD_LENGTH = 80;
+    std::size_t const MANDATORY_KEYWORDS = 12;        // SIMPLE/XTENSION, BITPIX, NAXIS(n), PCOUNT, GCOUNT, END etc.
+    std::size_t returnValue = 0;
+
+    auto roundToBlock = [] (std::size_t bytes) { return ((bytes + ACL::FITS_BLOCK - 1) / ACL::FITS_BLOCK) * ACL::FITS_BLOCK; };
+
+    for (ACL::DHDBStore::size_type hdb = 0; hdb < HDBCount(); ++hdb)
+    {
+      returnValue += roundToBlock((keywords(hdb).size() + MANDATORY_KEYWORDS) * CARD_LENGTH);
+
+      if (HDBType(hdb) == ACL::BT_IMAGE)
+      {
+        std::size_t bytesPerPixel = static_cast<std::size_t>(std::abs(getHDB(hdb)->BITPIX())) / 8;
+
+        returnValue += roundToBlock(static_cast<std::size_t>(imageWidth(hdb)) * static_cast<std::size_t>(imageHeight(hdb)) *
+                                    bytesPerPixel);
+      };
+    };
+
+    return returnValue;
+  }
+
   /// @brief Returns the file name and path.
   /// @returns The file name and path.
   /// @throws GCL::CCodeError(astroManager)
@@ -225,63 +456,382 @@ namespace astroManager
     imageIDValid_ = true;
   }
 
+  /// @brief      Determines if the file name refers to a FITS file.
+  /// @returns    true if the extension is one of the FITS extensions.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Use the static function.
+  /// @version    2026-10-17/GGB - Function created.
+
+  bool CAstroFile::isFITSFile() const
+  {
+    return isFITSFile(fileName_);
+  }
+
+  /// @brief      Determines if a file name refers to a FITS file.
+  /// @param[in]  fileName: The file name to test.
+  /// @returns    true if the extension is one of the FITS extensions.
+  /// @throws     None.
+  /// @version    2026-10-17/GGB - Function created.
+
+  bool CAstroFile::isFITSFile(boost::filesystem::path const &fileName)
+  {
+    std::string extension = boost::algorithm::to_lower_copy(fileName.extension().string());
+
+    return ( (extension == ".fts") || (extension == ".fit") || (extension == ".fits") );
+  }
+
+  /// @brief        Completes the load of a deferred load file.
+  /// @details      Performs the actions that must take place on the GUI thread (database access) after the data has been loaded
+  ///               by loadData().
+  /// @throws       None.
+  /// @version      2026-10-17/GGB - Function created.
+
+  void CAstroFile::completeLoad()
+  {
+    postLoadActions();
+  }
+
   /// @brief        Overloaded load() function to load the file contents.
   /// @details      Calls preLoadActions() and postLoadAction() to allow additional actions to take place automatically.
   /// @throws       GCL::CCodeError
+  /// @version      2026-10-17/GGB - Split into loadData() and completeLoad() to support loading on a worker thread.
+  /// @version      2026-10-17/GGB - Added memory mapped load of FITS files.
   /// @version      2017-07-26/GGB - Function created.
 
   void CAstroFile::load()
+  {
+    if (imageIDValid_ && !fileNameValid_)
+    {
+      preLoadActions();
+      loadFromDatabase();
+    }
+    else
+    {
+      loadData();
+    };
+    postLoadActions();
+  }
+
+  /// @brief        Loads (decodes) the image data.
+  /// @details      This function does not access the database or the GUI and can be called from a worker thread. The
+  ///               instance must not be accessed by any other thread until the function returns. The load is completed by
+  ///               calling completeLoad() from the GUI thread.
+  ///               FITS files are memory mapped (if enabled in the settings) rather than being read through the cfitsio file
+  ///               driver.
+  /// @throws       GCL::CCodeError
+  /// @throws       GCL::CError(astroManager, 0x000E)
+  /// @throws       ACL::CFITSException
+  /// @version      2026-10-17/GGB - Function created.
+
+  void CAstroFile::loadData()
   {
     preLoadActions();
     if (fileNameValid_)
     {
-      ACL::CAstroFile::loadFromFile(fileName_);
+      if (isFITSFile() && loadMemoryMapped_)
+      {
+        loadFromMappedFile();
+      }
+      else
+      {
+        ACL::CAstroFile::loadFromFile(fileName_);
+      };
     }
-    else if (imageIDValid_)
+    else if (imageIDValid_ && !databaseImage_.isEmpty())
     {
-      loadFromDatabase();
+      loadFromByteArray(databaseImage_);
+      databaseImage_.clear();
     }
     else
     {
       CODE_ERROR;
-    }
-    postLoadActions();
+    };
   }
 
   /// @brief Loads an image from the database.
   /// @throws GCL::CCodeError(astroManager)
+  /// @version 2026-10-17/GGB - Decoding moved to loadFromByteArray()
   /// @version 2017-08-12/GGB - Function created.
 
   void CAstroFile::loadFromDatabase()
   {
     QByteArray byteArray;
 
-
     if (database::databaseARID->downLoadImage(imageID_, imageVersion_, byteArray))
     {
-        // The following only works if the memory file is opened READONLY.
+      loadFromByteArray(byteArray);
+    }
+    else
+    {
+      CODE_ERROR;
+    };
+  }
 
-      fitsfile *file;
-      int status = 0;
-      void *ptr = byteArray.data();
-      std::size_t size = byteArray.size();
+  /// @brief Loads an image from a byte array containing a FITS file.
+  /// @param[in] byteArray: The byte array containing the FITS file.
+  /// @throws ACL::CFITSException
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::loadFromByteArray(QByteArray &byteArray)
+  {
+    loadFromMemory(byteArray.data(), static_cast<std::size_t>(byteArray.size()), "");
+  }
+
+  /// @brief      Loads the image from a FITS file held in memory.
+  /// @param[in]  memory: Pointer to the FITS file.
+  /// @param[in]  memorySize: Size of the FITS file (bytes).
+  /// @param[in]  name: The name to pass to cfitsio.
+  /// @details    If only the primary HDU is required, the end of the primary HDU is read from its header and the memory file is
+  ///             re-opened with the size limited to the end of the primary HDU. The extensions are then never read by cfitsio
+  ///             (and for a memory mapped file, never paged in). The headers of the extensions are not scanned.
+  /// @note       The memory file must be opened READONLY as the memory is not owned by cfitsio.
+  /// @throws     ACL::CFITSException
+  /// @version    2026-10-17/GGB - Only the primary header is read to find the end of the primary HDU. (No HDU catalogue)
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CAstroFile::loadFromMemory(void *memory, std::size_t memorySize, std::string const &name)
+  {
+    fitsfile *fitsFile = nullptr;
+    int status = 0;
+    void *ptr = memory;
+    std::size_t size = memorySize;
+
+    try
+    {
+      CFITSIO_TEST(fits_open_memfile, &fitsFile, name.c_str(), READONLY, &ptr, &size, ACL::FITS_BLOCK, nullptr);
+
+      extensionsSkipped_ = false;
+
+      if (hduSelection_ == HS_PRIMARY)
+      {
+        LONGLONG headerStart, dataStart, dataEnd;
+
+        CFITSIO_TEST(fits_get_hduaddrll, fitsFile, &headerStart, &dataStart, &dataEnd);
+
+        if (static_cast<std::size_t>(dataEnd) < memorySize)
+        {
+            // There is data after the primary HDU. Re-open with the size limited to the primary HDU.
 
-      CFITSIO_TEST(fits_open_memfile, &file, "", READONLY, &ptr, &size, ACL::FITS_BLOCK, nullptr);
-      loadFromFITS(file);
-      CFITSIO_TEST(fits_close_file, file);
+          extensionsSkipped_ = true;
+
+          CFITSIO_TEST(fits_close_file, fitsFile);
+          fitsFile = nullptr;
+
+          ptr = memory;
+          size = static_cast<std::size_t>(dataEnd);
+          CFITSIO_TEST(fits_open_memfile, &fitsFile, name.c_str(), READONLY, &ptr, &size, ACL::FITS_BLOCK, nullptr);
+        };
+      };
+
+      loadFromFITS(fitsFile);
+      CFITSIO_TEST(fits_close_file, fitsFile);
+    }
+    catch(...)
+    {
+      if (fitsFile)
+      {
+        status = 0;
+        fits_close_file(fitsFile, &status);
+      };
+      throw;
+    };
+  }
+
+  /// @brief      Loads a FITS file by mapping the file read-only into memory.
+  /// @details    The file is mapped using QFile::map() and the mapping is opened by cfitsio as a READONLY memory file. cfitsio
+  ///             then reads the headers and data directly from the mapped pages, rather than copying the file through its own
+  ///             I/O buffers. The pages are served from the operating system page cache, so several windows opening the same
+  ///             file share the cached pages. The mapping is released once the image planes have been populated.
+  ///             If the file cannot be mapped, the normal file driver is used. (All the HDU's are then loaded.)
+  /// @throws     GCL::CError(astroManager, 0x000E) - Error while opening file.
+  /// @throws     ACL::CFITSException
+  /// @version    2026-10-17/GGB - Use loadFromMemory() to allow only the primary HDU to be loaded.
+  /// @version    2026-10-17/GGB - Function created.
+
+  void CAstroFile::loadFromMappedFile()
+  {
+    QFile file(QString::fromStdString(fileName_.string()));
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+      ERROR(astroManager, 0x000E);
+    };
+
+    uchar *mapping = file.map(0, file.size());
+
+    if (mapping)
+    {
+      try
+      {
+        loadFromMemory(mapping, static_cast<std::size_t>(file.size()), fileName_.filename().string());
+      }
+      catch(...)
+      {
+        file.unmap(mapping);
+        throw;
+      };
+
+      file.unmap(mapping);
     }
     else
     {
-      CODE_ERROR;
+        // The file cannot be mapped (some network file systems). Use the cfitsio file driver.
+
+      DEBUGMESSAGE("Unable to map file " + fileName_.string() + ". Loading using file driver.");
+      file.close();
+      ACL::CAstroFile::loadFromFile(fileName_);
+    };
+  }
+
+  /// @brief Adds a photometry object to the file and to the spatial index.
+  /// @param[in] photometryObservation: The object to add.
+  /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::photometryObjectAdd(std::shared_ptr<ACL::CPhotometryObservation> photometryObservation)
+  {
+    ACL::CAstroFile::photometryObjectAdd(photometryObservation);
+
+    if (photometryIndexValid_)
+    {
+      photometryIndex_.insert(photometryObservation.get());
     };
   }
 
+  /// @brief Finds a photometry object that is close to a point.
+  /// @param[in] point: The point to test. (CCD coordinates)
+  /// @param[in] radius: The search radius. (pixels)
+  /// @returns The close object. nullptr if there is no close object.
+  /// @details The spatial index is rebuilt from the objects in the file if it is not valid.
+  /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Function created.
+
+  ACL::CPhotometryObservation *CAstroFile::photometryObjectClose(MCL::TPoint2D<FP_t> const &point, FP_t radius)
+  {
+    if (!photometryIndexValid_)
+    {
+      photometryIndex_.clear();
+
+      if (hasPhotometryHDB())
+      {
+        ACL::CPhotometryObservation *photometryObservation = photometryObjectFirst();
+
+        while (photometryObservation)
+        {
+          photometryIndex_.insert(photometryObservation);
+          photometryObservation = photometryObjectNext();
+        };
+      };
+      photometryIndexValid_ = true;
+    };
+
+    return photometryIndex_.findClose(point, radius);
+  }
+
+  /// @brief Removes a photometry object from the file and from the spatial index.
+  /// @param[in] objectName: The name of the object to remove.
+  /// @details Unless exactly one object in the index has the name, the index is rebuilt when it is next used, as the object
+  ///          removed from the file is not known.
+  /// @throws None.
+  /// @version 2026-10-17/GGB - Rebuild the index unless the name is found exactly once.
+  /// @version 2026-10-17/GGB - Rebuild the index if the name is not unique.
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::photometryObjectRemove(std::string const &objectName)
+  {
+    if (photometryIndex_.erase(objectName) != 1)
+    {
+      photometryIndexValid_ = false;
+    };
+    ACL::CAstroFile::photometryObjectRemove(objectName);
+  }
+
+  /// @brief Removes a photometry object from the file and from the spatial index.
+  /// @param[in] photometryObservation: The object to remove.
+  /// @details The object is removed from the index by pointer. The file removes the object by name, so if another object has
+  ///          the same name the index is rebuilt when it is next used.
+  /// @throws None.
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::photometryObjectRemove(ACL::CPhotometryObservation *photometryObservation)
+  {
+    std::string objectName = photometryObservation->objectName();
+
+    if (photometryIndexValid_)
+    {
+      photometryIndex_.erase(photometryObservation);
+
+      if (photometryIndex_.count(objectName) != 0)
+      {
+        photometryIndexValid_ = false;
+      };
+    };
+    ACL::CAstroFile::photometryObjectRemove(objectName);
+  }
+
+  /// @brief Removes all the photometry objects from the file and from the spatial index.
+  /// @throws None.
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::photometryObjectRemoveAll()
+  {
+    ACL::CAstroFile::photometryObjectRemoveAll();
+    photometryIndex_.clear();
+    photometryIndexValid_ = true;
+  }
+
+  /// @brief Renames a photometry object. The object is re-keyed in the spatial index.
+  /// @param[in] photometryObservation: The object to rename.
+  /// @param[in] objectName: The new name of the object.
+  /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Function created.
+
+  void CAstroFile::photometryObjectRename(ACL::CPhotometryObservation *photometryObservation, std::string const &objectName)
+  {
+    photometryObservation->objectName(objectName);
+
+    if (photometryIndexValid_)
+    {
+      photometryIndex_.insert(photometryObservation);
+    };
+  }
+
+  /// @brief Converts a list of image coordinates to WCS coordinates.
+  /// @param[in] hdb: The HDB containing the WCS information.
+  /// @param[in] points: The image coordinates to convert.
+  /// @returns The WCS coordinates. The value is not set if a point could not be converted.
+  /// @details The HDB is looked up once and each point is then converted by the ACL function on the calling thread. The ACL WCS
+  ///          functions are not known to be reentrant.
+  /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Renamed from pix2wcs(). The points are converted serially.
+  /// @version 2026-10-17/GGB - Function created.
+
+  std::vector<std::optional<ACL::CAstronomicalCoordinates>> CAstroFile::pix2wcsList(ACL::DHDBStore::size_type hdb,
+                                                                                    std::vector<MCL::TPoint2D<FP_t>> const &points)
+  {
+    std::vector<std::optional<ACL::CAstronomicalCoordinates>> returnValue;
+    auto imageHDB = getHDB(hdb);
+
+    returnValue.reserve(points.size());
+    for (auto const &point : points)
+    {
+      returnValue.push_back(imageHDB->pix2wcs(point));
+    };
+
+    return returnValue;
+  }
+
   /// @brief        Activities to perform after the file has been opened.
+  /// @details      The spatial indexes are rebuilt from the loaded objects when they are next used.
   /// @throws       None.
+  /// @version      2026-10-17/GGB - Invalidate the spatial indexes.
   /// @version      2017-08-12/GGB - Function created.
 
   void CAstroFile::postLoadActions()
   {
+    astrometryIndexValid_ = false;
+    photometryIndexValid_ = false;
+
       // If the original image needs to be saved, call the function to perform the saving.
 
     if (fileNameValid_ && settings::astroManagerSettings->value(settings::IMAGING_DATABASE_SAVEORIGINAL, QVariant(true)).toBool())
@@ -383,34 +933,43 @@ namespace astroManager
   }
 
   /// @brief Saves the image. The lastSaveAs_ variable is used to determine how to save the file.
+  /// @details Files that were loaded without their extensions (HS_PRIMARY) are not saved, as the extensions would be lost.
   /// @throws GCL::CCodeError(astroManager)
+  /// @version 2026-10-17/GGB - Do not save files that were loaded without their extensions.
   /// @version 2017-08-13/GGB - Function created.
 
   bool CAstroFile::save()
   {
     bool returnValue = false;
 
-    switch (lastSaveAs_)
+    if (extensionsSkipped_)
     {
-      case LS_NONE:
-      {
-        returnValue = saveAs();
-        break;
-      };
-      case LS_FILE:
-      {
-        returnValue = saveToFile();
-        break;
-      };
-      case LS_DATABASE:
-      {
-        returnValue = saveToDatabase();
-        break;
-      };
-      default:
+      WARNINGMESSAGE("File " + getImageName() + " was loaded without its extensions. The file cannot be saved.");
+    }
+    else
+    {
+      switch (lastSaveAs_)
       {
-        CODE_ERROR;
-        break;
+        case LS_NONE:
+        {
+          returnValue = saveAs();
+          break;
+        };
+        case LS_FILE:
+        {
+          returnValue = saveToFile();
+          break;
+        };
+        case LS_DATABASE:
+        {
+          returnValue = saveToDatabase();
+          break;
+        };
+        default:
+        {
+          CODE_ERROR;
+          break;
+        };
       };
     };
 
@@ -420,13 +979,18 @@ namespace astroManager
   /// @brief Performs the saveAs function.
   /// @details If the ARID database is enabled, then the
   /// @throws GCL::CCodeError(astroManager)
+  /// @version 2026-10-17/GGB - Do not save files that were loaded without their extensions.
   /// @version 2017-09-01/GGB - Function created.
 
   bool CAstroFile::saveAs()
   {
     bool returnValue = false;
 
-    if(!settings::astroManagerSettings->value(settings::ARID_DATABASE_DISABLE).toBool())
+    if (extensionsSkipped_)
+    {
+      WARNINGMESSAGE("File " + getImageName() + " was loaded without its extensions. The file cannot be saved.");
+    }
+    else if(!settings::astroManagerSettings->value(settings::ARID_DATABASE_DISABLE).toBool())
     {
         // Give the user the option to save to database or file.
 
@@ -546,8 +1110,10 @@ namespace astroManager
 
   /// @brief Saves the image to database. The image is automatically saved as the next version.
   /// @details Checks then need to be made to find the maximum allowable versions (zero is never considered a version) and deleting
-  ///          any extraneous versions.
+  ///          any extraneous versions. The memory file is pre-sized from the HDU sizes so that the file is normally written with a
+  ///          single allocation.
   /// @throws None.
+  /// @version 2026-10-17/GGB - Pre-size the memory file.
   /// @version 2017-08-13/GGB - Function created.
 
   bool CAstroFile::saveToDatabase()
@@ -608,7 +1174,13 @@ namespace astroManager
 
     try
     {
+      memoryArray.reserve(estimatedFITSSize());
       ACL::CAstroFile::save(memoryArray);
+
+      DEBUGMESSAGE("Save to database: " + std::to_string(memoryArray.allocations()) + " allocation(s), " +
+                   std::to_string(memoryArray.reallocations()) + " reallocation(s), " +
+                   std::to_string(memoryArray.bytesCopied()) + " bytes copied.");
+
       database::databaseARID->uploadImage(memoryArray.byteArray(), imageID_, ++imageVersion_, comments);
       returnValue = true;
     }
@@ -665,4 +1237,29 @@ namespace astroManager
     return returnValue;
   }
 
+  /// @brief Converts a list of WCS coordinates to image coordinates.
+  /// @param[in] hdb: The HDB containing the WCS information.
+  /// @param[in] coordinates: The WCS coordinates to convert.
+  /// @returns The image coordinates. The value is not set if the coordinate does not fall on the image.
+  /// @details The HDB is looked up once and each coordinate is then converted by the ACL function on the calling thread. The ACL
+  ///          WCS functions are not known to be reentrant.
+  /// @throws std::bad_alloc
+  /// @version 2026-10-17/GGB - Renamed from wcs2pix(). The coordinates are converted serially.
+  /// @version 2026-10-17/GGB - Function created.
+
+  std::vector<std::optional<MCL::TPoint2D<FP_t>>>
+  CAstroFile::wcs2pixList(ACL::DHDBStore::size_type hdb, std::vector<ACL::CAstronomicalCoordinates> const &coordinates)
+  {
+    std::vector<std::optional<MCL::TPoint2D<FP_t>>> returnValue;
+    auto imageHDB = getHDB(hdb);
+
+    returnValue.reserve(coordinates.size());
+    for (auto const &coordinate : coordinates)
+    {
+      returnValue.push_back(imageHDB->wcs2pix(coordinate));
+    };
+
+    return returnValue;
+  }
+
 } // namespace AstroManager
@@ -65,6 +65,7 @@ namespace astroManager
 
     /// @brief Constructor for the CAstrographicsView class.
     /// @param[in] parent: The owner of this instance.
+    /// @version 2026-10-17/GGB - Set the viewport update mode to suit the tiled image item.
     /// @version 2013-06-19/GGB - Added different definitions for windows and other.
     /// @version 2013-05-25/GGB - Added support for the navigator widget.
     /// @version 2011-06-03/GGB
@@ -96,6 +97,12 @@ namespace astroManager
       QGraphicsView::setCursor(Qt::CrossCursor);
       QGraphicsView::setMouseTracking(true);
 
+        // The image is drawn as tiles (CTiledImageItem). Only update the exposed areas so that only the tiles that become
+        // visible are drawn when panning.
+
+      QGraphicsView::setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+      QGraphicsView::setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing, true);
+
         // Intercept the scrollbar messages to ensure the viewport is updated in the navigator dock widget.
 
       connect(verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(updateNavigator(int)));
@@ -85,6 +85,7 @@
 #include "include/windowCalibration/ImageCalibration.h"
 #include "include/ImageComparison.h"
 #include "include/windowImage/windowImageDisplay.h"
+#include "include/windowImage/windowImageOpen.h"
 #include "include/windowImage/windowImageStacking.h"
 #include "include/settings.h"
 #include "include/TextEditorFITS.h"
@@ -2903,6 +2904,7 @@ namespace astroManager
     /// @brief      Open an image from file.
     /// @details    User must choose file to open from dialog box. Create an CImageWindow and set the filename up
     /// @throws     None.
+    /// @version    2026-10-17/GGB - Files are opened asynchronously. Each file displays its own progress window.
     /// @version    2018-12-14/GGB - Updated to allow opening multiple files. (Bug #33)
     /// @version    2013-03-02/GGB - Included the global settings::fileExtensions for the files extensions.
     /// @version    2013-01-21/GGB - Moved code into loadImage()
@@ -2927,24 +2929,12 @@ namespace astroManager
         settings::astroManagerSettings->setValue(settings::IMAGING_DIRECTORY,
                                                  QVariant(QString::fromStdString(filePath.parent_path().string())));
 
-        QProgressDialog progressDialog(tr("Opening Files..."), tr("Abort"), 0, fileList.size(), this);
-        progressDialog.setWindowModality(Qt::WindowModal);
-        progressDialog.setMinimumDuration(1000);
-        progressDialog.setWindowTitle("Open Files for Editing");
-
-        int fileCount = 0;
+          // The files are loaded concurrently on the thread pool. Each file can be cancelled from its own progress window.
 
         for (auto iter = fileList.begin(); iter != fileList.end(); ++iter)
         {
           filePath = (*iter).toStdString();
           loadFromFile(filePath);
-
-          progressDialog.setValue(++fileCount);
-
-          if (progressDialog.wasCanceled())
-          {
-            break;
-          };
         };
       };
     }
@@ -3174,6 +3164,115 @@ namespace astroManager
       imageWindow = nullptr;
     }
 
+    /// @brief      Starts the asynchronous load of an image.
+    /// @param[in]  astroFile: The astroFile to load. This must have been created with CAstroFile::LM_DEFERRED.
+    /// @details    A placeholder window is displayed while the image data is decoded on the thread pool. When the load is
+    ///             complete, imageOpenComplete() or imageOpenError() is called on the GUI thread.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CFrameWindow::imageOpenAsync(std::shared_ptr<CAstroFile> astroFile)
+    {
+      imaging::CImageOpenWindow *imageOpenWindow = new imaging::CImageOpenWindow(astroFile, this);
+
+      mdiArea->addSubWindow(imageOpenWindow);
+      imageOpenWindow->show();
+
+      imageOpenWindow->startLoad();
+    }
+
+    /// @brief      Completes opening an image after the image data has been loaded.
+    /// @param[in]  astroFile: The astroFile that has been loaded.
+    /// @details    Completes the load on the GUI thread, creates the image window and updates the recent file list.
+    /// @throws     GCL::CCodeError
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CFrameWindow::imageOpenComplete(std::shared_ptr<CAstroFile> astroFile)
+    {
+      try
+      {
+        astroFile->completeLoad();
+
+        imageCreateWindow(astroFile);
+
+        if (astroFile->fileNameValid())
+        {
+          GCL::logger::defaultLogger().logMessage(GCL::logger::info, "File: " + astroFile->getFileName().string() +
+                                                  " has been opened");
+
+          recentFileAdd(astroFile->getFileName());
+        };
+      }
+      catch(...)
+      {
+        imageOpenError(std::current_exception());
+      };
+    }
+
+    /// @brief      Reports an error that occurred while opening an image.
+    /// @param[in]  exception: The exception that was thrown while opening the image.
+    /// @throws     GCL::CCodeError
+    /// @throws     GCL::CRuntimeAssert
+    /// @note       Code errors and runtime assertions are propogated. All other exceptions are reported to the user.
+    /// @version    2026-10-17/GGB - Code taken from loadFromFile()
+
+    void CFrameWindow::imageOpenError(std::exception_ptr exception)
+    {
+      QMessageBox msgBox;
+
+      try
+      {
+        std::rethrow_exception(exception);
+      }
+      catch (GCL::CError &err)
+      {
+        if (err.errorCode() == 0x000D)
+        {
+          msgBox.setText(QString::fromStdString(boost::locale::translate("File Format Error.")));
+          msgBox.setInformativeText(QString::fromStdString(boost::locale::translate("The file format chosen is unknown.")));
+          msgBox.setIcon(QMessageBox::Critical);
+          msgBox.setStandardButtons(QMessageBox::Ok);
+          msgBox.setDefaultButton(QMessageBox::Ok);
+          msgBox.exec();
+        }
+        else
+        {
+          WARNINGMESSAGE("Error opening file");
+          WARNINGMESSAGE(std::to_string(err.errorCode()) + " - " + err.errorMessage());
+
+          msgBox.setText(QString::fromStdString(boost::locale::translate("Error Opening file.")));
+          msgBox.setInformativeText(QString::fromStdString(boost::locale::translate("There was an error opening the file.")));
+          msgBox.setIcon(QMessageBox::Critical);
+          msgBox.setStandardButtons(QMessageBox::Ok);
+          msgBox.setDefaultButton(QMessageBox::Ok);
+          msgBox.exec();
+        }
+      }
+      catch (GCL::CCodeError &)
+      {
+        throw;    // Propagate code errors.
+      }
+      catch (GCL::CRuntimeAssert &)
+      {
+        throw;    // Propagate runtime assertions.
+      }
+      catch (ACL::CFITSException &exception)
+      {
+        msgBox.setText(tr("cfitsio Error while opening file."));
+        msgBox.setInformativeText(QString::fromStdString(exception.errorMessage()));
+        msgBox.setIcon(QMessageBox::Warning);
+        msgBox.setStandardButtons(QMessageBox::Ok);
+        msgBox.setDefaultButton(QMessageBox::Ok);
+        msgBox.exec();
+
+        exception.logErrorMessage();
+      }
+      catch(...)
+      {
+        WARNINGMESSAGE("Unknown exception while opening file.");
+      };
+    }
+
     /// @brief      Opens an image from the ARID database.
     /// @param[in]  imageID: The ID value of the image to open.
     /// @throws
@@ -3237,87 +3336,15 @@ namespace astroManager
 
       if (versionValid)
       {
-        QMessageBox msgBox;
-        QStringList recentFileList;
-
-        std::list<boost::filesystem::path>::iterator iterator;
-
         try
         {
-          std::shared_ptr<CAstroFile> astroFile(std::make_shared<CAstroFile>(this, imageID, imageVersion));   // Create from database.
-
-          //GCL::logger::defaultLogger().logMessage(GCL::logger::info, "File: " + filePath.string() + " has been opened");
-
-          imageCreateWindow(astroFile);
-
-          // Update the last opened file list.
-
-//          lastOpened.remove(filePath);
-//          lastOpened.push_front(filePath);
-//          while (lastOpened.size() > settings::VSOPSettings->value(settings::FILE_LASTOPENEDDEPTH, QVariant(5)).toUInt() )
-//          {
-//            lastOpened.pop_back();
-//          }
-
-//          for (iterator = lastOpened.begin(); iterator != lastOpened.end(); iterator++)
-//          {
-//            recentFileList.push_back(QString::fromStdString((*iterator).string()));
-//          };
-
-//          settings::VSOPSettings->setValue(settings::FILE_LASTOPENED, recentFileList);
+            // The image is downloaded by the constructor. It is decoded on the thread pool.
 
-//          // Populate the last opened file list into the menu.
-
-//          populateRecentFileMenu();
-
-        }
-        catch (GCL::CError &err)
-        {
-          if (err.errorCode() == 0x000D)
-          {
-            msgBox.setText(tr("File Format Error."));
-            msgBox.setInformativeText(tr("The file format chosen is unknown."));
-            msgBox.setIcon(QMessageBox::Critical);
-            msgBox.setStandardButtons(QMessageBox::Ok);
-            msgBox.setDefaultButton(QMessageBox::Ok);
-            msgBox.exec();
-          }
-          else
-          {
-            WARNINGMESSAGE("Error opening file");
-            WARNINGMESSAGE(std::to_string(err.errorCode()) + " - " + err.errorMessage());
-
-            msgBox.setText(tr("Error Opening file."));
-            msgBox.setInformativeText(tr("There was an error opening the file."));
-            msgBox.setIcon(QMessageBox::Critical);
-            msgBox.setStandardButtons(QMessageBox::Ok);
-            msgBox.setDefaultButton(QMessageBox::Ok);
-            msgBox.exec();
-          }
-        }
-        catch (GCL::CCodeError &)
-        {
-          throw;    // Propogate code errors.
-        }
-        catch (GCL::CRuntimeAssert &)
-        {
-          throw;    // Propogate runtime assertions.
-        }
-        catch (ACL::CFITSException &exception)
-        {
-          msgBox.setText(tr("cfitsio Error while opening file."));
-          msgBox.setInformativeText(QString::fromStdString(exception.errorMessage()));
-          msgBox.setIcon(QMessageBox::Warning);
-          msgBox.setStandardButtons(QMessageBox::Ok);
-          msgBox.setDefaultButton(QMessageBox::Ok);
-          msgBox.exec();
-
-          exception.logErrorMessage();
+          imageOpenAsync(std::make_shared<CAstroFile>(this, imageID, imageVersion, CAstroFile::LM_DEFERRED));
         }
-
         catch(...)
         {
-          WARNINGMESSAGE("Unknown exception while opening file.");
+          imageOpenError(std::current_exception());
         };
       }
     }
@@ -3326,91 +3353,20 @@ namespace astroManager
     /// @param[in]  filePath: The path and filename of the file to load.
     /// @throws     std::bad_alloc
     /// @note       Exceptions related to file open errors are caught and closed.
+    /// @version    2026-10-17/GGB - The file is loaded asynchronously. Error handling moved to imageOpenError()
     /// @version    2016-04-17/GGB - Added catch() to catch CFITSException errors
     /// @version    2013-06-23/GGB - Added code to propogate code errors.
     /// @version    2013-01-21/GGB - Code taken from eventImageOpen()
 
     void CFrameWindow::loadFromFile(boost::filesystem::path &filePath)
     {
-      QMessageBox msgBox;
-      QStringList recentFileList;
-      std::list<boost::filesystem::path>::iterator iterator;
-
       try
       {
-        std::shared_ptr<CAstroFile> astroFile(std::make_shared<CAstroFile>(this, filePath));   // Create and load all the data from the file.
-
-        GCL::logger::defaultLogger().logMessage(GCL::logger::info, "File: " + filePath.string() + " has been opened");
-
-        imageCreateWindow(astroFile);
-
-          // Update the last opened file list.
-
-        lastOpened.remove(filePath);
-        lastOpened.push_front(filePath);
-        while (lastOpened.size() > settings::astroManagerSettings->value(settings::FILE_LASTOPENEDDEPTH, QVariant(5)).toUInt() )
-        {
-          lastOpened.pop_back();
-        }
-
-        for (iterator = lastOpened.begin(); iterator != lastOpened.end(); iterator++)
-        {
-          recentFileList.push_back(QString::fromStdString((*iterator).string()));
-        };
-
-        settings::astroManagerSettings->setValue(settings::FILE_LASTOPENED, recentFileList);
-
-          // Populate the last opened file list into the menu.
-
-        populateRecentFileMenu();
-      }
-      catch (GCL::CError &err)
-      {
-        if (err.errorCode() == 0x000D)
-        {
-          msgBox.setText(QString::fromStdString(boost::locale::translate("File Format Error.")));
-          msgBox.setInformativeText(QString::fromStdString(boost::locale::translate("The file format chosen is unknown.")));
-          msgBox.setIcon(QMessageBox::Critical);
-          msgBox.setStandardButtons(QMessageBox::Ok);
-          msgBox.setDefaultButton(QMessageBox::Ok);
-          msgBox.exec();
-        }
-        else
-        {
-          WARNINGMESSAGE("Error opening file");
-          WARNINGMESSAGE(std::to_string(err.errorCode()) + " - " + err.errorMessage());
-
-          msgBox.setText(QString::fromStdString(boost::locale::translate("Error Opening file.")));
-          msgBox.setInformativeText(QString::fromStdString(boost::locale::translate("There was an error opening the file.")));
-          msgBox.setIcon(QMessageBox::Critical);
-          msgBox.setStandardButtons(QMessageBox::Ok);
-          msgBox.setDefaultButton(QMessageBox::Ok);
-          msgBox.exec();
-        }
-      }
-      catch (GCL::CCodeError &)
-      {
-        throw;    // Propogate code errors.
-      }
-      catch (GCL::CRuntimeAssert &)
-      {
-        throw;    // Propogate runtime assertions.
-      }
-      catch (ACL::CFITSException &exception)
-      {
-        msgBox.setText(tr("cfitsio Error while opening file."));
-        msgBox.setInformativeText(QString::fromStdString(exception.errorMessage()));
-        msgBox.setIcon(QMessageBox::Warning);
-        msgBox.setStandardButtons(QMessageBox::Ok);
-        msgBox.setDefaultButton(QMessageBox::Ok);
-        msgBox.exec();
-
-        exception.logErrorMessage();
+        imageOpenAsync(std::make_shared<CAstroFile>(this, filePath, CAstroFile::LM_DEFERRED));
       }
-
       catch(...)
       {
-        WARNINGMESSAGE("Unknown exception while opening file.");
+        imageOpenError(std::current_exception());
       };
     }
 
@@ -3433,6 +3389,34 @@ namespace astroManager
       };
     }
 
+    /// @brief      Adds a file to the top of the recent file list.
+    /// @param[in]  filePath: The path and filename of the file.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Code taken from loadFromFile()
+
+    void CFrameWindow::recentFileAdd(boost::filesystem::path const &filePath)
+    {
+      QStringList recentFileList;
+
+      lastOpened.remove(filePath);
+      lastOpened.push_front(filePath);
+      while (lastOpened.size() > settings::astroManagerSettings->value(settings::FILE_LASTOPENEDDEPTH, QVariant(5)).toUInt() )
+      {
+        lastOpened.pop_back();
+      }
+
+      for (auto iterator = lastOpened.begin(); iterator != lastOpened.end(); iterator++)
+      {
+        recentFileList.push_back(QString::fromStdString((*iterator).string()));
+      };
+
+      settings::astroManagerSettings->setValue(settings::FILE_LASTOPENED, recentFileList);
+
+        // Populate the last opened file list into the menu.
+
+      populateRecentFileMenu();
+    }
+
     /// @brief Populates the recent File Menu with the relevant information.
     /// @throws None.
     /// @version 2013-01-22/GGB - Function created.
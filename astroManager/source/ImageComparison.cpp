@@ -101,6 +101,7 @@ namespace astroManager
     /// @param[in] aParent - The parent (owner) of this window. Will normally be the frame window.
     /// @throws None
     /// @details Sets up all the data members and then calls setupUI() to create the user interface.
+    /// @version 2026-10-17/GGB - Added the frame loader.
     /// @version 2013-06-19/GGB - Added different definitions for windows and other.
     /// @version 2013-06-07/GGB - Added the blinkTimer.
     /// @version 2011-06-11/GGB - Function created.
@@ -117,12 +118,15 @@ namespace astroManager
     {
       setAttribute(Qt::WA_DeleteOnClose);
 
+      frameLoader = new CFrameLoader(this);
+
       setupUI();
       setWindowTitle(tr("Image Comparison"));
     }
 
     /// @brief Must ensure that all the controlImage objects are properly deleted.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Cancel any images that are still being loaded.
     /// @version 2016-04-21/GGB - Update to reflect the use of a single data role and SCcontrolBlock
     /// @version 2016-04-21/GGB - Convert C-style casts to reinterpret_cast<>()
     /// @version 2013-06-10/GGB - Ensure that all the roles are correctly deleted on exit.
@@ -136,6 +140,8 @@ namespace astroManager
       int index;
       qulonglong ci;
 
+      frameLoader->cancelAll();
+
       for(index = 0; index < itemCount; index++)
       {
         lwi = listWidgetImages->item(0);
@@ -223,6 +229,7 @@ namespace astroManager
 
     /// @brief Ensures that all the dynamically allocated memory is freed.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Cancel any images that are still being loaded.
     /// @version 2016-04-22/GGB - Update to reflect the use of a single data role and SCcontrolBlock
     /// @version 2016-04-17/GGB
     ///   @li Changed C-style cast to reinterpret_cast<>()
@@ -234,6 +241,8 @@ namespace astroManager
       int itemCount = listWidgetImages->count();
       SControlBlock *controlBlock;
 
+      frameLoader->cancelAll();
+
       for (int index = 0; (index < itemCount) ; index++)
       {
         controlBlock =
@@ -357,8 +366,9 @@ namespace astroManager
 
     /// @brief Allows the user to select a single image or selection of images
     /// @details Opens the file selection dialog and allows the selection of multiple images. Image names are added to the list of images.
-    /// The image list is not cleared.
+    /// The image list is not cleared. The images are loaded in the background so they are ready when the user selects them.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Queue the images in the frame loader.
     /// @version 2016-04-21/GGB - Update to reflect the use of a single data role and SCcontrolBlock
     /// @version 2016-04-17/GGB - Added code to enable the buttons as required.
     /// @version 2011-06-12/GGB - Function created.
@@ -415,6 +425,8 @@ namespace astroManager
           lwi->setForeground(Qt::gray);
           listWidgetImages->addItem(lwi);
           lwi = nullptr;
+
+          frameLoader->addFile(reinterpret_cast<quint64>(newControlBlock), filePath);
         };
 
         if (listWidgetImages->count() > 0)
@@ -742,6 +754,7 @@ namespace astroManager
 
     /// @brief Removes images from the image list.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Cancel the images if they are still being loaded.
     /// @version 2017-07-03/GGB - Updated to reflect new dockwidgets storage method.
     /// @version 2016-04-22/GGB - Update to reflect the use of a single data role and SCcontrolBlock
     /// @version 2016-04-17/GGB - Bug#1571327 corrected.
@@ -787,6 +800,7 @@ namespace astroManager
 
           controlBlock = reinterpret_cast<SControlBlock *>(lwi->data(ROLE_CONTROLBLOCK).toULongLong());
           imageList.removeOne(controlBlock->inputFilename);
+          frameLoader->cancel(reinterpret_cast<quint64>(controlBlock));
 
           delete controlBlock;
           controlBlock = nullptr;
@@ -805,6 +819,59 @@ namespace astroManager
       };
     }
 
+    /// @brief Called when the frame loader could not load an image.
+    /// @param[in] key: The control block of the image.
+    /// @param[in] message: The error message.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CImageComparisonWindow::eventFrameFailed(quint64 key, QString message)
+    {
+      for (int index = 0; index < listWidgetImages->count(); ++index)
+      {
+        QListWidgetItem *lwi = listWidgetImages->item(index);
+
+        if (lwi->data(ROLE_CONTROLBLOCK).toULongLong() == key)
+        {
+          lwi->setForeground(Qt::red);
+          lwi->setToolTip(message);
+          break;
+        };
+      };
+    }
+
+    /// @brief Called when the frame loader has loaded an image. The image is stored in the control block of the image.
+    /// @param[in] key: The control block of the image.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CImageComparisonWindow::eventFrameLoaded(quint64 key)
+    {
+      SControlBlock *controlBlock = reinterpret_cast<SControlBlock *>(key);
+      std::shared_ptr<CAstroFile> astroFile = frameLoader->takeFrame(key);
+
+      if (astroFile && !controlBlock->inputImageValid)
+      {
+        controlBlock->inputImage.astroFile = astroFile;
+        controlBlock->inputImage.currentHDB = 0;
+        controlBlock->inputImageValid = true;
+
+          // Change the colour of the item to signify that the image is already loaded.
+
+        for (int index = 0; index < listWidgetImages->count(); ++index)
+        {
+          QListWidgetItem *lwi = listWidgetImages->item(index);
+
+          if (lwi->data(ROLE_CONTROLBLOCK).toULongLong() == key)
+          {
+            lwi->setForeground(Qt::black);
+            lwi->setToolTip(QString());
+            break;
+          };
+        };
+      };
+    }
+
     /// @brief Changes the interval of the timer.
     /// @param[in] newInterval - The new blink interval in ms
     /// @throws None.
@@ -1675,6 +1742,8 @@ namespace astroManager
       connect(blinkTimer, SIGNAL(timeout()), this, SLOT(eventBlink()));
       connect(spinBoxInterval, SIGNAL(valueChanged(double)), this, SLOT(eventIntervalChange(double)));
       connect(tabWidget, SIGNAL(currentChanged(int)), this, SLOT(eventTabCurrentChanged(int)));
+      connect(frameLoader, SIGNAL(frameLoaded(quint64)), this, SLOT(eventFrameLoaded(quint64)));
+      connect(frameLoader, SIGNAL(frameFailed(quint64, QString)), this, SLOT(eventFrameFailed(quint64, QString)));
 
       tabWidget->setCurrentIndex(0);    // Switch to the input tab.
 
@@ -1687,6 +1756,7 @@ namespace astroManager
     /// @throws None.
     /// @details The selected item contains the path of the item in the Qt::UserRole data. This allows quick selection of the
     /// filename and path of the item.
+    /// @version 2026-10-17/GGB - Load the image if the frame loader has not already loaded it.
     /// @version 2016-04-23/GGB - Update to reflect the use of a single data role and SCcontrolBlock
     /// @version 2016-03-28/GGB - Changed C-style casts to reinterpret_cast<>()
     /// @version 2011-03-03/GGB - Function created.
@@ -1705,10 +1775,16 @@ namespace astroManager
       {
         if ( !controlBlock->inputImageValid )
         {
-            // The image has not been loaded, it needs to be loaded.
+            // The image has not been loaded, it needs to be loaded. The user is waiting for this image, so it is not worth
+            // waiting for the frame loader.
             // Create the astroFile from the filename.
 
-//          controlBlock->inputImage.astroFile.reset(new ACL::CAstroFile(controlBlock->inputFilename.toStdString()));
+          frameLoader->cancel(reinterpret_cast<quint64>(controlBlock));
+          boost::filesystem::path fileName(controlBlock->inputFilename.toStdString());
+
+          controlBlock->inputImage.astroFile = std::make_shared<CAstroFile>(this, fileName, CAstroFile::LM_IMMEDIATE,
+                                                                            CAstroFile::HS_PRIMARY);
+          controlBlock->inputImage.currentHDB = 0;
           controlBlock->inputImageValid = true;
 
             // Change the colour of the item to signify that the image is already loaded.
@@ -468,10 +468,13 @@ namespace astroManager
   ///          of threads to use for each of the libraries.
   /// @param[in] numThreads: The number of threads to use
   /// @throws None.
+  /// @version 2026-10-17/GGB - Also sets the maximum number of threads for the global thread pool.
   /// @version 2017-06-25/GGB - Function created.
 
   void setThreads(size_t numThreads)
   {
+    QThreadPool::globalInstance()->setMaxThreadCount(static_cast<int>(numThreads));
+
     ACL::maxThreads = numThreads;
     //GCL::maxThreads = numThreads;
     MCL::maxThreads = numThreads;
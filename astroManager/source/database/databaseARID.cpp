@@ -56,6 +56,7 @@
 
   // astroManager application header files
 
+#include "include/ACL/FITSMemoryFileArray.h"
 #include "include/database/databaseATID.h"
 #include "include/dialogs/dialogConfigureSite.h"
 #include "include/dialogs/dialogConfigureTelescope.h"
@@ -1995,7 +1996,10 @@ namespace astroManager
     /// @param[in]  fileName: The filename of the image to save.
     /// @param[in]  imageID: The ID to associate with the imaged.
     /// @param[in]  imageVersion: The version number to associate with the image.
+    /// @details    The file is read into a buffer taken from the memory buffer pool. The buffer is returned to the pool once the
+    ///             image has been written to the database.
     /// @throws     None.
+    /// @version    2026-10-17/GGB - Use a pooled buffer to read the file.
     /// @version    2017-07-28/GGB - Function created.
 
     void CARID::uploadImage(QString const &fileName, imageID_t imageID, imageVersion_t imageVersion, QString const &comment)
@@ -2013,7 +2017,9 @@ namespace astroManager
       QFile file(fileName);
       if (file.open(QIODevice::ReadOnly))
       {
-        imageArray = file.readAll();
+        imageArray = CMemoryBufferPool::instance().acquire(static_cast<std::size_t>(file.size()));
+        imageArray.resize(static_cast<int>(file.size()));
+        imageArray.resize(static_cast<int>(file.read(imageArray.data(), file.size())));
         file.close();
       }
       else
@@ -2042,6 +2048,11 @@ namespace astroManager
         INFOMESSAGE("Image not saved.");
         processErrorInformation(*sqlQuery);
       };
+
+        // Release the bound image data so that the buffer is no longer shared and can be returned to the pool.
+
+      sqlQuery->clear();
+      CMemoryBufferPool::instance().release(std::move(imageArray));
     }
 
     /// @brief      Uploads an image to database.
@@ -2083,6 +2094,7 @@ namespace astroManager
         INFOMESSAGE(boost::locale::translate("Image not saved."));
       };
       sqlQuery->finish();
+      sqlQuery->clear();      // Release the bound image data. This allows the caller to return the buffer to the pool.
     }
 
     /// @brief      Counts the number of versions associated with the image.
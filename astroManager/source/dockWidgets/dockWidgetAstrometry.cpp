@@ -33,7 +33,8 @@
 //                        - CInstrumentDockwidget
 //                        - CMessageWidget
 //
-// HISTORY:             2015-09-22 GGB - astroManager 2015.09 release
+// HISTORY:             2026-10-17 GGB - Reference list changed to a QTableView over CAstrometryObservationModel.
+//                      2015-09-22 GGB - astroManager 2015.09 release
 //                      2013-09-30 GGB - astroManager 2013.09 release.
 //                      2013-03-22 GGB - astroManager 2013.03 release.
 //                      2013-02-01 GGB - Removed CAstrometryDockWidget into this file
@@ -66,8 +67,6 @@ namespace astroManager
     //
     //*****************************************************************************************************************************
 
-#define ROLE_OBJECTINDEX  Qt::UserRole + 0
-
     /// @brief Class constructor.
     /// @param[in] action: Pointer to the action
     /// @param[in] parent: Pointer to the parent object.
@@ -86,24 +85,60 @@ namespace astroManager
     }
 
     /// @brief Adds a new object into the object list.
-    /// @param[in] newObject: The new object being created.
+    /// @param[in] newObject: The new object being created. (Must already be at the back of the observation store.)
     /// @throws None.
+    /// @version 2026-10-17/GGB - Uses the observation model.
     /// @version 2015-01-04/GGB - Function created.
 
-    void CAstrometryDockWidget::addNewObject(astrometry::CAstrometryObservation *newObject)
+    void CAstrometryDockWidget::addNewObject(astrometry::CAstrometryObservation *)
     {
-        // Add the object to the table view.
+      addObjects(1);
+      tableViewAstrometry->selectRow(astrometryModel_->rowCount() - 1);
+    }
+
+    /// @brief Adds a number of new objects into the object list. The table is updated once for all the objects.
+    /// @param[in] count: The number of objects that have been added to the back of the observation store.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
 
-      insertRow(tableWidgetAstrometry->rowCount(), newObject);
+    void CAstrometryDockWidget::addObjects(std::size_t count)
+    {
+      astrometryModel_->addObjects(count);
     }
 
     /// @brief Displays astrometry information when an astrometry object is selected.
     /// @param[in] ao: The astrometry observation to display the data for.
-    /// @throws
-    /// @version
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function implemented using the code from referenceCompleted().
 
     void CAstrometryDockWidget::displayAstrometry(astrometry::CAstrometryObservation *ao)
     {
+      if (ao)
+      {
+        labelObjectName->setText(QString::fromStdString(ao->objectName()));
+        if (ao->observedCoordinates())
+        {
+          labelObjectRA->setText(QString::fromStdString(ao->observedCoordinates()->RA().A2SHMS()));
+          labelObjectDec->setText(QString::fromStdString(ao->observedCoordinates()->DEC().A2SDMS()));
+        }
+        else
+        {
+          labelObjectRA->setText("--" % UTF16_DEGREESIGN % "--'--""");
+          labelObjectDec->setText(UTF16_PLUSMINUSSIGN % "--" % UTF16_DEGREESIGN % "--'--""");
+        };
+        labelObjectType->setText(QString("------"));
+
+        try
+        {
+          if (currentImage->astroFile->astrometryCheckRequisites())
+          {
+            pushButtonPlateConstants->setEnabled(true);
+          };
+        }
+        catch(...)
+        {
+        };
+      };
     }
 
     /// @brief Procedure called when an image is activating.
@@ -137,6 +172,8 @@ namespace astroManager
 
     /// @brief Allows the user to select an object to associate with the currently selected reference or target.
     /// @throws C
+    // 2026-10-17/GGB - The object is renamed through the astroFile so the spatial index is kept up to date.
+    // 2026-10-17/GGB - Uses the observation model.
     // 2013-08-11/GGB - 1) Added code to initialise the name of the object. (Bug #1210914)
     //                  2) Added code to update dirty status of astroFile. (Bug #1210749)
     // 2013-03-17/GGB - Function flow cleaned up with introduction of CDockWidget.
@@ -150,7 +187,7 @@ namespace astroManager
       {
           // Get the current name of the object.
 
-        nRow = tableWidgetAstrometry->currentRow();
+        nRow = tableViewAstrometry->currentIndex().row();
         QString szName = QString::fromStdString(currentImage->astrometryObservations[nRow]->objectName());
 
         dialogs::CSelectObjectDialog *dlg = new dialogs::CSelectObjectDialog(szName, this);
@@ -160,11 +197,11 @@ namespace astroManager
             // Update the string in the table, as well as the displayed string on the image
             // as well as the strings for the object information.
 
-          nRow = tableWidgetAstrometry->currentRow();
+          nRow = tableViewAstrometry->currentIndex().row();
 
-          currentImage->astrometryObservations[nRow]->objectName(szName.toStdString());
+          currentImage->astroFile->astrometryObjectRename(currentImage->astrometryObservations[nRow].get(), szName.toStdString());
 
-          tableWidgetAstrometry->item(nRow, 0)->setText(szName);
+          astrometryModel_->objectChanged(nRow);
 
           labelObjectName->setText(szName);
 
@@ -210,6 +247,8 @@ namespace astroManager
 
     /// Allows the user to delete a reference object from the list of objects.
     //
+    // 2026-10-17/GGB - The object is removed from the astroFile by pointer.
+    // 2026-10-17/GGB - Uses the observation model.
     // 2015-01-01/GGB - Added code to delete the text and group and also to reset the current selection. (Bug #1406897)
     // 2013-08-11/GGB - Added code to delete the reference from the astroFile. (Bug #1210750)
     // 2011-06-29/GGB - Function created.
@@ -219,7 +258,7 @@ namespace astroManager
       int nRow;
       QGraphicsScene *scene;
 
-      nRow = tableWidgetAstrometry->currentRow();
+      nRow = tableViewAstrometry->currentIndex().row();
 
       if (nRow != -1 && currentImage)
       {
@@ -235,10 +274,8 @@ namespace astroManager
 
         currentImage->currentAstrometrySelection = nullptr;   // Remove the selection link.
 
-        currentImage->astroFile->astrometryObjectRemove(currentImage->astrometryObservations[nRow]->objectName());
-        currentImage->astrometryObservations.erase(currentImage->astrometryObservations.begin() + nRow);
-
-        tableWidgetAstrometry->removeRow(nRow);
+        currentImage->astroFile->astrometryObjectRemove(currentImage->astrometryObservations[nRow].get());
+        astrometryModel_->removeObject(nRow);
 
         pushButtonObjectInformation->setEnabled(false);
         pushButtonReferenceEdit->setEnabled(false);
@@ -334,15 +371,18 @@ namespace astroManager
     }
 
     /// @brief A row in the table has been selected. Display the appropriate data and unhide the buttons.
-    /// @param[in] nRow: The row that has been selected.
+    /// @param[in] index: The cell that has been selected.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Changed to take the model index from the table view.
     /// @version 2017-09-23/GGB - Updated to use CAngle.
     /// @version 2013-08-17/GGB - Corrected RA/Dec display (Bug #1213076)
     /// @version 2013-03-17/GGB - Function flow cleaned up with introduction of CDockWidget.
     /// @version 2011-06-27/GGB - Function created.
 
-    void CAstrometryDockWidget::eventTableRowReferenceSelected(int nRow, int)
+    void CAstrometryDockWidget::eventTableRowReferenceSelected(QModelIndex const &index)
     {
+      int nRow = index.row();
+
       pushButtonObjectInformation->setEnabled(true);
       pushButtonReferenceEdit->setEnabled(true);
       pushButtonReferenceDelete->setEnabled(true);
@@ -391,24 +431,6 @@ namespace astroManager
       currentImage->parent_->changeAstrometrySelection(ao);
     }
 
-    /// @brief Inserts a row into the table.
-    /// @param[in] nRow: Row number to insert.
-    /// @param[in] toInsert: Astrometry observation to insert.
-    /// @throws None
-    /// @version 2015-01-04/GGB - Function created.
-
-    void CAstrometryDockWidget::insertRow(int nRow, astrometry::CAstrometryObservation *toInsert)
-    {
-      ACL::CHDB *currentHDB;
-
-      currentHDB = currentImage->astroFile->getHDB(currentImage->currentHDB);
-
-      tableWidgetAstrometry->insertRow(nRow);
-      tableWidgetAstrometry->setRowHeight(nRow, 16);
-      tableWidgetAstrometry->setItem(nRow, 0, new QTableWidgetItem(*new QString(QString("%1").arg(QString::fromStdString(toInsert->objectName())))));
-      tableWidgetAstrometry->setCurrentCell(nRow, 0);
-    }
-
     /// @brief Called when the window is activated. This allows menus etc to be updated.
     /// @param[in] activeSubWindow: The active sub window.
     /// @throws None.
@@ -429,23 +451,16 @@ namespace astroManager
 
     /// @brief Redraws all the information in the dock widget. Is called after the astrometry image changes.
     /// @throws
+    /// @version 2026-10-17/GGB - The table is a view over the observation store.
     /// @version 2013-03-17/GGB - Changed type of object stored to be descendant of SAstrometryObjectInformation
     /// @version 2013-02-06/GGB - Removed all target code and have only one set of object code.
     /// @version 2011-06-29/GGB - Function created.
 
     void CAstrometryDockWidget::redraw()
     {
-      astrometry::DAstrometryObservationStore::const_iterator iter;
-      int nRow;
-
       if (currentImage)
       {
-          // Remove all the lines already in the reference tableWidget
-
-        while (tableWidgetAstrometry->rowCount())
-        {
-          tableWidgetAstrometry->removeRow(0);
-        };
+        astrometryModel_->observations(&currentImage->astrometryObservations);
 
         pushButtonReferenceSelect->setEnabled(true);
         pushButtonReferenceEdit->setEnabled(false);
@@ -458,22 +473,10 @@ namespace astroManager
         labelObjectRA->setText("--" % UTF16_DEGREESIGN % "--'--""");
         labelObjectDec->setText(UTF16_PLUSMINUSSIGN % "--" % UTF16_DEGREESIGN % "--'--""");
         labelObjectType->setText("");
-
-        nRow = 0;
-        for (iter = currentImage->astrometryObservations.begin(); iter != currentImage->astrometryObservations.end(); iter++)
-        {
-          tableWidgetAstrometry->insertRow(nRow);
-
-          tableWidgetAstrometry->setItem(nRow, 0, new QTableWidgetItem(QString::fromStdString((*iter)->objectName())));
-          nRow++;
-        };
       }
       else
       {
-        while (tableWidgetAstrometry->rowCount())
-        {
-          tableWidgetAstrometry->removeRow(0);
-        };
+        astrometryModel_->observations(nullptr);
 
         pushButtonReferenceSelect->setEnabled(false);
         pushButtonReferenceEdit->setEnabled(false);
@@ -494,7 +497,8 @@ namespace astroManager
     ///   @li Uncheck the button
     ///   @li Ensure that the user selects an object to go with the reference. \n
     ///   @li Add the new item into the astroFile \n
-    ///   @li Add the new item to the tableWidget \n
+    ///   @li Add the new item to the table \n
+    /// @version 2026-10-17/GGB - Uses the observation model. Display code moved to displayAstrometry().
     /// @version 2017-09-23/GGB - Updated to use CAngle
     /// @version 2013-08-16/GGB - Corrected bug with displaying RA/DEC (Bug #1213076)
     /// @version 2013-08-03/GGB - Moved some code into CImageDisplay to align with the requirements of CImageComparison.
@@ -506,36 +510,8 @@ namespace astroManager
 
     void CAstrometryDockWidget::referenceCompleted(astrometry::CAstrometryObservation *astrometryObject)
     {
-      int nRow = tableWidgetAstrometry->rowCount();
-
-      tableWidgetAstrometry->insertRow(nRow);
-
-      tableWidgetAstrometry->setItem(nRow, 0, new QTableWidgetItem(QString::fromStdString(astrometryObject->objectName())));
-      tableWidgetAstrometry->item(nRow, 0)->setData(ROLE_OBJECTINDEX, QVariant(nRow));
-
-      labelObjectName->setText(QString::fromStdString(astrometryObject->objectName()));
-      if (astrometryObject->observedCoordinates())
-      {
-        labelObjectRA->setText(QString::fromStdString(astrometryObject->observedCoordinates()->RA().A2SHMS()));
-        labelObjectDec->setText(QString::fromStdString(astrometryObject->observedCoordinates()->DEC().A2SDMS()));
-      }
-      else
-      {
-        labelObjectRA->setText("--" % UTF16_DEGREESIGN % "--'--""");
-        labelObjectDec->setText(UTF16_PLUSMINUSSIGN % "--" % UTF16_DEGREESIGN % "--'--""");
-      };
-      labelObjectType->setText(QString("------"));
-
-      try
-      {
-        if (currentImage->astroFile->astrometryCheckRequisites())
-        {
-          pushButtonPlateConstants->setEnabled(true);
-        };
-      }
-      catch(...)
-      {
-      };
+      addObjects(1);
+      displayAstrometry(astrometryObject);
     }
 
     /// @brief Enables the widget.
@@ -545,7 +521,7 @@ namespace astroManager
 
     void CAstrometryDockWidget::setEnabled(bool enabledValue)
     {
-      tableWidgetAstrometry->setEnabled(enabledValue);
+      tableViewAstrometry->setEnabled(enabledValue);
       pushButtonReferenceSelect->setEnabled(enabledValue);
       pushButtonReferenceEdit->setEnabled(enabledValue);
       pushButtonReferenceDelete->setEnabled(enabledValue);
@@ -559,6 +535,7 @@ namespace astroManager
 
     /// @brief Sets up the UI
     /// @throws GCL::CRuntimeAssert(...)
+    /// @version 2026-10-17/GGB - Reference table changed to a QTableView with CAstrometryObservationModel.
     /// @version 2017-07-10/GGB - Fixed Bug #90.
     /// @version 2013-07-18/GGB - Added check that all the widget members are found.
     /// @version 2013-02-01/GGB - Removed all target referencing information.
@@ -581,7 +558,7 @@ namespace astroManager
 
       setWidget(formWidget);
 
-      tableWidgetAstrometry = formWidget->findChild<QTableWidget *>("tableWidgetReference");
+      tableViewAstrometry = formWidget->findChild<QTableView *>("tableViewReference");
       pushButtonReferenceSelect = formWidget->findChild<QPushButton *>("pushButtonReferenceSelect");
       pushButtonReferenceEdit = formWidget->findChild<QPushButton *>("pushButtonReferenceEdit");
       pushButtonReferenceDelete = formWidget->findChild<QPushButton *>("pushButtonReferenceDelete");
@@ -593,14 +570,18 @@ namespace astroManager
       labelObjectDec = formWidget->findChild<QLabel *>("labelObjectDec");
       labelObjectType = formWidget->findChild<QLabel *>("labelObjectType");
 
-      if (!tableWidgetAstrometry || !pushButtonReferenceSelect || !pushButtonReferenceEdit || !pushButtonReferenceDelete ||
+      if (!tableViewAstrometry || !pushButtonReferenceSelect || !pushButtonReferenceEdit || !pushButtonReferenceDelete ||
           !pushButtonObjectInformation || !pushButtonPlateConstants || !labelObjectName || !labelCCDCoordinates || !labelObjectRA ||
           !labelObjectDec || !labelObjectType)
         CODE_ERROR;
 
+      astrometryModel_ = new CAstrometryObservationModel(this);
+      tableViewAstrometry->setModel(astrometryModel_);
+      tableViewAstrometry->verticalHeader()->setDefaultSectionSize(16);
+
       connect(pushButtonReferenceSelect, SIGNAL(clicked(bool)), this, SLOT(eventButtonReferenceSelect(bool)));
       connect(pushButtonReferenceDelete, SIGNAL(clicked(bool)), this, SLOT(eventButtonReferenceDelete(bool)));
-      connect(tableWidgetAstrometry, SIGNAL(cellClicked(int, int)), this, SLOT(eventTableRowReferenceSelected(int, int)));
+      connect(tableViewAstrometry, SIGNAL(clicked(QModelIndex)), this, SLOT(eventTableRowReferenceSelected(QModelIndex)));
       connect(pushButtonObjectInformation, SIGNAL(clicked(bool)), this, SLOT(eventAssociateObject(bool)));
       connect(pushButtonPlateConstants, SIGNAL(clicked(bool)), this, SLOT(eventPlateConstants(bool)));
 
@@ -52,6 +52,10 @@
 #include "include/dockWidgets/dockWidgetNavigator.h"
 #include "include/settings.h"
 
+  // Standard C++ library header files
+
+#include <cstring>
+
   // QWT Library
 
 #include <qwt_abstract_scale_draw.h>
@@ -86,6 +90,8 @@ namespace astroManager
     int const BW_SLIDER_LOWER   = 0;          // 0%
     int const BW_SLIDER_UPPER   = 1000;       // 100.0%
 
+    int const RENDER_DELAY      = 150;        // ms after the last change of the stretch.
+
     //*****************************************************************************************************************************
     //
     // CHistogram
@@ -96,6 +102,7 @@ namespace astroManager
     /// @param[in] parent - The parent widget. (Frame Window)
     /// @param[in] action - The menu action that is associated with this dock widget.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Added the renderTimer.
     /// @version 2017-07-01/GGB - Changed order of parameters.
     /// @version 2016-03-26/GGB - Changed default transfer function to ETF_LINEAR (was ETF_NONE)
     /// @version 2013-07-27/GGB - Added objectName for restoreState() support.
@@ -106,8 +113,12 @@ namespace astroManager
 
     CHistogram::CHistogram(QWidget *parent, QAction *action)
       : CDockWidgetImage(tr("Histogram"), parent, action, settings::DW_IMAGE_HISTOGRAM_VISIBLE), histogramData(),
-        histogramPlot(nullptr), transferFunction(ACL::ETF_LINEAR), gammaValue(1)
+        histogramPlot(nullptr), transferFunction(ACL::ETF_LINEAR), gammaValue(1), renderTimer(new QTimer(this))
     {
+      renderTimer->setSingleShot(true);
+      renderTimer->setInterval(RENDER_DELAY);
+      connect(renderTimer, SIGNAL(timeout()), this, SLOT(eventRenderImage()));
+
       gammaValue = settings::astroManagerSettings->value(settings::DW_HOTOGRAM_GAMMA, QVariant(1)).toDouble();
       QString tempTransferFunction = settings::astroManagerSettings->value(settings::DW_HISTOGRAM_TRANSFERFUNCTION,
                                                                    QVariant(QS_LINEAR)).toString();
@@ -175,37 +186,11 @@ namespace astroManager
       histogramPlot->setEnabled(enabledValue);
     }
 
-    /// @brief Thread function for doing the histogram calculation.
-    /// @throws CCodeError(astroManager)
-    /// @version 2015-09-05/GGB - Changed second parameter to std::tuple, from boost::tuple.
-    /// @version 2015-07-31/GGB - Updated code for new astro image interface.
-    /// @version 2013-04-13/GGB - Function created.
-
-    void CHistogram::displayHistogramThread(ACL::CAstroImage *astroImage, std::tuple<ACL::INDEX_t, ACL::INDEX_t,
-                                            ACL::FP_t, ACL::FP_t> values,
-                                            PHistogramSlice histogramSlice)
-    {
-      ACL::INDEX_t lIndex;
-      size_t nBinNo;
-
-        // Count the samples and assign each sample to a bin.
-
-      for(lIndex = std::get<0>(values); lIndex < std::get<1>(values); lIndex++)
-      {
-        nBinNo = static_cast<size_t>(std::floor((astroImage->getValue(lIndex) - std::get<2>(values)) / std::get<3>(values)));
-        if ( (nBinNo < 0) || (nBinNo >= HISTOGRAMBINS) )
-        {
-          CODE_ERROR;
-        }
-        else
-        {
-          (*histogramSlice)[nBinNo]++;        // Add the weighted pixel count to the bin.
-        };
-      };
-    }
-
     /// @brief Performs the calculations and display of the histogram
+    /// @details The histogram is calculated from the pixel buffer of the image using the global thread pool. The pixel buffer
+    ///          caches the histogram, so the histogram is only recalculated when the pixel data or the HDB changes.
     /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Use the cached histogram of the pixel buffer.
     /// @version 2015-07-03/GGB - Changed double to FP_t and long to size_t. Resolved bug 1471220
     /// @version 2013-07-13/GGB - Removed SControlImage::(min, max, mean)
     /// @version 2013-04-13/GGB - Converted to a multi-threaded calculation mechanism.
@@ -215,81 +200,23 @@ namespace astroManager
 
     void CHistogram::DisplayHistogram()
     {
-      std::vector<PHistogramSlice> histogramSlice;
-      FP_t fMin = currentImage->astroFile->imageMin(currentImage->currentHDB);
-      FP_t fMax = currentImage->astroFile->imageMax(currentImage->currentHDB);
-      FP_t fBinSize = (fMax - fMin) / (HISTOGRAMBINS - 1);
+      FP_t fMin, fMax, fBinSize;
       FP_t lastPos, currentPos;
-      size_t lIndex, lPixels;
+      size_t lIndex;
       FP_t histMax = 0;
-      std::vector<ACL::INDEX_t> histogram(HISTOGRAMBINS, 0);
       QwtIntervalSample intervalSample;
       QVector<QwtIntervalSample> intervalData;
-      ACL::CAstroImage *astroImage;
-      size_t numberOfThreads;
-      size_t threadNumber;
-      size_t indexStep;
-      ACL::INDEX_t indexBegin = 0, indexEnd = 0;
-      boost::thread_group threadGroup;
-      boost::thread *thread;
-      ACL::INDEX_t maxThreads = static_cast<size_t>(settings::astroManagerSettings->value(settings::MAX_THREADS, QVariant(2)).toLongLong());
 
       if (currentImage)
       {
         if (currentImage->astroFile)
         {
-          astroImage = currentImage->astroFile->getAstroImage(currentImage->currentHDB);
-
-          lPixels = astroImage->width() * astroImage->height();
-
-            // Ensure that we are using a reasonable number of threads. Maximise the number of threads to the number of rows
-
-          numberOfThreads = std::min(static_cast<ACL::INDEX_t>(astroImage->height()), std::max(ACL::INDEX_t(1), maxThreads));
-
-            // Create the histogram slices
-
-          for (lIndex = 0; lIndex < numberOfThreads; lIndex++)
-          {
-            PHistogramSlice hs(new std::vector<size_t>(HISTOGRAMBINS, 0));
-            histogramSlice.push_back(hs);
-          };
-
-          indexStep = lPixels / numberOfThreads;
-
-            // Spawn the threads.
-
-          for (threadNumber = 0; threadNumber < numberOfThreads; threadNumber++)
-          {
-            indexBegin = indexEnd;
-            if (threadNumber == (numberOfThreads -1) )
-            {
-              indexEnd = lPixels;
-            }
-            else
-            {
-              indexEnd += indexStep;
-            };
-
-            thread = new boost::thread(&CHistogram::displayHistogramThread, this, astroImage,
-                                       std::make_tuple(indexBegin, indexEnd, fMin, fBinSize),
-                                       histogramSlice[threadNumber]);
-            threadGroup.add_thread(thread);
-            thread = nullptr;
-          };
-
-          threadGroup.join_all();     // Wait for all the threads to finish.
-
-            // Add the histogram slices together.
+          std::shared_ptr<imaging::CPixelBuffer const> pixelBuffer = currentImage->pixelData();
+          std::vector<size_t> const &histogram = pixelBuffer->histogram(HISTOGRAMBINS);
 
-          for (lIndex = 0; lIndex < HISTOGRAMBINS; lIndex++)
-          {
-            ACL::INDEX_t count = (*histogramSlice[0])[lIndex];
-            for (size_t slice = 1; slice < numberOfThreads; slice++)
-            {
-              count += (*histogramSlice[slice])[lIndex];
-            };
-            histogram[lIndex] = count;
-          };
+          fMin = pixelBuffer->minValue();
+          fMax = pixelBuffer->maxValue();
+          fBinSize = (fMax - fMin) / (HISTOGRAMBINS - 1);
 
           currentPos = fMin;
           for(lIndex = 0; lIndex < HISTOGRAMBINS; lIndex++)
@@ -514,6 +441,27 @@ namespace astroManager
       redrawImage();
     }
 
+    /// @brief Renders the full resolution image after the stretch has stopped changing.
+    /// @details While the stretch is changing only the proxy image is rendered. Once the stretch has not changed for RENDER_DELAY
+    ///          the screen image and the pixmap are rendered and the preview is removed.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CHistogram::eventRenderImage()
+    {
+      if (currentImage && currentImage->renderPending)
+      {
+        if (renderScreenImage())
+        {
+          currentImage->pixmap->convertFromImage(*currentImage->ScreenImage);
+        };
+        currentImage->renderPending = false;
+
+        currentImage->parent_->repaintImage();      // This ensures that the image is redrawn
+        notifyImageDockWidgets();
+      };
+    }
+
     /// @brief Manages the white point changes.
     /// @note The white point cannot be above the minimum value.
     /// @note The maximum for the black point must also be updates to the white point value.
@@ -620,14 +568,14 @@ namespace astroManager
     /// @throws GCL::CodeError
     /// @details This will then re-read all the data associated with the controlImage and update all the fields to ensure that only
     /// valid information is displayed.
+    /// @version 2026-10-17/GGB - Render the proxy image.
+    /// @version 2026-10-17/GGB - Render using the display renderer.
     /// @version 2013-03-17/GGB - Function flow cleaned up with introduction of CDockWidget.
     /// @version 2013-03-09/GGB - Converted whitePoint and blackPoint to boost::optional<double>
     /// @version 2011-06-05/GGB - Function created.
 
     void CHistogram::imageChanged()
     {
-      long lIndex;
-
         // Prepare the output image.
 
       if (currentImage)
@@ -645,54 +593,20 @@ namespace astroManager
           currentImage->whitePoint = currentImage->astroFile->whitePoint();
         };
 
-          // Render the image to the current settings
-
-        currentImage->astroFile->setImagePlaneRenderFunction(currentImage->currentHDB, 0, *(currentImage->blackPoint),
-                                                             *(currentImage->whitePoint), checkBoxInvert->isChecked(),
-                                                             transferFunction, gammaValue);
-        currentImage->astroFile->renderImage(currentImage->currentHDB, ACL::RM_GREY8);
+          // Render the image to the current settings. The pixel data may have changed, so the copy must be recreated.
+          // The proxy is rendered now so that it is available to the navigator and magnify widgets, and for stretch changes.
 
+        currentImage->displayStretch = displayStretch(*(currentImage->blackPoint), *(currentImage->whitePoint));
+        currentImage->invalidatePixelData();
+        renderScreenImage();
+        renderProxyImage();
 
         if (currentImage->ScreenImage)
         {
-          delete currentImage->ScreenImage;
-          currentImage->ScreenImage = nullptr;
-        };
-
-        if (currentImage->astroFile->isMonoImage(currentImage->currentHDB))
-        {
-
-            // Working with a monochrome image
-
-          currentImage->ScreenImage = new QImage((uchar *) currentImage->astroFile->getRenderedImage(currentImage->currentHDB),
-                                                 currentImage->astroFile->imageWidth(currentImage->currentHDB),
-                                                 currentImage->astroFile->imageHeight(currentImage->currentHDB),
-                                                  sizeof(uchar) * currentImage->astroFile->imageWidth(currentImage->currentHDB),
-                                                 QImage::Format_Indexed8);
-
-          currentImage->ScreenImage->setColorCount(256);
-
-            // Create the gray scale colour table
-
-          for(lIndex = 0; lIndex <= 255; lIndex++)
-          {
-            currentImage->ScreenImage->setColor(lIndex, qRgb(lIndex, lIndex, lIndex));
-          };
-        }
-        else if (currentImage->astroFile->isPolyImage(currentImage->currentHDB))
-        {
-            // Working with a colour image.
-
-          //currentImage->ScreenImage = new QImage((uchar *) currentImage->astroFile->getOutputImage(currentImage->currentHDB),
-//            currentImage->astroFile->imageWidth(currentImage->currentHDB), currentImage->astroFile->imageHeight(currentImage->currentHDB),
-  //          sizeof(ACL::SColourRGB) * currentImage->astroFile->imageWidth(currentImage->currentHDB), QImage::Format_RGB888);
-        }
-        else
-        {
-          CODE_ERROR;
+          currentImage->pixmap->convertFromImage(*currentImage->ScreenImage);
         };
+        currentImage->renderPending = false;
 
-        currentImage->pixmap->convertFromImage(*currentImage->ScreenImage, Qt::MonoOnly);
         currentImage->parent_->repaintImage();    // Added to ensure the image is repainted. (2016-03-26)
 
         bInternalCall = true;   // Do not update the image.
@@ -723,12 +637,15 @@ namespace astroManager
     /// @details The histogram needs to be updated with the information from the new MDI window instance.
     /// @throws None.
     /// @pre 1. The currentImage member must have been updated before calling this function.
+    /// @version 2026-10-17/GGB - Complete any pending render of the image.
     /// @version 2018-10-21/GGB - Function created.
 
     void CHistogram::mdiWindowActivating(CMdiSubWindow *activeSubWindow)
     {
       if ( (activeSubWindow) && (activeSubWindow->getWindowClass() == CMdiSubWindow::WC_IMAGE))
       {
+        eventRenderImage();     // The stretch of the image may have been changed just before the window was deactivated.
+
         bInternalCall = true;   // Do not update the image.
 
         sbWhite->setMaximum(currentImage->astroFile->imageMax(currentImage->currentHDB));
@@ -757,8 +674,47 @@ namespace astroManager
       }
     }
 
+    /// @brief Returns the stretch for the current settings of the widget.
+    /// @param[in] blackPoint: The black point.
+    /// @param[in] whitePoint: The white point.
+    /// @returns The display stretch.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    imaging::SDisplayStretch CHistogram::displayStretch(FP_t blackPoint, FP_t whitePoint) const
+    {
+      imaging::SDisplayStretch returnValue;
+
+      returnValue.blackPoint = blackPoint;
+      returnValue.whitePoint = whitePoint;
+      returnValue.invert = checkBoxInvert->isChecked();
+      returnValue.transferFunction = transferFunction;
+      returnValue.gamma = gammaValue;
+
+      return returnValue;
+    }
+
+    /// @brief Informs the navigator and magnify widgets that the displayed image has changed.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CHistogram::notifyImageDockWidgets()
+    {
+      auto frameWindow = dynamic_cast<mdiframe::CFrameWindow *>(nativeParentWidget());
+
+      dynamic_cast<dockwidgets::CDockWidgetMagnify *>(frameWindow->getDockWidget(mdiframe::IDDW_VIEW_MAGNIFY))->imageChanged();
+      dynamic_cast<dockwidgets::CDockWidgetNavigator *>(frameWindow->getDockWidget(mdiframe::IDDW_VIEW_NAVIGATOR))->imageChanged();
+    }
+
     /// @brief Redraws the image.
+    /// @details Called when the stretch changes. If the window displays the image from the screen image, the proxy image is
+    ///          rendered and displayed immediately (also in the navigator and magnify widgets). The full resolution render is
+    ///          performed once the stretch has stopped changing. Windows that display the pixmap, and images rendered by ACL, are
+    ///          rendered immediately.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Render immediately if the image is rendered by ACL.
+    /// @version 2026-10-17/GGB - Display the proxy image while the stretch is changing.
+    /// @version 2026-10-17/GGB - Render using the display renderer and delay the pixmap update.
     /// @version 2013-05-26/GGB - Corrected program flow for new renderOutputImage function.
     /// @version 2013-05-20/GGB - Added the pixmap member.
     /// @version 2013-03-17/GGB - Function flow cleaned up with introduction of CDockWidget.
@@ -768,62 +724,136 @@ namespace astroManager
     {
       if (currentImage)
       {
-          // Do the transform
-
-        currentImage->astroFile->setImagePlaneRenderFunction(currentImage->currentHDB, 0, sbBlack->value(),
-                                                             sbWhite->value(), checkBoxInvert->isChecked(),
-                                                             transferFunction, gammaValue);
-        currentImage->astroFile->renderImage(currentImage->currentHDB, ACL::RM_GREY8);
+        currentImage->displayStretch = displayStretch(sbBlack->value(), sbWhite->value());
 
-        if (currentImage->ScreenImage)
+        if (currentImage->parent_->displaysPixmap() || !rendersWithLUT())
         {
-          delete currentImage->ScreenImage;
-          currentImage->ScreenImage = nullptr;
+          currentImage->renderPending = true;
+          eventRenderImage();
+        }
+        else if (renderProxyImage())
+        {
+          currentImage->renderPending = true;
+          currentImage->parent_->repaintPreview();
+          notifyImageDockWidgets();
+          renderTimer->start();
         };
+      };
+    }
 
-        if (currentImage->astroFile->isMonoImage(currentImage->currentHDB))
+    /// @brief Renders the current image into the screen image using the ACL rendering.
+    /// @returns true.
+    /// @details Used for monochrome images with transfer functions that the display renderer does not reproduce. The rendered
+    ///          image is copied into the screen image, which is reused if it has the correct size and format.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created. (Code restored from redrawImage())
+
+    bool CHistogram::renderACLImage()
+    {
+      int width = static_cast<int>(currentImage->astroFile->imageWidth(currentImage->currentHDB));
+      int height = static_cast<int>(currentImage->astroFile->imageHeight(currentImage->currentHDB));
+
+      currentImage->astroFile->setImagePlaneRenderFunction(currentImage->currentHDB, 0, currentImage->displayStretch.blackPoint,
+                                                           currentImage->displayStretch.whitePoint,
+                                                           currentImage->displayStretch.invert,
+                                                           currentImage->displayStretch.transferFunction,
+                                                           currentImage->displayStretch.gamma);
+      currentImage->astroFile->renderImage(currentImage->currentHDB, ACL::RM_GREY8);
+
+      if ( (currentImage->ScreenImage->format() != QImage::Format_Indexed8) || (currentImage->ScreenImage->width() != width) ||
+           (currentImage->ScreenImage->height() != height) )
+      {
+        *currentImage->ScreenImage = QImage(width, height, QImage::Format_Indexed8);
+        currentImage->ScreenImage->setColorCount(256);
+
+        for (int index = 0; index <= 255; index++)
         {
+          currentImage->ScreenImage->setColor(index, qRgb(index, index, index));
+        };
+      };
 
-            // Working with a monochrome image
+      uchar const *renderedImage = static_cast<uchar const *>(currentImage->astroFile->getRenderedImage(currentImage->currentHDB));
 
-          currentImage->ScreenImage = new QImage(static_cast<uchar *>(currentImage->astroFile->getRenderedImage(currentImage->currentHDB)),
-                                                 currentImage->astroFile->imageWidth(currentImage->currentHDB),
-                                                 currentImage->astroFile->imageHeight(currentImage->currentHDB),
-                                                 sizeof(uchar) * currentImage->astroFile->imageWidth(currentImage->currentHDB),
-                                                 QImage::Format_Indexed8);
+      for (int row = 0; row < height; ++row)
+      {
+        std::memcpy(currentImage->ScreenImage->scanLine(row), renderedImage + row * width, static_cast<std::size_t>(width));
+      };
 
-          currentImage->ScreenImage->setColorCount(256);
+      return true;
+    }
 
-            // Create the gray scale colour table
+    /// @brief Renders the proxy of the current image with the stretch of the image.
+    /// @returns true if the proxy image was rendered. false if the proxy image is unchanged, or cannot be rendered.
+    /// @details The proxy is not rendered if the image must be rendered by ACL.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Do not render the proxy if the image is rendered by ACL.
+    /// @version 2026-10-17/GGB - Render poly images.
+    /// @version 2026-10-17/GGB - Function created.
 
-          for(int lIndex=0; lIndex <= 255; lIndex++)
-          {
-            currentImage->ScreenImage->setColor(lIndex, qRgb(lIndex, lIndex, lIndex));
-          };
-        }
-        else if (currentImage->astroFile->isPolyImage(currentImage->currentHDB))
+    bool CHistogram::renderProxyImage()
+    {
+      bool returnValue = false;
+
+      if (rendersWithLUT())
+      {
+        returnValue = currentImage->proxyRenderer.render(currentImage->proxyData(), currentImage->displayStretch,
+                                                         currentImage->proxyImage);
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Renders the current image into the screen image with the stretch of the image.
+    /// @returns true if the screen image was rendered. false if the screen image is unchanged.
+    /// @details Monochrome images are rendered into an 8 bit greyscale image and poly images into a 32 bit RGB image. The screen
+    ///          image is reused if it has the correct size and format. Monochrome images with a transfer function that the
+    ///          display renderer does not reproduce are rendered by ACL.
+    /// @throws GCL::CodeError
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Use the ACL rendering for the logarithmic and sigmoid transfer functions.
+    /// @version 2026-10-17/GGB - Render poly images.
+    /// @version 2026-10-17/GGB - Function created.
+
+    bool CHistogram::renderScreenImage()
+    {
+      bool returnValue = false;
+
+      if ( currentImage->astroFile->isMonoImage(currentImage->currentHDB) ||
+           currentImage->astroFile->isPolyImage(currentImage->currentHDB) )
+      {
+        if (!currentImage->ScreenImage)
         {
-            // Working with a colour image.
+          currentImage->ScreenImage = new QImage();
+        };
 
-          //currentImage->ScreenImage = new QImage((uchar *) currentImage->astroFile->getOutputImage(currentImage->currentHDB),
-//            currentImage->astroFile->imageWidth(currentImage->currentHDB), currentImage->astroFile->imageHeight(currentImage->currentHDB),
-  //          sizeof(ACL::SColourRGB) * currentImage->astroFile->imageWidth(currentImage->currentHDB), QImage::Format_RGB888);
+        if (rendersWithLUT())
+        {
+          returnValue = currentImage->displayRenderer.render(currentImage->pixelData(), currentImage->displayStretch,
+                                                             *currentImage->ScreenImage);
         }
         else
         {
-          CODE_ERROR;
+          returnValue = renderACLImage();
         };
+      }
+      else
+      {
+        CODE_ERROR;
+      };
 
-        //currentImage->pixmap->convertFromImage(*currentImage->ScreenImage, Qt::MonoOnly);
-
-        currentImage->pixmap->convertFromImage(*currentImage->ScreenImage);
-        currentImage->parent_->repaintImage();      // This ensures that the image is redrawn
+      return returnValue;
+    }
 
-        auto frameWindow = dynamic_cast<mdiframe::CFrameWindow *>(nativeParentWidget());
+    /// @brief Determines if the current image is rendered using the display renderer.
+    /// @returns true if the display renderer is used. false if the image must be rendered by ACL.
+    /// @details ACL only renders monochrome images, so poly images are always rendered by the display renderer.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
 
-        dynamic_cast<dockwidgets::CDockWidgetMagnify *>(frameWindow->getDockWidget(mdiframe::IDDW_VIEW_MAGNIFY))->imageChanged();
-        dynamic_cast<dockwidgets::CDockWidgetNavigator *>(frameWindow->getDockWidget(mdiframe::IDDW_VIEW_NAVIGATOR))->imageChanged();
-      };
+    bool CHistogram::rendersWithLUT() const
+    {
+      return ( currentImage->astroFile->isPolyImage(currentImage->currentHDB) ||
+               imaging::CDisplayRenderer::rendersTransfer(currentImage->displayStretch.transferFunction) );
     }
 
     /// @brief Resets the values for the dockWidget
@@ -64,6 +64,32 @@ namespace astroManager
     {
     }
 
+    /// @brief Adds the current image to a scene.
+    /// @param[in] scene: The scene to add the image to.
+    /// @returns The item that was added.
+    /// @details While the current image is being rendered again, the proxy image is added, scaled to the size of the full image.
+    ///          The scene coordinates are the same as the image coordinates in both cases.
+    /// @pre currentImage != nullptr
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    QGraphicsPixmapItem *CDockWidgetImage::addImageToScene(QGraphicsScene *scene)
+    {
+      QGraphicsPixmapItem *returnValue;
+
+      if (currentImage->renderPending && !currentImage->proxyImage.isNull() && currentImage->ScreenImage)
+      {
+        returnValue = scene->addPixmap(QPixmap::fromImage(currentImage->proxyImage));
+        returnValue->setScale(static_cast<qreal>(currentImage->ScreenImage->width()) / currentImage->proxyImage.width());
+      }
+      else
+      {
+        returnValue = scene->addPixmap(*currentImage->pixmap);
+      };
+
+      return returnValue;
+    }
+
     /// @brief This function needs to be called when a window containing a SControlImage record becomes the active window.
     /// @details This allows the class on the other side to know if it should continue to update the record
     /// @param[in] activating: The controlImage structure for the image that is activating.
@@ -196,6 +196,7 @@ namespace astroManager
 
     /// @brief Function called when the image is updated.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Display the proxy image while the image is being rendered.
     /// @version 2013-05-20/GGB - Function created.
 
     void CDockWidgetMagnify::imageChanged()
@@ -204,7 +205,7 @@ namespace astroManager
 
       if (currentImage)
       {
-        graphicsScene->addPixmap(*currentImage->pixmap);
+        addImageToScene(graphicsScene);
       };
     }
 
@@ -72,7 +72,7 @@ namespace astroManager
 
     CDockWidgetNavigator::CDockWidgetNavigator(QWidget *parent, QAction *action)
       : CDockWidgetImage(DW_NAVIGATOR_NAME, parent, action, settings::DW_IMAGE_NAVIGATOR_VISIBLE),
-      viewRectangle(nullptr)
+      viewRectangle(nullptr), thumbnailItem(nullptr), thumbnailKey(0)
     {
       setupUI();
       setObjectName(DW_NAVIGATOR_NAME);
@@ -87,26 +87,57 @@ namespace astroManager
     }
 
     /// @brief Function called when the image is updated.
-    /// @throws
+    /// @details The navigator displays the thumbnail of the image, scaled to the size of the image so that the scene coordinates
+    ///          are the same as the image coordinates. The thumbnail is only rendered again if the pixel data or the stretch has
+    ///          changed, and the pixmap is only replaced if the thumbnail has been rendered again. Monochrome images with a
+    ///          transfer function that is rendered by ACL use a scaled copy of the screen image as the thumbnail.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Scale the screen image if the image is rendered by ACL.
+    /// @version 2026-10-17/GGB - Display the thumbnail image rather than the full resolution pixmap.
+    /// @version 2026-10-17/GGB - Display the proxy image while the image is being rendered.
     /// @version 2013-05-24/GGB - Function created.
 
     void CDockWidgetNavigator::imageChanged()
     {
       qreal zoomFactor;
 
-      graphicsScene->clear();
-      viewRectangle = nullptr; // Killed by the graphicsScene->clear()
+      if (viewRectangle)
+      {
+        graphicsScene->removeItem(viewRectangle);
+        delete viewRectangle;
+        viewRectangle = nullptr;
+      };
 
-      if (currentImage)
+      if (currentImage && currentImage->astroFile)
       {
-        graphicsScene->addPixmap(*currentImage->pixmap);
+        std::shared_ptr<imaging::CPixelBuffer const> thumbnail = currentImage->thumbnailData();
+
+        if ( currentImage->astroFile->isPolyImage(currentImage->currentHDB) ||
+             imaging::CDisplayRenderer::rendersTransfer(currentImage->displayStretch.transferFunction) )
+        {
+          currentImage->thumbnailRenderer.render(thumbnail, currentImage->displayStretch, currentImage->thumbnailImage);
+        }
+        else if (currentImage->ScreenImage)
+        {
+          currentImage->thumbnailImage = currentImage->ScreenImage->scaled(static_cast<int>(thumbnail->width()),
+                                                                           static_cast<int>(thumbnail->height()),
+                                                                           Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        };
+
+        if (currentImage->thumbnailImage.cacheKey() != thumbnailKey)
+        {
+          thumbnailItem->setPixmap(QPixmap::fromImage(currentImage->thumbnailImage));
+          thumbnailItem->setScale(static_cast<qreal>(thumbnail->binning()));
+          thumbnailKey = currentImage->thumbnailImage.cacheKey();
+        };
+
         graphicsView->resetTransform();
 
         int viewWidth = graphicsView->width() - ( 2 * MARGIN_X);
         int viewHeight = graphicsView->height() - ( 2 * MARGIN_Y);
 
-        qreal sceneWidth = currentImage->pixmap->width();;
-        qreal sceneHeight = currentImage->pixmap->height();
+        qreal sceneWidth = currentImage->pixelData()->width();
+        qreal sceneHeight = currentImage->pixelData()->height();
         graphicsView->setSceneRect(0, 0, sceneWidth, sceneHeight);
 
         qreal zoomX = (qreal) viewWidth / sceneWidth;
@@ -124,6 +155,11 @@ namespace astroManager
         graphicsView->scale(zoomFactor, zoomFactor);
         graphicsView->centerOn(sceneWidth / 2, sceneHeight / 2);
         graphicsView->repaint();
+      }
+      else
+      {
+        thumbnailItem->setPixmap(QPixmap());
+        thumbnailKey = 0;
       };
     }
 
@@ -163,6 +199,7 @@ namespace astroManager
 
     /// @brief Sets up the user interface for the class.
     /// @throws GCL::CError(astroManager, 0x0001)
+    /// @version 2026-10-17/GGB - Added the thumbnail item.
     /// @version 2017-07-10/GGB - Bug #90 checking for resource opening succesfully.
     /// @version 2013-05-24/GGB - Function created.
 
@@ -194,6 +231,8 @@ namespace astroManager
       glayout->addWidget(graphicsView, 0, 0, 1, 1);    // Only object in the layout
 
       graphicsScene = new QGraphicsScene();
+      thumbnailItem = graphicsScene->addPixmap(QPixmap());
+      thumbnailItem->setTransformationMode(Qt::SmoothTransformation);
 
       graphicsView->setScene(graphicsScene);
     }
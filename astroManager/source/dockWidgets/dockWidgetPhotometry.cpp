@@ -34,7 +34,8 @@
 //                        - CInstrumentDockwidget
 //                        - CMessageWidget
 //
-// HISTORY:             2015-09-22 GGB - astroManager 2015.09 release
+// HISTORY:             2026-10-17 GGB - Photometry list changed to a QTableView over CPhotometryObservationModel.
+//                      2015-09-22 GGB - astroManager 2015.09 release
 //                      2013-09-30 GGB - astroManager 2013.09 release.
 //                      2013-03-22 GGB - astroManager 2013.03 release.
 //                      2013-01-28 GGB - Split PhotometryDockWidgets from DockWidgets.
@@ -73,8 +74,6 @@ namespace astroManager
   namespace dockwidgets
   {
 
-    int const ROLE_OBJECINDEX_t  = Qt::UserRole + 0;
-
     //*****************************************************************************************************************************
     //
     // CPhotometryDockWidget
@@ -227,18 +226,28 @@ namespace astroManager
     }
 
     /// @brief Adds a new object into the object list.
-    /// @param[in] newObject: The object to add.
+    /// @param[in] newObject: The object to add. (Must already be at the back of the observation store.)
     /// @throws None.
+    /// @version 2026-10-17/GGB - Uses the observation model.
     /// @version 2013-05-12/GGB - Removed support for export csv button.
     /// @version 2013-05-10/GGB - Removed support for the objectStore.
     /// @version 2013-03-28/GGB - Added support for the objectStore.
     /// @version 2012-11-11/GGB - Function created.
 
-    void CPhotometryDockWidget::addNewObject(photometry::CPhotometryObservation *newObject)
+    void CPhotometryDockWidget::addNewObject(photometry::CPhotometryObservation *)
     {
-        // Add the object to the table view.
+      addObjects(1);
+      tableViewPhotometry->selectRow(photometryModel_->rowCount() - 1);
+    }
+
+    /// @brief Adds a number of new objects into the object list. The table is updated once for all the objects.
+    /// @param[in] count: The number of objects that have been added to the back of the observation store.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
 
-      insertRow(tableWidgetPhotometry->rowCount(), newObject);
+    void CPhotometryDockWidget::addObjects(std::size_t count)
+    {
+      photometryModel_->addObjects(count);
     }
 
     /// @brief Function called when an image is deactivated.
@@ -342,6 +351,8 @@ namespace astroManager
     /// @brief Push button to allow the object name to be selected for the object.
     /// @param[in] :unused.
     /// @throws GCL::CCodeError(astroManager)
+    /// @version 2026-10-17/GGB - The object is renamed through the astroFile so the spatial index is kept up to date.
+    /// @version 2026-10-17/GGB - Uses the observation model.
     /// @version 2013-08-11/GGB - 1) Added code to initialise the object name. (Bug #1210914)
     /// @version                  2) Added code to allow save and make the image dirty.
     /// @version 2013-08-09/GGB - Added support for the compare image window.
@@ -350,7 +361,7 @@ namespace astroManager
     void CPhotometryDockWidget::eventButtonObjectName(bool)
     {
       QString szName;
-      int nRow = tableWidgetPhotometry->currentRow();
+      int nRow = tableViewPhotometry->currentIndex().row();
 
       szName = QString::fromStdString(currentImage->photometryObservations[nRow]->objectName());
 
@@ -361,9 +372,9 @@ namespace astroManager
           // Update the string in the table, as well as the displayed string on the image
           // as well as the strings for the object information.
 
-        currentImage->photometryObservations[nRow]->objectName(szName.toStdString());
+        currentImage->astroFile->photometryObjectRename(currentImage->photometryObservations[nRow].get(), szName.toStdString());
 
-        tableWidgetPhotometry->item(nRow, 0)->setText(szName);
+        photometryModel_->objectChanged(nRow);
 
         tlObjectName->setText(szName);
 
@@ -392,12 +403,14 @@ namespace astroManager
     /// @brief Allows the user to delete an object from the current photometry list. The currently selected item is deleted. The
     ///        graphics item group also needs to be deleted.
     /// @throws
+    /// @version 2026-10-17/GGB - The object is removed from the astroFile by pointer.
+    /// @version 2026-10-17/GGB - Uses the observation model.
     /// @version 2015-01-01/GGB - Added code to delete the text and group and also to reset the current selection. (Bug #1406768)
     /// @version 2013-08-17/GGB - Function created.
 
     void CPhotometryDockWidget::eventButtonRemove(bool)
     {
-      int nRow = tableWidgetPhotometry->currentRow();
+      int nRow = tableViewPhotometry->currentIndex().row();
 
       if (nRow != -1 && currentImage)
       {
@@ -413,10 +426,8 @@ namespace astroManager
 
         currentImage->currentPhotometrySelection = nullptr;   // Remove the selection link.
 
-        currentImage->astroFile->photometryObjectRemove(currentImage->photometryObservations[nRow]->objectName());
-        currentImage->photometryObservations.erase(currentImage->photometryObservations.begin() + nRow);
-
-        tableWidgetPhotometry->removeRow(nRow);
+        currentImage->astroFile->photometryObjectRemove(currentImage->photometryObservations[nRow].get());
+        photometryModel_->removeObject(nRow);
 
         btnObjectName->setEnabled(false);
         pushButtonRemove->setEnabled(false);
@@ -545,21 +556,18 @@ namespace astroManager
     }
 
     /// @brief Displays the information for the item that has been selected.
-    /// @param[in] row: The selected row.
+    /// @param[in] index: The selected cell.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Changed to take the model index from the table view.
     /// @version 2013-08-24/GGB - Added code to allow the selected item to hilight.
     /// @version 2013-03-29/GGB - Function created.
 
-    void CPhotometryDockWidget::eventReferenceSelected(int row, int)
+    void CPhotometryDockWidget::eventReferenceSelected(QModelIndex const &index)
     {
-      std::string objectText;
-      photometry::CPhotometryObservation *selectedObject;
+      photometry::CPhotometryObservation *selectedObject = photometryModel_->observation(index.row());
 
-      if (!currentImage->photometryObservations.empty())
+      if (selectedObject)
       {
-        objectText = tableWidgetPhotometry->item(row, 0)->text().toStdString();
-
-        selectedObject = currentImage->photometryObservations[row].get();
         btnObjectName->setEnabled(true);
       }
       else
@@ -573,51 +581,6 @@ namespace astroManager
       pushButtonRemove->setEnabled(true);
     }
 
-    /// @brief Inserts a row into the table.
-    /// @param[in] nRow: The row number to insert the new row.
-    /// @param[in] toInsert: The observation to insert.
-    /// @throws GCL::CCodeError(astroManager)
-    /// @version 2013-03-17/GGB - Function flow cleaned up with introduction of CDockWidget.
-    /// @version 2012-11-12/GGB - Function created.
-
-    void CPhotometryDockWidget::insertRow(int nRow, photometry::CPhotometryObservation *toInsert)
-    {
-      ACL::CHDB *currentHDB;
-      FP_t zmag;
-
-      currentHDB = currentImage->astroFile->getHDB(currentImage->currentHDB);
-
-      if (settings::astroManagerSettings->value(settings::PHOTOMETRY_USEZMAG, QVariant(false)).toBool())
-      {
-        if (currentHDB->HDBType() == ACL::BT_IMAGE)
-        {
-          if (currentHDB->keywordExists(ACL::ASTROMANAGER_ZMAG))
-          {
-            zmag = static_cast<FP_t>(currentHDB->keywordData(ACL::ASTROMANAGER_ZMAG));
-          }
-          else
-          {
-            zmag = 0;
-          }
-        }
-        else
-        {
-          CODE_ERROR;
-        }
-      }
-      else
-      {
-        zmag = 0;
-      }
-
-      tableWidgetPhotometry->insertRow(nRow);
-      tableWidgetPhotometry->setRowHeight(nRow, 16);
-      tableWidgetPhotometry->setItem(nRow, 0, new QTableWidgetItem(*new QString(QString("%1").arg(QString::fromStdString(toInsert->objectName())))));
-      tableWidgetPhotometry->setItem(nRow, 1, new QTableWidgetItem(QString("%1").arg(zmag + *(toInsert->instrumentMagnitude()))));
-      tableWidgetPhotometry->setItem(nRow, 2, new QTableWidgetItem(QString("%1").arg(toInsert->magnitudeError())));
-      tableWidgetPhotometry->setCurrentCell(nRow, 0);
-    }
-
     /// @brief Called when the window is activated. This allows menus etc to be updated.
     /// @param[in] activeSubWindow: The active sub window.
     /// @throws None.
@@ -637,25 +600,38 @@ namespace astroManager
     }
 
     /// @brief Redraws all the information in the dock widget. Is called after the photometry image changes.
-    /// @throws None.
+    /// @throws GCL::CCodeError(astroManager)
+    /// @version 2026-10-17/GGB - The table is a view over the observation store.
     /// @version 2013-05-12/GGB - Removed support for the editing push button and the export csv pushbutton.
     /// @version 2013-03-17/GGB - Function flow cleaned up with introduction of CDockWidget.
     /// @version 2012-11-12/GGB - Function created.
 
     void CPhotometryDockWidget::redraw()
     {
-      int nRow;
-      photometry::CPhotometryObservation *currentObject;
-
       if (currentImage)
       {
-          // Remove all the existing data
+        FP_t zmag = 0;
 
-        while (tableWidgetPhotometry->rowCount())
+        if (settings::astroManagerSettings->value(settings::PHOTOMETRY_USEZMAG, QVariant(false)).toBool())
         {
-          tableWidgetPhotometry->removeRow(0);
+          ACL::CHDB *currentHDB = currentImage->astroFile->getHDB(currentImage->currentHDB);
+
+          if (currentHDB->HDBType() == ACL::BT_IMAGE)
+          {
+            if (currentHDB->keywordExists(ACL::ASTROMANAGER_ZMAG))
+            {
+              zmag = static_cast<FP_t>(currentHDB->keywordData(ACL::ASTROMANAGER_ZMAG));
+            };
+          }
+          else
+          {
+            CODE_ERROR;
+          };
         };
 
+        photometryModel_->zmag(zmag);
+        photometryModel_->observations(&currentImage->photometryObservations);
+
         if (isEnabled())
         {
           pushButtonSelect->setEnabled(true);
@@ -682,29 +658,12 @@ namespace astroManager
 
         tlStarE->setText("");
         tlSNR->setText("");
-
-        nRow = 0;
-
-        if (currentImage->astroFile->hasPhotometryHDB())
-        {
-          currentObject = dynamic_cast<photometry::CPhotometryObservation *>(currentImage->astroFile->photometryObjectFirst());
-
-          while (currentObject)
-          {
-            insertRow(nRow++, currentObject);
-            currentObject = dynamic_cast<photometry::CPhotometryObservation *>(currentImage->astroFile->photometryObjectNext());
-          };
-        };
       }
       else
       {
         labelFilter->setText("");
 
-
-        while (tableWidgetPhotometry->rowCount())
-        {
-          tableWidgetPhotometry->removeRow(0);
-        };
+        photometryModel_->observations(nullptr);
 
         pushButtonSelect->setEnabled(false);
         pushButtonRemove->setEnabled(false);
@@ -734,8 +693,9 @@ namespace astroManager
     /// 1. Uncheck the button \n
     /// 2. Ensure that the user selects an object to go with the reference. \n
     /// 3. Add the new item into the astroFile \n
-    /// 4. Add the new item to the tableWidget \n
+    /// 4. Add the new item to the table \n
     /// @throws GCL::CRuntimeAssert()
+    // 2026-10-17/GGB - Uses the observation model.
     // 2013-08-05/GGB - Moved code into the window objects.
     // 2013-04-12/GGB - Added code to set the creator and date of a new HDB.
     // 2013-03-31/GGB - Function created.
@@ -744,7 +704,6 @@ namespace astroManager
     {
       imaging::CImageWindow *subWindow;
       mdiframe::CFrameWindow *frameWindow;
-      int nRow = tableWidgetPhotometry->rowCount();
       pushButtonSelect->setChecked(false);
 
          // Let the image know that it has finished referencing.
@@ -764,10 +723,7 @@ namespace astroManager
         CODE_ERROR;    // Dock widget should be grayed.
       }
 
-      tableWidgetPhotometry->insertRow(nRow);
-
-      tableWidgetPhotometry->setItem(nRow, 0, new QTableWidgetItem(QString::fromStdString(photometryObject->objectName())));
-      tableWidgetPhotometry->item(nRow, 0)->setData(ROLE_OBJECINDEX_t, QVariant(nRow));
+      addNewObject(photometryObject);
     }
 
     /// @brief Called when the object needs to be enabled or disabled.
@@ -779,7 +735,7 @@ namespace astroManager
     {
       labelFilter->setEnabled(enabledValue);
       infoTab->setEnabled(enabledValue);
-      tableWidgetPhotometry->setEnabled(enabledValue);
+      tableViewPhotometry->setEnabled(enabledValue);
 
       pushButtonSelect->setEnabled(enabledValue);
       pushButtonRemove->setEnabled(enabledValue);
@@ -787,6 +743,7 @@ namespace astroManager
 
     /// Function to setup all the user interface elements
     /// @throws GCL::CError(astroManager, 0x0001)
+    /// @version 2026-10-17/GGB - Photometry table changed to a QTableView with CPhotometryObservationModel.
     /// @version 2017-07-10/GGB - Bug #90 checking for resource opening succesfully.
     /// @version 2013-08-18/GGG - Added ZMAG support
     /// @version 2013-05-18/GGB - Added support for the profileCurve.
@@ -817,7 +774,12 @@ namespace astroManager
       labelFilter = formWidget->findChild<QLabel *>("labelFilter");
       labelZMAG = formWidget->findChild<QLabel *>("labelZMAG");
 
-      tableWidgetPhotometry = formWidget->findChild<QTableWidget *>("tableWidgetPhotometry");
+      tableViewPhotometry = formWidget->findChild<QTableView *>("tableViewPhotometry");
+      RUNTIME_ASSERT(tableViewPhotometry != nullptr, "tableViewPhotometry not found in dwPhotometry.ui");
+
+      photometryModel_ = new CPhotometryObservationModel(this);
+      tableViewPhotometry->setModel(photometryModel_);
+      tableViewPhotometry->verticalHeader()->setDefaultSectionSize(16);
 
       infoTab = formWidget->findChild<QTabWidget *>("infoTab");
         tabAperture = infoTab->widget(nIndex);
@@ -887,7 +849,7 @@ namespace astroManager
       sbRadius3->setValue(uiRadius3);
       sbRadius3->setMinimum(uiRadius2);
 
-      connect(tableWidgetPhotometry, SIGNAL(cellClicked(int, int)), this, SLOT(eventReferenceSelected(int, int)));
+      connect(tableViewPhotometry, SIGNAL(clicked(QModelIndex)), this, SLOT(eventReferenceSelected(QModelIndex)));
 
       connect(sbRadius1, SIGNAL(valueChanged(int)), this, SLOT(eventRadius1Changed(int)));
       connect(sbRadius2, SIGNAL(valueChanged(int)), this, SLOT(eventRadius2Changed(int)));
@@ -0,0 +1,494 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								observationModels
+// SUBSYSTEM:						Dock Widgets
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt
+// NAMESPACE:						astroManager::dockwidgets
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Table models over the astrometry and photometry observations of an image. Used by the astrometry and
+//                      photometry dock widgets.
+//
+// CLASSES INCLUDED:    CAstrometryObservationModel
+//                      CPhotometryObservationModel
+//
+// CLASS HIERARCHY:     QAbstractTableModel
+//                        - CAstrometryObservationModel
+//                        - CPhotometryObservationModel
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/dockWidgets/observationModels.h"
+
+namespace astroManager
+{
+  namespace dockwidgets
+  {
+    /// @brief Returns the font used for the bold column headings.
+    /// @returns A bold font.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    static QFont boldHeaderFont()
+    {
+      QFont font;
+
+      font.setBold(true);
+
+      return font;
+    }
+
+    //*****************************************************************************************************************************
+    //
+    // CAstrometryObservationModel
+    //
+    //*****************************************************************************************************************************
+
+    /// @brief Constructor.
+    /// @param[in] parent: The parent object.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    CAstrometryObservationModel::CAstrometryObservationModel(QObject *parent) : QAbstractTableModel(parent)
+    {
+    }
+
+    /// @brief Announces the observations that have been added to the end of the store. The view is updated once for all the
+    ///        observations.
+    /// @param[in] count: The number of observations that have been added.
+    /// @details If the store does not contain the expected number of observations, the model is reset.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CAstrometryObservationModel::addObjects(std::size_t count)
+    {
+      if (observations_ && (count != 0))
+      {
+        if (static_cast<std::size_t>(rowCount_) + count == observations_->size())
+        {
+          beginInsertRows(QModelIndex(), rowCount_, rowCount_ + static_cast<int>(count) - 1);
+          rowCount_ = static_cast<int>(observations_->size());
+          endInsertRows();
+        }
+        else
+        {
+          beginResetModel();
+          rowCount_ = static_cast<int>(observations_->size());
+          endResetModel();
+        };
+      };
+    }
+
+    /// @brief Returns the number of columns.
+    /// @returns The number of columns.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    int CAstrometryObservationModel::columnCount(QModelIndex const &parent) const
+    {
+      return (parent.isValid() ? 0 : COLUMN_COUNT);
+    }
+
+    /// @brief Returns the data to display.
+    /// @param[in] index: The cell.
+    /// @param[in] role: The role.
+    /// @returns The data for the cell.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    QVariant CAstrometryObservationModel::data(QModelIndex const &index, int role) const
+    {
+      QVariant returnValue;
+
+      if ( index.isValid() && (index.row() < rowCount_) && (role == Qt::DisplayRole) && (index.column() == COLUMN_OBJECT) )
+      {
+        returnValue = QString::fromStdString((*observations_)[index.row()]->objectName());
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Returns the column headings.
+    /// @param[in] section: The column.
+    /// @param[in] orientation: The orientation of the header.
+    /// @param[in] role: The role.
+    /// @returns The heading.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    QVariant CAstrometryObservationModel::headerData(int section, Qt::Orientation orientation, int role) const
+    {
+      QVariant returnValue;
+
+      if ( (orientation == Qt::Horizontal) && (role == Qt::DisplayRole) )
+      {
+        switch (section)
+        {
+          case COLUMN_OBJECT:
+          {
+            returnValue = tr("Object");
+            break;
+          };
+          case COLUMN_TYPE:
+          {
+            returnValue = tr("Type");
+            break;
+          };
+          default:
+          {
+            break;
+          };
+        };
+      };
+
+      if ( (orientation == Qt::Horizontal) && (role == Qt::FontRole) && boldColumn(section) )
+      {
+        returnValue = boldHeaderFont();
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Determines if the heading of a column is shown in bold.
+    /// @param[in] section: The column.
+    /// @returns true if the heading is bold.
+    /// @throws None.
+    /// @details The Object and Type headings were both bold in the table of the original astrometry form (dwAstrometry.ui).
+    /// @version 2026-10-17/GGB - Function created.
+
+    bool CAstrometryObservationModel::boldColumn(int section)
+    {
+      return ( (section == COLUMN_OBJECT) || (section == COLUMN_TYPE) );
+    }
+
+    /// @brief Returns the observation displayed in a row.
+    /// @param[in] row: The row.
+    /// @returns The observation. nullptr if the row is not valid.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    astrometry::CAstrometryObservation *CAstrometryObservationModel::observation(int row) const
+    {
+      astrometry::CAstrometryObservation *returnValue = nullptr;
+
+      if ( (row >= 0) && (row < rowCount_) )
+      {
+        returnValue = (*observations_)[row].get();
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Called when the data of an observation has changed.
+    /// @param[in] row: The row of the observation.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CAstrometryObservationModel::objectChanged(int row)
+    {
+      if ( (row >= 0) && (row < rowCount_) )
+      {
+        emit dataChanged(index(row, 0), index(row, COLUMN_COUNT - 1));
+      };
+    }
+
+    /// @brief Sets the observations to display. The model is reset.
+    /// @param[in] observations: The observations. (nullptr if there are no observations to display)
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CAstrometryObservationModel::observations(astrometry::DAstrometryObservationStore *observations)
+    {
+      beginResetModel();
+      observations_ = observations;
+      rowCount_ = observations_ ? static_cast<int>(observations_->size()) : 0;
+      endResetModel();
+    }
+
+    /// @brief Removes an observation from the store.
+    /// @param[in] row: The row of the observation.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CAstrometryObservationModel::removeObject(int row)
+    {
+      if ( (row >= 0) && (row < rowCount_) )
+      {
+        beginRemoveRows(QModelIndex(), row, row);
+        observations_->erase(observations_->begin() + row);
+        --rowCount_;
+        endRemoveRows();
+      };
+    }
+
+    /// @brief Returns the number of rows.
+    /// @returns The number of observations announced to the view.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    int CAstrometryObservationModel::rowCount(QModelIndex const &parent) const
+    {
+      return (parent.isValid() ? 0 : rowCount_);
+    }
+
+    //*****************************************************************************************************************************
+    //
+    // CPhotometryObservationModel
+    //
+    //*****************************************************************************************************************************
+
+    /// @brief Constructor.
+    /// @param[in] parent: The parent object.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    CPhotometryObservationModel::CPhotometryObservationModel(QObject *parent) : QAbstractTableModel(parent)
+    {
+    }
+
+    /// @brief Announces the observations that have been added to the end of the store. The view is updated once for all the
+    ///        observations.
+    /// @param[in] count: The number of observations that have been added.
+    /// @details If the store does not contain the expected number of observations, the model is reset.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CPhotometryObservationModel::addObjects(std::size_t count)
+    {
+      if (observations_ && (count != 0))
+      {
+        if (static_cast<std::size_t>(rowCount_) + count == observations_->size())
+        {
+          beginInsertRows(QModelIndex(), rowCount_, rowCount_ + static_cast<int>(count) - 1);
+          rowCount_ = static_cast<int>(observations_->size());
+          endInsertRows();
+        }
+        else
+        {
+          beginResetModel();
+          rowCount_ = static_cast<int>(observations_->size());
+          endResetModel();
+        };
+      };
+    }
+
+    /// @brief Returns the number of columns.
+    /// @returns The number of columns.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    int CPhotometryObservationModel::columnCount(QModelIndex const &parent) const
+    {
+      return (parent.isValid() ? 0 : COLUMN_COUNT);
+    }
+
+    /// @brief Returns the data to display.
+    /// @param[in] index: The cell.
+    /// @param[in] role: The role.
+    /// @returns The data for the cell.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    QVariant CPhotometryObservationModel::data(QModelIndex const &index, int role) const
+    {
+      QVariant returnValue;
+
+      if ( index.isValid() && (index.row() < rowCount_) && (role == Qt::DisplayRole) )
+      {
+        photometry::CPhotometryObservation const *photometryObservation = (*observations_)[index.row()].get();
+
+        switch (index.column())
+        {
+          case COLUMN_OBJECT:
+          {
+            returnValue = QString::fromStdString(photometryObservation->objectName());
+            break;
+          };
+          case COLUMN_MAGNITUDE:
+          {
+            if (photometryObservation->instrumentMagnitude())
+            {
+              returnValue = QString("%1").arg(zmag_ + *(photometryObservation->instrumentMagnitude()));
+            };
+            break;
+          };
+          case COLUMN_MAGNITUDEERROR:
+          {
+            returnValue = QString("%1").arg(photometryObservation->magnitudeError());
+            break;
+          };
+          default:
+          {
+            break;
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Returns the column headings.
+    /// @param[in] section: The column.
+    /// @param[in] orientation: The orientation of the header.
+    /// @param[in] role: The role.
+    /// @returns The heading.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    QVariant CPhotometryObservationModel::headerData(int section, Qt::Orientation orientation, int role) const
+    {
+      QVariant returnValue;
+
+      if ( (orientation == Qt::Horizontal) && (role == Qt::DisplayRole) )
+      {
+        switch (section)
+        {
+          case COLUMN_OBJECT:
+          {
+            returnValue = tr("Object");
+            break;
+          };
+          case COLUMN_MAGNITUDE:
+          {
+            returnValue = tr("Inst Mag");
+            break;
+          };
+          case COLUMN_MAGNITUDEERROR:
+          {
+            returnValue = tr("MagErr");
+            break;
+          };
+          default:
+          {
+            break;
+          };
+        };
+      };
+
+      if ( (orientation == Qt::Horizontal) && (role == Qt::FontRole) && boldColumn(section) )
+      {
+        returnValue = boldHeaderFont();
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Determines if the heading of a column is shown in bold.
+    /// @param[in] section: The column.
+    /// @returns true if the heading is bold.
+    /// @throws None.
+    /// @details Only the Object heading was bold in the table of the original photometry form (dwPhotometry.ui).
+    /// @version 2026-10-17/GGB - Function created.
+
+    bool CPhotometryObservationModel::boldColumn(int section)
+    {
+      return (section == COLUMN_OBJECT);
+    }
+
+    /// @brief Returns the observation displayed in a row.
+    /// @param[in] row: The row.
+    /// @returns The observation. nullptr if the row is not valid.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    photometry::CPhotometryObservation *CPhotometryObservationModel::observation(int row) const
+    {
+      photometry::CPhotometryObservation *returnValue = nullptr;
+
+      if ( (row >= 0) && (row < rowCount_) )
+      {
+        returnValue = (*observations_)[row].get();
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Called when the data of an observation has changed.
+    /// @param[in] row: The row of the observation.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CPhotometryObservationModel::objectChanged(int row)
+    {
+      if ( (row >= 0) && (row < rowCount_) )
+      {
+        emit dataChanged(index(row, 0), index(row, COLUMN_COUNT - 1));
+      };
+    }
+
+    /// @brief Sets the observations to display. The model is reset.
+    /// @param[in] observations: The observations. (nullptr if there are no observations to display)
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CPhotometryObservationModel::observations(photometry::DPhotometryObservationStore *observations)
+    {
+      beginResetModel();
+      observations_ = observations;
+      rowCount_ = observations_ ? static_cast<int>(observations_->size()) : 0;
+      endResetModel();
+    }
+
+    /// @brief Removes an observation from the store.
+    /// @param[in] row: The row of the observation.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CPhotometryObservationModel::removeObject(int row)
+    {
+      if ( (row >= 0) && (row < rowCount_) )
+      {
+        beginRemoveRows(QModelIndex(), row, row);
+        observations_->erase(observations_->begin() + row);
+        --rowCount_;
+        endRemoveRows();
+      };
+    }
+
+    /// @brief Returns the number of rows.
+    /// @returns The number of observations announced to the view.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    int CPhotometryObservationModel::rowCount(QModelIndex const &parent) const
+    {
+      return (parent.isValid() ? 0 : rowCount_);
+    }
+
+    /// @brief Sets the value added to the instrument magnitudes.
+    /// @param[in] zmag: The ZMAG value.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CPhotometryObservationModel::zmag(FP_t zmag)
+    {
+      zmag_ = zmag;
+
+      if (rowCount_ != 0)
+      {
+        emit dataChanged(index(0, COLUMN_MAGNITUDE), index(rowCount_ - 1, COLUMN_MAGNITUDE));
+      };
+    }
+
+  } // namespace dockwidgets
+} // namespace astroManager
@@ -0,0 +1,444 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								combineKernels
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Combine kernels for stacking. The values of a tile of output pixels are held frame interleaved (the values
+//                      of each pixel are contiguous), so each pixel is combined from one contiguous run of values. Small sets
+//                      of values are ordered with a sorting network, larger sets with nth_element. The sigma clip combine can
+//                      reject values around the median (MAD), with winsorized sigma clipping or with linear fit clipping.
+//
+// CLASSES INCLUDED:    CCombineTile
+//
+// CLASS HIERARCHY:     CCombineTile
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/combineKernels.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    FP_t const SIGMACLIP_KAPPA = 3;               ///< Values further than KAPPA standard deviations from the centre are rejected.
+    FP_t const MAD_TO_SIGMA = 1.4826;             ///< Converts the median absolute deviation to a standard deviation.
+    std::size_t const SIGMACLIP_ITERATIONS = 5;   ///< Maximum number of rejection passes.
+    FP_t const WINSORIZE_LIMIT = 1.5;             ///< Values are winsorized at LIMIT standard deviations from the median.
+    FP_t const WINSORIZE_CORRECTION = 1.134;      ///< Corrects the standard deviation of the winsorized values.
+    FP_t const WINSORIZE_TOLERANCE = 0.0005;      ///< Relative change of the standard deviation when winsorizing has converged.
+    std::size_t const WINSORIZE_ITERATIONS = 10;
+    std::size_t const LINEARFIT_MINIMUM = 6;      ///< Fewer values are not clipped by the linear fit.
+    std::size_t const SORTINGNETWORK_MAXIMUM = 16;  ///< Larger sets of values are ordered with nth_element.
+
+    /// @brief      Orders a small number of values. (Odd-even transposition sorting network)
+    /// @param[in]  values: The values to order.
+    /// @param[in]  count: The number of values.
+    /// @details    The network has no data dependent branches, so it is faster than a general sort for small counts.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static void sortingNetwork(float *values, std::size_t count)
+    {
+      for (std::size_t pass = 0; pass < count; ++pass)
+      {
+        for (std::size_t index = pass & 1; index + 1 < count; index += 2)
+        {
+          float lower = std::min(values[index], values[index + 1]);
+
+          values[index + 1] = std::max(values[index], values[index + 1]);
+          values[index] = lower;
+        };
+      };
+    }
+
+    /// @brief      Determines the median of the values.
+    /// @param[in]  values: The values. The values are reordered.
+    /// @param[in]  count: The number of values. Must be greater than zero.
+    /// @returns    The median value.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Use a sorting network for small counts.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static float medianValue(float *values, std::size_t count)
+    {
+      float returnValue;
+
+      if (count <= SORTINGNETWORK_MAXIMUM)
+      {
+        sortingNetwork(values, count);
+        returnValue = ((count % 2) == 0) ? (values[count / 2 - 1] + values[count / 2]) / 2 : values[count / 2];
+      }
+      else
+      {
+        float *middle = values + count / 2;
+
+        std::nth_element(values, middle, values + count);
+        returnValue = *middle;
+
+        if ((count % 2) == 0)
+        {
+          returnValue = (returnValue + *std::max_element(values, middle)) / 2;
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Determines the mean of the values.
+    /// @param[in]  values: The values.
+    /// @param[in]  count: The number of values. Must be greater than zero.
+    /// @returns    The mean.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static FP_t meanValue(float const *values, std::size_t count)
+    {
+      FP_t sum = 0;
+
+      for (std::size_t index = 0; index < count; ++index)
+      {
+        sum += values[index];
+      };
+
+      return sum / count;
+    }
+
+    /// @brief      Determines the standard deviation of the values. (Two pass)
+    /// @param[in]  values: The values.
+    /// @param[in]  count: The number of values. Must be greater than one.
+    /// @returns    The sample standard deviation.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static FP_t standardDeviation(float const *values, std::size_t count)
+    {
+      FP_t mean = meanValue(values, count);
+      FP_t sum = 0;
+
+      for (std::size_t index = 0; index < count; ++index)
+      {
+        sum += (values[index] - mean) * (values[index] - mean);
+      };
+
+      return std::sqrt(sum / (count - 1));
+    }
+
+    /// @brief      Moves the values within the limit of the centre to the front of the values.
+    /// @param[in]  values: The values.
+    /// @param[in]  count: The number of values.
+    /// @param[in]  centre: The centre of the values.
+    /// @param[in]  limit: The maximum deviation from the centre.
+    /// @returns    The number of values kept.
+    /// @details    The order of the values that are kept is not changed.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static std::size_t keepValues(float *values, std::size_t count, FP_t centre, FP_t limit)
+    {
+      std::size_t returnValue = 0;
+
+      for (std::size_t index = 0; index < count; ++index)
+      {
+        if (std::fabs(values[index] - centre) <= limit)
+        {
+          values[returnValue++] = values[index];
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Sigma clip around the median using the median absolute deviation.
+    /// @param[in]  values: The values. The values are reordered.
+    /// @param[in]  scratch: Working storage for count values.
+    /// @param[in]  count: The number of values.
+    /// @returns    The mean of the values that are not rejected.
+    /// @details    The median absolute deviation is used as the standard deviation of a small number of values is dominated by
+    ///             the values that should be rejected.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created. (Moved from CImageStacker::combine())
+
+    static float clipMAD(float *values, float *scratch, std::size_t count)
+    {
+      bool clipped = true;
+
+      for (std::size_t iteration = 0; (iteration < SIGMACLIP_ITERATIONS) && clipped && (count > 2); ++iteration)
+      {
+        float median = medianValue(values, count);
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+          scratch[index] = std::fabs(values[index] - median);
+        };
+
+        std::size_t kept = keepValues(values, count, median, SIGMACLIP_KAPPA * MAD_TO_SIGMA * medianValue(scratch, count));
+
+        clipped = (kept != count) && (kept != 0);
+        if (clipped)
+        {
+          count = kept;
+        };
+      };
+
+      return static_cast<float>(meanValue(values, count));
+    }
+
+    /// @brief      Winsorized sigma clip.
+    /// @param[in]  values: The values. The values are reordered.
+    /// @param[in]  scratch: Working storage for count values.
+    /// @param[in]  count: The number of values.
+    /// @returns    The mean of the values that are not rejected.
+    /// @details    The standard deviation is found from a copy of the values where the values further than WINSORIZE_LIMIT
+    ///             standard deviations from the median are replaced by the limit. This is repeated until the standard deviation
+    ///             converges. Values further than SIGMACLIP_KAPPA standard deviations from the median are then rejected.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static float clipWinsorized(float *values, float *scratch, std::size_t count)
+    {
+      bool clipped = true;
+
+      for (std::size_t iteration = 0; (iteration < SIGMACLIP_ITERATIONS) && clipped && (count > 2); ++iteration)
+      {
+        std::copy(values, values + count, scratch);
+
+        FP_t median = medianValue(scratch, count);
+        FP_t sigma = standardDeviation(values, count);
+        bool converged = (sigma == 0);
+
+        for (std::size_t winsorize = 0; (winsorize < WINSORIZE_ITERATIONS) && !converged; ++winsorize)
+        {
+          float lower = static_cast<float>(median - WINSORIZE_LIMIT * sigma);
+          float upper = static_cast<float>(median + WINSORIZE_LIMIT * sigma);
+
+          for (std::size_t index = 0; index < count; ++index)
+          {
+            scratch[index] = std::min(std::max(values[index], lower), upper);
+          };
+
+          FP_t winsorizedSigma = WINSORIZE_CORRECTION * standardDeviation(scratch, count);
+
+          converged = (std::fabs(winsorizedSigma - sigma) <= WINSORIZE_TOLERANCE * sigma);
+          sigma = winsorizedSigma;
+        };
+
+        std::size_t kept = keepValues(values, count, median, SIGMACLIP_KAPPA * sigma);
+
+        clipped = (kept != count) && (kept != 0);
+        if (clipped)
+        {
+          count = kept;
+        };
+      };
+
+      return static_cast<float>(meanValue(values, count));
+    }
+
+    /// @brief      Linear fit clip.
+    /// @param[in]  values: The values. The values are reordered.
+    /// @param[in]  count: The number of values.
+    /// @returns    The mean of the values that are not rejected.
+    /// @details    A line is fitted to the central half of the sorted values. (Value against rank) Values further than
+    ///             SIGMACLIP_KAPPA mean absolute deviations (of the central half) from the line are rejected. This handles
+    ///             gradients between the frames better than clipping around a single centre. Fitting only the central half stops
+    ///             the outliers from tilting the line.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static float clipLinearFit(float *values, std::size_t count)
+    {
+      bool clipped = true;
+
+      for (std::size_t iteration = 0; (iteration < SIGMACLIP_ITERATIONS) && clipped && (count >= LINEARFIT_MINIMUM); ++iteration)
+      {
+        std::size_t fitFirst = count / 4;
+        std::size_t fitCount = count - 2 * fitFirst;
+        FP_t rankMean = fitFirst + static_cast<FP_t>(fitCount - 1) / 2;
+        FP_t rankVariance = static_cast<FP_t>(fitCount) * (fitCount * fitCount - 1) / 12;    // Sum of (rank - rankMean)^2
+        FP_t valueMean;
+        FP_t slope = 0;
+        FP_t deviation = 0;
+        std::size_t kept = 0;
+
+        if (count <= SORTINGNETWORK_MAXIMUM)
+        {
+          sortingNetwork(values, count);
+        }
+        else
+        {
+          std::sort(values, values + count);
+        };
+
+        valueMean = meanValue(values + fitFirst, fitCount);
+        for (std::size_t index = fitFirst; index < fitFirst + fitCount; ++index)
+        {
+          slope += (index - rankMean) * values[index];
+        };
+        slope /= rankVariance;
+
+        for (std::size_t index = fitFirst; index < fitFirst + fitCount; ++index)
+        {
+          deviation += std::fabs(values[index] - (valueMean + slope * (index - rankMean)));
+        };
+        deviation /= fitCount;
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+          if (std::fabs(values[index] - (valueMean + slope * (index - rankMean))) <= SIGMACLIP_KAPPA * deviation)
+          {
+            values[kept++] = values[index];
+          };
+        };
+
+        clipped = (kept != count) && (kept != 0);
+        if (clipped)
+        {
+          count = kept;
+        };
+      };
+
+      return static_cast<float>(meanValue(values, count));
+    }
+
+    /// @brief      Combines the values of one output pixel.
+    /// @param[in]  values: The values from the frames that cover the pixel. The values are reordered.
+    /// @param[in]  scratch: Working storage for count values.
+    /// @param[in]  count: The number of values.
+    /// @param[in]  stackMode: The combine method.
+    /// @param[in]  rejection: The rejection used by the sigma clip combine.
+    /// @returns    The combined value. Zero if no frames cover the pixel.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Added the rejection. (Moved from CImageStacker::combine())
+    /// @version    2026-10-17/GGB - Function created.
+
+    float combineValues(float *values, float *scratch, std::size_t count, ACL::CImageStack::EStackMode stackMode,
+                        ERejection rejection)
+    {
+      float returnValue = 0;
+
+      if (count != 0)
+      {
+        switch (stackMode)
+        {
+          case ACL::CImageStack::SM_SUM:
+          {
+            returnValue = static_cast<float>(meanValue(values, count) * count);
+            break;
+          };
+          case ACL::CImageStack::SM_MEAN:
+          {
+            returnValue = static_cast<float>(meanValue(values, count));
+            break;
+          };
+          case ACL::CImageStack::SM_MEDIAN:
+          {
+            returnValue = medianValue(values, count);
+            break;
+          };
+          case ACL::CImageStack::SM_SIGMACLIP:
+          {
+            switch (rejection)
+            {
+              case RJ_WINSORIZED:
+              {
+                returnValue = clipWinsorized(values, scratch, count);
+                break;
+              };
+              case RJ_LINEARFIT:
+              {
+                returnValue = clipLinearFit(values, count);
+                break;
+              };
+              default:
+              {
+                returnValue = clipMAD(values, scratch, count);
+                break;
+              };
+            };
+            break;
+          };
+          default:
+          {
+            break;    // Checked by the callers.
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    //*****************************************************************************************************************************
+    //
+    // CCombineTile
+    //
+    //*****************************************************************************************************************************
+
+    /// @brief      Constructor for the class.
+    /// @param[in]  frameCount: The maximum number of values for each pixel. (The number of frames)
+    /// @param[in]  pixelCapacity: The maximum number of pixels in the tile.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    CCombineTile::CCombineTile(std::size_t frameCount, std::size_t pixelCapacity) : frameCount_(frameCount),
+      pixelCapacity_(pixelCapacity), values_(frameCount * pixelCapacity), counts_(pixelCapacity), scratch_(frameCount)
+    {
+    }
+
+    /// @brief      Starts a new tile. All the values are removed.
+    /// @param[in]  pixelCount: The number of pixels in the tile. Must not be more than the capacity.
+    /// @throws     GCL::CRuntimeAssert
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CCombineTile::clear(std::size_t pixelCount)
+    {
+      RUNTIME_ASSERT(pixelCount <= pixelCapacity_, "Parameter pixelCount is greater than the capacity of the tile.");
+
+      pixelCount_ = pixelCount;
+      std::fill(counts_.begin(), counts_.begin() + pixelCount, 0);
+    }
+
+    /// @brief      Combines the values of each pixel of the tile.
+    /// @param[in]  stackMode: The combine method.
+    /// @param[out] output: The combined pixels. (pixelCount values)
+    /// @param[in]  rejection: The rejection used by the sigma clip combine.
+    /// @details    The values of the tile are reordered.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CCombineTile::combine(ACL::CImageStack::EStackMode stackMode, float *output, ERejection rejection)
+    {
+      for (std::size_t pixel = 0; pixel < pixelCount_; ++pixel)
+      {
+        output[pixel] = combineValues(values_.data() + pixel * frameCount_, scratch_.data(), counts_[pixel], stackMode, rejection);
+      };
+    }
+
+  } // namespace imaging
+} // namespace astroManager
@@ -0,0 +1,359 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								displayRenderer
+// SUBSYSTEM:						Rendering of images for display.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Implements the display stretch of images.
+//
+// CLASSES INCLUDED:    SDisplayStretch, CDisplayRenderer
+//
+// CLASS HIERARCHY:     CDisplayRenderer
+//
+// HISTORY:             2026-10-17 GGB - Logarithmic and sigmoid functions are left to ACL.
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/displayRenderer.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    std::size_t const CHUNK_SIZE = 1024;          ///< Number of pixels converted to LUT indexes at a time.
+
+    //*****************************************************************************************************************************
+    //
+    // SDisplayStretch
+    //
+    //*****************************************************************************************************************************
+
+    /// @brief      Equality operator.
+    /// @param[in]  rhs: The stretch to compare against.
+    /// @returns    true if the stretches are the same.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool SDisplayStretch::operator==(SDisplayStretch const &rhs) const noexcept
+    {
+      return ( (blackPoint == rhs.blackPoint) && (whitePoint == rhs.whitePoint) && (invert == rhs.invert) &&
+               (transferFunction == rhs.transferFunction) && (gamma == rhs.gamma) );
+    }
+
+    //*****************************************************************************************************************************
+    //
+    // CDisplayRenderer
+    //
+    //*****************************************************************************************************************************
+
+    /// @brief      Constructor for the class.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    CDisplayRenderer::CDisplayRenderer() : lut_(LUT_SIZE, 0), lutValid_(false), lutStretch_(),
+      lutPixelType_(CPixelBuffer::PT_FLOAT), renderedBuffer_(), renderedStretch_(), renderedKey_(0)
+    {
+    }
+
+    /// @brief      Builds the look-up table for the stretch.
+    /// @param[in]  pixelType: The type of the pixel data.
+    /// @param[in]  stretch: The stretch to apply.
+    /// @details    For 16 bit data the LUT is indexed by the pixel value. For floating point data the LUT covers the range from
+    ///             the black point to the white point.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CDisplayRenderer::buildLUT(CPixelBuffer::EPixelType pixelType, SDisplayStretch const &stretch)
+    {
+      FP_t range = std::max(stretch.whitePoint - stretch.blackPoint, std::numeric_limits<FP_t>::epsilon());
+
+      for (std::size_t index = 0; index < LUT_SIZE; ++index)
+      {
+        FP_t value;
+
+        if (pixelType == CPixelBuffer::PT_UINT16)
+        {
+          value = std::min(std::max((static_cast<FP_t>(index) - stretch.blackPoint) / range, FP_t(0)), FP_t(1));
+        }
+        else
+        {
+          value = static_cast<FP_t>(index) / (LUT_SIZE - 1);
+        };
+
+        value = transfer(value, stretch);
+
+        if (stretch.invert)
+        {
+          value = 1 - value;
+        };
+
+        lut_[index] = static_cast<std::uint8_t>(std::lround(std::min(std::max(value, FP_t(0)), FP_t(1)) * 255));
+      };
+
+      lutPixelType_ = pixelType;
+      lutStretch_ = stretch;
+      lutValid_ = true;
+    }
+
+    /// @brief      Renders the pixel buffer into the display image.
+    /// @param[in]  buffer: The pixel buffer to render.
+    /// @param[in]  stretch: The stretch to apply.
+    /// @param[in]  image: The output image. Mono buffers are rendered into a greyscale Format_Indexed8 image, poly buffers into a
+    ///             Format_RGB32 image. The image is reallocated if it does not have the size and format required for the buffer.
+    /// @returns    true if the image was rendered. false if the image already contains the render.
+    /// @details    The same stretch is applied to each of the colour planes.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Added rendering of poly (RGB) buffers.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CDisplayRenderer::render(std::shared_ptr<CPixelBuffer const> const &buffer, SDisplayStretch const &stretch, QImage &image)
+    {
+      bool returnValue = false;
+      QImage::Format format;
+
+      RUNTIME_ASSERT(buffer, "Parameter buffer cannot be nullptr");
+
+      format = (buffer->planes() == 1) ? QImage::Format_Indexed8 : QImage::Format_RGB32;
+
+      if ( (image.format() != format) || (static_cast<std::size_t>(image.width()) != buffer->width()) ||
+           (static_cast<std::size_t>(image.height()) != buffer->height()) )
+      {
+        image = QImage(static_cast<int>(buffer->width()), static_cast<int>(buffer->height()), format);
+
+        if (format == QImage::Format_Indexed8)
+        {
+          image.setColorCount(256);
+
+          for (int index = 0; index <= 255; index++)
+          {
+            image.setColor(index, qRgb(index, index, index));
+          };
+        };
+      };
+
+      if ( (renderedBuffer_.lock() != buffer) || (renderedStretch_ != stretch) || (renderedKey_ != image.cacheKey()) )
+      {
+        if (!lutValid_ || (lutPixelType_ != buffer->pixelType()) || (lutStretch_ != stretch))
+        {
+          buildLUT(buffer->pixelType(), stretch);
+        };
+
+          // bits() detaches the image. It must be called before the threads are started.
+
+        uchar *bits = image.bits();
+        std::size_t bytesPerLine = static_cast<std::size_t>(image.bytesPerLine());
+        std::uint8_t const *lut = lut_.data();
+        std::size_t width = buffer->width();
+        float blackPoint = static_cast<float>(stretch.blackPoint);
+        float scale = static_cast<float>((LUT_SIZE - 1) /
+                                         std::max(stretch.whitePoint - stretch.blackPoint, std::numeric_limits<FP_t>::epsilon()));
+
+        if (format == QImage::Format_Indexed8)
+        {
+          parallelFor(buffer->height(), [&](std::size_t rowBegin, std::size_t rowEnd)
+          {
+            for (std::size_t row = rowBegin; row < rowEnd; ++row)
+            {
+              stretchRow(*buffer, row, 0, lut, blackPoint, scale, bits + row * bytesPerLine);
+            };
+          });
+        }
+        else
+        {
+          parallelFor(buffer->height(), [&](std::size_t rowBegin, std::size_t rowEnd)
+          {
+            std::vector<std::uint8_t> red(width), green(width), blue(width);
+
+            for (std::size_t row = rowBegin; row < rowEnd; ++row)
+            {
+              std::uint32_t *output = reinterpret_cast<std::uint32_t *>(bits + row * bytesPerLine);
+              std::uint8_t const *r = red.data();
+              std::uint8_t const *g = green.data();
+              std::uint8_t const *b = blue.data();
+
+              stretchRow(*buffer, row, 0, lut, blackPoint, scale, red.data());
+              stretchRow(*buffer, row, 1, lut, blackPoint, scale, green.data());
+              stretchRow(*buffer, row, 2, lut, blackPoint, scale, blue.data());
+
+                // Interleave the planes. (Same layout as qRgb(), written so that the compiler can vectorise the loop)
+
+              for (std::size_t column = 0; column < width; ++column)
+              {
+                output[column] = 0xFF000000u | (std::uint32_t(r[column]) << 16) | (std::uint32_t(g[column]) << 8) |
+                                 std::uint32_t(b[column]);
+              };
+            };
+          });
+        };
+
+        renderedBuffer_ = buffer;
+        renderedStretch_ = stretch;
+        renderedKey_ = image.cacheKey();
+        returnValue = true;
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Determines if the renderer reproduces the ACL rendering of a transfer function.
+    /// @param[in]  transferFunction: The transfer function.
+    /// @returns    true if the look-up table gives the same result as the ACL rendering.
+    /// @details    The logarithmic and sigmoid functions are not reproduced, as their scaling is internal to ACL. Monochrome
+    ///             images with these functions must be rendered by ACL.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CDisplayRenderer::rendersTransfer(ACL::ETransferFunction transferFunction) noexcept
+    {
+      bool returnValue;
+
+      switch (transferFunction)
+      {
+        case ACL::ETF_LINEAR:
+        case ACL::ETF_GAMMA:
+        case ACL::ETF_SQRT:
+        case ACL::ETF_CBRT:
+        case ACL::ETF_SQUARE:
+        {
+          returnValue = true;
+          break;
+        };
+        default:
+        {
+          returnValue = false;
+          break;
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Applies the look-up table to one row of one plane of the buffer.
+    /// @param[in]  buffer: The pixel buffer.
+    /// @param[in]  row: The row to stretch.
+    /// @param[in]  plane: The plane to stretch.
+    /// @param[in]  lut: The look-up table.
+    /// @param[in]  blackPoint: The black point. (Floating point data only)
+    /// @param[in]  scale: The scale from (value - blackPoint) to the LUT index. (Floating point data only)
+    /// @param[out] output: The 8 bit output values. (buffer.width() values)
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created. (Code moved from render())
+
+    void CDisplayRenderer::stretchRow(CPixelBuffer const &buffer, std::size_t row, std::size_t plane, std::uint8_t const *lut,
+                                      float blackPoint, float scale, std::uint8_t *output)
+    {
+      std::size_t width = buffer.width();
+
+      if (buffer.pixelType() == CPixelBuffer::PT_UINT16)
+      {
+        std::uint16_t const *input = buffer.row16(row, plane);
+
+        for (std::size_t column = 0; column < width; ++column)
+        {
+          output[column] = lut[input[column]];
+        };
+      }
+      else
+      {
+        float const *input = buffer.rowFloat(row, plane);
+        float const maxIndex = static_cast<float>(LUT_SIZE - 1);
+        std::uint16_t indexes[CHUNK_SIZE];
+
+        for (std::size_t chunkStart = 0; chunkStart < width; chunkStart += CHUNK_SIZE)
+        {
+          std::size_t chunkSize = std::min(CHUNK_SIZE, width - chunkStart);
+
+            // Branch free, so that the compiler can vectorise the loop. NaN values map to the black point.
+
+          for (std::size_t index = 0; index < chunkSize; ++index)
+          {
+            float value = (input[chunkStart + index] - blackPoint) * scale;
+
+            value = (value > 0.0f) ? value : 0.0f;
+            value = (value < maxIndex) ? value : maxIndex;
+            indexes[index] = static_cast<std::uint16_t>(value);
+          };
+
+          for (std::size_t index = 0; index < chunkSize; ++index)
+          {
+            output[chunkStart + index] = lut[indexes[index]];
+          };
+        };
+      };
+    }
+
+    /// @brief      Applies the transfer function to a normalised value.
+    /// @param[in]  value: The normalised value. (0 = black point, 1 = white point)
+    /// @param[in]  stretch: The stretch to apply.
+    /// @returns    The transformed value. (0-1)
+    /// @details    Transfer functions that are not reproduced (see rendersTransfer()) are rendered linearly. This only applies to
+    ///             poly images and previews, as ACL renders monochrome images with these functions.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Removed the approximations of the logarithmic and sigmoid functions.
+    /// @version    2026-10-17/GGB - Function created.
+
+    FP_t CDisplayRenderer::transfer(FP_t value, SDisplayStretch const &stretch)
+    {
+      FP_t gamma = (stretch.gamma > 0) ? stretch.gamma : 1;
+
+      switch (stretch.transferFunction)
+      {
+        case ACL::ETF_GAMMA:
+        {
+          value = std::pow(value, 1 / gamma);
+          break;
+        };
+        case ACL::ETF_SQRT:
+        {
+          value = std::sqrt(value);
+          break;
+        };
+        case ACL::ETF_CBRT:
+        {
+          value = std::cbrt(value);
+          break;
+        };
+        case ACL::ETF_SQUARE:
+        {
+          value = value * value;
+          break;
+        };
+        case ACL::ETF_LINEAR:
+        default:
+        {
+          break;
+        };
+      };
+
+      return value;
+    }
+
+  } // namespace imaging
+} // namespace astroManager
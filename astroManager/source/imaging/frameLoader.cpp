@@ -0,0 +1,428 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								frameLoader
+// SUBSYSTEM:						Image loading.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Loads a list of frames concurrently. Requests are queued and decoded on the global thread pool. The number of
+//                      frames being decoded is limited by the number of threads and by a memory budget, so that long lists of
+//                      frames do not exhaust memory. Completed frames are handed back on the GUI thread by signals, in the order
+//                      that they finish.
+//
+// CLASSES INCLUDED:    CFrameLoader
+//
+// CLASS HIERARCHY:     QObject
+//                        - CFrameLoader
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/frameLoader.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+
+  // astroManager header files
+
+#include "include/error.h"
+#include "include/settings.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    /// @brief Constructor for the class.
+    /// @param[in] parent: The parent (owner) of the loader. This is also used as the parent of the astroFiles that are created.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    CFrameLoader::CFrameLoader(QWidget *parent) : QObject(parent), parentWidget_(parent),
+      memoryBudget_(settings::astroManagerSettings->value(settings::IMAGING_LOAD_MEMORYBUDGET, QVariant(512)).toULongLong() *
+                    1024 * 1024)
+    {
+    }
+
+    /// @brief Destructor for the class.
+    /// @details Any frames that are still being loaded are cancelled. The workers hold their own references to the astroFile and
+    ///          load state, so the loader can be destroyed while the workers are still running.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    CFrameLoader::~CFrameLoader()
+    {
+      cancelAll();
+    }
+
+    /// @brief Queues a frame to be loaded from a file.
+    /// @param[in] key: The key used to identify the frame in the signals and in takeFrame().
+    /// @param[in] fileName: The file to load.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::addFile(quint64 key, boost::filesystem::path const &fileName)
+    {
+      SRequest request;
+
+      request.key = key;
+      request.fileName = fileName;
+
+      addRequest(std::move(request));
+    }
+
+    /// @brief Queues a frame to be loaded from the database.
+    /// @param[in] key: The key used to identify the frame in the signals and in takeFrame().
+    /// @param[in] imageID: The ID of the image to load.
+    /// @param[in] imageVersion: The version of the image to load.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::addImage(quint64 key, database::imageID_t imageID, database::imageVersion_t imageVersion)
+    {
+      SRequest request;
+
+      request.key = key;
+      request.imageID = imageID;
+      request.imageVersion = imageVersion;
+
+      addRequest(std::move(request));
+    }
+
+    /// @brief Adds a request to the queue and starts loading if there is capacity available.
+    /// @param[in] request: The request to add.
+    /// @note frameFailed() may be emitted before this function returns if the file cannot be opened.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::addRequest(SRequest &&request)
+    {
+      RUNTIME_ASSERT(!isPending(request.key), "Frame has already been requested.");
+
+      loadedFrames_.erase(request.key);
+      requestQueue_.push_back(std::move(request));
+
+      startLoads();
+
+      if (pendingCount() == 0)
+      {
+        emit finished();      // The frames could not be opened.
+      };
+    }
+
+    /// @brief Cancels the load of a frame.
+    /// @param[in] key: The key of the frame to cancel.
+    /// @details If the frame is being decoded, the worker is left to finish and the result is discarded. A loaded frame that has
+    ///          not been taken is released. No signals are emitted for a cancelled frame.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::cancel(quint64 key) noexcept
+    {
+      requestQueue_.erase(std::remove_if(requestQueue_.begin(), requestQueue_.end(),
+                                         [key] (SRequest const &request) { return request.key == key; }),
+                          requestQueue_.end());
+
+      auto iter = inFlight_.find(key);
+
+      if (iter != inFlight_.end())
+      {
+        iter->second.loadState->cancelled = true;
+        iter->second.futureWatcher->disconnect(this);
+        iter->second.futureWatcher->deleteLater();
+        memoryInFlight_ -= iter->second.memoryEstimate;
+        inFlight_.erase(iter);
+      };
+
+      loadedFrames_.erase(key);
+    }
+
+    /// @brief Cancels all the frames that are queued or being loaded and releases any frames that have not been taken.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::cancelAll() noexcept
+    {
+      requestQueue_.clear();
+
+      for (auto &load : inFlight_)
+      {
+        load.second.loadState->cancelled = true;
+        load.second.futureWatcher->disconnect(this);
+        load.second.futureWatcher->deleteLater();
+      };
+
+      inFlight_.clear();
+      memoryInFlight_ = 0;
+      loadedFrames_.clear();
+    }
+
+    /// @brief Converts a captured exception into text that can be displayed to the user.
+    /// @param[in] exception: The exception captured by the worker.
+    /// @returns The error text.
+    /// @throws GCL::CCodeError
+    /// @throws GCL::CRuntimeAssert
+    /// @version 2026-10-17/GGB - Function created.
+
+    QString CFrameLoader::errorText(std::exception_ptr exception) const
+    {
+      QString returnValue;
+
+      try
+      {
+        std::rethrow_exception(exception);
+      }
+      catch (GCL::CCodeError &)
+      {
+        throw;    // Propagate code errors.
+      }
+      catch (GCL::CRuntimeAssert &)
+      {
+        throw;    // Propagate runtime assertions.
+      }
+      catch (GCL::CError &error)
+      {
+        returnValue = QString::fromStdString(std::to_string(error.errorCode()) + " - " + error.errorMessage());
+      }
+      catch (ACL::CFITSException &error)
+      {
+        returnValue = QString::fromStdString(error.errorMessage());
+      }
+      catch (std::exception &error)
+      {
+        returnValue = QString::fromStdString(error.what());
+      }
+      catch (...)
+      {
+        returnValue = tr("Unknown exception while loading the frame.");
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Called on the GUI thread when a worker has finished.
+    /// @details The load is completed on the GUI thread (database access) and the frame is made available through takeFrame().
+    ///          Further loads are then started. finished() is emitted when there are no more frames to load.
+    /// @throws GCL::CCodeError
+    /// @throws GCL::CRuntimeAssert
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::eventLoadFinished()
+    {
+      QObject *futureWatcher = sender();
+      auto iter = std::find_if(inFlight_.begin(), inFlight_.end(),
+                               [futureWatcher] (std::pair<quint64 const, SLoad> const &load)
+                               { return load.second.futureWatcher == futureWatcher; });
+
+      if (iter != inFlight_.end())
+      {
+        quint64 key = iter->first;
+        std::shared_ptr<CAstroFile> astroFile = iter->second.astroFile;
+        std::exception_ptr exception = iter->second.loadState->exception;
+
+        iter->second.futureWatcher->deleteLater();
+        memoryInFlight_ -= iter->second.memoryEstimate;
+        inFlight_.erase(iter);
+
+        if (!exception)
+        {
+          try
+          {
+            astroFile->completeLoad();
+          }
+          catch(...)
+          {
+            exception = std::current_exception();
+          };
+        };
+
+        startLoads();
+
+        if (exception)
+        {
+          QString message = errorText(exception);
+
+          WARNINGMESSAGE("Error loading frame: " + message.toStdString());
+          emit frameFailed(key, message);
+        }
+        else
+        {
+          loadedFrames_[key] = astroFile;
+          emit frameLoaded(key);
+        };
+
+        if (pendingCount() == 0)
+        {
+          emit finished();
+        };
+      };
+    }
+
+    /// @brief Determines if a frame is queued or being loaded.
+    /// @param[in] key: The key of the frame.
+    /// @returns true if the frame is queued or being loaded.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    bool CFrameLoader::isPending(quint64 key) const
+    {
+      return ( (inFlight_.find(key) != inFlight_.end()) ||
+               std::any_of(requestQueue_.begin(), requestQueue_.end(),
+                           [key] (SRequest const &request) { return request.key == key; }) );
+    }
+
+    /// @brief Moves a queued frame to the front of the queue. Used when the user needs a frame before the others.
+    /// @param[in] key: The key of the frame.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::prioritise(quint64 key)
+    {
+      auto iter = std::find_if(requestQueue_.begin(), requestQueue_.end(),
+                               [key] (SRequest const &request) { return request.key == key; });
+
+      if (iter != requestQueue_.end())
+      {
+        std::rotate(requestQueue_.begin(), iter, std::next(iter));
+      };
+    }
+
+    /// @brief Starts the load of a single frame on the global thread pool.
+    /// @param[in] request: The frame to load.
+    /// @details The astroFile is constructed on the GUI thread. (Images in the database are downloaded during construction.)
+    ///          The worker decodes the image data and calculates the statistics that are needed to display the image. Exceptions
+    ///          are captured and reported on the GUI thread.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::startLoad(SRequest const &request)
+    {
+      SLoad load;
+
+      try
+      {
+        if (request.fileName.empty())
+        {
+          load.astroFile = std::make_shared<CAstroFile>(parentWidget_, request.imageID, request.imageVersion,
+                                                        CAstroFile::LM_DEFERRED, CAstroFile::HS_PRIMARY);
+        }
+        else
+        {
+          load.astroFile = std::make_shared<CAstroFile>(parentWidget_, request.fileName, CAstroFile::LM_DEFERRED,
+                                                        CAstroFile::HS_PRIMARY);
+        };
+      }
+      catch (std::bad_alloc &)
+      {
+        throw;
+      }
+      catch(...)
+      {
+        QString message = errorText(std::current_exception());
+
+        WARNINGMESSAGE("Error loading frame: " + message.toStdString());
+        emit frameFailed(request.key, message);
+        return;
+      };
+
+      std::shared_ptr<CAstroFile> astroFile = load.astroFile;
+      std::shared_ptr<SLoadState> loadState = std::make_shared<SLoadState>();
+
+      load.loadState = loadState;
+      load.memoryEstimate = astroFile->encodedSize() * DECODE_FACTOR;
+      load.futureWatcher = new QFutureWatcher<void>(this);
+      connect(load.futureWatcher, SIGNAL(finished()), this, SLOT(eventLoadFinished()));
+
+      memoryInFlight_ += load.memoryEstimate;
+
+      QFutureWatcher<void> *futureWatcher = load.futureWatcher;
+      inFlight_.emplace(request.key, std::move(load));
+
+      futureWatcher->setFuture(QtConcurrent::run([astroFile, loadState]()
+      {
+        if (loadState->cancelled)
+        {
+          return;
+        };
+
+        try
+        {
+          astroFile->loadData();
+
+          if (!loadState->cancelled && astroFile->HDBCount() != 0 && astroFile->HDBType(0) == ACL::BT_IMAGE)
+          {
+            astroFile->imageMin(0);
+            astroFile->imageMax(0);
+            astroFile->blackPoint();
+            astroFile->whitePoint();
+          };
+        }
+        catch(...)
+        {
+          loadState->exception = std::current_exception();
+        };
+      }));
+    }
+
+    /// @brief Starts loading queued frames while there is capacity available.
+    /// @details A frame is started if there is a free thread and the memory used by the frames being decoded is below the budget.
+    ///          The memory used may therefore exceed the budget by one frame. At least one frame is always loaded so that frames
+    ///          larger than the budget can be loaded.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CFrameLoader::startLoads()
+    {
+      std::size_t threadCount = static_cast<std::size_t>(std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
+
+      while (!requestQueue_.empty() && (inFlight_.size() < threadCount) && (inFlight_.empty() || memoryInFlight_ < memoryBudget_))
+      {
+        SRequest request = std::move(requestQueue_.front());
+        requestQueue_.pop_front();
+
+        startLoad(request);
+      };
+    }
+
+    /// @brief Returns a loaded frame and removes it from the loader.
+    /// @param[in] key: The key of the frame.
+    /// @returns The loaded frame. nullptr if the frame has not been loaded.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    std::shared_ptr<CAstroFile> CFrameLoader::takeFrame(quint64 key)
+    {
+      std::shared_ptr<CAstroFile> returnValue;
+      auto iter = loadedFrames_.find(key);
+
+      if (iter != loadedFrames_.end())
+      {
+        returnValue = std::move(iter->second);
+        loadedFrames_.erase(iter);
+      };
+
+      return returnValue;
+    }
+
+  } // namespace imaging
+} // namespace astroManager
@@ -0,0 +1,450 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								imageCalibrator
+// SUBSYSTEM:						Image calibration.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Calibrates images using master bias, dark and flat frames. The master frames are read once and are then shared
+//                      (read only) by all the images being calibrated, so calibrateFile() can be called concurrently from a
+//                      number of threads. Each call reads an image, applies the master frames and writes the calibrated image.
+//
+// CLASSES INCLUDED:    CImageCalibrator
+//
+// CLASS HIERARCHY:     CImageCalibrator
+//
+// HISTORY:             2026-10-17 GGB - Master darks may have the bias subtracted. (BIASSUB keyword.)
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/imageCalibrator.h"
+
+  // Standard C++ library header files
+
+#include <cmath>
+#include <limits>
+
+  // Miscellaneous library header files.
+
+#include "boost/locale.hpp"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    /// @brief      Applies the master frames to an image.
+    /// @param[in]  imageData: The image data. The calibrated values are returned in the same storage.
+    /// @param[in]  exposure: The exposure time (s) of the image. Zero if not known.
+    /// @details    The bias is subtracted. The dark current is scaled by the ratio of the exposure times and subtracted. If the
+    ///             master dark has had the bias subtracted (BIASSUB = T) it is the dark current, otherwise the dark current is
+    ///             (dark - bias). If there is no master bias, a dark frame that contains the bias cannot be scaled, so it is
+    ///             subtracted without scaling, while a dark frame without the bias is scaled and the bias remains in the image.
+    ///             The image is then divided by the normalised flat.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Use the BIASSUB state of the master dark.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageCalibrator::applyMasters(std::vector<float> &imageData, FP_t exposure) const
+    {
+      std::size_t const pixelCount = imageData.size();
+      float *image = imageData.data();
+
+      float darkScale = 1;
+
+      if (masterDark_ && (exposure > 0) && (masterDark_->exposure > 0) )
+      {
+        darkScale = static_cast<float>(exposure / masterDark_->exposure);
+      };
+
+      if (masterBias_ && masterDark_ && masterDark_->biasSubtracted)
+      {
+        float const *bias = masterBias_->data.data();
+        float const *dark = masterDark_->data.data();
+
+        for (std::size_t index = 0; index < pixelCount; ++index)
+        {
+          image[index] -= bias[index] + darkScale * dark[index];
+        };
+      }
+      else if (masterBias_ && masterDark_)
+      {
+        float const *bias = masterBias_->data.data();
+        float const *dark = masterDark_->data.data();
+
+        for (std::size_t index = 0; index < pixelCount; ++index)
+        {
+          image[index] -= bias[index] + darkScale * (dark[index] - bias[index]);
+        };
+      }
+      else if (masterBias_)
+      {
+        float const *bias = masterBias_->data.data();
+
+        for (std::size_t index = 0; index < pixelCount; ++index)
+        {
+          image[index] -= bias[index];
+        };
+      }
+      else if (masterDark_)
+      {
+        float const *dark = masterDark_->data.data();
+
+        if (!masterDark_->biasSubtracted)
+        {
+          darkScale = 1;
+        };
+
+        for (std::size_t index = 0; index < pixelCount; ++index)
+        {
+          image[index] -= darkScale * dark[index];
+        };
+      };
+
+      if (masterFlat_)
+      {
+        float const *flat = masterFlat_->data.data();
+
+        for (std::size_t index = 0; index < pixelCount; ++index)
+        {
+          image[index] *= flat[index];
+        };
+      };
+    }
+
+    /// @brief      Calibrates an image file and writes the calibrated image to the output file.
+    /// @param[in]  inputFile: The image to calibrate. The image in the primary HDU is calibrated.
+    /// @param[in]  outputFile: The file to write the calibrated image to. May be the same as the input file.
+    /// @returns    true if the image was calibrated. false if the output file exists and overwriting is not allowed.
+    /// @details    The calibrated image is written as 32 bit floating point data. The descriptive keywords of the input image
+    ///             are copied. The image is written to a temporary file which replaces the output file once it is complete, so an
+    ///             existing output file is not damaged if there is an error. If required, the existing output file is kept as a
+    ///             backup and the original image is saved as an extension.
+    ///             This function does not change the calibrator and may be called concurrently.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     boost::filesystem::filesystem_error
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CImageCalibrator::calibrateFile(boost::filesystem::path const &inputFile, boost::filesystem::path const &outputFile) const
+    {
+      bool returnValue = false;
+
+      if (overwrite_ || !boost::filesystem::exists(outputFile))
+      {
+        boost::filesystem::path temporaryFile(outputFile.string() + ".tmp");
+        fitsfile *inputFITS = nullptr;
+        fitsfile *outputFITS = nullptr;
+        int status = 0;
+        std::size_t width, height;
+        std::vector<float> imageData;
+        int keywordCount;
+        char card[FLEN_CARD];
+
+        try
+        {
+          CFITSIO_TEST(fits_open_diskfile, &inputFITS, inputFile.string().c_str(), READONLY);
+          readImage(inputFITS, width, height, imageData);
+
+          checkSize(masterBias_, width, height);
+          checkSize(masterDark_, width, height);
+          checkSize(masterFlat_, width, height);
+
+          applyMasters(imageData, readExposure(inputFITS));
+
+          long naxes[2] = {static_cast<long>(width), static_cast<long>(height)};
+          long firstPixel[2] = {1, 1};
+
+          boost::filesystem::remove(temporaryFile);
+          CFITSIO_TEST(fits_create_diskfile, &outputFITS, temporaryFile.string().c_str());
+          CFITSIO_TEST(fits_create_img, outputFITS, FLOAT_IMG, 2, naxes);
+          CFITSIO_TEST(fits_write_pix, outputFITS, TFLOAT, firstPixel, static_cast<LONGLONG>(imageData.size()), imageData.data());
+
+            // Copy the descriptive keywords. Structural, scaling, range and checksum keywords do not apply to the output.
+
+          CFITSIO_TEST(fits_get_hdrspace, inputFITS, &keywordCount, nullptr);
+
+          for (int keyword = 1; keyword <= keywordCount; ++keyword)
+          {
+            CFITSIO_TEST(fits_read_record, inputFITS, keyword, card);
+
+            int keywordClass = fits_get_keyclass(card);
+
+            if ( (keywordClass >= TYP_UNIT_KEY) && (keywordClass != TYP_CKSUM_KEY) )
+            {
+              CFITSIO_TEST(fits_write_record, outputFITS, card);
+            };
+          };
+
+          CFITSIO_TEST(fits_write_history, outputFITS, "Calibrated by astroManager.");
+
+          if (saveOriginal_)
+          {
+            CFITSIO_TEST(fits_copy_hdu, inputFITS, outputFITS, 0);
+            CFITSIO_TEST(fits_update_key, outputFITS, TSTRING, "EXTNAME", const_cast<char *>("ORIGINAL"),
+                         "Image before calibration");
+          };
+
+          CFITSIO_TEST(fits_close_file, outputFITS);
+          outputFITS = nullptr;
+          CFITSIO_TEST(fits_close_file, inputFITS);
+          inputFITS = nullptr;
+
+          if (boost::filesystem::exists(outputFile))
+          {
+            if (backup_)
+            {
+              boost::filesystem::path backupFile(outputFile.string() + ".bak");
+
+              boost::filesystem::remove(backupFile);
+              boost::filesystem::rename(outputFile, backupFile);
+            }
+            else
+            {
+              boost::filesystem::remove(outputFile);
+            };
+          };
+
+          boost::filesystem::rename(temporaryFile, outputFile);
+          returnValue = true;
+        }
+        catch(...)
+        {
+          status = 0;
+
+          if (outputFITS)
+          {
+            fits_close_file(outputFITS, &status);
+          };
+          if (inputFITS)
+          {
+            fits_close_file(inputFITS, &status);
+          };
+
+          boost::system::error_code errorCode;
+          boost::filesystem::remove(temporaryFile, errorCode);
+          throw;
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Checks that a master frame matches the size of the image being calibrated.
+    /// @param[in]  masterFrame: The master frame. Not checked if there is no master frame.
+    /// @param[in]  width: The width of the image.
+    /// @param[in]  height: The height of the image.
+    /// @throws     GCL::CRuntimeError
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageCalibrator::checkSize(std::optional<SMasterFrame> const &masterFrame, std::size_t width, std::size_t height)
+    {
+      if (masterFrame && ( (masterFrame->width != width) || (masterFrame->height != height) ))
+      {
+        RUNTIME_ERROR(boost::locale::translate("Image calibration: The master frame and the image are different sizes."));
+      };
+    }
+
+    /// @brief      Reads the master bias frame.
+    /// @param[in]  fileName: The master bias frame.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageCalibrator::masterBias(boost::filesystem::path const &fileName)
+    {
+      masterBias_ = readMasterFrame(fileName);
+    }
+
+    /// @brief      Reads the master dark frame.
+    /// @param[in]  fileName: The master dark frame.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageCalibrator::masterDark(boost::filesystem::path const &fileName)
+    {
+      masterDark_ = readMasterFrame(fileName);
+    }
+
+    /// @brief      Reads the master flat frame.
+    /// @param[in]  fileName: The master flat frame.
+    /// @details    The flat is normalised to a mean of one and the reciprocal is stored, so the images can be multiplied rather
+    ///             than divided. Pixels that are not positive (or are null) are not corrected.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageCalibrator::masterFlat(boost::filesystem::path const &fileName)
+    {
+      SMasterFrame masterFrame = readMasterFrame(fileName);
+      FP_t sum = 0;
+      std::size_t count = 0;
+
+      for (float value : masterFrame.data)
+      {
+        if (value > 0)      // false for NaN.
+        {
+          sum += value;
+          ++count;
+        };
+      };
+
+      if (count == 0)
+      {
+        RUNTIME_ERROR(boost::locale::translate("Image calibration: The master flat frame has no valid pixels."));
+      };
+
+      float mean = static_cast<float>(sum / static_cast<FP_t>(count));
+
+      for (float &value : masterFrame.data)
+      {
+        value = (value > 0) ? (mean / value) : 1;
+      };
+
+      masterFlat_ = std::move(masterFrame);
+    }
+
+    /// @brief      Sets the options for writing the output files.
+    /// @param[in]  overwrite: Overwrite existing output files.
+    /// @param[in]  backup: Keep an existing output file as a backup (.bak) when it is overwritten.
+    /// @param[in]  saveOriginal: Save the original image as an extension in the output file.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageCalibrator::options(bool overwrite, bool backup, bool saveOriginal) noexcept
+    {
+      overwrite_ = overwrite;
+      backup_ = backup;
+      saveOriginal_ = saveOriginal;
+    }
+
+    /// @brief      Reads the exposure time of an image.
+    /// @param[in]  fitsFile: The open file.
+    /// @returns    The exposure time (s). Zero if the image does not have an exposure time.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    FP_t CImageCalibrator::readExposure(fitsfile *fitsFile)
+    {
+      double returnValue = 0;
+      int status = 0;
+
+      if (fits_read_key(fitsFile, TDOUBLE, "EXPOSURE", &returnValue, nullptr, &status))
+      {
+        status = 0;
+        returnValue = 0;
+
+        if (fits_read_key(fitsFile, TDOUBLE, "EXPTIME", &returnValue, nullptr, &status))
+        {
+          returnValue = 0;
+        };
+      };
+
+      return static_cast<FP_t>(returnValue);
+    }
+
+    /// @brief      Reads the image in the current HDU as floating point values.
+    /// @param[in]  fitsFile: The open file.
+    /// @param[out] width: The width of the image.
+    /// @param[out] height: The height of the image.
+    /// @param[out] imageData: The image data. Null pixels are returned as NaN.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageCalibrator::readImage(fitsfile *fitsFile, std::size_t &width, std::size_t &height, std::vector<float> &imageData)
+    {
+      int status = 0;
+      int naxis;
+      long naxes[2] = {0, 0};
+      long firstPixel[2] = {1, 1};
+      float nullValue = std::numeric_limits<float>::quiet_NaN();
+
+      CFITSIO_TEST(fits_get_img_dim, fitsFile, &naxis);
+      CFITSIO_TEST(fits_get_img_size, fitsFile, 2, naxes);
+
+      if ( (naxis != 2) || (naxes[0] < 1) || (naxes[1] < 1) )
+      {
+        RUNTIME_ERROR(boost::locale::translate("Image calibration: Only two dimensional images can be calibrated."));
+      };
+
+      width = static_cast<std::size_t>(naxes[0]);
+      height = static_cast<std::size_t>(naxes[1]);
+      imageData.resize(width * height);
+
+      CFITSIO_TEST(fits_read_pix, fitsFile, TFLOAT, firstPixel, static_cast<LONGLONG>(imageData.size()), &nullValue,
+                   imageData.data(), nullptr);
+    }
+
+    /// @brief      Reads a master frame.
+    /// @param[in]  fileName: The master frame. The image in the primary HDU is used.
+    /// @returns    The master frame.
+    /// @details    Master frames without a BIASSUB keyword are taken to include the bias.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Read the BIASSUB keyword.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CImageCalibrator::SMasterFrame CImageCalibrator::readMasterFrame(boost::filesystem::path const &fileName)
+    {
+      SMasterFrame returnValue;
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      int biasSubtracted;
+
+      try
+      {
+        CFITSIO_TEST(fits_open_diskfile, &fitsFile, fileName.string().c_str(), READONLY);
+        readImage(fitsFile, returnValue.width, returnValue.height, returnValue.data);
+        returnValue.exposure = readExposure(fitsFile);
+
+        status = 0;
+        if (!fits_read_key(fitsFile, TLOGICAL, "BIASSUB", &biasSubtracted, nullptr, &status))
+        {
+          returnValue.biasSubtracted = (biasSubtracted != 0);
+        };
+
+        status = 0;
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        throw;
+      };
+
+      return returnValue;
+    }
+
+  } // namespace imaging
+} // namespace astroManager
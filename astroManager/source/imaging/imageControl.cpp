@@ -41,6 +41,8 @@ namespace astroManager
 {
   namespace imaging
   {
+    std::size_t const PROXY_DIMENSION = 1024;     ///< Maximum width and height of the proxy image.
+    std::size_t const THUMBNAIL_DIMENSION = 256;  ///< Maximum width and height of the thumbnail image.
 
     //*****************************************************************************************************************************
     //
@@ -232,6 +234,58 @@ namespace astroManager
       };
     }
 
+    /// @brief Discards the copy of the pixel data.
+    /// @details Must be called when the pixel values of the image have changed. The copy is recreated when next needed.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void SControlImage::invalidatePixelData()
+    {
+      pixelBuffer.reset();
+    }
+
+    /// @brief Returns the contiguous copy of the pixel data of the current HDB.
+    /// @returns The pixel buffer.
+    /// @details The buffer is created if it does not exist, or if it was created from a different HDB or image.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    std::shared_ptr<CPixelBuffer const> const &SControlImage::pixelData()
+    {
+      RUNTIME_ASSERT(astroFile, "astroFile cannot be nullptr");
+
+      if (!pixelBuffer || !pixelBuffer->isCopyOf(*astroFile, currentHDB))
+      {
+        pixelBuffer = std::make_shared<CPixelBuffer const>(*astroFile, currentHDB);
+      };
+
+      return pixelBuffer;
+    }
+
+    /// @brief Returns the reduced resolution copy of the pixel data of the current HDB.
+    /// @returns The proxy pixel buffer. (At most PROXY_DIMENSION pixels wide and high)
+    /// @details The proxy is cached by the pixel buffer, so it is created once after each change of the pixel data.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    std::shared_ptr<CPixelBuffer const> SControlImage::proxyData()
+    {
+      return pixelData()->proxy(PROXY_DIMENSION);
+    }
+
+    /// @brief Returns the thumbnail copy of the pixel data of the current HDB.
+    /// @returns The thumbnail pixel buffer. (At most THUMBNAIL_DIMENSION pixels wide and high)
+    /// @details The thumbnail is created from the proxy, not the full resolution data, and is cached by the proxy. It is
+    ///          therefore created once after each change of the pixel data. A change of the stretch only needs the (small)
+    ///          thumbnail image to be rendered again.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    std::shared_ptr<CPixelBuffer const> SControlImage::thumbnailData()
+    {
+      return proxyData()->proxy(THUMBNAIL_DIMENSION);
+    }
+
   } // namespace imaging
 
 } // namespace AstroManager
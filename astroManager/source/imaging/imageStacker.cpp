@@ -0,0 +1,646 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								imageStacker
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Stacks images without holding the images in memory. The output image is processed in bands of rows. For
+//                      each band, only the rows of each input frame that map onto the band are read from disk. The band is then
+//                      combined (in parallel) and written to the output file. The height of the bands is chosen so that the
+//                      input rows of all the frames fit within the memory budget. The memory used therefore depends on the
+//                      memory budget and not on the number of frames.
+//
+// CLASSES INCLUDED:    CImageStacker
+//
+// CLASS HIERARCHY:     CImageStacker
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/imageStacker.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+
+  // Miscellaneous library header files.
+
+#include "boost/locale.hpp"
+
+  // astroManager header files.
+
+#include "include/imaging/pixelBuffer.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    //*****************************************************************************************************************************
+    //
+    // CImageStacker
+    //
+    //*****************************************************************************************************************************
+
+    /// @brief      Constructor for the class.
+    /// @param[in]  memoryBudget: The memory (bytes) that may be used for the input rows and the output band.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CImageStacker::CImageStacker(std::size_t memoryBudget) : memoryBudget_(memoryBudget), frames_()
+    {
+    }
+
+    /// @brief      Adds a frame that is read from a FITS file as required.
+    /// @param[in]  fileName: The FITS file. The image in the primary HDU is stacked.
+    /// @param[in]  align1: The first alignment point.
+    /// @param[in]  align2: The second alignment point.
+    /// @details    Only the header of the file is read. The first frame added is the reference frame.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageStacker::addFile(boost::filesystem::path const &fileName, MCL::TPoint2D<FP_t> const &align1,
+                                MCL::TPoint2D<FP_t> const &align2)
+    {
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      int naxis;
+      long naxes[2] = {0, 0};
+      SFrame frame;
+
+      try
+      {
+        CFITSIO_TEST(fits_open_diskfile, &fitsFile, fileName.string().c_str(), READONLY);
+        CFITSIO_TEST(fits_get_img_dim, fitsFile, &naxis);
+        CFITSIO_TEST(fits_get_img_size, fitsFile, 2, naxes);
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        throw;
+      };
+
+      if ( (naxis != 2) || (naxes[0] < 2) || (naxes[1] < 2) )
+      {
+        RUNTIME_ERROR(boost::locale::translate("Image stacking: Only two dimensional images can be stacked."));
+      };
+
+      frame.fileName = fileName;
+      frame.width = static_cast<std::size_t>(naxes[0]);
+      frame.height = static_cast<std::size_t>(naxes[1]);
+      frame.align1 = align1;
+      frame.align2 = align2;
+
+      frames_.push_back(std::move(frame));
+    }
+
+    /// @brief      Adds a frame that is held in memory.
+    /// @param[in]  astroFile: The astroFile containing the frame.
+    /// @param[in]  hdb: The HDB containing the image.
+    /// @param[in]  align1: The first alignment point.
+    /// @param[in]  align2: The second alignment point.
+    /// @details    Used for frames that are not available as FITS files. (Frames opened from the database.) The first frame added
+    ///             is the reference frame.
+    /// @throws     GCL::CRuntimeError
+    /// @throws     GCL::CRuntimeAssert
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageStacker::addImage(std::shared_ptr<CAstroFile> astroFile, ACL::DHDBStore::size_type hdb,
+                                 MCL::TPoint2D<FP_t> const &align1, MCL::TPoint2D<FP_t> const &align2)
+    {
+      RUNTIME_ASSERT(astroFile, "Parameter astroFile cannot be nullptr.");
+
+      SFrame frame;
+      ACL::CAstroImage *astroImage = astroFile->getAstroImage(hdb);
+
+      if ( !astroFile->isMonoImage(hdb) || (astroImage->width() < 2) || (astroImage->height() < 2) )
+      {
+        RUNTIME_ERROR(boost::locale::translate("Image stacking: Only two dimensional images can be stacked."));
+      };
+
+      frame.astroFile = astroFile;
+      frame.hdb = hdb;
+      frame.width = static_cast<std::size_t>(astroImage->width());
+      frame.height = static_cast<std::size_t>(astroImage->height());
+      frame.align1 = align1;
+      frame.align2 = align2;
+
+      frames_.push_back(std::move(frame));
+    }
+
+    /// @brief      Determines the height of the bands so that the memory used stays within the budget.
+    /// @returns    The number of output rows in each band.
+    /// @details    A band of n output rows needs about (|sin| * (width - 1) + |cos| * n + 3) rows of each frame, where sin and
+    ///             cos are the rotation and scale of the frame. The memory needed is therefore linear in n.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::size_t CImageStacker::bandHeight() const
+    {
+      std::size_t returnValue;
+      std::size_t outputWidth = frames_.front().width;
+      FP_t fixedBytes = 0;
+      FP_t bytesPerRow = static_cast<FP_t>(outputWidth * sizeof(float));
+      FP_t rows;
+
+      for (SFrame const &frame : frames_)
+      {
+        fixedBytes += (std::ceil(std::fabs(frame.sinTerm) * (outputWidth - 1)) + 3) * frame.width * sizeof(float);
+        bytesPerRow += std::fabs(frame.cosTerm) * frame.width * sizeof(float);
+      };
+
+      rows = (static_cast<FP_t>(memoryBudget_) - fixedBytes) / bytesPerRow;
+
+      if (rows < 1)
+      {
+        WARNINGMESSAGE("Image stacking: The memory budget is too small for " + std::to_string(frames_.size()) +
+                       " frames. Stacking one row at a time.");
+        returnValue = 1;
+      }
+      else
+      {
+        returnValue = std::min(frames_.front().height, static_cast<std::size_t>(rows));
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Calculates the transform from the output image (reference frame) to each of the frames.
+    /// @details    The transform is the rotation and scale that maps the vector between the alignment points of the reference
+    ///             frame onto the vector between the alignment points of the frame. Frames with coincident alignment points are
+    ///             only translated.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageStacker::calculateTransforms()
+    {
+      FP_t referenceX = frames_.front().align2.x() - frames_.front().align1.x();
+      FP_t referenceY = frames_.front().align2.y() - frames_.front().align1.y();
+      FP_t referenceLength = referenceX * referenceX + referenceY * referenceY;
+
+      for (SFrame &frame : frames_)
+      {
+        FP_t frameX = frame.align2.x() - frame.align1.x();
+        FP_t frameY = frame.align2.y() - frame.align1.y();
+
+        if (referenceLength > 0)
+        {
+          frame.cosTerm = (frameX * referenceX + frameY * referenceY) / referenceLength;
+          frame.sinTerm = (frameY * referenceX - frameX * referenceY) / referenceLength;
+        }
+        else
+        {
+          frame.cosTerm = 1;
+          frame.sinTerm = 0;
+        };
+      };
+    }
+
+    /// @brief      Removes all the frames.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageStacker::clearFrames() noexcept
+    {
+      frames_.clear();
+    }
+
+    /// @brief      Combines the output rows of the band.
+    /// @param[in]  firstRow: The first output row of the band.
+    /// @param[in]  lastRow: One past the last output row of the band.
+    /// @param[in]  stackMode: The combine method.
+    /// @param[out] output: The combined rows.
+    /// @details    Each frame is sampled (bilinear interpolation) at the position of the output pixel. Frames that do not cover
+    ///             the output pixel, and NaN values, are excluded from the combine. The rows are split between the threads of the
+    ///             global thread pool. The sum and the mean are accumulated directly as each frame is sampled. For the other
+    ///             combine methods each output row is a tile. (See CCombineTile)
+    /// @pre        The rows of the frames have been read by readBand().
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - The sum and mean are accumulated without gathering the values into a tile.
+    /// @version    2026-10-17/GGB - The rows are combined as tiles by the combine kernels.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageStacker::combineBand(std::size_t firstRow, std::size_t lastRow, ACL::CImageStack::EStackMode stackMode,
+                                    std::vector<float> &output) const
+    {
+      std::size_t outputWidth = frames_.front().width;
+      MCL::TPoint2D<FP_t> const &origin = frames_.front().align1;
+
+      output.resize((lastRow - firstRow) * outputWidth);
+
+        // Samples each frame along an output row. Each frame adds its values along the row, so the rows of the frame are read
+        // sequentially.
+
+      auto sampleRow = [&](std::size_t row, auto &&addValue)
+      {
+        FP_t dy = static_cast<FP_t>(firstRow + row) - origin.y();
+
+        for (SFrame const &frame : frames_)
+        {
+          for (std::size_t column = 0; column < outputWidth; ++column)
+          {
+            FP_t dx = static_cast<FP_t>(column) - origin.x();
+            FP_t x = frame.align1.x() + frame.cosTerm * dx - frame.sinTerm * dy;
+            FP_t y = frame.align1.y() + frame.sinTerm * dx + frame.cosTerm * dy;
+
+            if ( (x >= 0) && (y >= 0) && (x <= frame.width - 1) && (y <= frame.height - 1) )
+            {
+              long x0 = std::min(static_cast<long>(x), static_cast<long>(frame.width) - 2);
+              long y0 = std::min(static_cast<long>(y), static_cast<long>(frame.height) - 2);
+
+              if ( (y0 >= frame.bandFirstRow) && (y0 < frame.bandLastRow) )
+              {
+                float const *pixel = frame.bandData.data() + (y0 - frame.bandFirstRow) * frame.width + x0;
+                FP_t fx = x - x0;
+                FP_t fy = y - y0;
+
+                addValue(column, static_cast<float>((pixel[0] * (1 - fx) + pixel[1] * fx) * (1 - fy) +
+                                                    (pixel[frame.width] * (1 - fx) + pixel[frame.width + 1] * fx) * fy));
+              };
+            };
+          };
+        };
+      };
+
+      if ( (stackMode == ACL::CImageStack::SM_SUM) || (stackMode == ACL::CImageStack::SM_MEAN) )
+      {
+        parallelFor(lastRow - firstRow, [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+          std::vector<FP_t> sums(outputWidth);
+          std::vector<std::uint32_t> counts(outputWidth);
+
+          for (std::size_t row = rowBegin; row < rowEnd; ++row)
+          {
+            float *outputRow = output.data() + row * outputWidth;
+
+            std::fill(sums.begin(), sums.end(), 0);
+            std::fill(counts.begin(), counts.end(), 0);
+
+            sampleRow(row, [&](std::size_t column, float value)
+            {
+              if (!std::isnan(value))
+              {
+                sums[column] += value;
+                counts[column]++;
+              };
+            });
+
+              // Zero if no frames cover the pixel. (As combineValues())
+
+            for (std::size_t column = 0; column < outputWidth; ++column)
+            {
+              if (counts[column] == 0)
+              {
+                outputRow[column] = 0;
+              }
+              else if (stackMode == ACL::CImageStack::SM_SUM)
+              {
+                outputRow[column] = static_cast<float>(sums[column]);
+              }
+              else
+              {
+                outputRow[column] = static_cast<float>(sums[column] / counts[column]);
+              };
+            };
+          };
+        });
+      }
+      else
+      {
+        parallelFor(lastRow - firstRow, [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+          CCombineTile tile(frames_.size(), outputWidth);
+
+          for (std::size_t row = rowBegin; row < rowEnd; ++row)
+          {
+            tile.clear(outputWidth);
+
+            sampleRow(row, [&](std::size_t column, float value)
+            {
+              tile.addValue(column, value);
+            });
+
+            tile.combine(stackMode, output.data() + row * outputWidth, rejection_);
+          };
+        });
+      };
+    }
+
+    /// @brief      Copies the descriptive keywords of a FITS file to the output file.
+    /// @param[in]  inputFile: The file to copy the keywords from. The keywords of the primary HDU are copied.
+    /// @param[in]  outputFile: The output file.
+    /// @details    Structural, scaling, range and checksum keywords are not copied as they do not apply to the output. The WCS
+    ///             keywords are copied. (A stacked image is aligned to the reference frame.)
+    /// @throws     ACL::CFITSException
+    /// @version    2026-10-17/GGB - Made static so that the keywords of any file can be copied.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageStacker::copyKeywords(boost::filesystem::path const &inputFile, fitsfile *outputFile)
+    {
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      int keywordCount;
+      char card[FLEN_CARD];
+
+      try
+      {
+        CFITSIO_TEST(fits_open_diskfile, &fitsFile, inputFile.string().c_str(), READONLY);
+        CFITSIO_TEST(fits_get_hdrspace, fitsFile, &keywordCount, nullptr);
+
+        for (int keyword = 1; keyword <= keywordCount; ++keyword)
+        {
+          CFITSIO_TEST(fits_read_record, fitsFile, keyword, card);
+
+          int keywordClass = fits_get_keyclass(card);
+
+          if ( (keywordClass >= TYP_UNIT_KEY) && (keywordClass != TYP_CKSUM_KEY) )
+          {
+            CFITSIO_TEST(fits_write_record, outputFile, card);
+          };
+        };
+
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        throw;
+      };
+    }
+
+    /// @brief      Determines the rows of a frame that are needed for a band of output rows.
+    /// @param[in]  frame: The frame.
+    /// @param[in]  firstRow: The first output row of the band.
+    /// @param[in]  lastRow: One past the last output row of the band.
+    /// @param[out] frameFirstRow: The first row of the frame needed.
+    /// @param[out] frameLastRow: The last row of the frame needed. Less than frameFirstRow if no rows are needed.
+    /// @details    The transform is linear, so the extreme rows are found at the corners of the band.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageStacker::frameRows(SFrame const &frame, std::size_t firstRow, std::size_t lastRow, long &frameFirstRow,
+                                  long &frameLastRow) const
+    {
+      MCL::TPoint2D<FP_t> const &origin = frames_.front().align1;
+      FP_t dx[2] = { -origin.x(), static_cast<FP_t>(frames_.front().width - 1) - origin.x() };
+      FP_t dy[2] = { static_cast<FP_t>(firstRow) - origin.y(), static_cast<FP_t>(lastRow - 1) - origin.y() };
+      FP_t minimumY = std::numeric_limits<FP_t>::max();
+      FP_t maximumY = std::numeric_limits<FP_t>::lowest();
+
+      for (FP_t x : dx)
+      {
+        for (FP_t y : dy)
+        {
+          FP_t frameY = frame.align1.y() + frame.sinTerm * x + frame.cosTerm * y;
+
+          minimumY = std::min(minimumY, frameY);
+          maximumY = std::max(maximumY, frameY);
+        };
+      };
+
+      frameFirstRow = std::max(static_cast<long>(std::floor(minimumY)), 0L);
+      frameLastRow = std::min(static_cast<long>(std::floor(maximumY)) + 1, static_cast<long>(frame.height) - 1);
+    }
+
+    /// @brief      Reads the rows of a frame needed for a band of output rows.
+    /// @param[in]  frame: The frame.
+    /// @param[in]  firstRow: The first output row of the band.
+    /// @param[in]  lastRow: One past the last output row of the band.
+    /// @details    Only the rows needed are read from the FITS file. Undefined (blank) pixels are read as NaN.
+    /// @throws     ACL::CFITSException
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageStacker::readBand(SFrame &frame, std::size_t firstRow, std::size_t lastRow)
+    {
+      frameRows(frame, firstRow, lastRow, frame.bandFirstRow, frame.bandLastRow);
+
+      if (frame.bandLastRow >= frame.bandFirstRow)
+      {
+        std::size_t rowCount = static_cast<std::size_t>(frame.bandLastRow - frame.bandFirstRow + 1);
+
+        frame.bandData.resize(rowCount * frame.width);
+
+        if (!frame.fileName.empty())
+        {
+          fitsfile *fitsFile = nullptr;
+          int status = 0;
+          int anyNull;
+          long firstPixel[2] = {1, frame.bandFirstRow + 1};
+          float nullValue = std::numeric_limits<float>::quiet_NaN();
+
+          try
+          {
+            CFITSIO_TEST(fits_open_diskfile, &fitsFile, frame.fileName.string().c_str(), READONLY);
+            CFITSIO_TEST(fits_read_pix, fitsFile, TFLOAT, firstPixel, static_cast<LONGLONG>(frame.bandData.size()), &nullValue,
+                         frame.bandData.data(), &anyNull);
+            CFITSIO_TEST(fits_close_file, fitsFile);
+          }
+          catch(...)
+          {
+            if (fitsFile)
+            {
+              status = 0;
+              fits_close_file(fitsFile, &status);
+            };
+            throw;
+          };
+        }
+        else
+        {
+          ACL::CAstroImage *astroImage = frame.astroFile->getAstroImage(frame.hdb);
+          std::size_t index = static_cast<std::size_t>(frame.bandFirstRow) * frame.width;
+
+          for (float &value : frame.bandData)
+          {
+            value = static_cast<float>(astroImage->getValue(static_cast<ACL::INDEX_t>(index++)));
+          };
+        };
+      }
+      else
+      {
+        frame.bandData.clear();
+      };
+    }
+
+    /// @brief      Stacks the frames and writes the result to a FITS file.
+    /// @param[in]  stackMode: The combine method.
+    /// @param[in]  outputFile: The output file. Overwritten if it exists.
+    /// @returns    true if the frames were stacked. false if the stack was cancelled. (The output file is removed.)
+    /// @details    The output image has the size of the reference (first) frame and is aligned to the reference frame. The output
+    ///             is created band by band. For each band the rows needed from each frame are read (the frames are read in
+    ///             parallel), the band is combined and the band is written to the output file. If a progress has been set, each
+    ///             band is also copied to the preview of the progress, and the cancel flag is checked before each band.
+    ///             This function can be called on any thread.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CCodeError
+    /// @throws     GCL::CRuntimeAssert
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Added progress, preview and cancellation.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CImageStacker::stackImages(ACL::CImageStack::EStackMode stackMode, boost::filesystem::path const &outputFile)
+    {
+      RUNTIME_ASSERT(!frames_.empty(), "No frames to stack.");
+
+      if ( (stackMode != ACL::CImageStack::SM_SUM) && (stackMode != ACL::CImageStack::SM_MEAN) &&
+           (stackMode != ACL::CImageStack::SM_MEDIAN) && (stackMode != ACL::CImageStack::SM_SIGMACLIP) )
+      {
+        CODE_ERROR;
+      };
+
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      std::size_t outputWidth = frames_.front().width;
+      std::size_t outputHeight = frames_.front().height;
+      std::size_t rowsPerBand;
+      std::vector<float> outputBand;
+      std::vector<std::exception_ptr> errors(frames_.size());
+      long naxes[2] = {static_cast<long>(outputWidth), static_cast<long>(outputHeight)};
+      int frameCount = static_cast<int>(frames_.size());
+      bool returnValue = true;
+
+      calculateTransforms();
+      rowsPerBand = bandHeight();
+
+      INFOMESSAGE("Image stacking: Stacking " + std::to_string(frames_.size()) + " frames in bands of " +
+                  std::to_string(rowsPerBand) + " rows.");
+
+      boost::filesystem::remove(outputFile);
+
+      try
+      {
+        CFITSIO_TEST(fits_create_diskfile, &fitsFile, outputFile.string().c_str());
+        CFITSIO_TEST(fits_create_img, fitsFile, FLOAT_IMG, 2, naxes);
+
+        if (progress_)
+        {
+          std::lock_guard<std::mutex> lock(progress_->previewMutex);
+
+          progress_->width = outputWidth;
+          progress_->height = outputHeight;
+          progress_->preview.assign(outputWidth * outputHeight, std::numeric_limits<float>::quiet_NaN());
+          progress_->rowsDone = 0;
+        };
+
+        for (std::size_t firstRow = 0; (firstRow < outputHeight) && returnValue; firstRow += rowsPerBand)
+        {
+          std::size_t lastRow = std::min(outputHeight, firstRow + rowsPerBand);
+          long firstPixel[2] = {1, static_cast<long>(firstRow) + 1};
+
+          parallelFor(frames_.size(), [&](std::size_t frameBegin, std::size_t frameEnd)
+          {
+            for (std::size_t frame = frameBegin; frame < frameEnd; ++frame)
+            {
+              try
+              {
+                readBand(frames_[frame], firstRow, lastRow);
+              }
+              catch(...)
+              {
+                errors[frame] = std::current_exception();
+              };
+            };
+          });
+
+          for (std::exception_ptr const &error : errors)
+          {
+            if (error)
+            {
+              std::rethrow_exception(error);
+            };
+          };
+
+          combineBand(firstRow, lastRow, stackMode, outputBand);
+
+          CFITSIO_TEST(fits_write_pix, fitsFile, TFLOAT, firstPixel, static_cast<LONGLONG>(outputBand.size()),
+                       outputBand.data());
+
+          if (progress_)
+          {
+            std::lock_guard<std::mutex> lock(progress_->previewMutex);
+
+            std::copy(outputBand.begin(), outputBand.end(), progress_->preview.begin() + firstRow * outputWidth);
+            progress_->rowsDone = lastRow;
+            returnValue = !progress_->cancel;
+          };
+        };
+
+        if (returnValue)
+        {
+          if (!frames_.front().fileName.empty())
+          {
+            copyKeywords(frames_.front().fileName, fitsFile);     // Only copied if the reference frame is a FITS file.
+          };
+          CFITSIO_TEST(fits_update_key, fitsFile, TINT, "NCOMBINE", &frameCount, "Number of images combined");
+        };
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        boost::filesystem::remove(outputFile);
+
+        for (SFrame &frame : frames_)
+        {
+          std::vector<float>().swap(frame.bandData);
+        };
+        throw;
+      };
+
+        // Release the memory used for the bands.
+
+      for (SFrame &frame : frames_)
+      {
+        std::vector<float>().swap(frame.bandData);
+      };
+
+      if (!returnValue)
+      {
+        INFOMESSAGE("Image stacking: Cancelled.");
+        boost::filesystem::remove(outputFile);
+      };
+
+      return returnValue;
+    }
+
+  } // namespace imaging
+} // namespace astroManager
@@ -0,0 +1,414 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								liveStacker
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Incremental (live) stacking. Each frame is aligned to the reference (first) frame and folded into running
+//                      accumulators (count, Welford mean and variance, an approximate median and a clipped mean). Adding a
+//                      frame, and creating the current result, therefore only costs the size of one frame and not the number of
+//                      frames already stacked.
+//
+// CLASSES INCLUDED:    CLiveStacker
+//
+// CLASS HIERARCHY:     CLiveStacker
+//
+// HISTORY:             2026-10-17 GGB - Added resultFITS() to create the result in memory.
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/liveStacker.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+  // Miscellaneous library header files.
+
+#include "boost/locale.hpp"
+
+  // astroManager header files.
+
+#include "include/imaging/imageStacker.h"
+#include "include/imaging/pixelBuffer.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    FP_t const CLIP_KAPPA = 3;                    ///< Values further than KAPPA standard deviations from the mean are rejected.
+    std::uint32_t const CLIP_MINIMUM = 3;         ///< Values are not rejected until there are enough values for a deviation.
+    FP_t const MEDIAN_GAIN = 1.25;                ///< sqrt(pi / 2). Step of the median estimate for normal distributions.
+
+    /// @brief      Constructor for the class.
+    /// @param[in]  medianSketch: true if the approximate median of each pixel should be maintained.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CLiveStacker::CLiveStacker(bool medianSketch) : medianSketch_(medianSketch)
+    {
+    }
+
+    /// @brief      Folds a frame into the accumulators.
+    /// @param[in]  astroFile: The astroFile containing the frame.
+    /// @param[in]  hdb: The HDB containing the image.
+    /// @param[in]  align1: The first alignment point of the frame.
+    /// @param[in]  align2: The second alignment point of the frame.
+    /// @details    The first frame is the reference frame and defines the size and alignment of the result. Each frame is
+    ///             sampled (bilinear interpolation) at the position of each pixel of the result, using the same transform as
+    ///             CImageStacker. Pixels not covered by the frame, and NaN values, are not accumulated.
+    ///             The median is estimated by stochastic approximation: the estimate moves towards each new value by a step
+    ///             proportional to the standard deviation and inversely proportional to the number of values. The clipped mean
+    ///             rejects values that are further than CLIP_KAPPA standard deviations from the clipped mean of the earlier
+    ///             frames.
+    /// @throws     GCL::CRuntimeError
+    /// @throws     GCL::CRuntimeAssert
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CLiveStacker::addFrame(std::shared_ptr<CAstroFile> astroFile, ACL::DHDBStore::size_type hdb,
+                                MCL::TPoint2D<FP_t> const &align1, MCL::TPoint2D<FP_t> const &align2)
+    {
+      RUNTIME_ASSERT(astroFile, "Parameter astroFile cannot be nullptr.");
+
+      ACL::CAstroImage *astroImage = astroFile->getAstroImage(hdb);
+
+      if ( !astroFile->isMonoImage(hdb) || (astroImage->width() < 2) || (astroImage->height() < 2) )
+      {
+        RUNTIME_ERROR(boost::locale::translate("Image stacking: Only two dimensional images can be stacked."));
+      };
+
+      std::size_t frameWidth = static_cast<std::size_t>(astroImage->width());
+      std::size_t frameHeight = static_cast<std::size_t>(astroImage->height());
+      std::vector<float> frameData(frameWidth * frameHeight);
+      FP_t cosTerm = 1;
+      FP_t sinTerm = 0;
+
+      if (frameCount_ == 0)
+      {
+        std::size_t pixelCount = frameWidth * frameHeight;
+
+        width_ = frameWidth;
+        height_ = frameHeight;
+        align1_ = align1;
+        align2_ = align2;
+
+        count_.assign(pixelCount, 0);
+        mean_.assign(pixelCount, 0);
+        m2_.assign(pixelCount, 0);
+        clippedCount_.assign(pixelCount, 0);
+        clippedMean_.assign(pixelCount, 0);
+        if (medianSketch_)
+        {
+          median_.assign(pixelCount, 0);
+        };
+      }
+      else
+      {
+          // Rotation and scale from the reference frame to the frame. (See CImageStacker::calculateTransforms())
+
+        FP_t referenceX = align2_.x() - align1_.x();
+        FP_t referenceY = align2_.y() - align1_.y();
+        FP_t referenceLength = referenceX * referenceX + referenceY * referenceY;
+        FP_t frameX = align2.x() - align1.x();
+        FP_t frameY = align2.y() - align1.y();
+
+        if (referenceLength > 0)
+        {
+          cosTerm = (frameX * referenceX + frameY * referenceY) / referenceLength;
+          sinTerm = (frameY * referenceX - frameX * referenceY) / referenceLength;
+        };
+      };
+
+      parallelFor(frameHeight, [&](std::size_t rowBegin, std::size_t rowEnd)
+      {
+        for (std::size_t index = rowBegin * frameWidth; index < rowEnd * frameWidth; ++index)
+        {
+          frameData[index] = static_cast<float>(astroImage->getValue(static_cast<ACL::INDEX_t>(index)));
+        };
+      });
+
+      parallelFor(height_, [&](std::size_t rowBegin, std::size_t rowEnd)
+      {
+        for (std::size_t row = rowBegin; row < rowEnd; ++row)
+        {
+          FP_t dy = static_cast<FP_t>(row) - align1_.y();
+
+          for (std::size_t column = 0; column < width_; ++column)
+          {
+            FP_t dx = static_cast<FP_t>(column) - align1_.x();
+            FP_t x = align1.x() + cosTerm * dx - sinTerm * dy;
+            FP_t y = align1.y() + sinTerm * dx + cosTerm * dy;
+
+            if ( (x >= 0) && (y >= 0) && (x <= frameWidth - 1) && (y <= frameHeight - 1) )
+            {
+              long x0 = std::min(static_cast<long>(x), static_cast<long>(frameWidth) - 2);
+              long y0 = std::min(static_cast<long>(y), static_cast<long>(frameHeight) - 2);
+              float const *pixel = frameData.data() + y0 * frameWidth + x0;
+              FP_t fx = x - x0;
+              FP_t fy = y - y0;
+              FP_t value = (pixel[0] * (1 - fx) + pixel[1] * fx) * (1 - fy) +
+                           (pixel[frameWidth] * (1 - fx) + pixel[frameWidth + 1] * fx) * fy;
+
+              if (!std::isnan(value))
+              {
+                std::size_t index = row * width_ + column;
+                std::uint32_t count = ++count_[index];
+                FP_t standardDeviation = (count > 2) ? std::sqrt(m2_[index] / (count - 2)) : 0;   // Of the earlier values.
+                FP_t delta = value - mean_[index];
+
+                mean_[index] += static_cast<float>(delta / count);
+                m2_[index] += static_cast<float>(delta * (value - mean_[index]));
+
+                if ( (clippedCount_[index] < CLIP_MINIMUM) ||
+                     (std::fabs(value - clippedMean_[index]) <= CLIP_KAPPA * standardDeviation) )
+                {
+                  clippedMean_[index] += static_cast<float>((value - clippedMean_[index]) / ++clippedCount_[index]);
+                };
+
+                if (medianSketch_)
+                {
+                  if (count == 1)
+                  {
+                    median_[index] = static_cast<float>(value);
+                  }
+                  else
+                  {
+                    FP_t step = MEDIAN_GAIN * std::sqrt(m2_[index] / (count - 1)) / count;
+
+                    if (value > median_[index])
+                    {
+                      median_[index] = static_cast<float>(std::min<FP_t>(median_[index] + step, value));
+                    }
+                    else if (value < median_[index])
+                    {
+                      median_[index] = static_cast<float>(std::max<FP_t>(median_[index] - step, value));
+                    };
+                  };
+                };
+              };
+            };
+          };
+        };
+      });
+
+      frameCount_++;
+    }
+
+    /// @brief      Removes all the frames. The next frame added becomes the reference frame.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CLiveStacker::clear() noexcept
+    {
+      frameCount_ = 0;
+      width_ = height_ = 0;
+
+      std::vector<std::uint32_t>().swap(count_);
+      std::vector<float>().swap(mean_);
+      std::vector<float>().swap(m2_);
+      std::vector<float>().swap(median_);
+      std::vector<std::uint32_t>().swap(clippedCount_);
+      std::vector<float>().swap(clippedMean_);
+    }
+
+    /// @brief      Creates the current result from the accumulators.
+    /// @param[in]  stackMode: The combine method.
+    /// @param[out] output: The result. (width * height values, row by row)
+    /// @details    SM_MEDIAN returns the mean if the median is not maintained. SM_SIGMACLIP returns the clipped mean. Pixels that
+    ///             are not covered by any frame are zero.
+    /// @throws     GCL::CCodeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CLiveStacker::resultImage(ACL::CImageStack::EStackMode stackMode, std::vector<float> &output) const
+    {
+      output.resize(width_ * height_);
+
+      switch (stackMode)
+      {
+        case ACL::CImageStack::SM_SUM:
+        {
+          for (std::size_t index = 0; index < output.size(); ++index)
+          {
+            output[index] = mean_[index] * count_[index];
+          };
+          break;
+        };
+        case ACL::CImageStack::SM_MEAN:
+        {
+          std::copy(mean_.begin(), mean_.end(), output.begin());
+          break;
+        };
+        case ACL::CImageStack::SM_MEDIAN:
+        {
+          std::copy(medianSketch_ ? median_.begin() : mean_.begin(), medianSketch_ ? median_.end() : mean_.end(),
+                    output.begin());
+          break;
+        };
+        case ACL::CImageStack::SM_SIGMACLIP:
+        {
+          std::copy(clippedMean_.begin(), clippedMean_.end(), output.begin());
+          break;
+        };
+        default:
+        {
+          CODE_ERROR;
+          break;
+        };
+      };
+    }
+
+    /// @brief      Creates the current result as a FITS file held in memory.
+    /// @param[in]  stackMode: The combine method.
+    /// @param[in]  keywordFile: The FITS file to copy the keywords from. (The reference frame) Not used if empty.
+    /// @returns    The FITS file.
+    /// @details    The result is not written to disk. The FITS file can be loaded with the CAstroFile(QWidget *, QByteArray &)
+    ///             constructor.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CCodeError
+    /// @throws     GCL::CRuntimeAssert
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    QByteArray CLiveStacker::resultFITS(ACL::CImageStack::EStackMode stackMode, boost::filesystem::path const &keywordFile) const
+    {
+      RUNTIME_ASSERT(frameCount_ != 0, "No frames to stack.");
+
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      std::size_t memorySize = ACL::FITS_BLOCK;
+      void *memory = std::malloc(memorySize);         // Owned by cfitsio while the file is open. (Grown by std::realloc)
+      QByteArray returnValue;
+
+      if (!memory)
+      {
+        throw std::bad_alloc();
+      };
+
+      try
+      {
+        CFITSIO_TEST(fits_create_memfile, &fitsFile, &memory, &memorySize, 0, std::realloc);
+        writeFITS(fitsFile, stackMode, keywordFile);
+
+          // The size of the file is the end of the HDU. (memorySize is the size of the buffer)
+
+        LONGLONG headerStart, dataStart, dataEnd;
+
+        CFITSIO_TEST(fits_get_hduaddrll, fitsFile, &headerStart, &dataStart, &dataEnd);
+        CFITSIO_TEST(fits_close_file, fitsFile);
+        fitsFile = nullptr;
+
+        returnValue = QByteArray(static_cast<char const *>(memory),
+                                 static_cast<int>(std::min(static_cast<std::size_t>(dataEnd), memorySize)));
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        std::free(memory);
+        throw;
+      };
+
+      std::free(memory);
+
+      return returnValue;
+    }
+
+    /// @brief      Writes the current result to a FITS file.
+    /// @param[in]  stackMode: The combine method.
+    /// @param[in]  outputFile: The output file. Overwritten if it exists.
+    /// @param[in]  keywordFile: The FITS file to copy the keywords from. (The reference frame) Not used if empty.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CCodeError
+    /// @throws     GCL::CRuntimeAssert
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - The HDU is written by writeFITS().
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CLiveStacker::writeImage(ACL::CImageStack::EStackMode stackMode, boost::filesystem::path const &outputFile,
+                                  boost::filesystem::path const &keywordFile) const
+    {
+      RUNTIME_ASSERT(frameCount_ != 0, "No frames to stack.");
+
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+
+      boost::filesystem::remove(outputFile);
+
+      try
+      {
+        CFITSIO_TEST(fits_create_diskfile, &fitsFile, outputFile.string().c_str());
+        writeFITS(fitsFile, stackMode, keywordFile);
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        boost::filesystem::remove(outputFile);
+        throw;
+      };
+    }
+
+    /// @brief      Writes the current result as the primary HDU of a FITS file.
+    /// @param[in]  fitsFile: The (empty) FITS file.
+    /// @param[in]  stackMode: The combine method.
+    /// @param[in]  keywordFile: The FITS file to copy the keywords from. (The reference frame) Not used if empty.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CCodeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created. (Code moved from writeImage())
+
+    void CLiveStacker::writeFITS(fitsfile *fitsFile, ACL::CImageStack::EStackMode stackMode,
+                                 boost::filesystem::path const &keywordFile) const
+    {
+      int status = 0;
+      std::vector<float> output;
+      long naxes[2] = {static_cast<long>(width_), static_cast<long>(height_)};
+      long firstPixel[2] = {1, 1};
+      int frameCount = static_cast<int>(frameCount_);
+
+      resultImage(stackMode, output);
+
+      CFITSIO_TEST(fits_create_img, fitsFile, FLOAT_IMG, 2, naxes);
+      CFITSIO_TEST(fits_write_pix, fitsFile, TFLOAT, firstPixel, static_cast<LONGLONG>(output.size()), output.data());
+
+      if (!keywordFile.empty())
+      {
+        CImageStacker::copyKeywords(keywordFile, fitsFile);
+      };
+      CFITSIO_TEST(fits_update_key, fitsFile, TINT, "NCOMBINE", &frameCount, "Number of images combined");
+    }
+
+  } // namespace imaging
+} // namespace astroManager
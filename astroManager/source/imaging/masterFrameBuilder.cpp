@@ -0,0 +1,568 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								masterFrameBuilder
+// SUBSYSTEM:						Image calibration.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Creates master calibration frames (bias, dark and flat) from a list of FITS files without holding all the
+//                      frames in memory. A mean combine is calculated with a running mean and variance, so each frame is read
+//                      once and only two frames are held in memory. Median and sigma clip combines are calculated in bands of
+//                      rows. The height of the bands is chosen so that the rows of all the frames fit within the memory budget.
+//                      The pixels are combined in parallel.
+//
+// CLASSES INCLUDED:    CMasterFrameBuilder
+//
+// CLASS HIERARCHY:     CMasterFrameBuilder
+//
+// HISTORY:             2026-10-17 GGB - Added cancel() and the BIASSUB keyword.
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/masterFrameBuilder.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+
+  // Miscellaneous library header files.
+
+#include "boost/locale.hpp"
+#include <QtConcurrent/QtConcurrent>
+
+  // astroManager header files.
+
+#include "include/imaging/combineKernels.h"
+#include "include/imaging/imageStacker.h"
+#include "include/imaging/pixelBuffer.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    std::size_t const TILE_PIXELS = 256;          ///< Number of pixels combined together by the combine kernels.
+
+    /// @brief      Constructor for the class.
+    /// @param[in]  memoryBudget: The memory (bytes) that may be used for the rows of the frames when combining in bands.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CMasterFrameBuilder::CMasterFrameBuilder(std::size_t memoryBudget) : memoryBudget_(memoryBudget), frames_()
+    {
+    }
+
+    /// @brief      Adds a frame to be combined.
+    /// @param[in]  fileName: The FITS file. The image in the primary HDU is combined.
+    /// @details    Only the header of the file is read. All the frames must be the same size.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CMasterFrameBuilder::addFile(boost::filesystem::path const &fileName)
+    {
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      int naxis;
+      long naxes[2] = {0, 0};
+
+      try
+      {
+        CFITSIO_TEST(fits_open_diskfile, &fitsFile, fileName.string().c_str(), READONLY);
+        CFITSIO_TEST(fits_get_img_dim, fitsFile, &naxis);
+        CFITSIO_TEST(fits_get_img_size, fitsFile, 2, naxes);
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        throw;
+      };
+
+      if ( (naxis != 2) || (naxes[0] < 1) || (naxes[1] < 1) )
+      {
+        RUNTIME_ERROR(boost::locale::translate("Master frame: Only two dimensional images can be combined."));
+      }
+      else if (frames_.empty())
+      {
+        width_ = static_cast<std::size_t>(naxes[0]);
+        height_ = static_cast<std::size_t>(naxes[1]);
+      }
+      else if ( (static_cast<std::size_t>(naxes[0]) != width_) || (static_cast<std::size_t>(naxes[1]) != height_) )
+      {
+        RUNTIME_ERROR(boost::locale::translate("Master frame: All the frames must be the same size."));
+      };
+
+      frames_.push_back(fileName);
+    }
+
+    /// @brief      Determines the number of rows that are combined in each band.
+    /// @returns    The number of rows in a band.
+    /// @details    Each row of the band needs a row from every frame, plus the output row.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::size_t CMasterFrameBuilder::bandHeight() const
+    {
+      std::size_t returnValue;
+      std::size_t bytesPerRow = (frames_.size() + 1) * width_ * sizeof(float);
+
+      returnValue = memoryBudget_ / bytesPerRow;
+
+      if (returnValue < 1)
+      {
+        WARNINGMESSAGE("Master frame: The memory budget is too small for " + std::to_string(frames_.size()) +
+                       " frames. Combining one row at a time.");
+        returnValue = 1;
+      }
+      else
+      {
+        returnValue = std::min(height_, returnValue);
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Calculates the scale of each frame when the frames are normalised.
+    /// @details    Each frame is scaled so that its mean level is the same as the mean level of the first frame. The frames are
+    ///             read one at a time, in bands of rows.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CMasterFrameBuilder::calculateScales()
+    {
+      std::size_t rowsPerBand = std::max<std::size_t>(1, std::min(height_, memoryBudget_ / (width_ * sizeof(float))));
+      std::vector<float> bandData(rowsPerBand * width_);
+      std::vector<FP_t> frameMeans(frames_.size());
+
+      frameScales_.assign(frames_.size(), 1);
+
+      for (std::size_t frame = 0; frame < frames_.size(); ++frame)
+      {
+        FP_t sum = 0;
+        std::size_t count = 0;
+
+        for (std::size_t firstRow = 0; firstRow < height_; firstRow += rowsPerBand)
+        {
+          std::size_t rowCount = std::min(rowsPerBand, height_ - firstRow);
+
+          readRows(frame, firstRow, rowCount, bandData.data());
+
+          for (std::size_t index = 0; index < rowCount * width_; ++index)
+          {
+            if (!std::isnan(bandData[index]))
+            {
+              sum += bandData[index];
+              ++count;
+            };
+          };
+        };
+
+        frameMeans[frame] = (count != 0) ? sum / count : 0;
+      };
+
+      for (std::size_t frame = 0; frame < frames_.size(); ++frame)
+      {
+        if (frameMeans[frame] <= 0)
+        {
+          RUNTIME_ERROR(boost::locale::translate("Master frame: A frame to be normalised has a mean level of zero or less."));
+        };
+
+        frameScales_[frame] = frameMeans.front() / frameMeans[frame];
+      };
+    }
+
+    /// @brief      Combines the frames in bands of rows, using a median or sigma clip combine.
+    /// @param[in]  outputFile: The output file. The image HDU has been created.
+    /// @param[in]  stackMode: The combine method.
+    /// @details    For each band the rows of all the frames are read (the frames are read in parallel) and the pixels are combined
+    ///             in parallel, in tiles of TILE_PIXELS pixels. NaN values are excluded from the combine.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - The pixels are combined in tiles by the combine kernels.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CMasterFrameBuilder::combineBands(fitsfile *outputFile, ACL::CImageStack::EStackMode stackMode)
+    {
+      int status = 0;
+      std::size_t rowsPerBand = bandHeight();
+      std::size_t const frameCount = frames_.size();
+      std::vector<float> bandData(frameCount * rowsPerBand * width_);
+      std::vector<float> outputBand(rowsPerBand * width_);
+      std::vector<std::exception_ptr> errors(frameCount);
+
+      INFOMESSAGE("Master frame: Combining " + std::to_string(frameCount) + " frames in bands of " + std::to_string(rowsPerBand) +
+                  " rows.");
+
+      for (std::size_t firstRow = 0; (firstRow < height_) && !cancelled_; firstRow += rowsPerBand)
+      {
+        std::size_t rowCount = std::min(rowsPerBand, height_ - firstRow);
+        std::size_t const bandPixels = rowCount * width_;
+        long firstPixel[2] = {1, static_cast<long>(firstRow) + 1};
+
+        parallelFor(frameCount, [&](std::size_t frameBegin, std::size_t frameEnd)
+        {
+          for (std::size_t frame = frameBegin; frame < frameEnd; ++frame)
+          {
+            try
+            {
+              readRows(frame, firstRow, rowCount, bandData.data() + frame * bandPixels);
+            }
+            catch(...)
+            {
+              errors[frame] = std::current_exception();
+            };
+          };
+        });
+
+        for (std::exception_ptr const &error : errors)
+        {
+          if (error)
+          {
+            std::rethrow_exception(error);
+          };
+        };
+
+        parallelFor((bandPixels + TILE_PIXELS - 1) / TILE_PIXELS, [&](std::size_t tileBegin, std::size_t tileEnd)
+        {
+          CCombineTile tile(frameCount, TILE_PIXELS);
+
+          for (std::size_t tileIndex = tileBegin; tileIndex < tileEnd; ++tileIndex)
+          {
+            std::size_t tileFirst = tileIndex * TILE_PIXELS;
+            std::size_t tilePixels = std::min(TILE_PIXELS, bandPixels - tileFirst);
+
+            tile.clear(tilePixels);
+
+            for (std::size_t frame = 0; frame < frameCount; ++frame)
+            {
+              float const *frameData = bandData.data() + frame * bandPixels + tileFirst;
+
+              for (std::size_t pixel = 0; pixel < tilePixels; ++pixel)
+              {
+                tile.addValue(pixel, frameData[pixel]);
+              };
+            };
+
+            tile.combine(stackMode, outputBand.data() + tileFirst);
+          };
+        });
+
+        CFITSIO_TEST(fits_write_pix, outputFile, TFLOAT, firstPixel, static_cast<LONGLONG>(bandPixels), outputBand.data());
+      };
+    }
+
+    /// @brief      Combines the frames with a running mean.
+    /// @param[in]  outputFile: The output file. The image HDU has been created.
+    /// @details    The mean and variance of each pixel are updated as each frame is read. (Welford's method.) The next frame is
+    ///             read while the current frame is being accumulated, and the accumulation is done in parallel. The standard
+    ///             deviation of the frames is written to an image extension (STDDEV) as a measure of the noise in the master.
+    ///             NaN values are excluded.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CMasterFrameBuilder::combineMean(fitsfile *outputFile)
+    {
+      int status = 0;
+      std::size_t const pixelCount = width_ * height_;
+      std::vector<float> currentFrame(pixelCount);
+      std::vector<float> nextFrame(pixelCount);
+      std::vector<double> mean(pixelCount, 0);
+      std::vector<double> sumSquares(pixelCount, 0);
+      std::vector<std::uint32_t> counts(pixelCount, 0);
+      std::vector<float> outputData(pixelCount);
+      std::exception_ptr readError;
+      QFuture<void> readFuture;
+      long firstPixel[2] = {1, 1};
+      long naxes[2] = {static_cast<long>(width_), static_cast<long>(height_)};
+
+      auto readFrame = [this, &readError](std::size_t frame, float *frameData)
+      {
+        try
+        {
+          readRows(frame, 0, height_, frameData);
+        }
+        catch(...)
+        {
+          readError = std::current_exception();
+        };
+      };
+
+      readFuture = QtConcurrent::run([&readFrame, &nextFrame]() { readFrame(0, nextFrame.data()); });
+
+      for (std::size_t frame = 0; frame < frames_.size(); ++frame)
+      {
+        readFuture.waitForFinished();
+
+        if (cancelled_)
+        {
+          return;
+        };
+
+        if (readError)
+        {
+          std::rethrow_exception(readError);
+        };
+
+        std::swap(currentFrame, nextFrame);
+
+        if ( (frame + 1 < frames_.size()) && !cancelled_ )
+        {
+          readFuture = QtConcurrent::run([&readFrame, &nextFrame, frame]() { readFrame(frame + 1, nextFrame.data()); });
+        };
+
+        parallelFor(pixelCount, [&](std::size_t pixelBegin, std::size_t pixelEnd)
+        {
+          for (std::size_t pixel = pixelBegin; pixel < pixelEnd; ++pixel)
+          {
+            double value = currentFrame[pixel];
+
+            if (!std::isnan(value))
+            {
+              double delta = value - mean[pixel];
+
+              ++counts[pixel];
+              mean[pixel] += delta / counts[pixel];
+              sumSquares[pixel] += delta * (value - mean[pixel]);
+            };
+          };
+        });
+      };
+
+      for (std::size_t pixel = 0; pixel < pixelCount; ++pixel)
+      {
+        outputData[pixel] = (counts[pixel] != 0) ? static_cast<float>(mean[pixel]) : std::numeric_limits<float>::quiet_NaN();
+      };
+      CFITSIO_TEST(fits_write_pix, outputFile, TFLOAT, firstPixel, static_cast<LONGLONG>(pixelCount), outputData.data());
+
+      for (std::size_t pixel = 0; pixel < pixelCount; ++pixel)
+      {
+        outputData[pixel] = (counts[pixel] > 1) ? static_cast<float>(std::sqrt(sumSquares[pixel] / (counts[pixel] - 1))) : 0;
+      };
+
+      CFITSIO_TEST(fits_create_img, outputFile, FLOAT_IMG, 2, naxes);
+      CFITSIO_TEST(fits_update_key, outputFile, TSTRING, "EXTNAME", const_cast<char *>("STDDEV"),
+                   "Standard deviation of the combined frames");
+      CFITSIO_TEST(fits_write_pix, outputFile, TFLOAT, firstPixel, static_cast<LONGLONG>(pixelCount), outputData.data());
+    }
+
+    /// @brief      Creates the master frame and writes it to the output file.
+    /// @param[in]  stackMode: The combine method. SM_MEAN, SM_MEDIAN or SM_SIGMACLIP.
+    /// @param[in]  outputFile: The output file. Overwritten if it exists.
+    /// @returns    true if the master frame was written. false if the combine was cancelled. (The output file is removed.)
+    /// @details    The keywords of the first frame are copied to the master frame. The BIASSUB keyword records whether the
+    ///             bias has been removed from the master.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CCodeError
+    /// @throws     GCL::CRuntimeAssert
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Write the BIASSUB keyword. Return false if cancelled.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CMasterFrameBuilder::createMasterFrame(ACL::CImageStack::EStackMode stackMode, boost::filesystem::path const &outputFile)
+    {
+      RUNTIME_ASSERT(frames_.size() >= 2, "At least two frames are needed to create a master frame.");
+
+      if ( (stackMode != ACL::CImageStack::SM_MEAN) && (stackMode != ACL::CImageStack::SM_MEDIAN) &&
+           (stackMode != ACL::CImageStack::SM_SIGMACLIP) )
+      {
+        CODE_ERROR;
+      };
+
+      if ( !subtractFrame_.empty() && (subtractFrame_.size() != width_ * height_) )
+      {
+        RUNTIME_ERROR(boost::locale::translate("Master frame: The frame to subtract is not the same size as the frames."));
+      };
+
+      bool returnValue = false;
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      int frameCount = static_cast<int>(frames_.size());
+      int biasSubtracted = biasSubtracted_ ? 1 : 0;
+      long naxes[2] = {static_cast<long>(width_), static_cast<long>(height_)};
+
+      frameScales_.assign(frames_.size(), 1);
+      if (normalise_)
+      {
+        calculateScales();
+      };
+
+      boost::filesystem::remove(outputFile);
+
+      try
+      {
+        CFITSIO_TEST(fits_create_diskfile, &fitsFile, outputFile.string().c_str());
+        CFITSIO_TEST(fits_create_img, fitsFile, FLOAT_IMG, 2, naxes);
+        CImageStacker::copyKeywords(frames_.front(), fitsFile);
+        CFITSIO_TEST(fits_update_key, fitsFile, TINT, "NCOMBINE", &frameCount, "Number of images combined");
+        CFITSIO_TEST(fits_update_key, fitsFile, TLOGICAL, "BIASSUB", &biasSubtracted, "Bias has been subtracted");
+
+        if (stackMode == ACL::CImageStack::SM_MEAN)
+        {
+          combineMean(fitsFile);
+        }
+        else
+        {
+          combineBands(fitsFile, stackMode);
+        };
+
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        boost::filesystem::remove(outputFile);
+        throw;
+      };
+
+      if (cancelled_)
+      {
+        INFOMESSAGE("Master frame: Cancelled.");
+        boost::filesystem::remove(outputFile);
+      }
+      else
+      {
+        returnValue = true;
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Reads rows of a frame.
+    /// @param[in]  frame: The index of the frame.
+    /// @param[in]  firstRow: The first row to read.
+    /// @param[in]  rowCount: The number of rows to read.
+    /// @param[out] output: The rows. Null pixels are returned as NaN.
+    /// @details    The frame to subtract is subtracted and the frame scale is applied. May be called concurrently.
+    /// @throws     ACL::CFITSException
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CMasterFrameBuilder::readRows(std::size_t frame, std::size_t firstRow, std::size_t rowCount, float *output) const
+    {
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      long firstPixel[2] = {1, static_cast<long>(firstRow) + 1};
+      float nullValue = std::numeric_limits<float>::quiet_NaN();
+      std::size_t const pixelCount = rowCount * width_;
+
+      try
+      {
+        CFITSIO_TEST(fits_open_diskfile, &fitsFile, frames_[frame].string().c_str(), READONLY);
+        CFITSIO_TEST(fits_read_pix, fitsFile, TFLOAT, firstPixel, static_cast<LONGLONG>(pixelCount), &nullValue, output, nullptr);
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        throw;
+      };
+
+      if (!subtractFrame_.empty())
+      {
+        float const *subtract = subtractFrame_.data() + firstRow * width_;
+
+        for (std::size_t index = 0; index < pixelCount; ++index)
+        {
+          output[index] -= subtract[index];
+        };
+      };
+
+      if (!frameScales_.empty() && (frameScales_[frame] != 1))
+      {
+        float scale = static_cast<float>(frameScales_[frame]);
+
+        for (std::size_t index = 0; index < pixelCount; ++index)
+        {
+          output[index] *= scale;
+        };
+      };
+    }
+
+    /// @brief      Sets a master frame that is subtracted from each frame before combining. (The master bias when creating a
+    ///             master dark, or the master dark when creating a master flat.)
+    /// @param[in]  fileName: The master frame. The image in the primary HDU is used.
+    /// @throws     ACL::CFITSException
+    /// @throws     GCL::CRuntimeError
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CMasterFrameBuilder::subtractFrame(boost::filesystem::path const &fileName)
+    {
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      int naxis;
+      long naxes[2] = {0, 0};
+      long firstPixel[2] = {1, 1};
+      float nullValue = 0;
+
+      try
+      {
+        CFITSIO_TEST(fits_open_diskfile, &fitsFile, fileName.string().c_str(), READONLY);
+        CFITSIO_TEST(fits_get_img_dim, fitsFile, &naxis);
+        CFITSIO_TEST(fits_get_img_size, fitsFile, 2, naxes);
+
+        if ( (naxis != 2) || (naxes[0] < 1) || (naxes[1] < 1) )
+        {
+          RUNTIME_ERROR(boost::locale::translate("Master frame: Only two dimensional images can be combined."));
+        };
+
+        subtractFrame_.resize(static_cast<std::size_t>(naxes[0]) * static_cast<std::size_t>(naxes[1]));
+        CFITSIO_TEST(fits_read_pix, fitsFile, TFLOAT, firstPixel, static_cast<LONGLONG>(subtractFrame_.size()), &nullValue,
+                     subtractFrame_.data(), nullptr);
+        CFITSIO_TEST(fits_close_file, fitsFile);
+      }
+      catch(...)
+      {
+        if (fitsFile)
+        {
+          status = 0;
+          fits_close_file(fitsFile, &status);
+        };
+        std::vector<float>().swap(subtractFrame_);
+        throw;
+      };
+    }
+
+  } // namespace imaging
+} // namespace astroManager
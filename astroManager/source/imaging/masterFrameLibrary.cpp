@@ -0,0 +1,469 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								masterFrameLibrary
+// SUBSYSTEM:						Image calibration.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL, cfitsio
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						An on disk library of master calibration frames. Each master is stored in the library directory and is indexed
+//                      (library.ini) by frame type, instrument, binning, exposure, CCD temperature, filter and date. The
+//                      frames that the master was created from are recorded with their sizes and modification times. A master
+//                      is invalidated (and removed from the library) when any of its source frames change. Masters can be
+//                      found either for an image to be calibrated, or for a set of source frames so that the master does not need
+//                      to be created again.
+//
+// CLASSES INCLUDED:    CMasterFrameLibrary
+//
+// CLASS HIERARCHY:     CMasterFrameLibrary
+//
+// HISTORY:             2026-10-17 GGB - Record whether the bias has been subtracted from a master.
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/masterFrameLibrary.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <limits>
+
+  // Qt library header files
+
+#include <QDate>
+#include <QStandardPaths>
+
+  // astroManager header files
+
+#include "include/settings.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    static char const *FRAME_TYPE_NAMES[] = {"bias", "dark", "flat"};
+
+    /// @brief      Constructor for the class. Opens the library index.
+    /// @details    The library directory is read from the IMAGE_CALIBRATION_LIBRARY_DIRECTORY setting and is created if it does
+    ///             not exist.
+    /// @throws     boost::filesystem::filesystem_error
+    /// @version    2026-10-17/GGB - Function created.
+
+    CMasterFrameLibrary::CMasterFrameLibrary()
+      : libraryDirectory_(settings::astroManagerSettings->value(settings::IMAGE_CALIBRATION_LIBRARY_DIRECTORY,
+          QVariant(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/masterFrames")).toString().toStdString()),
+        index_(QString::fromStdString((libraryDirectory_ / "library.ini").string()), QSettings::IniFormat),
+        temperatureTolerance_(settings::astroManagerSettings->value(settings::IMAGE_CALIBRATION_LIBRARY_TEMPERATURE,
+                                                                    QVariant(1.0)).toDouble()),
+        maximumAge_(settings::astroManagerSettings->value(settings::IMAGE_CALIBRATION_LIBRARY_MAXIMUMAGE, QVariant(30)).toInt())
+    {
+      boost::filesystem::create_directories(libraryDirectory_);
+    }
+
+    /// @brief      Adds a master frame to the library.
+    /// @param[in]  frameType: The type of the master frame.
+    /// @param[in]  masterFile: The master frame. The file is copied into the library.
+    /// @param[in]  sourceFrames: The frames the master was created from.
+    /// @param[in]  subtractFrame: The master frame that was subtracted from the source frames. (Empty if none.)
+    /// @param[in]  combineMode: The combine mode used to create the master.
+    /// @returns    The path of the master in the library.
+    /// @details    The master is indexed using the keywords of the master frame. (The keywords of the first source frame and the
+    ///             BIASSUB keyword.)
+    /// @throws     ACL::CFITSException
+    /// @throws     boost::filesystem::filesystem_error
+    /// @version    2026-10-17/GGB - Record the BIASSUB state of the master.
+    /// @version    2026-10-17/GGB - Function created.
+
+    boost::filesystem::path CMasterFrameLibrary::addMaster(EFrameType frameType, boost::filesystem::path const &masterFile,
+                                                           std::vector<boost::filesystem::path> const &sourceFrames,
+                                                           boost::filesystem::path const &subtractFrame, int combineMode)
+    {
+      SFrameKey frameKey = readFrameKey(masterFile);
+      std::string masterName = std::string(FRAME_TYPE_NAMES[frameType]) + "-" +
+                               boost::filesystem::unique_path("%%%%%%%%%%%%").string();
+      boost::filesystem::path returnValue = libraryDirectory_ / (masterName + ".fits");
+
+      boost::filesystem::copy_file(masterFile, returnValue);
+
+      index_.beginGroup(QString::fromStdString(masterName));
+      index_.setValue("Type", static_cast<int>(frameType));
+      index_.setValue("File", QString::fromStdString(returnValue.string()));
+      index_.setValue("Instrument", QString::fromStdString(frameKey.instrument));
+      index_.setValue("XBinning", frameKey.xBinning);
+      index_.setValue("YBinning", frameKey.yBinning);
+      index_.setValue("Exposure", frameKey.exposure);
+      if (frameKey.hasTemperature)
+      {
+        index_.setValue("Temperature", frameKey.temperature);
+      };
+      index_.setValue("Filter", QString::fromStdString(frameKey.filter));
+      index_.setValue("Date", QString::fromStdString(frameKey.date));
+      index_.setValue("BiasSubtracted", frameKey.biasSubtracted);
+      index_.setValue("CombineMode", combineMode);
+      index_.setValue("Sources", fingerprints(sourceFrames, subtractFrame));
+      index_.endGroup();
+      index_.sync();
+
+      INFOMESSAGE("Master frame library: Added " + returnValue.string());
+
+      return returnValue;
+    }
+
+    /// @brief      Finds a master frame to calibrate an image.
+    /// @param[in]  frameType: The type of master frame to find.
+    /// @param[in]  frameKey: The key of the image to calibrate.
+    /// @param[in]  masterBias: true if the image is also calibrated with a master bias.
+    /// @returns    The path of the master. Empty if there is no suitable master.
+    /// @details    The masters must have the same instrument and binning. Dark frames must have the same exposure (within 1%)
+    ///             and flat frames the same filter. Bias and dark frames must have a CCD temperature within the tolerance. A
+    ///             dark frame with the bias subtracted is only suitable if a master bias is also used. Of the suitable masters,
+    ///             flat frames with the bias subtracted are preferred, then the master closest in temperature and then in date
+    ///             is returned. Masters with changed source frames are removed from the library.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Only return masters with a compatible bias state.
+    /// @version    2026-10-17/GGB - Function created.
+
+    boost::filesystem::path CMasterFrameLibrary::findMaster(EFrameType frameType, SFrameKey const &frameKey, bool masterBias)
+    {
+      boost::filesystem::path returnValue;
+      bool bestBiasSubtracted = false;
+      FP_t bestTemperature = std::numeric_limits<FP_t>::max();
+      qint64 bestAge = std::numeric_limits<qint64>::max();
+      QDate frameDate = QDate::fromString(QString::fromStdString(frameKey.date), Qt::ISODate);
+
+      for (QString const &masterName : index_.childGroups())
+      {
+        if ( (index_.value(masterName + "/Type").toInt() == frameType) && isValid(masterName) )
+        {
+          SFrameKey masterKey = indexKey(masterName);
+
+          if (matches(frameType, frameKey, masterKey, masterBias))
+          {
+            FP_t temperature = (frameKey.hasTemperature && masterKey.hasTemperature) ?
+                                 std::abs(frameKey.temperature - masterKey.temperature) : 0;
+            QDate masterDate = QDate::fromString(QString::fromStdString(masterKey.date), Qt::ISODate);
+            qint64 age = (frameDate.isValid() && masterDate.isValid()) ? std::abs(masterDate.daysTo(frameDate)) : 0;
+
+            bool biasSubtracted = (frameType == FT_FLAT) && masterKey.biasSubtracted;
+
+            if ( (biasSubtracted && !bestBiasSubtracted) ||
+                 ((biasSubtracted == bestBiasSubtracted) &&
+                  ((temperature < bestTemperature) || ((temperature == bestTemperature) && (age < bestAge)))) )
+            {
+              bestBiasSubtracted = biasSubtracted;
+              bestTemperature = temperature;
+              bestAge = age;
+              returnValue = index_.value(masterName + "/File").toString().toStdString();
+            };
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Finds a master frame that has been created from a set of frames.
+    /// @param[in]  frameType: The type of master frame.
+    /// @param[in]  sourceFrames: The frames to create the master from.
+    /// @param[in]  subtractFrame: The master frame subtracted from the frames. (Empty if none.)
+    /// @param[in]  combineMode: The combine mode.
+    /// @returns    The path of the master. Empty if the master needs to be created.
+    /// @details    The master is only returned if none of the frames have changed since the master was created.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    boost::filesystem::path CMasterFrameLibrary::findMaster(EFrameType frameType,
+                                                            std::vector<boost::filesystem::path> const &sourceFrames,
+                                                            boost::filesystem::path const &subtractFrame, int combineMode)
+    {
+      boost::filesystem::path returnValue;
+      QStringList sourceFingerprints = fingerprints(sourceFrames, subtractFrame);
+
+      sourceFingerprints.sort();
+
+      for (QString const &masterName : index_.childGroups())
+      {
+        if ( (index_.value(masterName + "/Type").toInt() == frameType) &&
+             (index_.value(masterName + "/CombineMode").toInt() == combineMode) && isValid(masterName) )
+        {
+          QStringList masterFingerprints = index_.value(masterName + "/Sources").toStringList();
+
+          masterFingerprints.sort();
+
+          if (masterFingerprints == sourceFingerprints)
+          {
+            returnValue = index_.value(masterName + "/File").toString().toStdString();
+            break;
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Returns the fingerprint of a file. (The path, size and modification time.)
+    /// @param[in]  fileName: The file.
+    /// @returns    The fingerprint. Empty if the file does not exist.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    QString CMasterFrameLibrary::fingerprint(boost::filesystem::path const &fileName)
+    {
+      QString returnValue;
+      boost::system::error_code errorCode;
+      boost::filesystem::path absolutePath = boost::filesystem::absolute(fileName);
+      boost::uintmax_t fileSize = boost::filesystem::file_size(absolutePath, errorCode);
+
+      if (!errorCode)
+      {
+        std::time_t writeTime = boost::filesystem::last_write_time(absolutePath, errorCode);
+
+        if (!errorCode)
+        {
+          returnValue = QString("%1|%2|%3").arg(QString::fromStdString(absolutePath.string()))
+                                           .arg(static_cast<qulonglong>(fileSize)).arg(static_cast<qlonglong>(writeTime));
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Returns the fingerprints of the source frames of a master.
+    /// @param[in]  sourceFrames: The source frames.
+    /// @param[in]  subtractFrame: The master frame subtracted from the source frames. (Empty if none.)
+    /// @returns    The fingerprints. The subtract frame is prefixed with "-".
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    QStringList CMasterFrameLibrary::fingerprints(std::vector<boost::filesystem::path> const &sourceFrames,
+                                                  boost::filesystem::path const &subtractFrame)
+    {
+      QStringList returnValue;
+
+      for (boost::filesystem::path const &sourceFrame : sourceFrames)
+      {
+        returnValue << fingerprint(sourceFrame);
+      };
+
+      if (!subtractFrame.empty())
+      {
+        returnValue << "-" + fingerprint(subtractFrame);
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Returns the key of a master in the index.
+    /// @param[in]  masterName: The name of the master in the index.
+    /// @returns    The key of the master.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CMasterFrameLibrary::SFrameKey CMasterFrameLibrary::indexKey(QString const &masterName)
+    {
+      SFrameKey returnValue;
+
+      index_.beginGroup(masterName);
+      returnValue.instrument = index_.value("Instrument").toString().toStdString();
+      returnValue.xBinning = index_.value("XBinning", QVariant(1)).toInt();
+      returnValue.yBinning = index_.value("YBinning", QVariant(1)).toInt();
+      returnValue.exposure = index_.value("Exposure", QVariant(0)).toDouble();
+      returnValue.hasTemperature = index_.contains("Temperature");
+      returnValue.temperature = index_.value("Temperature", QVariant(0)).toDouble();
+      returnValue.filter = index_.value("Filter").toString().toStdString();
+      returnValue.date = index_.value("Date").toString().toStdString();
+      returnValue.biasSubtracted = index_.value("BiasSubtracted", QVariant(false)).toBool();
+      index_.endGroup();
+
+      return returnValue;
+    }
+
+    /// @brief      Checks that a master is still valid. Invalid masters are removed from the library.
+    /// @param[in]  masterName: The name of the master in the index.
+    /// @returns    true if the master file exists and none of its source frames have changed.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CMasterFrameLibrary::isValid(QString const &masterName)
+    {
+      bool returnValue = boost::filesystem::exists(index_.value(masterName + "/File").toString().toStdString());
+
+      if (returnValue)
+      {
+        for (QString const &sourceFingerprint : index_.value(masterName + "/Sources").toStringList())
+        {
+          QString storedFingerprint = sourceFingerprint.startsWith("-") ? sourceFingerprint.mid(1) : sourceFingerprint;
+
+          if (fingerprint(storedFingerprint.section('|', 0, 0).toStdString()) != storedFingerprint)
+          {
+            returnValue = false;
+            break;
+          };
+        };
+      };
+
+      if (!returnValue)
+      {
+        INFOMESSAGE("Master frame library: " + masterName.toStdString() + " is no longer valid. Removed from the library.");
+        removeMaster(masterName);
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Determines if a master is suitable to calibrate a frame.
+    /// @param[in]  frameType: The type of the master.
+    /// @param[in]  frameKey: The key of the frame to calibrate.
+    /// @param[in]  masterKey: The key of the master.
+    /// @param[in]  masterBias: true if the frame is also calibrated with a master bias.
+    /// @returns    true if the master is suitable.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - A dark frame without the bias needs a master bias.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CMasterFrameLibrary::matches(EFrameType frameType, SFrameKey const &frameKey, SFrameKey const &masterKey,
+                                      bool masterBias) const
+    {
+      bool returnValue = (frameKey.instrument == masterKey.instrument) && (frameKey.xBinning == masterKey.xBinning) &&
+                         (frameKey.yBinning == masterKey.yBinning);
+
+      if (returnValue && (frameType == FT_DARK))
+      {
+        returnValue = (std::abs(frameKey.exposure - masterKey.exposure) <=
+                       0.01 * std::max(frameKey.exposure, masterKey.exposure)) && (masterBias || !masterKey.biasSubtracted);
+      };
+
+      if (returnValue && (frameType == FT_FLAT))
+      {
+        returnValue = (frameKey.filter == masterKey.filter);
+      };
+
+      if (returnValue && (frameType != FT_FLAT) && frameKey.hasTemperature)
+      {
+        returnValue = masterKey.hasTemperature && (std::abs(frameKey.temperature - masterKey.temperature) <= temperatureTolerance_);
+      };
+
+      if (returnValue)
+      {
+        QDate frameDate = QDate::fromString(QString::fromStdString(frameKey.date), Qt::ISODate);
+        QDate masterDate = QDate::fromString(QString::fromStdString(masterKey.date), Qt::ISODate);
+
+        if (frameDate.isValid() && masterDate.isValid())
+        {
+          returnValue = std::abs(masterDate.daysTo(frameDate)) <= maximumAge_;
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Reads the key of a frame from the FITS header.
+    /// @param[in]  fileName: The frame.
+    /// @returns    The key of the frame. Keywords that are not present have their default values.
+    /// @details    The exposure is read from EXPOSURE (or EXPTIME) and the CCD temperature from CCD-TEMP (or CCD_TEMP). Only the
+    ///             date part of DATE-OBS is used. Frames without a BIASSUB keyword are taken to include the bias.
+    /// @throws     ACL::CFITSException
+    /// @version    2026-10-17/GGB - Read the BIASSUB keyword.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CMasterFrameLibrary::SFrameKey CMasterFrameLibrary::readFrameKey(boost::filesystem::path const &fileName)
+    {
+      SFrameKey returnValue;
+      fitsfile *fitsFile = nullptr;
+      int status = 0;
+      char stringValue[FLEN_VALUE];
+      double doubleValue;
+      int logicalValue;
+
+      CFITSIO_TEST(fits_open_diskfile, &fitsFile, fileName.string().c_str(), READONLY);
+
+      auto readString = [&](char const *keyword, std::string &value)
+      {
+        status = 0;
+        if (!fits_read_key(fitsFile, TSTRING, keyword, stringValue, nullptr, &status))
+        {
+          value = stringValue;
+        };
+      };
+      auto readDouble = [&](char const *keyword, FP_t &value)
+      {
+        bool found = false;
+
+        status = 0;
+        if (!fits_read_key(fitsFile, TDOUBLE, keyword, &doubleValue, nullptr, &status))
+        {
+          value = doubleValue;
+          found = true;
+        };
+
+        return found;
+      };
+
+      readString("INSTRUME", returnValue.instrument);
+      readString("FILTER", returnValue.filter);
+      readString("DATE-OBS", returnValue.date);
+      returnValue.date = returnValue.date.substr(0, 10);
+
+      status = 0;
+      fits_read_key(fitsFile, TINT, "XBINNING", &returnValue.xBinning, nullptr, &status);
+      status = 0;
+      fits_read_key(fitsFile, TINT, "YBINNING", &returnValue.yBinning, nullptr, &status);
+
+      if (!readDouble("EXPOSURE", returnValue.exposure))
+      {
+        readDouble("EXPTIME", returnValue.exposure);
+      };
+
+      returnValue.hasTemperature = readDouble("CCD-TEMP", returnValue.temperature) ||
+                                   readDouble("CCD_TEMP", returnValue.temperature);
+
+      status = 0;
+      if (!fits_read_key(fitsFile, TLOGICAL, "BIASSUB", &logicalValue, nullptr, &status))
+      {
+        returnValue.biasSubtracted = (logicalValue != 0);
+      };
+
+      status = 0;
+      CFITSIO_TEST(fits_close_file, fitsFile);
+
+      return returnValue;
+    }
+
+    /// @brief      Removes a master from the library. The master file is deleted.
+    /// @param[in]  masterName: The name of the master in the index.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CMasterFrameLibrary::removeMaster(QString const &masterName)
+    {
+      boost::system::error_code errorCode;
+
+      boost::filesystem::remove(index_.value(masterName + "/File").toString().toStdString(), errorCode);
+      index_.remove(masterName);
+      index_.sync();
+    }
+
+  } // namespace imaging
+} // namespace astroManager
@@ -0,0 +1,554 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								pixelBuffer
+// SUBSYSTEM:						Contiguous copies of image data for the display and analysis code.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, ACL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Implements a contiguous, typed copy of the pixel data of an image HDB.
+//
+// CLASSES INCLUDED:    CPixelBuffer
+//
+// CLASS HIERARCHY:     CPixelBuffer
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/pixelBuffer.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+  // Miscellaneous library header files.
+
+#include <QtConcurrent/QtConcurrent>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    std::size_t const BANDS_PER_THREAD = 4;       ///< Allows for uneven progress of the threads.
+    std::size_t const CHUNK_SIZE = 1024;          ///< Number of pixels converted to bin indexes at a time.
+    std::size_t const COLOUR_PLANES = 3;          ///< Poly images are displayed as RGB.
+
+    /// @brief      Splits the range [0, count) into bands and calls the function for each band using the global thread pool.
+    /// @param[in]  count: The number of items. (Normally the number of rows in an image)
+    /// @param[in]  function: The function to call for each band. Called with the first item and one past the last item.
+    /// @details    The function returns when all the bands have been processed. The function must not throw.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void parallelFor(std::size_t count, std::function<void(std::size_t, std::size_t)> const &function)
+    {
+      std::size_t numberOfBands = std::min(count,
+                                           static_cast<std::size_t>(std::max(QThreadPool::globalInstance()->maxThreadCount(), 1)) *
+                                           BANDS_PER_THREAD);
+
+      if (numberOfBands <= 1)
+      {
+        function(0, count);
+      }
+      else
+      {
+        std::vector<std::pair<std::size_t, std::size_t>> bands;
+        std::size_t bandStart = 0;
+
+        bands.reserve(numberOfBands);
+        for (std::size_t band = 0; band < numberOfBands; ++band)
+        {
+          std::size_t bandEnd = (count * (band + 1)) / numberOfBands;
+
+          bands.emplace_back(bandStart, bandEnd);
+          bandStart = bandEnd;
+        };
+
+        QtConcurrent::blockingMap(bands, [&function](std::pair<std::size_t, std::size_t> &band)
+        {
+          function(band.first, band.second);
+        });
+      };
+    }
+
+    /// @brief      Reduces the resolution of an image by averaging blocks of pixels.
+    /// @tparam     T: The pixel type.
+    /// @tparam     A: The type used to accumulate the block sums.
+    /// @param[in]  input: The input image.
+    /// @param[in]  width: The width of the input image.
+    /// @param[in]  height: The height of the input image.
+    /// @param[in]  binning: The size of the blocks. The blocks at the right and bottom edges may be smaller.
+    /// @param[out] output: The output image. Must have room for ceil(width / binning) * ceil(height / binning) pixels.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    template<typename T, typename A>
+    void boxFilter(T const *input, std::size_t width, std::size_t height, std::size_t binning, T *output)
+    {
+      std::size_t outputWidth = (width + binning - 1) / binning;
+      std::size_t outputHeight = (height + binning - 1) / binning;
+
+      parallelFor(outputHeight, [&](std::size_t rowBegin, std::size_t rowEnd)
+      {
+        std::vector<A> sums(outputWidth);
+
+        for (std::size_t outputRow = rowBegin; outputRow < rowEnd; ++outputRow)
+        {
+          std::size_t firstRow = outputRow * binning;
+          std::size_t lastRow = std::min(firstRow + binning, height);
+
+          std::fill(sums.begin(), sums.end(), A(0));
+
+          for (std::size_t row = firstRow; row < lastRow; ++row)
+          {
+            T const *inputRow = input + row * width;
+
+            for (std::size_t outputColumn = 0; outputColumn < outputWidth; ++outputColumn)
+            {
+              std::size_t firstColumn = outputColumn * binning;
+              std::size_t lastColumn = std::min(firstColumn + binning, width);
+              A sum = 0;
+
+              for (std::size_t column = firstColumn; column < lastColumn; ++column)
+              {
+                sum += inputRow[column];
+              };
+              sums[outputColumn] += sum;
+            };
+          };
+
+          for (std::size_t outputColumn = 0; outputColumn < outputWidth; ++outputColumn)
+          {
+            std::size_t columns = std::min(binning, width - outputColumn * binning);
+            A count = static_cast<A>(columns * (lastRow - firstRow));
+            A sum = sums[outputColumn];
+
+            if constexpr (std::is_integral<T>::value)
+            {
+              sum += count / 2;                   // Round to the nearest integer.
+            };
+
+            output[outputRow * outputWidth + outputColumn] = static_cast<T>(sum / count);
+          };
+        };
+      });
+    }
+
+    //*****************************************************************************************************************************
+    //
+    // CPixelBuffer
+    //
+    //*****************************************************************************************************************************
+
+    /// @brief      Constructor for the class. Copies the pixel data from the image.
+    /// @param[in]  astroFile: The astroFile containing the image.
+    /// @param[in]  hdb: The HDB containing the image.
+    /// @details    Integer images with all values in the range 0-65535 are copied as 16 bit values. If the image is not an
+    ///             integer image, or a value outside the range is found, the image is copied as floating point values.
+    ///             Poly images are copied as three planes (red, green, blue), one after the other.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Added support for poly images.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CPixelBuffer::CPixelBuffer(CAstroFile &astroFile, ACL::DHDBStore::size_type hdb) : source_(astroFile.getAstroImage(hdb)),
+      hdb_(hdb), width_(0), height_(0), planes_(1), binning_(1), pixelType_(PT_FLOAT), data16_(), dataFloat_(), minValue_(0),
+      maxValue_(0), histogram_(), proxy_()
+    {
+      ACL::CAstroImage *astroImage = astroFile.getAstroImage(hdb);
+
+      RUNTIME_ASSERT(astroImage, "Parameter astroImage cannot be nullptr");
+
+      width_ = static_cast<std::size_t>(astroImage->width());
+      height_ = static_cast<std::size_t>(astroImage->height());
+      planes_ = astroFile.isPolyImage(hdb) ? COLOUR_PLANES : 1;
+
+      if ( (astroFile.getHDB(hdb)->BITPIX() > 0) && (astroFile.imageMin(hdb) >= 0) &&
+           (astroFile.imageMax(hdb) <= std::numeric_limits<std::uint16_t>::max()) && copyInteger(astroImage) )
+      {
+        pixelType_ = PT_UINT16;
+      }
+      else
+      {
+        copyFloat(astroImage);
+        pixelType_ = PT_FLOAT;
+      };
+    }
+
+    /// @brief      Constructs a reduced resolution copy of a buffer.
+    /// @param[in]  source: The full resolution buffer.
+    /// @param[in]  binning: The number of pixels (in each axis) to average into each pixel of the new buffer.
+    /// @details    The minimum and maximum values are taken from the source so that the proxy can be used with the same display
+    ///             stretch and look-up tables as the source.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    CPixelBuffer::CPixelBuffer(CPixelBuffer const &source, std::size_t binning) : source_(source.source_), hdb_(source.hdb_),
+      width_((source.width_ + binning - 1) / binning), height_((source.height_ + binning - 1) / binning),
+      planes_(source.planes_), binning_(source.binning_ * binning), pixelType_(source.pixelType_), data16_(), dataFloat_(),
+      minValue_(source.minValue_), maxValue_(source.maxValue_), histogram_(), proxy_()
+    {
+      if (pixelType_ == PT_UINT16)
+      {
+        data16_.resize(width_ * height_ * planes_);
+        for (std::size_t plane = 0; plane < planes_; ++plane)
+        {
+          boxFilter<std::uint16_t, std::uint64_t>(source.row16(0, plane), source.width_, source.height_, binning,
+                                                  data16_.data() + plane * width_ * height_);
+        };
+      }
+      else
+      {
+        dataFloat_.resize(width_ * height_ * planes_);
+        for (std::size_t plane = 0; plane < planes_; ++plane)
+        {
+          boxFilter<float, double>(source.rowFloat(0, plane), source.width_, source.height_, binning,
+                                   dataFloat_.data() + plane * width_ * height_);
+        };
+      };
+    }
+
+    /// @brief      Copies the image as 16 bit integer values.
+    /// @param[in]  astroImage: The image to copy.
+    /// @returns    true - All the values could be stored.
+    /// @returns    false - A value is not an integer, or is out of range. (IE scaled data) The buffer is released.
+    /// @details    The range of each value is checked before it is converted, so out of range and NaN values are never cast.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Check the range before converting the value.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CPixelBuffer::copyInteger(ACL::CAstroImage *astroImage)
+    {
+      std::atomic<bool> valid(true);
+      std::vector<std::pair<std::uint16_t, std::uint16_t>> rowLimits(height_ * planes_);
+
+      data16_.resize(width_ * height_ * planes_);
+
+      parallelFor(height_ * planes_, [&](std::size_t rowBegin, std::size_t rowEnd)
+      {
+        for (std::size_t row = rowBegin; (row < rowEnd) && valid; ++row)
+        {
+          std::uint16_t *output = data16_.data() + row * width_;
+          std::uint16_t rowMin = std::numeric_limits<std::uint16_t>::max();
+          std::uint16_t rowMax = 0;
+
+          for (std::size_t column = 0; column < width_; ++column)
+          {
+            FP_t value = imageValue(astroImage, row, column);
+
+            if ( !(value >= 0) || !(value <= std::numeric_limits<std::uint16_t>::max()) )
+            {
+              valid = false;        // Out of range or NaN.
+              break;
+            };
+
+            std::uint16_t integerValue = static_cast<std::uint16_t>(value);
+
+            if (integerValue != value)
+            {
+              valid = false;
+              break;
+            };
+
+            output[column] = integerValue;
+            rowMin = std::min(rowMin, integerValue);
+            rowMax = std::max(rowMax, integerValue);
+          };
+
+          rowLimits[row] = std::make_pair(rowMin, rowMax);
+        };
+      });
+
+      if (valid)
+      {
+        minValue_ = std::numeric_limits<std::uint16_t>::max();
+        maxValue_ = 0;
+        for (auto const &limits : rowLimits)
+        {
+          minValue_ = std::min(minValue_, static_cast<FP_t>(limits.first));
+          maxValue_ = std::max(maxValue_, static_cast<FP_t>(limits.second));
+        };
+      }
+      else
+      {
+        std::vector<std::uint16_t>().swap(data16_);
+      };
+
+      return valid;
+    }
+
+    /// @brief      Copies the image as floating point values.
+    /// @param[in]  astroImage: The image to copy.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CPixelBuffer::copyFloat(ACL::CAstroImage *astroImage)
+    {
+      std::vector<std::pair<float, float>> rowLimits(height_ * planes_);
+
+      dataFloat_.resize(width_ * height_ * planes_);
+
+      parallelFor(height_ * planes_, [&](std::size_t rowBegin, std::size_t rowEnd)
+      {
+        for (std::size_t row = rowBegin; row < rowEnd; ++row)
+        {
+          float *output = dataFloat_.data() + row * width_;
+          float rowMin = std::numeric_limits<float>::max();
+          float rowMax = std::numeric_limits<float>::lowest();
+
+          for (std::size_t column = 0; column < width_; ++column)
+          {
+            output[column] = static_cast<float>(imageValue(astroImage, row, column));
+            rowMin = std::min(rowMin, output[column]);
+            rowMax = std::max(rowMax, output[column]);
+          };
+
+          rowLimits[row] = std::make_pair(rowMin, rowMax);
+        };
+      });
+
+      minValue_ = std::numeric_limits<FP_t>::max();
+      maxValue_ = std::numeric_limits<FP_t>::lowest();
+      for (auto const &limits : rowLimits)
+      {
+        minValue_ = std::min(minValue_, static_cast<FP_t>(limits.first));
+        maxValue_ = std::max(maxValue_, static_cast<FP_t>(limits.second));
+      };
+    }
+
+    /// @brief      Returns the histogram of the pixel values.
+    /// @param[in]  numberOfBins: The number of bins.
+    /// @returns    The number of pixels in each bin.
+    /// @details    The bins cover the range from the minimum value to the maximum value. The bin size is
+    ///             (maxValue - minValue) / (numberOfBins - 1), so the maximum value falls into the last bin. The histogram is
+    ///             calculated the first time that it is requested and is then cached by the buffer. For poly images the
+    ///             histogram includes all the planes.
+    /// @throws     std::bad_alloc
+    /// @throws     GCL::CRuntimeAssert
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::vector<std::size_t> const &CPixelBuffer::histogram(std::size_t numberOfBins) const
+    {
+      RUNTIME_ASSERT( (numberOfBins > 1) && (numberOfBins <= std::numeric_limits<std::uint16_t>::max()),
+                      "Parameter numberOfBins out of range.");
+
+      if (histogram_.size() != numberOfBins)
+      {
+        FP_t binSize = (maxValue_ - minValue_) / (numberOfBins - 1);
+        FP_t binScale = (binSize > 0) ? 1 / binSize : 0;      // An image with a single value has all pixels in the first bin.
+
+        histogram_.assign(numberOfBins, 0);
+
+        if (pixelType_ == PT_UINT16)
+        {
+          histogram16(histogram_, binScale);
+        }
+        else
+        {
+          histogramFloat(histogram_, binScale);
+        };
+      };
+
+      return histogram_;
+    }
+
+    /// @brief      Calculates the histogram of 16 bit data.
+    /// @param[out] histogram: The histogram. The bins must be zero on entry.
+    /// @param[in]  binScale: The reciprocal of the bin size.
+    /// @details    The bin for each possible pixel value is determined once. Each band of rows is counted into private bins, the
+    ///             private bins are added to the histogram when the band is complete.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CPixelBuffer::histogram16(std::vector<std::size_t> &histogram, FP_t binScale) const
+    {
+      std::size_t numberOfBins = histogram.size();
+      std::vector<std::uint16_t> binIndex(static_cast<std::size_t>(maxValue_) + 1, 0);
+      std::mutex histogramMutex;
+
+      for (std::size_t value = static_cast<std::size_t>(minValue_); value < binIndex.size(); ++value)
+      {
+        binIndex[value] = static_cast<std::uint16_t>(std::min(static_cast<std::size_t>((value - minValue_) * binScale),
+                                                              numberOfBins - 1));
+      };
+
+      parallelFor(height_ * planes_, [&](std::size_t rowBegin, std::size_t rowEnd)
+      {
+        std::vector<std::size_t> bins(numberOfBins, 0);
+        std::uint16_t const *index = binIndex.data();
+
+        for (std::size_t row = rowBegin; row < rowEnd; ++row)
+        {
+          std::uint16_t const *input = row16(row);
+
+          for (std::size_t column = 0; column < width_; ++column)
+          {
+            ++bins[index[input[column]]];
+          };
+        };
+
+        std::lock_guard<std::mutex> lock(histogramMutex);
+
+        for (std::size_t bin = 0; bin < numberOfBins; ++bin)
+        {
+          histogram[bin] += bins[bin];
+        };
+      });
+    }
+
+    /// @brief      Calculates the histogram of floating point data.
+    /// @param[out] histogram: The histogram. The bins must be zero on entry.
+    /// @param[in]  binScale: The reciprocal of the bin size.
+    /// @details    The bin indexes are calculated a chunk at a time by a branch free loop that the compiler can vectorise. Values
+    ///             that do not fall into a bin (NaN) are counted in an additional bin that is discarded.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CPixelBuffer::histogramFloat(std::vector<std::size_t> &histogram, FP_t binScale) const
+    {
+      std::size_t numberOfBins = histogram.size();
+      float const minValue = static_cast<float>(minValue_);
+      float const scale = static_cast<float>(binScale);
+      float const lastBin = static_cast<float>(numberOfBins - 1);
+      std::mutex histogramMutex;
+
+      parallelFor(height_ * planes_, [&](std::size_t rowBegin, std::size_t rowEnd)
+      {
+        std::vector<std::size_t> bins(numberOfBins + 1, 0);
+        std::uint32_t indexes[CHUNK_SIZE];
+
+        for (std::size_t row = rowBegin; row < rowEnd; ++row)
+        {
+          float const *input = rowFloat(row);
+
+          for (std::size_t chunkStart = 0; chunkStart < width_; chunkStart += CHUNK_SIZE)
+          {
+            std::size_t chunkSize = std::min(CHUNK_SIZE, width_ - chunkStart);
+
+            for (std::size_t index = 0; index < chunkSize; ++index)
+            {
+              float value = (input[chunkStart + index] - minValue) * scale;
+              bool valid = (value >= 0.0f);                     // false for NaN.
+
+              value = (value < lastBin) ? value : lastBin;      // Rounding at the maximum value.
+              indexes[index] = valid ? static_cast<std::uint32_t>(value) : static_cast<std::uint32_t>(numberOfBins);
+            };
+
+            for (std::size_t index = 0; index < chunkSize; ++index)
+            {
+              ++bins[indexes[index]];
+            };
+          };
+        };
+
+        std::lock_guard<std::mutex> lock(histogramMutex);
+
+        for (std::size_t bin = 0; bin < numberOfBins; ++bin)
+        {
+          histogram[bin] += bins[bin];
+        };
+      });
+    }
+
+    /// @brief      Returns a reduced resolution copy of the buffer.
+    /// @param[in]  maximumDimension: The maximum width and height of the proxy.
+    /// @returns    The proxy. If the buffer is already small enough, the buffer itself is returned.
+    /// @details    The proxy is created by averaging blocks of pixels. It is created the first time that it is requested and is
+    ///             then cached by the buffer.
+    /// @pre        The buffer must be owned by a std::shared_ptr.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::shared_ptr<CPixelBuffer const> CPixelBuffer::proxy(std::size_t maximumDimension) const
+    {
+      RUNTIME_ASSERT(maximumDimension > 0, "Parameter maximumDimension must be greater than zero.");
+
+      std::shared_ptr<CPixelBuffer const> returnValue;
+      std::size_t binning = (std::max(width_, height_) + maximumDimension - 1) / maximumDimension;
+
+      if (binning <= 1)
+      {
+        returnValue = shared_from_this();
+      }
+      else
+      {
+        if (!proxy_ || (proxy_->binning_ != binning * binning_))
+        {
+          proxy_.reset(new CPixelBuffer(*this, binning));
+        };
+
+        returnValue = proxy_;
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Returns a value from the image.
+    /// @param[in]  astroImage: The image.
+    /// @param[in]  row: The buffer row. (Rows of the planes follow each other)
+    /// @param[in]  column: The column.
+    /// @returns    The value of the pixel.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    FP_t CPixelBuffer::imageValue(ACL::CAstroImage *astroImage, std::size_t row, std::size_t column) const
+    {
+      FP_t returnValue;
+      ACL::INDEX_t index = static_cast<ACL::INDEX_t>((row % height_) * width_ + column);
+
+      if (planes_ == 1)
+      {
+        returnValue = astroImage->getValue(index);
+      }
+      else
+      {
+        returnValue = astroImage->getValue(index, row / height_);
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Determines if the buffer is a copy of the specified image.
+    /// @param[in]  astroFile: The astroFile containing the image.
+    /// @param[in]  hdb: The HDB containing the image.
+    /// @returns    true if the buffer was created from the image and the image size has not changed.
+    /// @note       Changes to the pixel values of the same image are not detected. The owner of the buffer must discard the buffer
+    ///             when the pixel values change.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CPixelBuffer::isCopyOf(CAstroFile &astroFile, ACL::DHDBStore::size_type hdb) const
+    {
+      ACL::CAstroImage *astroImage = astroFile.getAstroImage(hdb);
+
+      return ( (hdb == hdb_) && (astroImage == source_) && astroImage &&
+               (static_cast<std::size_t>(astroImage->width()) == width_) &&
+               (static_cast<std::size_t>(astroImage->height()) == height_) );
+    }
+
+  } // namespace imaging
+} // namespace astroManager
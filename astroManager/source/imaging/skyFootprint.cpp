@@ -0,0 +1,225 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								skyFootprint
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	MCL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						The intersection of the sky footprints of a set of images. Each footprint is the polygon formed by the
+//                      coordinates of the image corners, projected onto the plane tangent to the sky at a reference point.
+//                      The footprints are intersected (convex polygon clipping) as they are added, so the common overlap of a
+//                      set of images is found in a single pass. Points inside the overlap are used to align the images.
+//
+// CLASSES INCLUDED:    CSkyFootprint
+//
+// CLASS HIERARCHY:     CSkyFootprint
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/skyFootprint.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    FP_t const DEGREES_TO_RADIANS = M_PI / 180;   ///< Conversion factor from degrees to radians.
+
+    /// @brief      Constructor for the class.
+    /// @param[in]  ra: Right ascension of the tangent point. (Degrees)
+    /// @param[in]  dec: Declination of the tangent point. (Degrees)
+    /// @details    The tangent point should be near the centre of the footprints, normally the centre of the reference image.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CSkyFootprint::CSkyFootprint(FP_t ra, FP_t dec) : ra0_(ra * DEGREES_TO_RADIANS), dec0_(dec * DEGREES_TO_RADIANS), overlap_()
+    {
+    }
+
+    /// @brief      Returns two points inside the common overlap that are far apart.
+    /// @param[in]  seperation: The fraction (0-1) of the distance from the centroid of the overlap to the two vertices of the
+    ///             overlap that are furthest apart.
+    /// @returns    The two points. (RA, Dec in degrees). No value if there is no common overlap.
+    /// @details    As the overlap is convex, the points are inside the overlap for any seperation up to 1.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::optional<std::pair<MCL::TPoint2D<FP_t>, MCL::TPoint2D<FP_t>>> CSkyFootprint::alignmentPoints(FP_t seperation) const
+    {
+      std::optional<std::pair<MCL::TPoint2D<FP_t>, MCL::TPoint2D<FP_t>>> returnValue;
+
+      if (!isEmpty())
+      {
+        FP_t centroidX = 0, centroidY = 0;
+        std::size_t first = 0, second = 1;
+        FP_t maximumDistance = 0;
+
+        for (MCL::TPoint2D<FP_t> const &vertex : overlap_)
+        {
+          centroidX += vertex.x() / overlap_.size();
+          centroidY += vertex.y() / overlap_.size();
+        };
+
+        for (std::size_t i = 0; i < overlap_.size(); ++i)
+        {
+          for (std::size_t j = i + 1; j < overlap_.size(); ++j)
+          {
+            FP_t distance = std::hypot(overlap_[i].x() - overlap_[j].x(), overlap_[i].y() - overlap_[j].y());
+
+            if (distance > maximumDistance)
+            {
+              maximumDistance = distance;
+              first = i;
+              second = j;
+            };
+          };
+        };
+
+        auto alignmentPoint = [&](MCL::TPoint2D<FP_t> const &vertex)
+        {
+          return deproject(MCL::TPoint2D<FP_t>(centroidX + (vertex.x() - centroidX) * seperation,
+                                               centroidY + (vertex.y() - centroidY) * seperation));
+        };
+
+        returnValue = std::make_pair(alignmentPoint(overlap_[first]), alignmentPoint(overlap_[second]));
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Converts a point in the tangent plane to sky coordinates. (Inverse gnomonic projection)
+    /// @param[in]  point: The point in the tangent plane.
+    /// @returns    The sky coordinates. (RA, Dec in degrees)
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    MCL::TPoint2D<FP_t> CSkyFootprint::deproject(MCL::TPoint2D<FP_t> const &point) const
+    {
+      FP_t denominator = std::cos(dec0_) - point.y() * std::sin(dec0_);
+      FP_t ra = ra0_ + std::atan2(point.x(), denominator);
+      FP_t dec = std::atan2(std::sin(dec0_) + point.y() * std::cos(dec0_), std::hypot(point.x(), denominator));
+
+      ra = std::fmod(ra / DEGREES_TO_RADIANS + 360, 360);
+
+      return MCL::TPoint2D<FP_t>(ra, dec / DEGREES_TO_RADIANS);
+    }
+
+    /// @brief      Intersects the common overlap with the footprint of an image.
+    /// @param[in]  corners: The sky coordinates (RA, Dec in degrees) of the corners of the image, in order around the image.
+    /// @details    The footprint is projected onto the tangent plane and the overlap is clipped against each edge of the
+    ///             footprint. (Sutherland-Hodgman) The first footprint becomes the overlap.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CSkyFootprint::intersect(std::vector<MCL::TPoint2D<FP_t>> const &corners)
+    {
+      std::vector<MCL::TPoint2D<FP_t>> footprint;
+      FP_t area = 0;
+
+      for (MCL::TPoint2D<FP_t> const &corner : corners)
+      {
+        footprint.push_back(project(corner));
+      };
+
+        // Make the footprint counter clockwise. (Images may be flipped.)
+
+      for (std::size_t index = 0; index < footprint.size(); ++index)
+      {
+        MCL::TPoint2D<FP_t> const &current = footprint[index];
+        MCL::TPoint2D<FP_t> const &next = footprint[(index + 1) % footprint.size()];
+
+        area += current.x() * next.y() - next.x() * current.y();
+      };
+      if (area < 0)
+      {
+        std::reverse(footprint.begin(), footprint.end());
+      };
+
+      if (!hasFootprint_)
+      {
+        overlap_ = footprint;
+        hasFootprint_ = true;
+      }
+      else
+      {
+        for (std::size_t edge = 0; (edge < footprint.size()) && !isEmpty(); ++edge)
+        {
+          MCL::TPoint2D<FP_t> const &edgeStart = footprint[edge];
+          MCL::TPoint2D<FP_t> const &edgeEnd = footprint[(edge + 1) % footprint.size()];
+          std::vector<MCL::TPoint2D<FP_t>> input;
+
+          auto side = [&](MCL::TPoint2D<FP_t> const &point)     // > 0 is inside. (Left of the edge)
+          {
+            return (edgeEnd.x() - edgeStart.x()) * (point.y() - edgeStart.y()) -
+                   (edgeEnd.y() - edgeStart.y()) * (point.x() - edgeStart.x());
+          };
+
+          std::swap(input, overlap_);
+
+          for (std::size_t index = 0; index < input.size(); ++index)
+          {
+            MCL::TPoint2D<FP_t> const &current = input[index];
+            MCL::TPoint2D<FP_t> const &previous = input[(index + input.size() - 1) % input.size()];
+            FP_t currentSide = side(current);
+            FP_t previousSide = side(previous);
+
+            if ( (currentSide >= 0) != (previousSide >= 0) )
+            {
+              FP_t t = previousSide / (previousSide - currentSide);
+
+              overlap_.emplace_back(previous.x() + t * (current.x() - previous.x()),
+                                    previous.y() + t * (current.y() - previous.y()));
+            };
+            if (currentSide >= 0)
+            {
+              overlap_.push_back(current);
+            };
+          };
+        };
+      };
+    }
+
+    /// @brief      Projects sky coordinates onto the tangent plane. (Gnomonic projection)
+    /// @param[in]  coordinates: The sky coordinates. (RA, Dec in degrees)
+    /// @returns    The point in the tangent plane.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    MCL::TPoint2D<FP_t> CSkyFootprint::project(MCL::TPoint2D<FP_t> const &coordinates) const
+    {
+      FP_t ra = coordinates.x() * DEGREES_TO_RADIANS;
+      FP_t dec = coordinates.y() * DEGREES_TO_RADIANS;
+      FP_t cosine = std::sin(dec0_) * std::sin(dec) + std::cos(dec0_) * std::cos(dec) * std::cos(ra - ra0_);
+
+      return MCL::TPoint2D<FP_t>(std::cos(dec) * std::sin(ra - ra0_) / cosine,
+                                 (std::cos(dec0_) * std::sin(dec) - std::sin(dec0_) * std::cos(dec) * std::cos(ra - ra0_)) /
+                                 cosine);
+    }
+
+  } // namespace imaging
+} // namespace astroManager
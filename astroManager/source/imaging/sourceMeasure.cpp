@@ -0,0 +1,320 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								sourceMeasure
+// SUBSYSTEM:						Measurement of the sources in an image.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	MCL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Measures the sources in an image using a pixel buffer (a snapshot of the image) rather than the ACL image.
+//                      The pixel buffer is not changed after it is created, so the measurements can be made concurrently on
+//                      worker threads while the image is owned by the GUI thread. The first plane of the buffer is used.
+//
+// CLASSES INCLUDED:    CSourceMeasure
+//
+// CLASS HIERARCHY:     CSourceMeasure
+//
+// HISTORY:             2026-10-17 GGB - Added FWHM() and aperture().
+//                      2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/sourceMeasure.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+  // astroManager header files.
+
+#include "include/error.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    FP_t const MAD_TO_SIGMA = 1.4826;           ///< Converts the median absolute deviation to a standard deviation.
+    AXIS_t const CENTROID_BOX = 2;              ///< Half size of the box around the maximum used for the centroid.
+    AXIS_t const FWHM_BOX = 10;                 ///< Half size of the box used to measure the FWHM.
+    FP_t const PI = 3.14159265358979323846;
+
+    /// @brief      Constructor for the class.
+    /// @param[in]  pixelBuffer: The snapshot of the image to measure.
+    /// @throws     GCL::CRuntimeAssert
+    /// @version    2026-10-17/GGB - Function created.
+
+    CSourceMeasure::CSourceMeasure(std::shared_ptr<CPixelBuffer const> pixelBuffer) : pixelBuffer_(std::move(pixelBuffer))
+    {
+      RUNTIME_ASSERT(pixelBuffer_ != nullptr, "The pixel buffer cannot be nullptr.");
+    }
+
+    /// @brief      Determines if a box is completely inside the image.
+    /// @param[in]  x: The column of the centre of the box.
+    /// @param[in]  y: The row of the centre of the box.
+    /// @param[in]  halfSize: The half size of the box.
+    /// @returns    true if all the pixels of the box are in the image.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CSourceMeasure::contains(AXIS_t x, AXIS_t y, AXIS_t halfSize) const noexcept
+    {
+      return ( (x - halfSize >= 0) && (y - halfSize >= 0) &&
+               (x + halfSize < static_cast<AXIS_t>(pixelBuffer_->width())) &&
+               (y + halfSize < static_cast<AXIS_t>(pixelBuffer_->height())) );
+    }
+
+    /// @brief      Returns the value of a pixel.
+    /// @param[in]  x: The column. (0 <= x < width)
+    /// @param[in]  y: The row. (0 <= y < height)
+    /// @returns    The value of the pixel.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    FP_t CSourceMeasure::value(AXIS_t x, AXIS_t y) const noexcept
+    {
+      FP_t returnValue;
+
+      if (pixelBuffer_->pixelType() == CPixelBuffer::PT_UINT16)
+      {
+        returnValue = pixelBuffer_->row16(static_cast<std::size_t>(y))[x];
+      }
+      else
+      {
+        returnValue = pixelBuffer_->rowFloat(static_cast<std::size_t>(y))[x];
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Finds the centroid of the source closest to a point.
+    /// @param[in]  guess: The expected position of the source.
+    /// @param[in]  radius: The half size of the box searched. (pixels)
+    /// @param[in]  sensitivity: The detection threshold. (Standard deviations of the background.)
+    /// @param[in]  workspace: Storage for the pixel values. Reused between calls to avoid allocating.
+    /// @returns    The centroid. No value if the box is outside the image or there is no pixel above the threshold.
+    /// @details    The background and its standard deviation are estimated from the median and the median absolute deviation
+    ///             of the box. The position is the centroid of the 5x5 pixels around the maximum of the box, as
+    ///             CStarRegistration::extractStars(). Only reads the pixel buffer, so can be called concurrently.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::optional<MCL::TPoint2D<FP_t>> CSourceMeasure::centroid(MCL::TPoint2D<FP_t> const &guess, AXIS_t radius,
+                                                                int sensitivity, std::vector<float> &workspace) const
+    {
+      std::optional<MCL::TPoint2D<FP_t>> returnValue;
+      AXIS_t const width = static_cast<AXIS_t>(pixelBuffer_->width());
+      AXIS_t const height = static_cast<AXIS_t>(pixelBuffer_->height());
+      AXIS_t const centreX = static_cast<AXIS_t>(std::lround(guess.x()));
+      AXIS_t const centreY = static_cast<AXIS_t>(std::lround(guess.y()));
+      AXIS_t const firstX = std::max<AXIS_t>(centreX - radius, CENTROID_BOX);
+      AXIS_t const lastX = std::min<AXIS_t>(centreX + radius, width - CENTROID_BOX - 1);
+      AXIS_t const firstY = std::max<AXIS_t>(centreY - radius, CENTROID_BOX);
+      AXIS_t const lastY = std::min<AXIS_t>(centreY + radius, height - CENTROID_BOX - 1);
+
+      workspace.clear();
+
+      if ( (firstX <= lastX) && (firstY <= lastY) )
+      {
+        AXIS_t maximumX = centreX, maximumY = centreY;
+        FP_t maximum = -std::numeric_limits<FP_t>::infinity();
+
+        for (AXIS_t y = firstY; y <= lastY; ++y)
+        {
+          for (AXIS_t x = firstX; x <= lastX; ++x)
+          {
+            FP_t pixel = value(x, y);
+
+            if (!std::isnan(pixel))
+            {
+              workspace.push_back(static_cast<float>(pixel));
+
+              if (pixel > maximum)
+              {
+                maximum = pixel;
+                maximumX = x;
+                maximumY = y;
+              };
+            };
+          };
+        };
+
+        if (!workspace.empty())
+        {
+          std::nth_element(workspace.begin(), workspace.begin() + workspace.size() / 2, workspace.end());
+          FP_t background = workspace[workspace.size() / 2];
+
+          for (float &pixel : workspace)
+          {
+            pixel = static_cast<float>(std::abs(pixel - background));
+          };
+          std::nth_element(workspace.begin(), workspace.begin() + workspace.size() / 2, workspace.end());
+          FP_t noise = std::max<FP_t>(MAD_TO_SIGMA * workspace[workspace.size() / 2], 1e-6);
+
+          if (maximum > background + sensitivity * noise)
+          {
+            FP_t sumX = 0, sumY = 0, flux = 0;
+
+            for (AXIS_t dy = -CENTROID_BOX; dy <= CENTROID_BOX; ++dy)
+            {
+              for (AXIS_t dx = -CENTROID_BOX; dx <= CENTROID_BOX; ++dx)
+              {
+                FP_t signal = value(maximumX + dx, maximumY + dy) - background;
+
+                if (signal > 0)
+                {
+                  sumX += signal * (maximumX + dx);
+                  sumY += signal * (maximumY + dy);
+                  flux += signal;
+                };
+              };
+            };
+
+            returnValue = MCL::TPoint2D<FP_t>(sumX / flux, sumY / flux);
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Measures the full width at half maximum (FWHM) of a source.
+    /// @param[in]  point: The position of the source.
+    /// @param[in]  workspace: Storage for the pixel values. Reused between calls to avoid allocating.
+    /// @returns    The FWHM. (pixels) No value if the box around the source is outside the image or there is no signal.
+    /// @details    The background is the median of the box around the source, and the peak is the maximum of the 3x3 pixels
+    ///             at the source. The FWHM is the diameter of the circle with the same area as the pixels of the box that are
+    ///             at least half of the peak. Only reads the pixel buffer, so can be called concurrently.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::optional<FP_t> CSourceMeasure::FWHM(MCL::TPoint2D<FP_t> const &point, std::vector<float> &workspace) const
+    {
+      std::optional<FP_t> returnValue;
+      AXIS_t const centreX = static_cast<AXIS_t>(std::lround(point.x()));
+      AXIS_t const centreY = static_cast<AXIS_t>(std::lround(point.y()));
+
+      workspace.clear();
+
+      if (contains(centreX, centreY, FWHM_BOX))
+      {
+        FP_t peak = -std::numeric_limits<FP_t>::infinity();
+
+        for (AXIS_t y = centreY - FWHM_BOX; y <= centreY + FWHM_BOX; ++y)
+        {
+          for (AXIS_t x = centreX - FWHM_BOX; x <= centreX + FWHM_BOX; ++x)
+          {
+            FP_t pixel = value(x, y);
+
+            if (!std::isnan(pixel))
+            {
+              workspace.push_back(static_cast<float>(pixel));
+
+              if ( (std::abs(x - centreX) <= 1) && (std::abs(y - centreY) <= 1) && (pixel > peak) )
+              {
+                peak = pixel;
+              };
+            };
+          };
+        };
+
+        if (!workspace.empty())
+        {
+          std::nth_element(workspace.begin(), workspace.begin() + workspace.size() / 2, workspace.end());
+          FP_t background = workspace[workspace.size() / 2];
+          FP_t halfMaximum = (peak - background) / 2;
+
+          if (halfMaximum > 0)
+          {
+            std::size_t area = 0;
+
+            for (float pixel : workspace)
+            {
+              if (pixel - background >= halfMaximum)
+              {
+                ++area;
+              };
+            };
+
+            returnValue = 2 * std::sqrt(static_cast<FP_t>(area) / PI);
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Sums the pixels in a circular aperture and sky annulus.
+    /// @param[in]  point: The centre of the aperture.
+    /// @param[in]  radius1: The radius of the aperture.
+    /// @param[in]  radius2: The inner radius of the sky annulus.
+    /// @param[in]  radius3: The outer radius of the sky annulus.
+    /// @returns    The sums and areas. No value if the annulus is not completely inside the image.
+    /// @details    A pixel is in the aperture (or annulus) if its centre is. Pixels that are NaN are not counted. Only reads the
+    ///             pixel buffer, so can be called concurrently.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::optional<CSourceMeasure::SAperture> CSourceMeasure::aperture(MCL::TPoint2D<FP_t> const &point, FP_t radius1,
+                                                                      FP_t radius2, FP_t radius3) const noexcept
+    {
+      std::optional<SAperture> returnValue;
+      AXIS_t const centreX = static_cast<AXIS_t>(std::lround(point.x()));
+      AXIS_t const centreY = static_cast<AXIS_t>(std::lround(point.y()));
+      AXIS_t const halfSize = static_cast<AXIS_t>(std::ceil(radius3)) + 1;
+
+      if (contains(centreX, centreY, halfSize))
+      {
+        SAperture sums{0, 0, 0, 0};
+
+        for (AXIS_t y = centreY - halfSize; y <= centreY + halfSize; ++y)
+        {
+          for (AXIS_t x = centreX - halfSize; x <= centreX + halfSize; ++x)
+          {
+            FP_t pixel = value(x, y);
+            FP_t distance = std::hypot(x - point.x(), y - point.y());
+
+            if (!std::isnan(pixel))
+            {
+              if (distance <= radius1)
+              {
+                sums.sourceADU += pixel;
+                ++sums.sourceArea;
+              }
+              else if ( (distance >= radius2) && (distance <= radius3) )
+              {
+                sums.skyADU += pixel;
+                ++sums.skyArea;
+              };
+            };
+          };
+        };
+
+        returnValue = sums;
+      };
+
+      return returnValue;
+    }
+
+  } // namespace imaging
+} // namespace astroManager
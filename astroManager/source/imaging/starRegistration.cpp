@@ -0,0 +1,506 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								starRegistration
+// SUBSYSTEM:						Image stacking.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL, MCL
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Registers images using the stars in the images, so that images without WCS information can be aligned. Stars
+//                      are extracted from each image and triangles are formed from the brightest stars. The triangles are
+//                      described by the ratios of their sides, which do not change with translation, rotation or scale. The
+//                      triangles of the reference image are held in a k-d tree, and matching triangles vote for matching
+//                      stars. An affine transform is then fitted (least squares) to the matching stars.
+//
+// CLASSES INCLUDED:    CStarRegistration
+//
+// CLASS HIERARCHY:     CStarRegistration
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/starRegistration.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    std::size_t const TRIANGLE_STARS = 20;      ///< Number of the brightest stars used to form triangles.
+    std::size_t const MINIMUM_MATCHES = 4;      ///< Minimum number of matched stars for a registration.
+    FP_t const TRIANGLE_TOLERANCE = 0.005;      ///< Maximum difference between the side ratios of matching triangles.
+    FP_t const MINIMUM_SIDE = 5;                ///< Triangles with shorter sides (pixels) are not used.
+    std::size_t const BACKGROUND_SAMPLES = 100000;
+    std::size_t const FIT_ITERATIONS = 5;
+
+    /// @brief      Constructor for the class.
+    /// @param[in]  matchTolerance: The maximum distance (pixels) between a transformed reference star and a matching star.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    CStarRegistration::CStarRegistration(FP_t matchTolerance) : matchTolerance_(matchTolerance), referenceStars_(),
+      referenceTriangles_()
+    {
+    }
+
+    /// @brief      Orders the triangles as a k-d tree.
+    /// @param[in]  begin: The first triangle of the range.
+    /// @param[in]  end: One past the last triangle of the range.
+    /// @param[in]  depth: The depth of the range in the tree. Even depths split on u, odd depths on v.
+    /// @details    The median of each range is the node, with the lower values before it and the higher values after it.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CStarRegistration::buildTree(std::vector<STriangle>::iterator begin, std::vector<STriangle>::iterator end,
+                                      std::size_t depth)
+    {
+      if (end - begin > 1)
+      {
+        std::vector<STriangle>::iterator median = begin + (end - begin) / 2;
+
+        std::nth_element(begin, median, end, [depth](STriangle const &lhs, STriangle const &rhs)
+        {
+          return (depth % 2 == 0) ? lhs.u < rhs.u : lhs.v < rhs.v;
+        });
+
+        buildTree(begin, median, depth + 1);
+        buildTree(median + 1, end, depth + 1);
+      };
+    }
+
+    /// @brief      Extracts the stars from an image.
+    /// @param[in]  astroImage: The image. (The first plane is used.)
+    /// @param[in]  maximumStars: The maximum number of stars to return.
+    /// @param[in]  sigma: The detection threshold. (Standard deviations of the background.)
+    /// @returns    The brightest stars, brightest first.
+    /// @details    The background and its standard deviation are estimated from the median and the median absolute deviation
+    ///             of a sample of the pixels. A star is a local maximum above the threshold that has at least two neighbours
+    ///             above the threshold. (Hot pixels are not detected.) The position of the star is the centroid of the 5x5
+    ///             pixels around the maximum. Called concurrently for different images.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::vector<CStarRegistration::SStar> CStarRegistration::extractStars(ACL::CAstroImage *astroImage,
+                                                                          std::size_t maximumStars, FP_t sigma)
+    {
+      std::vector<SStar> returnValue;
+      long const width = astroImage->width();
+      long const height = astroImage->height();
+      std::vector<float> imageData(static_cast<std::size_t>(width * height));
+      std::vector<float> samples;
+      std::size_t sampleStep = std::max<std::size_t>(1, imageData.size() / BACKGROUND_SAMPLES);
+
+      for (std::size_t index = 0; index < imageData.size(); ++index)
+      {
+        imageData[index] = static_cast<float>(astroImage->getValue(static_cast<ACL::INDEX_t>(index)));
+      };
+
+        // Estimate the background and noise.
+
+      for (std::size_t index = 0; index < imageData.size(); index += sampleStep)
+      {
+        if (!std::isnan(imageData[index]))
+        {
+          samples.push_back(imageData[index]);
+        };
+      };
+
+      if ( (width >= 5) && (height >= 5) && !samples.empty())
+      {
+        std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+        FP_t background = samples[samples.size() / 2];
+
+        for (float &sample : samples)
+        {
+          sample = static_cast<float>(std::abs(sample - background));
+        };
+        std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+        FP_t noise = std::max<FP_t>(1.4826 * samples[samples.size() / 2], 1e-6);
+        float threshold = static_cast<float>(background + sigma * noise);
+
+        auto pixel = [&](long x, long y) { return imageData[static_cast<std::size_t>(y * width + x)]; };
+
+        for (long y = 2; y < height - 2; ++y)
+        {
+          for (long x = 2; x < width - 2; ++x)
+          {
+            float value = pixel(x, y);
+
+            if (value > threshold)
+            {
+              bool isMaximum = true;
+              int neighbours = 0;
+
+                // Neighbours before the pixel must be less than the pixel, and neighbours after not more than the pixel. This
+                // gives a single maximum when two pixels have the same value.
+
+              for (long dy = -1; (dy <= 1) && isMaximum; ++dy)
+              {
+                for (long dx = -1; (dx <= 1) && isMaximum; ++dx)
+                {
+                  if ( (dx != 0) || (dy != 0) )
+                  {
+                    float neighbour = pixel(x + dx, y + dy);
+
+                    isMaximum = ((dy < 0) || ((dy == 0) && (dx < 0))) ? neighbour < value : neighbour <= value;
+                    if (neighbour > threshold)
+                    {
+                      ++neighbours;
+                    };
+                  };
+                };
+              };
+
+              if (isMaximum && (neighbours >= 2))
+              {
+                SStar star{0, 0, 0};
+
+                for (long dy = -2; dy <= 2; ++dy)
+                {
+                  for (long dx = -2; dx <= 2; ++dx)
+                  {
+                    FP_t signal = pixel(x + dx, y + dy) - background;
+
+                    if (signal > 0)
+                    {
+                      star.x += signal * (x + dx);
+                      star.y += signal * (y + dy);
+                      star.flux += signal;
+                    };
+                  };
+                };
+
+                star.x /= star.flux;
+                star.y /= star.flux;
+                returnValue.push_back(star);
+              };
+            };
+          };
+        };
+      };
+
+      std::sort(returnValue.begin(), returnValue.end(), [](SStar const &lhs, SStar const &rhs) { return lhs.flux > rhs.flux; });
+      if (returnValue.size() > maximumStars)
+      {
+        returnValue.resize(maximumStars);
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Fits an affine transform to matched stars.
+    /// @param[in]  sourceStars: The stars in the source (reference) image.
+    /// @param[in]  targetStars: The stars in the target image.
+    /// @param[in]  matches: The matched stars. (Index of the source star, index of the target star.)
+    /// @returns    The transform from source to target coordinates. No value if the stars do not determine a transform.
+    /// @details    The normal equations are solved by Cramer's rule.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::optional<CStarRegistration::STransform>
+    CStarRegistration::fitTransform(std::vector<SStar> const &sourceStars, std::vector<SStar> const &targetStars,
+                                    std::vector<std::pair<std::size_t, std::size_t>> const &matches)
+    {
+      std::optional<STransform> returnValue;
+      FP_t sxx = 0, sxy = 0, sx = 0, syy = 0, sy = 0, n = 0;
+      FP_t sxu = 0, syu = 0, su = 0, sxv = 0, syv = 0, sv = 0;
+
+      for (std::pair<std::size_t, std::size_t> const &match : matches)
+      {
+        SStar const &source = sourceStars[match.first];
+        SStar const &target = targetStars[match.second];
+
+        sxx += source.x * source.x;
+        sxy += source.x * source.y;
+        sx += source.x;
+        syy += source.y * source.y;
+        sy += source.y;
+        n += 1;
+        sxu += source.x * target.x;
+        syu += source.y * target.x;
+        su += target.x;
+        sxv += source.x * target.y;
+        syv += source.y * target.y;
+        sv += target.y;
+      };
+
+      auto determinant = [](FP_t m00, FP_t m01, FP_t m02, FP_t m10, FP_t m11, FP_t m12, FP_t m20, FP_t m21, FP_t m22)
+      {
+        return m00 * (m11 * m22 - m12 * m21) - m01 * (m10 * m22 - m12 * m20) + m02 * (m10 * m21 - m11 * m20);
+      };
+
+      FP_t det = determinant(sxx, sxy, sx, sxy, syy, sy, sx, sy, n);
+
+      if ( (matches.size() >= 3) && (std::abs(det) > 1e-9 * std::max<FP_t>(1, sxx * syy * n)) )
+      {
+        STransform transform;
+
+        transform.a = determinant(sxu, sxy, sx, syu, syy, sy, su, sy, n) / det;
+        transform.b = determinant(sxx, sxu, sx, sxy, syu, sy, sx, su, n) / det;
+        transform.c = determinant(sxx, sxy, sxu, sxy, syy, syu, sx, sy, su) / det;
+        transform.d = determinant(sxv, sxy, sx, syv, syy, sy, sv, sy, n) / det;
+        transform.e = determinant(sxx, sxv, sx, sxy, syv, sy, sx, sv, n) / det;
+        transform.f = determinant(sxx, sxy, sxv, sxy, syy, syv, sx, sy, sv) / det;
+
+        returnValue = transform;
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Forms triangles from the brightest stars.
+    /// @param[in]  stars: The stars, brightest first.
+    /// @returns    The triangles.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::vector<CStarRegistration::STriangle> CStarRegistration::makeTriangles(std::vector<SStar> const &stars)
+    {
+      std::vector<STriangle> returnValue;
+      std::size_t starCount = std::min(stars.size(), TRIANGLE_STARS);
+
+      auto distance = [&stars](std::size_t i, std::size_t j)
+      {
+        return std::hypot(stars[i].x - stars[j].x, stars[i].y - stars[j].y);
+      };
+
+      for (std::size_t i = 0; i < starCount; ++i)
+      {
+        for (std::size_t j = i + 1; j < starCount; ++j)
+        {
+          for (std::size_t k = j + 1; k < starCount; ++k)
+          {
+              // Each side is paired with the star opposite it.
+
+            std::pair<FP_t, std::size_t> sides[3] = { {distance(j, k), i}, {distance(i, k), j}, {distance(i, j), k} };
+
+            std::sort(std::begin(sides), std::end(sides));
+
+            if (sides[0].first >= MINIMUM_SIDE)
+            {
+              returnValue.push_back({sides[0].first / sides[2].first, sides[1].first / sides[2].first,
+                                     {sides[0].second, sides[1].second, sides[2].second}});
+            };
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Sets the stars of the reference image. The other images are registered to the reference image.
+    /// @param[in]  stars: The stars of the reference image, brightest first.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CStarRegistration::referenceStars(std::vector<SStar> const &stars)
+    {
+      referenceStars_ = stars;
+      referenceTriangles_ = makeTriangles(referenceStars_);
+      buildTree(referenceTriangles_.begin(), referenceTriangles_.end(), 0);
+    }
+
+    /// @brief      Registers an image to the reference image.
+    /// @param[in]  stars: The stars of the image, brightest first.
+    /// @returns    The transform from reference image coordinates to image coordinates. No value if the image could not be
+    ///             registered.
+    /// @details    Each triangle of the image votes for the stars of the matching reference triangles. The stars with the most
+    ///             votes are matched, and a transform is fitted with the matches that do not fit being removed. All the stars
+    ///             are then matched using the transform and the transform is fitted again. May be called concurrently.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::optional<CStarRegistration::STransform> CStarRegistration::registerStars(std::vector<SStar> const &stars) const
+    {
+      std::optional<STransform> returnValue;
+      std::vector<STriangle> triangles = makeTriangles(stars);
+      std::size_t referenceCount = std::min(referenceStars_.size(), TRIANGLE_STARS);
+      std::size_t starCount = std::min(stars.size(), TRIANGLE_STARS);
+      std::vector<int> votes(referenceCount * starCount, 0);
+      std::vector<std::size_t> found;
+      std::vector<std::tuple<int, std::size_t, std::size_t>> candidates;
+      std::vector<std::pair<std::size_t, std::size_t>> matches;
+      std::vector<bool> referenceUsed(referenceCount, false), starUsed(starCount, false);
+
+      for (STriangle const &triangle : triangles)
+      {
+        found.clear();
+        searchTree(0, referenceTriangles_.size(), 0, triangle, found);
+
+        for (std::size_t index : found)
+        {
+          for (std::size_t vertex = 0; vertex < 3; ++vertex)
+          {
+            ++votes[referenceTriangles_[index].vertex[vertex] * starCount + triangle.vertex[vertex]];
+          };
+        };
+      };
+
+        // Match the stars with the most votes first.
+
+      for (std::size_t reference = 0; reference < referenceCount; ++reference)
+      {
+        for (std::size_t star = 0; star < starCount; ++star)
+        {
+          if (votes[reference * starCount + star] >= 2)
+          {
+            candidates.emplace_back(votes[reference * starCount + star], reference, star);
+          };
+        };
+      };
+      std::sort(candidates.begin(), candidates.end(), [](std::tuple<int, std::size_t, std::size_t> const &lhs,
+                                                         std::tuple<int, std::size_t, std::size_t> const &rhs)
+      {
+        return std::get<0>(lhs) > std::get<0>(rhs);
+      });
+
+      for (std::tuple<int, std::size_t, std::size_t> const &candidate : candidates)
+      {
+        if (!referenceUsed[std::get<1>(candidate)] && !starUsed[std::get<2>(candidate)])
+        {
+          referenceUsed[std::get<1>(candidate)] = true;
+          starUsed[std::get<2>(candidate)] = true;
+          matches.emplace_back(std::get<1>(candidate), std::get<2>(candidate));
+        };
+      };
+
+        // Fit the transform, removing the worst match while any match does not fit.
+
+      while (matches.size() >= MINIMUM_MATCHES)
+      {
+        returnValue = fitTransform(referenceStars_, stars, matches);
+
+        if (returnValue)
+        {
+          auto residual = [&](std::pair<std::size_t, std::size_t> const &match)
+          {
+            MCL::TPoint2D<FP_t> point = (*returnValue)(MCL::TPoint2D<FP_t>(referenceStars_[match.first].x,
+                                                                            referenceStars_[match.first].y));
+            return std::hypot(point.x() - stars[match.second].x, point.y() - stars[match.second].y);
+          };
+          auto worst = std::max_element(matches.begin(), matches.end(),
+                                        [&residual](std::pair<std::size_t, std::size_t> const &lhs,
+                                                    std::pair<std::size_t, std::size_t> const &rhs)
+          {
+            return residual(lhs) < residual(rhs);
+          });
+
+          if (residual(*worst) <= matchTolerance_)
+          {
+            break;
+          };
+
+          matches.erase(worst);
+          returnValue.reset();
+        }
+        else
+        {
+          break;
+        };
+      };
+
+        // Match all the stars using the transform and fit again.
+
+      for (std::size_t iteration = 0; (iteration < FIT_ITERATIONS) && returnValue; ++iteration)
+      {
+        std::vector<bool> used(stars.size(), false);
+
+        matches.clear();
+        for (std::size_t reference = 0; reference < referenceStars_.size(); ++reference)
+        {
+          MCL::TPoint2D<FP_t> point = (*returnValue)(MCL::TPoint2D<FP_t>(referenceStars_[reference].x,
+                                                                          referenceStars_[reference].y));
+          FP_t bestDistance = matchTolerance_;
+          std::size_t bestStar = stars.size();
+
+          for (std::size_t star = 0; star < stars.size(); ++star)
+          {
+            FP_t distance = std::hypot(point.x() - stars[star].x, point.y() - stars[star].y);
+
+            if (!used[star] && (distance <= bestDistance))
+            {
+              bestDistance = distance;
+              bestStar = star;
+            };
+          };
+
+          if (bestStar != stars.size())
+          {
+            used[bestStar] = true;
+            matches.emplace_back(reference, bestStar);
+          };
+        };
+
+        if (matches.size() >= MINIMUM_MATCHES)
+        {
+          returnValue = fitTransform(referenceStars_, stars, matches);
+        }
+        else
+        {
+          returnValue.reset();
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Finds the reference triangles that match a triangle.
+    /// @param[in]  begin: The first triangle of the range.
+    /// @param[in]  end: One past the last triangle of the range.
+    /// @param[in]  depth: The depth of the range in the tree.
+    /// @param[in]  triangle: The triangle to match.
+    /// @param[out] found: The indexes of the matching triangles are appended.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CStarRegistration::searchTree(std::size_t begin, std::size_t end, std::size_t depth, STriangle const &triangle,
+                                       std::vector<std::size_t> &found) const
+    {
+      if (begin < end)
+      {
+        std::size_t median = begin + (end - begin) / 2;
+        STriangle const &node = referenceTriangles_[median];
+        FP_t difference = (depth % 2 == 0) ? triangle.u - node.u : triangle.v - node.v;
+
+        if ( (std::abs(triangle.u - node.u) <= TRIANGLE_TOLERANCE) && (std::abs(triangle.v - node.v) <= TRIANGLE_TOLERANCE) )
+        {
+          found.push_back(median);
+        };
+
+        if (difference <= TRIANGLE_TOLERANCE)
+        {
+          searchTree(begin, median, depth + 1, triangle, found);
+        };
+        if (difference >= -TRIANGLE_TOLERANCE)
+        {
+          searchTree(median + 1, end, depth + 1, triangle, found);
+        };
+      };
+    }
+
+  } // namespace imaging
+} // namespace astroManager
@@ -0,0 +1,256 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								tiledImageItem
+// SUBSYSTEM:						Tiled, multi-resolution graphics item for displaying images.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt
+// NAMESPACE:						astroManager::imaging
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Implements a QGraphicsItem that displays a rendered image as a pyramid of tiles.
+//
+// CLASSES INCLUDED:    CTiledImageItem
+//
+// CLASS HIERARCHY:     QGraphicsItem
+//                        CTiledImageItem
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/tiledImageItem.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <cmath>
+
+  // astroManager header files
+
+#include "include/settings.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    /// @brief      Constructor for the class.
+    /// @param[in]  image: The rendered image to display.
+    /// @param[in]  parent: The parent item.
+    /// @details    The image is deep copied. The rendered image (SControlImage::ScreenImage) refers to a buffer owned by the
+    ///             astroFile, which is released when the image is next rendered.
+    ///             The number of levels is chosen so that the smallest level fits into a single tile.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    CTiledImageItem::CTiledImageItem(QImage const &image, QGraphicsItem *parent) : QGraphicsItem(parent), imageLevels_(),
+      sourceKey_(image.cacheKey()), maximumLevel_(0), tileCache_(), previewImage_()
+    {
+      int dimension = std::max(image.width(), image.height());
+
+      while (dimension > TILE_SIZE)
+      {
+        dimension = (dimension + 1) / 2;
+        ++maximumLevel_;
+      };
+
+      imageLevels_.resize(static_cast<std::size_t>(maximumLevel_) + 1);
+      imageLevels_[0] = image.copy();
+
+        // The cache must be able to hold at least one tile, otherwise QCache::insert() deletes the tile immediately.
+
+      tileCache_.setMaxCost(std::max(settings::astroManagerSettings->value(settings::IMAGING_DISPLAY_TILECACHE,
+                                                                           QVariant(64)).toInt(), 1) * 1024);
+
+      setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);    // Required for the exposedRect.
+    }
+
+    /// @brief      Returns the bounding rectangle of the item.
+    /// @returns    The bounding rectangle (full resolution image coordinates).
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    QRectF CTiledImageItem::boundingRect() const
+    {
+      return QRectF(imageLevels_[0].rect());
+    }
+
+    /// @brief      Returns the image for the specified level of the pyramid.
+    /// @param[in]  level: The level to return.
+    /// @returns    The image for the level.
+    /// @details    The level is created from the previous level (halving the size) the first time it is required.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    QImage const &CTiledImageItem::imageLevel(int level)
+    {
+      QImage &levelImage = imageLevels_[static_cast<std::size_t>(level)];
+
+      if (levelImage.isNull())
+      {
+        QImage const &previousLevel = imageLevel(level - 1);
+
+        levelImage = previousLevel.scaled(std::max(1, (previousLevel.width() + 1) / 2),
+                                          std::max(1, (previousLevel.height() + 1) / 2),
+                                          Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+      };
+
+      return levelImage;
+    }
+
+    /// @brief      Paints the tiles that intersect the exposed rectangle.
+    /// @param[in]  painter: The painter to use.
+    /// @param[in]  option: The style options. The exposedRect is used to determine the visible tiles.
+    /// @details    If a preview has been set, the exposed part of the preview is drawn instead of the tiles.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Draw the preview if it is set.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CTiledImageItem::paint(QPainter *painter, QStyleOptionGraphicsItem const *option, QWidget *)
+    {
+      QRectF exposedRect = option->exposedRect.isEmpty() ? boundingRect() : (option->exposedRect & boundingRect());
+
+      if (!exposedRect.isEmpty() && !previewImage_.isNull())
+      {
+        qreal scaleX = static_cast<qreal>(previewImage_.width()) / boundingRect().width();
+        qreal scaleY = static_cast<qreal>(previewImage_.height()) / boundingRect().height();
+
+        painter->drawImage(exposedRect, previewImage_, QRectF(exposedRect.left() * scaleX, exposedRect.top() * scaleY,
+                                                              exposedRect.width() * scaleX, exposedRect.height() * scaleY));
+      }
+      else if (!exposedRect.isEmpty())
+      {
+        int level = selectLevel(QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform()));
+        int tileSize = TILE_SIZE << level;          // Size of a tile in the item coordinates.
+        QImage const &levelImage = imageLevel(level);
+
+        int firstColumn = static_cast<int>(std::floor(exposedRect.left())) / tileSize;
+        int lastColumn = std::min(static_cast<int>(std::ceil(exposedRect.right())) / tileSize,
+                                  (levelImage.width() - 1) / TILE_SIZE);
+        int firstRow = static_cast<int>(std::floor(exposedRect.top())) / tileSize;
+        int lastRow = std::min(static_cast<int>(std::ceil(exposedRect.bottom())) / tileSize,
+                               (levelImage.height() - 1) / TILE_SIZE);
+
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+          for (int column = firstColumn; column <= lastColumn; ++column)
+          {
+            QPixmap *tilePixmap = tile(level, column, row);
+
+              // The target is calculated from the tile size so that the edge tiles at the coarse levels cover the full image.
+
+            QRectF target(column * tileSize, row * tileSize, tilePixmap->width() << level, tilePixmap->height() << level);
+
+            painter->drawPixmap(target & boundingRect(), *tilePixmap,
+                                QRectF(0, 0, (std::min(target.right(), boundingRect().right()) - target.left()) / (1 << level),
+                                       (std::min(target.bottom(), boundingRect().bottom()) - target.top()) / (1 << level)));
+          };
+        };
+      };
+    }
+
+    /// @brief      Selects the pyramid level to use for the level of detail.
+    /// @param[in]  levelOfDetail: The level of detail (device pixels per item pixel).
+    /// @returns    The coarsest level that still has at least one level pixel per device pixel.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    int CTiledImageItem::selectLevel(qreal levelOfDetail) const
+    {
+      int level = 0;
+
+      while ( (level < maximumLevel_) && (levelOfDetail * (1 << (level + 1)) <= 1.0) )
+      {
+        ++level;
+      };
+
+      return level;
+    }
+
+    /// @brief      Replaces the image displayed by the item.
+    /// @param[in]  image: The new rendered image.
+    /// @returns    true if the image was replaced. false if the image has a different size. (A new item is required.)
+    /// @details    Used when the image is rendered again with a different stretch. The levels and the tile cache are discarded
+    ///             and recreated as they are needed, the item remains in the scene. Any preview is removed.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    bool CTiledImageItem::setImage(QImage const &image)
+    {
+      bool returnValue = false;
+
+      if (image.size() == imageLevels_[0].size())
+      {
+        for (auto &levelImage : imageLevels_)
+        {
+          levelImage = QImage();
+        };
+        imageLevels_[0] = image.copy();
+        sourceKey_ = image.cacheKey();
+        tileCache_.clear();
+        previewImage_ = QImage();
+        update();
+
+        returnValue = true;
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Sets the preview image.
+    /// @param[in]  image: The reduced resolution image to display in place of the tiles. A null image removes the preview.
+    /// @details    The preview is scaled to cover the full item. It is displayed until it is removed, or until setImage() is
+    ///             called.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CTiledImageItem::setPreview(QImage const &image)
+    {
+      previewImage_ = image;
+      update();
+    }
+
+    /// @brief      Returns the specified tile, creating it if it is not in the cache.
+    /// @param[in]  level: The pyramid level.
+    /// @param[in]  column: The tile column.
+    /// @param[in]  row: The tile row.
+    /// @returns    Pointer to the tile. The pointer is owned by the cache and is only valid until the next tile is inserted.
+    /// @throws     std::bad_alloc
+    /// @version    2026-10-17/GGB - Function created.
+
+    QPixmap *CTiledImageItem::tile(int level, int column, int row)
+    {
+      quint64 key = (static_cast<quint64>(level) << 56) | (static_cast<quint64>(column) << 28) | static_cast<quint64>(row);
+      QPixmap *tilePixmap = tileCache_.object(key);
+
+      if (!tilePixmap)
+      {
+        QImage const &levelImage = imageLevel(level);
+        QRect tileRect = QRect(column * TILE_SIZE, row * TILE_SIZE, TILE_SIZE, TILE_SIZE) & levelImage.rect();
+
+        tilePixmap = new QPixmap(QPixmap::fromImage(levelImage.copy(tileRect)));
+
+        tileCache_.insert(key, tilePixmap, std::max(1, tilePixmap->width() * tilePixmap->height() * tilePixmap->depth() / 8 / 1024));
+      };
+
+      return tilePixmap;
+    }
+
+  } // namespace imaging
+} // namespace astroManager
@@ -1,4 +1,4 @@
-﻿//*********************************************************************************************************************************
+//*********************************************************************************************************************************
 //
 // PROJECT:							AstroManager (Astronomy Observation Manager)
 // FILE:								ImageCalibration.cpp
@@ -35,20 +35,235 @@
 
 #include "include/windowCalibration/ImageCalibration.h"
 
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
   // Miscellaneous library header files.
 
 #include <ACL>
 #include "boost/filesystem.hpp"
 
+  // Qt library header files
+
+#include <QtConcurrent/QtConcurrent>
+
   // astroManager header files
 
 #include "include/FrameWindow.h"
+#include "include/imaging/imageCalibrator.h"
+#include "include/imaging/masterFrameBuilder.h"
+#include "include/imaging/masterFrameLibrary.h"
 #include "include/settings.h"
 
 namespace astroManager
 {
   namespace calibration
   {
+    /// @brief      Creates a master frame from a list of frames. The frames are combined on a worker thread while a busy
+    ///             indicator is shown.
+    /// @param[in]  parent: The parent window for the dialogs.
+    /// @param[in]  frameType: The type of master frame.
+    /// @param[in]  frameList: The frames to combine.
+    /// @param[in]  subtractFile: Master frame to subtract from each frame. (Empty if none.)
+    /// @param[in]  normalise: true if the frames should be normalised. (Flat frames.)
+    /// @param[in]  stackMode: The combine method selected by the user.
+    /// @param[in]  outputFile: The file to write the master frame to.
+    /// @param[out] libraryFile: The path of the master in the master frame library. (Empty if it is not in the library.)
+    /// @returns    true if the master frame was created. false if there was an error or the user cancelled.
+    /// @details    If the master frame library has a master created from the same frames (that have not changed since) the
+    ///             master is copied from the library rather than being created again. Otherwise the frames are streamed by
+    ///             imaging::CMasterFrameBuilder, so the memory used does not grow with the number of frames, and the new master
+    ///             is added to the library. The memory available for median and sigma clip combines is read from the
+    ///             IMAGE_CALIBRATION_MEMORYBUDGET setting. Errors are reported to the user.
+    ///             A master dark created with a master bias subtracted, or a master flat created with a master dark that
+    ///             includes the bias subtracted, has the bias removed and is written with BIASSUB = T.
+    /// @throws     GCL::CCodeError
+    /// @throws     GCL::CRuntimeAssert
+    /// @version    2026-10-17/GGB - The combine method is passed in, the bias state is written to the master and the combine
+    ///                              can be cancelled.
+    /// @version    2026-10-17/GGB - Reuse masters from the master frame library.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static bool createMasterFrame(QWidget *parent, imaging::CMasterFrameLibrary::EFrameType frameType,
+                                  QStringList const &frameList, QString const &subtractFile, bool normalise,
+                                  ACL::CImageStack::EStackMode stackMode, boost::filesystem::path const &outputFile,
+                                  QString &libraryFile)
+    {
+      bool returnValue = false;
+      bool cancelled = false;
+      QMessageBox msgBox(parent);
+      imaging::CMasterFrameBuilder masterFrameBuilder(
+            settings::astroManagerSettings->value(settings::IMAGE_CALIBRATION_MEMORYBUDGET, QVariant(1024)).toULongLong() *
+            1024 * 1024);
+      std::unique_ptr<imaging::CMasterFrameLibrary> masterFrameLibrary;
+      std::vector<boost::filesystem::path> sourceFrames;
+      boost::filesystem::path subtractFrame(subtractFile.toStdString());
+      boost::filesystem::path libraryMaster;
+      QProgressDialog progressDialog(QObject::tr("Creating master frame..."), QObject::tr("Cancel"), 0, 0, parent);
+      QFutureWatcher<void> futureWatcher;
+      std::exception_ptr exception;
+
+      libraryFile.clear();
+
+      for (QString const &frame : frameList)
+      {
+        sourceFrames.emplace_back(frame.toStdString());
+      };
+
+        // Check the library for a master created from the same frames. A library that cannot be opened is not an error, the
+        // master is just created.
+
+      try
+      {
+        masterFrameLibrary.reset(new imaging::CMasterFrameLibrary());
+        libraryMaster = masterFrameLibrary->findMaster(frameType, sourceFrames, subtractFrame, stackMode);
+
+        if (!libraryMaster.empty())
+        {
+          if (libraryMaster != outputFile)
+          {
+            boost::filesystem::remove(outputFile);
+            boost::filesystem::copy_file(libraryMaster, outputFile);
+          };
+          INFOMESSAGE("Master frame reused from the master frame library: " + libraryMaster.string());
+          libraryFile = QString::fromStdString(libraryMaster.string());
+          returnValue = true;
+        };
+      }
+      catch (boost::filesystem::filesystem_error &error)
+      {
+        WARNINGMESSAGE("Master frame library: " + std::string(error.what()));
+        masterFrameLibrary.reset();
+      };
+
+      if (!returnValue)
+      {
+        progressDialog.setWindowModality(Qt::WindowModal);
+        QObject::connect(&futureWatcher, SIGNAL(finished()), &progressDialog, SLOT(reset()));
+        QObject::connect(&progressDialog, &QProgressDialog::canceled, [&masterFrameBuilder]() { masterFrameBuilder.cancel(); });
+
+        futureWatcher.setFuture(QtConcurrent::run([&]()
+        {
+          try
+          {
+            for (boost::filesystem::path const &sourceFrame : sourceFrames)
+            {
+              masterFrameBuilder.addFile(sourceFrame);
+            };
+
+            if (!subtractFrame.empty())
+            {
+              masterFrameBuilder.subtractFrame(subtractFrame);
+
+                // A master bias always removes the bias. A master dark only removes the bias if it still contains it.
+
+              masterFrameBuilder.biasSubtracted(
+                    (frameType != imaging::CMasterFrameLibrary::FT_FLAT) ||
+                    !imaging::CMasterFrameLibrary::readFrameKey(subtractFrame).biasSubtracted);
+            };
+
+            masterFrameBuilder.normalise(normalise);
+            cancelled = !masterFrameBuilder.createMasterFrame(stackMode, outputFile);
+          }
+          catch(...)
+          {
+            exception = std::current_exception();
+          };
+        }));
+
+        progressDialog.exec();
+        futureWatcher.waitForFinished();
+
+        if (exception)
+        {
+          try
+          {
+            std::rethrow_exception(exception);
+          }
+          catch (GCL::CCodeError &)
+          {
+            throw;    // Propagate code errors.
+          }
+          catch (GCL::CRuntimeAssert &)
+          {
+            throw;    // Propagate runtime assertions.
+          }
+          catch (GCL::CError &error)
+          {
+            msgBox.setText(QObject::tr("Error while creating the master frame."));
+            msgBox.setInformativeText(QString::fromStdString(error.errorMessage()));
+          }
+          catch (ACL::CFITSException &error)
+          {
+            msgBox.setText(QObject::tr("cfitsio Error while creating the master frame."));
+            msgBox.setInformativeText(QString::fromStdString(error.errorMessage()));
+          }
+          catch (std::exception &error)
+          {
+            msgBox.setText(QObject::tr("Error while creating the master frame."));
+            msgBox.setInformativeText(QString::fromStdString(error.what()));
+          };
+
+          msgBox.setIcon(QMessageBox::Warning);
+          msgBox.setStandardButtons(QMessageBox::Ok);
+          msgBox.setDefaultButton(QMessageBox::Ok);
+          msgBox.exec();
+        }
+        else if (!cancelled)
+        {
+          returnValue = true;
+
+          if (masterFrameLibrary)
+          {
+            try
+            {
+              libraryMaster = masterFrameLibrary->addMaster(frameType, outputFile, sourceFrames, subtractFrame, stackMode);
+              libraryFile = QString::fromStdString(libraryMaster.string());
+            }
+            catch (boost::filesystem::filesystem_error &error)
+            {
+              WARNINGMESSAGE("Master frame library: " + std::string(error.what()));
+            }
+            catch (ACL::CFITSException &error)
+            {
+              WARNINGMESSAGE("Master frame library: " + error.errorMessage());
+            };
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief      Returns the combine method selected on a create master frame form.
+    /// @param[in]  formWidget: The form. (windowCreateMasterBiasFrame, windowCreateMasterDarkFrame or
+    ///             windowCreateMasterFlatFrame.)
+    /// @returns    The combine method.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    static ACL::CImageStack::EStackMode selectedCombineMode(QWidget *formWidget)
+    {
+      ACL::CImageStack::EStackMode returnValue = ACL::CImageStack::SM_MEAN;
+
+      if (formWidget->findChild<QRadioButton *>("radioMedianCombine")->isChecked())
+      {
+        returnValue = ACL::CImageStack::SM_MEDIAN;
+      }
+      else if (formWidget->findChild<QRadioButton *>("radioSigmaClip")->isChecked())
+      {
+        returnValue = ACL::CImageStack::SM_SIGMACLIP;
+      };
+
+      return returnValue;
+    }
+
     //*****************************************************************************************************************************
     //
     // CCreateMasterDarkWindow
@@ -101,6 +316,8 @@ namespace astroManager
 
     // Called when the create button is clicked by the user.
     // Checks that their is valid data and then runs through the creation process.
+    /// @version 2026-10-17/GGB - Reuse masters from the master frame library.
+    /// @version 2026-10-17/GGB - Frames are streamed through imaging::CMasterFrameBuilder rather than held in memory.
     /// @version 2017-06-14/GGB - Update to Qt5
     /// @version 2011-05-21/GGB - Function created.
 
@@ -111,10 +328,9 @@ namespace astroManager
       bool bForceBasic = false;
       bool useMasterBiasFrame = false, useBiasFrames = false, saveMasterBiasFrame = false;
 
-      QStringList::iterator iter;
-      ACL::CMasterBiasFrame *masterBiasFrame;
-      ACL::CMasterDarkFrame *masterDarkFrame;
-      ACL::CAstroFile *masterBiasFile = NULL;
+      QString masterBiasFile;
+      QString libraryFile;
+      boost::filesystem::path temporaryBiasFile;
 
         // Read the state of the check boxes.
 
@@ -179,13 +395,13 @@ namespace astroManager
         if (msgBox.exec() == QMessageBox::Yes)
           bForceBasic = true;
         else
-          bExit = false;
+          bExit = true;
       };
 
       if (!bExit)
       {
-          // All the basic requirements have been met. Filenames are selected as required. Additional checks will
-          // be carried out by the libAstroClass function.
+          // All the basic requirements have been met. Filenames are selected as required. Additional checks are carried out
+          // while the frames are combined.
 
           // If we are going into forced basic mode, just force all the bias frame use flags to false.
 
@@ -196,148 +412,55 @@ namespace astroManager
           saveMasterBiasFrame = false;
         };
 
-          // If we are using master bias frames, we must create the master bias frame at this stage.
+          // If we are using bias frames, we must create the master bias frame at this stage. If it is not being saved, it is
+          // written to a temporary file.
 
         if (useBiasFrames)
         {
-            // Creating a new master bias frame.
-
-          masterBiasFrame = new ACL::CMasterBiasFrame(masterBiasSaveAs.toStdString());
-
-          for (iter = biasImageList.begin(); iter != biasImageList.end(); iter++)
-            masterBiasFrame->addBiasFrame( (*iter).toStdString() );
-
-          try
+          if (saveMasterBiasFrame && !masterBiasSaveAs.isNull())
           {
-            masterBiasFrame->verifyFrames();
+            masterBiasFile = masterBiasSaveAs;
           }
-          catch (GCL::CError &err)
-          {
-            switch (err.errorCode())
-            {
-            case 0x2000:    // image array sizes
-              msgBox.setText(tr("Bias Image Array sizes are inconsistent."));
-              msgBox.setInformativeText(tr("All the image arrays must have the same number of axes (NAXIS)."));
-              msgBox.setIcon(QMessageBox::Warning);
-              msgBox.setStandardButtons(QMessageBox::Ok);
-              msgBox.setDefaultButton(QMessageBox::Ok);
-              msgBox.exec();
-              break;
-            case 0x2001:    // image sizes
-              msgBox.setText(tr("Bias Image sizes are inconsistent."));
-              msgBox.setInformativeText(tr("All the image must have the same sizes (NAXIS1, NAXIS2, NAXIS3)."));
-              msgBox.setIcon(QMessageBox::Warning);
-              msgBox.setStandardButtons(QMessageBox::Ok);
-              msgBox.setDefaultButton(QMessageBox::Ok);
-              msgBox.exec();
-              break;
-            case 0x2002:    // exposure times
-              msgBox.setText(tr("Bias Image exposures are inconsistent."));
-              msgBox.setInformativeText(tr("All the images must have the same exposure times."));
-              msgBox.setIcon(QMessageBox::Warning);
-              msgBox.setStandardButtons(QMessageBox::Ok);
-              msgBox.setDefaultButton(QMessageBox::Ok);
-              msgBox.exec();
-              break;
-            default:
-              CODE_ERROR;
-            };  // switch
-          }; // catch
-          if (saveMasterBiasFrame)
+          else
           {
-//            masterBiasFrame->save();
-          }
+            temporaryBiasFile = boost::filesystem::temp_directory_path() /
+                                boost::filesystem::unique_path("masterBias-%%%%-%%%%.fits");
+            masterBiasFile = QString::fromStdString(temporaryBiasFile.string());
+          };
+
+          bExit = !createMasterFrame(this, imaging::CMasterFrameLibrary::FT_BIAS, biasImageList, QString(), false,
+                                     selectedCombineMode(widget()),
+                                     boost::filesystem::path(masterBiasFile.toStdString()), libraryFile);
 
-          masterBiasFile = masterBiasFrame->setMasterBiasFile(NULL);      // Take control of the master bias frame.
+            // Subtract the copy in the library, so that the master dark can be found in the library the next time.
 
-          delete masterBiasFrame;
-          masterBiasFrame = NULL;
+          if (!libraryFile.isEmpty())
+          {
+            masterBiasFile = libraryFile;
+          };
         }
         else if (useMasterBiasFrame)
         {
-//          masterBiasFile = new ACL::CAstroFile(biasFileName.toStdString());
+          masterBiasFile = biasFileName;
         };
 
           // Create the master dark frame
 
-        masterDarkFrame = new ACL::CMasterDarkFrame(darkFileName.toStdString());
-        masterDarkFrame->setMasterBiasFile(masterBiasFile);
-
-          // Now add the dark frame file names
-
-        for (iter = darkImageList.begin(); iter != darkImageList.end(); iter++)
-          masterDarkFrame->addDarkFrame( (*iter).toStdString() );
-
-          // Call the CMasterDarkFrame class to verify all the dark frames are compatible.
-
-        try
-        {
-          masterDarkFrame->verifyFrames();
-        }
-        catch (GCL::CError &error)
+        if (!bExit && createMasterFrame(this, imaging::CMasterFrameLibrary::FT_DARK, darkImageList, masterBiasFile, false,
+                                        selectedCombineMode(widget()),
+                                        boost::filesystem::path(darkFileName.toStdString()), libraryFile))
         {
-          if (error.library() == "ACL")
-          {
-            switch (error.errorCode())
-            {
-              case 0x2000:    // image array sizes
-              {
-                msgBox.setText(tr("Image Array sizes are inconsistent."));
-                msgBox.setInformativeText(tr("All the image arrays must have the same number of axes (NAXIS)."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              case 0x2001:    // image sizes
-              {
-                msgBox.setText(tr("Image sizes are inconsistent."));
-                msgBox.setInformativeText(tr("All the image must have the same sizes (NAXIS1, NAXIS2, NAXIS3)."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              case 0x2002:    // exposure times
-              {
-                msgBox.setText(tr("Image exposures are inconsistent."));
-                msgBox.setInformativeText(tr("All the images must have the same exposure times."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              default:
-              {
-                CODE_ERROR;
-              };
-            };  // switch
-          };  // if
-        };  // catch
-
-        masterDarkFrame->createMasterFrame(ACL::EIC_MEAN);
-//        masterDarkFrame->save();
-
-        msgBox.setText(tr("Master Dark Frame Created and Saved."));
-        msgBox.setInformativeText(tr("The Master Dark Frame has been created using the dark frames."));
-        msgBox.setIcon(QMessageBox::Information);
-        msgBox.setStandardButtons(QMessageBox::Ok);
-        msgBox.setDefaultButton(QMessageBox::Ok);
-        msgBox.exec();
-
-        if (masterBiasFile)
-        {
-          delete masterBiasFile;
-          masterBiasFile = nullptr;
+          msgBox.setText(tr("Master Dark Frame Created and Saved."));
+          msgBox.setInformativeText(tr("The Master Dark Frame has been created using the dark frames."));
+          msgBox.setIcon(QMessageBox::Information);
+          msgBox.setStandardButtons(QMessageBox::Ok);
+          msgBox.setDefaultButton(QMessageBox::Ok);
+          msgBox.exec();
         };
 
-        if (masterDarkFrame)
+        if (!temporaryBiasFile.empty())
         {
-          delete masterDarkFrame;
-          masterDarkFrame = nullptr;
+          boost::filesystem::remove(temporaryBiasFile);
         };
       };
     }
@@ -798,6 +921,8 @@ namespace astroManager
     }
 
     // Does the actual creation work for the master flat and dark (if required)
+    /// @version 2026-10-17/GGB - Reuse masters from the master frame library.
+    /// @version 2026-10-17/GGB - Frames are streamed through imaging::CMasterFrameBuilder rather than held in memory.
     /// @version 2017-06-14/GGB - Update to Qt5
     /// @version 2011-05-23/GGB - Function created.
 
@@ -805,10 +930,8 @@ namespace astroManager
     {
       QMessageBox msgBox;
       bool bExit = false;
-      ACL::CMasterFlatFrame *masterFlatFrame = nullptr;
-      ACL::CAstroFile *masterDarkFile = nullptr;
-      ACL::CMasterDarkFrame *masterDarkFrame = nullptr;
-      QStringList::const_iterator iter;
+      QString masterDarkFile;
+      QString libraryFile;
       bool useMasterDark = false, useDarkFrames = false, saveMasterDark = false;
 
         // First collect all the flag values.
@@ -884,158 +1007,38 @@ namespace astroManager
 
       if (!bExit)
       {   // Ok to proceed.
-          // Create the object to perform the conversion.
+          // Create the master dark first if it is being created from dark frames.
 
-        if (useMasterDark)
+        if (useDarkFrames)
         {
-          if (useDarkFrames)
-          {
-            masterDarkFrame = new ACL::CMasterDarkFrame(darkSaveAs.toStdString());
-
-            for (iter = darkImageList.begin(); iter != darkImageList.end(); iter++)
-              masterDarkFrame->addDarkFrame( (*iter).toStdString() );
+          masterDarkFile = darkSaveAs;
+          bExit = !createMasterFrame(this, imaging::CMasterFrameLibrary::FT_DARK, darkImageList, QString(), false,
+                                     selectedCombineMode(widget()),
+                                     boost::filesystem::path(masterDarkFile.toStdString()), libraryFile);
 
-            try
-            {
-              masterDarkFrame->verifyFrames();
-            }
-            catch (GCL::CError &error)
-            {
-              if (error.library() == "ACL")
-              {
-                switch (error.errorCode())
-                {
-                  case 0x2000:    // image array sizes
-                  {
-                    msgBox.setText(tr("Dark Frame image ""naxis"" are inconsistent."));
-                    msgBox.setInformativeText(tr("All the flat frames must have the same number of axes (NAXIS)."));
-                    msgBox.setIcon(QMessageBox::Warning);
-                    msgBox.setStandardButtons(QMessageBox::Ok);
-                    msgBox.setDefaultButton(QMessageBox::Ok);
-                    msgBox.exec();
-                    break;
-                  };
-                  case 0x2001:    // image sizes
-                  {
-                    msgBox.setText(tr("Dark Frame image sizes are inconsistent."));
-                    msgBox.setInformativeText(tr("All the image must have the same sizes (NAXIS1, NAXIS2, NAXIS3)."));
-                    msgBox.setIcon(QMessageBox::Warning);
-                    msgBox.setStandardButtons(QMessageBox::Ok);
-                    msgBox.setDefaultButton(QMessageBox::Ok);
-                    msgBox.exec();
-                    break;
-                  };
-                  case 0x2002:    // exposure times
-                  {
-                    msgBox.setText(tr("Dark Frame exposures are inconsistent."));
-                    msgBox.setInformativeText(tr("All the Flat Frames must have the same exposure times."));
-                    msgBox.setIcon(QMessageBox::Warning);
-                    msgBox.setStandardButtons(QMessageBox::Ok);
-                    msgBox.setDefaultButton(QMessageBox::Ok);
-                    msgBox.exec();
-                    break;
-                  };
-                  default:
-                  {
-                    CODE_ERROR;
-                  };
-                };  // switch
-              };  // if
-            };  // catch
-
-            if (saveMasterDark)
-            {
-//              masterDarkFrame->save();
-            }
-
-            masterDarkFile = masterDarkFrame->setMasterDarkFile(NULL);    // Take control of the file.
-            delete masterDarkFrame;
-            masterDarkFrame = nullptr;
-          }
-          else
+          if (!libraryFile.isEmpty())
           {
-//            masterDarkFile = new ACL::CAstroFile(darkFileName.toStdString());
+            masterDarkFile = libraryFile;
           };
-        };
-
-        masterFlatFrame = new ACL::CMasterFlatFrame( flatFileName.toStdString() );
-        masterFlatFrame->setMasterFlatDarkFile(masterDarkFile);
-
-          // Copy the flat file names into the object.
-
-        for (iter = flatImageList.begin(); iter != flatImageList.end(); iter++)
-          masterFlatFrame->addFlatFrame( (*iter).toStdString() );
-
-          // All data is now copied to the object. Verify that the files are all consistent.
-
-        try
-        {
-          masterFlatFrame->verifyFrames();
         }
-        catch (GCL::CError &error)
+        else if (useMasterDark)
         {
-          if (error.library() == "ACL")
-          {
-            switch (error.errorCode())
-            {
-              case 0x2000:    // image array sizes
-              {
-                msgBox.setText(tr("Flat Frame image ""naxis"" are inconsistent."));
-                msgBox.setInformativeText(tr("All the flat frames must have the same number of axes (NAXIS)."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              case 0x2001:    // image sizes
-              {
-                msgBox.setText(tr("Flat Frame image sizes are inconsistent."));
-                msgBox.setInformativeText(tr("All the image must have the same sizes (NAXIS1, NAXIS2, NAXIS3)."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              case 0x2002:    // exposure times
-              {
-                msgBox.setText(tr("Flat Frame exposures are inconsistent."));
-                msgBox.setInformativeText(tr("All the Flat Frames must have the same exposure times."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              default:
-              {
-                CODE_ERROR;
-              };
-            };  // switch
-          };  // if
-        };  // catch
-
-        masterFlatFrame->createMasterFrame(ACL::EIC_MEAN);
-//        masterFlatFrame->save();
-
-        msgBox.setText(tr("Master Flat Frame Created and Saved."));
-        msgBox.setInformativeText(tr("The Master Flat Frame has been created using the flat frames."));
-        msgBox.setIcon(QMessageBox::Information);
-        msgBox.setStandardButtons(QMessageBox::Ok);
-        msgBox.setDefaultButton(QMessageBox::Ok);
-        msgBox.exec();
-
-        if (masterFlatFrame)
-        {
-          delete masterFlatFrame;
-          masterFlatFrame = NULL;
+          masterDarkFile = darkFileName;
         };
 
-        if (masterDarkFile)
+          // The flat frames are normalised to the level of the first frame, so changes in illumination between the frames
+          // do not bias the combine.
+
+        if (!bExit && createMasterFrame(this, imaging::CMasterFrameLibrary::FT_FLAT, flatImageList, masterDarkFile, true,
+                                        selectedCombineMode(widget()),
+                                        boost::filesystem::path(flatFileName.toStdString()), libraryFile))
         {
-          delete masterDarkFile;
-          masterDarkFile = NULL;
+          msgBox.setText(tr("Master Flat Frame Created and Saved."));
+          msgBox.setInformativeText(tr("The Master Flat Frame has been created using the flat frames."));
+          msgBox.setIcon(QMessageBox::Information);
+          msgBox.setStandardButtons(QMessageBox::Ok);
+          msgBox.setDefaultButton(QMessageBox::Ok);
+          msgBox.exec();
         };
       };
     }
@@ -1385,6 +1388,8 @@ namespace astroManager
 
     /// @brief Procedure to create the master bias frame.
     /// @throws CCodeError
+    /// @version 2026-10-17/GGB - Reuse masters from the master frame library.
+    /// @version 2026-10-17/GGB - Frames are streamed through imaging::CMasterFrameBuilder rather than held in memory.
     /// @version 2017-06-14/GGB - Update to Qt5
     /// @version 2011-05-22/GGB - Function created.
 
@@ -1392,8 +1397,7 @@ namespace astroManager
     {
       QMessageBox msgBox;
       bool bExit = false;
-      QStringList::iterator iter;
-      ACL::CMasterBiasFrame *masterBiasFrame;
+      QString libraryFile;
 
         // Check that there are a number of bias frames selected.
 
@@ -1418,75 +1422,10 @@ namespace astroManager
         bExit = true;
       };
 
-      if (!bExit)
+      if (!bExit && createMasterFrame(this, imaging::CMasterFrameLibrary::FT_BIAS, biasImageList, QString(), false,
+                                      selectedCombineMode(widget()),
+                                      boost::filesystem::path(masterBiasFileName.toStdString()), libraryFile))
       {
-          // All the basic requirements have been met. Filenames are selected as required. Additional checks will
-          // be carried out by the libAstroClass function.
-
-          // Create the master bias frame object.
-
-        masterBiasFrame = new ACL::CMasterBiasFrame(std::string(masterBiasFileName.toStdString()));
-
-          // Now add the bias frame file names
-
-        for (iter = biasImageList.begin(); iter != biasImageList.end(); iter++)
-        {
-          masterBiasFrame->addBiasFrame( std::string((*iter).toStdString()) );
-        }
-
-          // Call the CMasterBiasFrame class to verify all the dark frames are compatible.
-
-        try
-        {
-          masterBiasFrame->verifyFrames();
-        }
-        catch (GCL::CError &error)
-        {
-          if (error.library() == "ACL")
-          {
-            switch (error.errorCode())
-            {
-              case 0x2000:    // image array sizes
-              {
-                msgBox.setText(tr("Image Array sizes are inconsistent."));
-                msgBox.setInformativeText(tr("All the image arrays must have the same number of axes (NAXIS)."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              case 0x2001:    // image sizes
-              {
-                msgBox.setText(tr("Image sizes are inconsistent."));
-                msgBox.setInformativeText(tr("All the image must have the same sizes (NAXIS1, NAXIS2, NAXIS3)."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              case 0x2002:    // exposure times
-              {
-                msgBox.setText(tr("Image exposures are inconsistent."));
-                msgBox.setInformativeText(tr("All the images must have the same exposure times."));
-                msgBox.setIcon(QMessageBox::Warning);
-                msgBox.setStandardButtons(QMessageBox::Ok);
-                msgBox.setDefaultButton(QMessageBox::Ok);
-                msgBox.exec();
-                break;
-              };
-              default:
-              {
-                CODE_ERROR;
-              };
-            };  // switch
-          };  // if
-        };  // catch
-
-        masterBiasFrame->createMasterFrame(ACL::EIC_MEAN);
-//        masterBiasFrame->save();
-
         msgBox.setText(tr("Master Bias Frame Created and Saved."));
         msgBox.setInformativeText(tr("The Master Bias Frame has been created using the bias frames."));
         msgBox.setIcon(QMessageBox::Information);
@@ -1697,6 +1636,33 @@ namespace astroManager
       CMdiSubWindow::closeEvent(event);
     }
 
+    /// @brief Finds the images that would be written to the same output file.
+    /// @returns A list of the images that have the same file name as an earlier image in the list.
+    /// @details All the calibrated images are written to the save directory with the name of the input image, so images with the
+    ///          same name in different directories would overwrite each other. The names are compared without case, as the
+    ///          save directory may be on a file system that ignores case.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    QStringList CImageCalibrationMultipleWindow::duplicateOutputFiles() const
+    {
+      QStringList returnValue;
+      std::map<QString, QString> outputFiles;
+
+      for (QString const &image : imagesList)
+      {
+        QString outputFile = QFileInfo(image).fileName().toLower();
+        auto result = outputFiles.emplace(outputFile, image);
+
+        if (!result.second)
+        {
+          returnValue << tr("%1 (same name as %2)").arg(image).arg(result.first->second);
+        };
+      };
+
+      return returnValue;
+    }
+
     // Allows the user to specify the name of the master bias frame.
     /// @version 2017-06-14/GGB - Update to Qt5
     /// @version 2011-05-24/GGB - Function created.
@@ -1714,7 +1680,19 @@ namespace astroManager
       };
     }
 
-    // Procedure to calibrate the images.
+    /// @brief Procedure to calibrate the images.
+    /// @details The master frames are read once. The images are then calibrated concurrently on the global thread pool. Each
+    ///          thread reads an image, applies the master frames and writes the calibrated image to the save directory, so only
+    ///          one image per thread is held in memory. A progress dialog is displayed and the calibration can be cancelled.
+    ///          (Images that are being calibrated when the user cancels are completed.)
+    ///          Master frames that have not been selected are matched for each image, and the images are calibrated in groups
+    ///          that use the same master frames.
+    /// @throws GCL::CCodeError
+    /// @throws GCL::CRuntimeAssert
+    /// @version 2026-10-17/GGB - Match master frames for each image rather than for the first image.
+    /// @version 2026-10-17/GGB - Refuse to calibrate images that would be written to the same output file.
+    /// @version 2026-10-17/GGB - Match master frames that have not been selected from the master frame library.
+    /// @version 2026-10-17/GGB - Implemented the calibration. Exit if the user does not want to continue without a frame.
     /// @version 2017-06-14/GGB - Update to Qt5
     /// @version 2011-05-25/GGB - Function created.
 
@@ -1724,6 +1702,13 @@ namespace astroManager
       bool bUseDark = false, bUseFlat = false, bUseBias = false;
       bool bExit = false;
       QMessageBox msgBox;
+      std::vector<SImageMasters> imageMasters;
+
+      auto missingMaster = [&imageMasters](QString SImageMasters::*master)
+      {
+        return std::any_of(imageMasters.begin(), imageMasters.end(),
+                           [master](SImageMasters const &masters) { return (masters.*master).isEmpty(); });
+      };
 
         // Get the state of the checks and checkboxes.
 
@@ -1735,6 +1720,10 @@ namespace astroManager
       bUseFlat = widget()->findChild<QGroupBox *>("groupBoxUseFlat")->isChecked();
       bUseBias = widget()->findChild<QGroupBox *>("groupBoxUseBias")->isChecked();
 
+        // Master frames that are required, but have not been selected, are matched from the master frame library.
+
+      imageMasters = matchMasterFrames(bUseBias, bUseDark, bUseFlat);
+
         // Now check that we have valid data
 
       if (imagesList.size() < 1)
@@ -1747,11 +1736,11 @@ namespace astroManager
         msgBox.exec();
         bExit = true;
       }
-      else if ( bUseDark && masterDarkFrame.isNull() )
+      else if ( bUseDark && missingMaster(&SImageMasters::dark) )
       {
         msgBox.setText(tr("Dark frame not selected."));
-        msgBox.setInformativeText(tr("A dark frame has been indicated as required, but no dark frame has been supplied. \
-                                     Continue without using a dark frame?"));
+        msgBox.setInformativeText(tr("A dark frame has been indicated as required, but no dark frame has been supplied or found "
+                                     "for all the images. Continue without using a dark frame?"));
         msgBox.setIcon(QMessageBox::Question);
         msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
         msgBox.setDefaultButton(QMessageBox::No);
@@ -1759,13 +1748,13 @@ namespace astroManager
         if (msgBox.exec() == QMessageBox::Yes)
           bUseDark = bUseBias = false;
         else
-          bExit = false;
+          bExit = true;
       }
-      else if ( bUseBias && masterBiasFrame.isNull() )
+      else if ( bUseBias && missingMaster(&SImageMasters::bias) )
       {
         msgBox.setText(tr("Bias frame not selected."));
-        msgBox.setInformativeText(tr("A bias frame has been indicated as required, but no bias frame has been supplied. \
-                                     Continue without using a bias frame?"));
+        msgBox.setInformativeText(tr("A bias frame has been indicated as required, but no bias frame has been supplied or found "
+                                     "for all the images. Continue without using a bias frame?"));
         msgBox.setIcon(QMessageBox::Question);
         msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
         msgBox.setDefaultButton(QMessageBox::No);
@@ -1773,13 +1762,13 @@ namespace astroManager
         if (msgBox.exec() == QMessageBox::Yes)
           bUseBias = false;
         else
-          bExit = false;
+          bExit = true;
       }
-      else if ( bUseFlat && masterFlatFrame.isNull() )
+      else if ( bUseFlat && missingMaster(&SImageMasters::flat) )
       {
         msgBox.setText(tr("Flat frame not selected."));
-        msgBox.setInformativeText(tr("A flat frame has been indicated as required, but no flat frame has been supplied. \
-                                     Continue without using a flat frame?"));
+        msgBox.setInformativeText(tr("A flat frame has been indicated as required, but no flat frame has been supplied or found "
+                                     "for all the images. Continue without using a flat frame?"));
         msgBox.setIcon(QMessageBox::Question);
         msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
         msgBox.setDefaultButton(QMessageBox::No);
@@ -1787,12 +1776,232 @@ namespace astroManager
         if (msgBox.exec() == QMessageBox::Yes)
           bUseFlat = false;
         else
-          bExit = false;
+          bExit = true;
+      }
+      else if ( saveDirectory.isEmpty() )
+      {
+        msgBox.setText(tr("Save directory not selected."));
+        msgBox.setInformativeText(tr("A directory to save the calibrated images to must be selected."));
+        msgBox.setIcon(QMessageBox::Warning);
+        msgBox.setStandardButtons(QMessageBox::Ok);
+        msgBox.setDefaultButton(QMessageBox::Ok);
+        msgBox.exec();
+        bExit = true;
+      }
+      else if ( !duplicateOutputFiles().isEmpty() )
+      {
+        msgBox.setText(tr("Images with the same name."));
+        msgBox.setInformativeText(tr("Some of the images have the same file name and would be saved to the same file. Rename or "
+                                     "remove these images before calibrating."));
+        msgBox.setDetailedText(duplicateOutputFiles().join("\n"));
+        msgBox.setIcon(QMessageBox::Warning);
+        msgBox.setStandardButtons(QMessageBox::Ok);
+        msgBox.setDefaultButton(QMessageBox::Ok);
+        msgBox.exec();
+        bExit = true;
       };
 
       if (!bExit)   // No need to exit yet.
       {
+        struct SCalibrationJob
+        {
+          boost::filesystem::path inputFile;
+          boost::filesystem::path outputFile;
+          std::size_t calibrator = 0;           ///< Index of the calibrator with the master frames for the image.
+          bool processed = false;
+          bool calibrated = false;
+          std::exception_ptr exception;
+        };
+
+        std::vector<imaging::CImageCalibrator> imageCalibrators;
+        std::vector<SImageMasters> calibratorMasters;
+        std::map<QString, std::size_t> calibratorIndex;
+        std::vector<SCalibrationJob> calibrationJobs(imagesList.size());
+        QStringList errorList;
+        int skippedCount = 0;
+
+          // Group the images by the master frames used to calibrate them. There is a calibrator for each group.
+
+        for (std::size_t index = 0; index < calibrationJobs.size(); ++index)
+        {
+          SImageMasters masters;
+
+          masters.bias = bUseBias ? imageMasters[index].bias : QString();
+          masters.dark = bUseDark ? imageMasters[index].dark : QString();
+          masters.flat = bUseFlat ? imageMasters[index].flat : QString();
+
+          QString masterKey = masters.bias + "|" + masters.dark + "|" + masters.flat;
+          auto iterator = calibratorIndex.find(masterKey);
+
+          if (iterator == calibratorIndex.end())
+          {
+            iterator = calibratorIndex.emplace(masterKey, calibratorMasters.size()).first;
+            calibratorMasters.push_back(masters);
+          };
+
+          calibrationJobs[index].calibrator = iterator->second;
+        };
+
+        imageCalibrators.resize(calibratorMasters.size());
+
+          // Read the master frames once. They are shared by all the threads.
+
+        try
+        {
+          for (std::size_t calibrator = 0; calibrator < imageCalibrators.size(); ++calibrator)
+          {
+            if (!calibratorMasters[calibrator].bias.isEmpty())
+            {
+              imageCalibrators[calibrator].masterBias(boost::filesystem::path(calibratorMasters[calibrator].bias.toStdString()));
+            };
+            if (!calibratorMasters[calibrator].dark.isEmpty())
+            {
+              imageCalibrators[calibrator].masterDark(boost::filesystem::path(calibratorMasters[calibrator].dark.toStdString()));
+            };
+            if (!calibratorMasters[calibrator].flat.isEmpty())
+            {
+              imageCalibrators[calibrator].masterFlat(boost::filesystem::path(calibratorMasters[calibrator].flat.toStdString()));
+            };
+          };
+        }
+        catch (GCL::CError &error)
+        {
+          msgBox.setText(tr("Error while reading the master frames."));
+          msgBox.setInformativeText(QString::fromStdString(error.errorMessage()));
+          msgBox.setIcon(QMessageBox::Warning);
+          msgBox.setStandardButtons(QMessageBox::Ok);
+          msgBox.setDefaultButton(QMessageBox::Ok);
+          msgBox.exec();
+          bExit = true;
+        }
+        catch (ACL::CFITSException &error)
+        {
+          msgBox.setText(tr("cfitsio Error while reading the master frames."));
+          msgBox.setInformativeText(QString::fromStdString(error.errorMessage()));
+          msgBox.setIcon(QMessageBox::Warning);
+          msgBox.setStandardButtons(QMessageBox::Ok);
+          msgBox.setDefaultButton(QMessageBox::Ok);
+          msgBox.exec();
+          bExit = true;
+        };
+
+        if (!bExit)
+        {
+          for (imaging::CImageCalibrator &imageCalibrator : imageCalibrators)
+          {
+            imageCalibrator.options(bOverwrite, bBackup, bSaveOriginal);
+          };
+
+          for (int index = 0; index < imagesList.size(); ++index)
+          {
+            calibrationJobs[index].inputFile = boost::filesystem::path(imagesList[index].toStdString());
+            calibrationJobs[index].outputFile = boost::filesystem::path(saveDirectory.toStdString()) /
+                                                calibrationJobs[index].inputFile.filename();
+          };
+
+            // Calibrate the images. Each thread works on one image at a time.
+
+          QProgressDialog progressDialog(tr("Calibrating images..."), tr("Cancel"), 0, static_cast<int>(calibrationJobs.size()),
+                                         this);
+          QFutureWatcher<void> futureWatcher;
 
+          progressDialog.setWindowModality(Qt::WindowModal);
+
+          connect(&futureWatcher, SIGNAL(finished()), &progressDialog, SLOT(reset()));
+          connect(&progressDialog, SIGNAL(canceled()), &futureWatcher, SLOT(cancel()));
+          connect(&futureWatcher, SIGNAL(progressRangeChanged(int, int)), &progressDialog, SLOT(setRange(int, int)));
+          connect(&futureWatcher, SIGNAL(progressValueChanged(int)), &progressDialog, SLOT(setValue(int)));
+
+          futureWatcher.setFuture(QtConcurrent::map(calibrationJobs, [&imageCalibrators](SCalibrationJob &calibrationJob)
+          {
+            try
+            {
+              calibrationJob.calibrated = imageCalibrators[calibrationJob.calibrator].calibrateFile(calibrationJob.inputFile,
+                                                                                                   calibrationJob.outputFile);
+            }
+            catch(...)
+            {
+              calibrationJob.exception = std::current_exception();
+            };
+            calibrationJob.processed = true;
+          }));
+
+          progressDialog.exec();
+          futureWatcher.waitForFinished();
+
+          if (futureWatcher.isCanceled())
+          {
+            INFOMESSAGE("Image calibration cancelled.");
+          };
+
+            // Report the results.
+
+          for (SCalibrationJob const &calibrationJob : calibrationJobs)
+          {
+            QString fileName = QString::fromStdString(calibrationJob.inputFile.filename().string());
+
+            if (calibrationJob.exception)
+            {
+              try
+              {
+                std::rethrow_exception(calibrationJob.exception);
+              }
+              catch (GCL::CCodeError &)
+              {
+                throw;    // Propagate code errors.
+              }
+              catch (GCL::CRuntimeAssert &)
+              {
+                throw;    // Propagate runtime assertions.
+              }
+              catch (GCL::CError &error)
+              {
+                errorList << QString("%1: %2").arg(fileName).arg(QString::fromStdString(error.errorMessage()));
+              }
+              catch (ACL::CFITSException &error)
+              {
+                errorList << QString("%1: %2").arg(fileName).arg(QString::fromStdString(error.errorMessage()));
+              }
+              catch (std::exception &error)
+              {
+                errorList << QString("%1: %2").arg(fileName).arg(QString::fromStdString(error.what()));
+              }
+              catch (...)
+              {
+                errorList << QString("%1: %2").arg(fileName).arg(tr("Unknown error."));
+              };
+            }
+            else if (calibrationJob.processed && !calibrationJob.calibrated)
+            {
+              ++skippedCount;
+            };
+          };
+
+          if (!errorList.isEmpty())
+          {
+            for (QString const &error : errorList)
+            {
+              WARNINGMESSAGE("Image calibration: " + error.toStdString());
+            };
+
+            msgBox.setText(tr("Errors while calibrating images."));
+            msgBox.setInformativeText(tr("%1 images could not be calibrated.").arg(errorList.size()));
+            msgBox.setDetailedText(errorList.join("\n"));
+            msgBox.setIcon(QMessageBox::Warning);
+            msgBox.setStandardButtons(QMessageBox::Ok);
+            msgBox.setDefaultButton(QMessageBox::Ok);
+            msgBox.exec();
+          }
+          else if (skippedCount != 0)
+          {
+            msgBox.setText(tr("Images not calibrated."));
+            msgBox.setInformativeText(tr("%1 images were not calibrated as the output files already exist.").arg(skippedCount));
+            msgBox.setIcon(QMessageBox::Information);
+            msgBox.setStandardButtons(QMessageBox::Ok);
+            msgBox.setDefaultButton(QMessageBox::Ok);
+            msgBox.exec();
+          };
+        };
       };
     }
 
@@ -1938,6 +2147,128 @@ namespace astroManager
       };
     }
 
+    /// @brief      Matches master frames from the master frame library.
+    /// @param[in]  useBias: true if a master bias is required.
+    /// @param[in]  useDark: true if a master dark is required.
+    /// @param[in]  useFlat: true if a master flat is required.
+    /// @returns    The master frames for each image. (In the order of imagesList.)
+    /// @details    Masters selected by the user are used for all the images. The masters that have not been selected are matched
+    ///             for each image using the keywords of the image. (Instrument, binning, exposure, CCD temperature, filter and
+    ///             date.) A master dark is matched to suit whether the image has a master bias. If one master of a type is
+    ///             matched for all the images it is displayed in the window, otherwise the number of masters is displayed.
+    ///             Images that cannot be matched have no master of that type.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Match the masters for each image.
+    /// @version    2026-10-17/GGB - Function created.
+
+    std::vector<CImageCalibrationMultipleWindow::SImageMasters>
+    CImageCalibrationMultipleWindow::matchMasterFrames(bool useBias, bool useDark, bool useFlat)
+    {
+      std::vector<SImageMasters> returnValue(imagesList.size());
+      bool matchBias = useBias && masterBiasFrame.isNull();
+      bool matchDark = useDark && masterDarkFrame.isNull();
+      bool matchFlat = useFlat && masterFlatFrame.isNull();
+
+      for (SImageMasters &masters : returnValue)
+      {
+        masters.bias = masterBiasFrame;
+        masters.dark = masterDarkFrame;
+        masters.flat = masterFlatFrame;
+      };
+
+      if (!imagesList.isEmpty() && (matchBias || matchDark || matchFlat))
+      {
+        std::unique_ptr<imaging::CMasterFrameLibrary> masterFrameLibrary;
+
+        try
+        {
+          masterFrameLibrary.reset(new imaging::CMasterFrameLibrary());
+        }
+        catch (boost::filesystem::filesystem_error &error)
+        {
+          WARNINGMESSAGE("Master frame library: " + std::string(error.what()));
+        };
+
+        if (masterFrameLibrary)
+        {
+          for (int index = 0; index < imagesList.size(); ++index)
+          {
+            SImageMasters &masters = returnValue[index];
+
+            try
+            {
+              imaging::CMasterFrameLibrary::SFrameKey frameKey =
+                  imaging::CMasterFrameLibrary::readFrameKey(boost::filesystem::path(imagesList[index].toStdString()));
+
+              if (matchBias)
+              {
+                masters.bias = QString::fromStdString(
+                      masterFrameLibrary->findMaster(imaging::CMasterFrameLibrary::FT_BIAS, frameKey, false).string());
+              };
+
+              if (matchDark)
+              {
+                masters.dark = QString::fromStdString(
+                      masterFrameLibrary->findMaster(imaging::CMasterFrameLibrary::FT_DARK, frameKey,
+                                                     useBias && !masters.bias.isEmpty()).string());
+              };
+
+              if (matchFlat)
+              {
+                masters.flat = QString::fromStdString(
+                      masterFrameLibrary->findMaster(imaging::CMasterFrameLibrary::FT_FLAT, frameKey, false).string());
+              };
+            }
+            catch (boost::filesystem::filesystem_error &error)
+            {
+              WARNINGMESSAGE("Master frame library: " + std::string(error.what()));
+            }
+            catch (ACL::CFITSException &error)
+            {
+              WARNINGMESSAGE("Master frame library: " + imagesList[index].toStdString() + ": " + error.errorMessage());
+            };
+          };
+        };
+
+          // Display the masters that have been matched.
+
+        auto displayMasters = [&returnValue, this](QString SImageMasters::*master, char const *lineEditName)
+        {
+          std::set<QString> matchedMasters;
+
+          for (SImageMasters const &masters : returnValue)
+          {
+            matchedMasters.insert(masters.*master);
+          };
+
+          if ( (matchedMasters.size() == 1) && !matchedMasters.begin()->isEmpty() )
+          {
+            widget()->findChild<QLineEdit *>(lineEditName)->setText(*matchedMasters.begin());
+          }
+          else if (matchedMasters.size() > 1)
+          {
+            widget()->findChild<QLineEdit *>(lineEditName)->setText(tr("%1 masters matched from the library")
+                                                                    .arg(matchedMasters.size() - matchedMasters.count(QString())));
+          };
+        };
+
+        if (matchBias)
+        {
+          displayMasters(&SImageMasters::bias, "lineEditMasterBiasFrame");
+        };
+        if (matchDark)
+        {
+          displayMasters(&SImageMasters::dark, "lineEditMasterDarkFrame");
+        };
+        if (matchFlat)
+        {
+          displayMasters(&SImageMasters::flat, "lineEditMasterFlatFrame");
+        };
+      };
+
+      return returnValue;
+    }
+
     /// Sets up the UI by loading from file and getting all the window addresses.
     /// @throws GCL::CError(astroManager, 0x0001)
     /// @version 2017-07-10/GGB - Bug #90 checking for resource opening succesfully.
@@ -50,6 +50,8 @@
   // Standard C++ library header files
 
 #include <list>
+#include <optional>
+#include <vector>
 
   // Qt Framework
 
@@ -76,6 +78,8 @@
 #include "include/dockWidgets/dockWidgetNavigator.h"
 #include "include/dockWidgets/dockWidgetPhotometry.h"
 #include "include/error.h"
+#include "include/imaging/sourceMeasure.h"
+#include "include/imaging/spatialIndex.h"
 #include "include/settings.h"
 #include "include/astroManager.h"
 
@@ -156,6 +160,7 @@ namespace astroManager
 
     /// @brief Loads the astrometry targets from a file.
     /// @throws
+    /// @version 2026-10-17/GGB - Use the batched WCS transform. Fixed the deletion of targets that are not on the image.
     /// @version 2017-09-23/GGB - Updated to use CAngle
     /// @version 2017-07-03/GGB - Updated to reflect new dockwidget storage method.
 
@@ -238,13 +243,23 @@ namespace astroManager
 
           // Have all the data. Convert the RA/Dec to CCD coordinates
 
-          for (targetIterator = astrometryTargets.begin(); targetIterator != astrometryTargets.end(); ++targetIterator)
+          std::vector<ACL::CAstronomicalCoordinates> targetCoordinates;
+
+          for (auto const &target : astrometryTargets)
+          {
+            targetCoordinates.push_back(*target->observedCoordinates());
+          };
+
+          std::vector<std::optional<MCL::TPoint2D<FP_t>>> targetPixels =
+              controlImage.astroFile->wcs2pixList(controlImage.currentHDB, targetCoordinates);
+          targetIterator = astrometryTargets.begin();
+
+          for (auto const &targetPixel : targetPixels)
           {
-            std::optional<MCL::TPoint2D<FP_t>> result = controlImage.astroFile->wcs2pix(controlImage.currentHDB,
-                                                                                          *(*targetIterator)->observedCoordinates());
-            if (result)
+            if (targetPixel)
             {
-              (*targetIterator)->CCDCoordinates(*result);
+              (*targetIterator)->CCDCoordinates(*targetPixel);
+              ++targetIterator;
             }
             else
             {
@@ -523,6 +538,7 @@ namespace astroManager
 
     /// @brief Handles the menu action to bin pixels
     /// @throws None.
+    /// @version 2026-10-17/GGB - Invalidate the object indexes of the file.
     /// @version 2013-06-23/GGB - Added code to to reset the blackPoint and white Point. (Bug #1193740)
     /// @version 2013-05-25/GGB - Added support for View | Magnify and View | Navigator
     /// @version 2013-02-02/GGB - Added support for the histogram widget.
@@ -540,6 +556,7 @@ namespace astroManager
         oy = controlImage.astroFile->imageHeight(controlImage.currentHDB);
 
         controlImage.astroFile->binPixels(controlImage.currentHDB, dlg.getBinSize());
+        controlImage.astroFile->invalidateObjectIndexes();
 
         controlImage.blackPoint = controlImage.astroFile->blackPoint();
         controlImage.whitePoint = controlImage.astroFile->whitePoint();
@@ -876,6 +893,7 @@ namespace astroManager
 
     /// @brief Function to crop the image. Called from CFrameWindow.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Invalidate the object indexes of the file.
     /// @version 2015-09-21/GGB - Found and corrected memory leak.
     /// @version 2013-09-16/GGB - Default to image size for the dialog. (Bug #1219189)
     /// @version 2013-06-28/GGB - Added historyUpdate() and std::clog output.
@@ -893,6 +911,7 @@ namespace astroManager
       if (dlg.exec() == QDialog::Accepted)
       {
         controlImage.astroFile->imageCrop(controlImage.currentHDB, origin, dims);
+        controlImage.astroFile->invalidateObjectIndexes();
 
         historyUpdate();
 
@@ -1920,6 +1939,7 @@ namespace astroManager
 
     /// @brief Handles the flip event from the menu.
     /// @throws GCL::CCodeError(astroManager)
+    /// @version 2026-10-17/GGB - Invalidate the object indexes of the file.
     /// @version 2014-12-28/GGB - Changed logging to use GCL::logger.
     /// @version 2013-06-29/GGB - Bug #1195952 fixed.
     /// @version 2013-06-28/GGB - Added historyUpdate().
@@ -1931,6 +1951,7 @@ namespace astroManager
       if (controlImage.astroFile)
       {
         controlImage.astroFile->flipImage(controlImage.currentHDB);
+        controlImage.astroFile->invalidateObjectIndexes();
 
         historyUpdate();
 
@@ -1956,6 +1977,7 @@ namespace astroManager
     /// 1) Get the size of the canvas from the user.
     /// 2) Float the image.
     //
+    // 2026-10-17/GGB - Invalidate the object indexes of the file.
     // 2015-07-30/GGB - Changed the dialog to stack assigned rather than dynamically assigned.
     // 2014-12-30/GGB - Use GLC::logger rather than std::clog for messaging.
     // 2013-06-28/GGB - Added historyUpdate() and std::clog output.
@@ -1969,6 +1991,7 @@ namespace astroManager
       if (dlg.exec() == QDialog::Accepted)
       {
         controlImage.astroFile->imageFloat(controlImage.currentHDB, dlg.getWidth(), dlg.getHeight(), dlg.getBackground());
+        controlImage.astroFile->invalidateObjectIndexes();
 
         historyUpdate();
 
@@ -1987,6 +2010,7 @@ namespace astroManager
     /// @brief Handles the flip event from the menu.
     /// @details Call the astroFile flip event.
     ///
+    // 2026-10-17/GGB - Invalidate the object indexes of the file.
     // 2014-12-30/GGB - Use GCL::logger rather than std::clog for messaging.
     // 2013-06-29/GGB - Bug #1195952 fixed.
     // 2013-06-28/GGB - Added historyUpdate()
@@ -2000,6 +2024,7 @@ namespace astroManager
       if (controlImage.astroFile)
       {
         controlImage.astroFile->flopImage(controlImage.currentHDB);
+        controlImage.astroFile->invalidateObjectIndexes();
 
         historyUpdate();
 
@@ -2218,6 +2243,15 @@ namespace astroManager
     /// @param None.
     /// @returns None.
     /// @throws None.
+    /// @details The targets are converted to image coordinates with one call to wcs2pixList(). The centroids are then searched
+    ///          concurrently in the pixel buffer of the image (a snapshot owned by the workers), so the ACL image is only used on
+    ///          the calling thread. The objects are then added to the image in a single pass.
+    /// @version 2026-10-17/GGB - Search the centroids concurrently in the pixel buffer rather than the ACL image.
+    /// @version 2026-10-17/GGB - The centroids are searched on the calling thread.
+    /// @version 2026-10-17/GGB - Add the targets to the astrometry dock widget in a single insert.
+    /// @version 2026-10-17/GGB - Use the batched WCS transforms.
+    /// @version 2026-10-17/GGB - Convert and centroid the targets concurrently.
+    /// @version 2026-10-17/GGB - Use the spatial index to check for objects that are already identified.
     /// @version 2016-04-25/GGB - Function created.
 
     void CImageWindow::loadObjects()
@@ -2225,7 +2259,6 @@ namespace astroManager
       dockwidgets::CAstrometryDockWidget *dw = dynamic_cast<dockwidgets::CAstrometryDockWidget *>
           (dynamic_cast<mdiframe::CFrameWindow *>(nativeParentWidget())->getDockWidget(mdiframe::IDDW_ASTROMETRYCONTROL));
 
-      std::optional<ACL::CAstronomicalCoordinates> tl, br;
       ACL::DTargetAstronomy targetList;       // Will be destructed when it goes out of scope.
       int targetCount = 0, targetOutside = 0, targetCentroid = 0;
 
@@ -2240,113 +2273,120 @@ namespace astroManager
 
         // Get the surrounding square
 
-      MCL::TPoint2D<FP_t> topLeft(0, controlImage.astroFile->imageHeight(controlImage.currentHDB) - 1);
-      MCL::TPoint2D<FP_t> bottomRight(controlImage.astroFile->imageWidth(controlImage.currentHDB) - 1, 0);
-
-      tl = controlImage.astroFile->pix2wcs(controlImage.currentHDB, topLeft);
-      br = controlImage.astroFile->pix2wcs(controlImage.currentHDB, bottomRight);
+      std::vector<std::optional<ACL::CAstronomicalCoordinates>> corners =
+          controlImage.astroFile->pix2wcsList(controlImage.currentHDB,
+              { MCL::TPoint2D<FP_t>(0, controlImage.astroFile->imageHeight(controlImage.currentHDB) - 1),
+                MCL::TPoint2D<FP_t>(controlImage.astroFile->imageWidth(controlImage.currentHDB) - 1, 0) });
 
         // Query the database
 
-      database::databaseATID->queryByCoordinates(*tl, *br, targetList);
+      database::databaseATID->queryByCoordinates(*corners[0], *corners[1], targetList);
 
       INFOMESSAGE("Adding to target list...");
 
-        // Add the targets to the target list.
-        // For each target, we need to convert the RA/DEC to a pixel pair.
-        // The pixel pair is then used to search for the centroid.
-        // When the centroid is found, the object is checked against the list for repeats.
-        // The object can then be added to the list.
+        // Convert the RA/DEC of each target to a pixel pair and search for the centroid.
 
+      std::vector<ACL::DTargetAstronomy::value_type> targets(targetList.begin(), targetList.end());
+      std::vector<ACL::CAstronomicalCoordinates> targetCoordinates;
+      std::vector<std::optional<MCL::TPoint2D<FP_t>>> centroids(targets.size());
+      ACL::CAstroTime currentTime;
+      AXIS_t centroidRadius = settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS,
+                                                                    QVariant(20)).toLongLong();
+      int centroidSensitivity = settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_SENSITIVITY,
+                                                                      QVariant(3)).toInt();
+      FP_t closeRadius = settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS).toInt();
 
-      for (auto &elem : targetList)
+      targetCoordinates.reserve(targets.size());
+      for (auto const &target : targets)
       {
-        std::optional<MCL::TPoint2D<FP_t>> ccdPixel;
+        targetCoordinates.push_back(target->positionICRS(currentTime));
+      };
 
-        ccdPixel = controlImage.astroFile->wcs2pix(controlImage.currentHDB, elem->positionICRS(ACL::CAstroTime()));
+      std::vector<std::optional<MCL::TPoint2D<FP_t>>> imagePixels =
+          controlImage.astroFile->wcs2pixList(controlImage.currentHDB, targetCoordinates);
 
-          // It is possible for the converted coordinate to fall outside of the image.
+        // The snapshot is taken on this thread. The workers only read it.
 
-        if (ccdPixel)
-        {
-            // Search for the centroid of the object.
+      imaging::CSourceMeasure sourceMeasure(controlImage.pixelData());
 
-          ccdPixel = controlImage.astroFile->centroid(controlImage.currentHDB, *ccdPixel,
-                                                      settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS,
-                                                                                    QVariant(20)).toLongLong(),
-                                                      settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_SENSITIVITY,
-                                                                                    QVariant(3)).toInt());;
-          if (ccdPixel)
-          {
-              // Found a centroid.
+      imaging::parallelFor(targets.size(), [&](std::size_t targetBegin, std::size_t targetEnd)
+      {
+        std::vector<float> workspace;
 
-            bool bClose = false;
-            astrometry::CAstrometryObservation *astrometryObject;
-            ACL::CAstrometryObservation *existingObject;
+        workspace.reserve(static_cast<std::size_t>((2 * centroidRadius + 1) * (2 * centroidRadius + 1)));
 
-              // Check if the object is already identified.
+        for (std::size_t target = targetBegin; target < targetEnd; ++target)
+        {
+            // It is possible for the converted coordinate to fall outside of the image.
 
-            if (controlImage.astroFile->hasAstrometryHDB())
-            {
-              existingObject = controlImage.astroFile->astrometryObjectFirst();
+          if (imagePixels[target])
+          {
+            centroids[target] = sourceMeasure.centroid(*imagePixels[target], centroidRadius, centroidSensitivity, workspace);
+          };
+        };
+      });
 
-              while ( (existingObject) && !bClose)
-              {
-                bClose = existingObject->isClose(*ccdPixel,
-                                                 settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS).toInt());
-                existingObject = controlImage.astroFile->astrometryObjectNext();
-              };
-            };
+        // Add the targets to the target list in a single pass.
+        // When the centroid is found, the object is checked against the list for repeats.
+        // The object can then be added to the list.
 
-              // Object not identified - add to the list.
+      astrometry::CAstrometryObservation *lastObject = nullptr;
 
-            if (!bClose)
-            {
-              controlImage.astrometryObservations.emplace_back(std::make_shared<astrometry::CAstrometryObservation>(elem));
+      for (std::size_t target = 0; target < targets.size(); ++target)
+      {
+        if (!imagePixels[target])
+        {
+            // Pixel falls outside of the image.  Note it in the debug log.
 
-              controlImage.astrometryObservations.back()->CCDCoordinates(*ccdPixel);
+          targetOutside++;
+          DEBUGMESSAGE("Object " + targets[target]->objectName() + " falls outside the image.");
+        }
+        else if (!centroids[target])
+        {
+            // No centroid found. Note this in the debug log.
 
-                // Add the astrometry observation to the reference list.
+          targetCentroid++;
+          DEBUGMESSAGE("Object " + targets[target]->objectName() + " could not find centroid. Not added to image.");
+        }
+        else if (controlImage.astroFile->astrometryObjectClose(*centroids[target], closeRadius) == nullptr)
+        {
+            // Object not identified - add to the list.
 
-              if ( !controlImage.astroFile->hasAstrometryHDB() )
-              {
-                ACL::CHDBAstrometry *ahdb = controlImage.astroFile->createAstrometryHDB();
-                ahdb->keywordWrite(ACL::HEASARC_CREATOR, CREATOR(), ACL::HEASARC_COMMENT_CREATOR);
-                ahdb->keywordWrite(ACL::FITS_DATE, getDate(), ACL::FITS_COMMENT_DATE);
-              };
+          controlImage.astrometryObservations.emplace_back(std::make_shared<astrometry::CAstrometryObservation>(targets[target]));
+          lastObject = controlImage.astrometryObservations.back().get();
 
-              controlImage.astroFile->astrometryObjectAdd(controlImage.astrometryObservations.back());
+          lastObject->CCDCoordinates(*centroids[target]);
 
+            // Add the astrometry observation to the reference list.
 
-              changeAstrometrySelection(controlImage.astrometryObservations.back().get());
+          if ( !controlImage.astroFile->hasAstrometryHDB() )
+          {
+            ACL::CHDBAstrometry *ahdb = controlImage.astroFile->createAstrometryHDB();
+            ahdb->keywordWrite(ACL::HEASARC_CREATOR, CREATOR(), ACL::HEASARC_COMMENT_CREATOR);
+            ahdb->keywordWrite(ACL::FITS_DATE, getDate(), ACL::FITS_COMMENT_DATE);
+          };
 
-              astrometryReferenceAdd(controlImage.astrometryObservations.back().get());
-              dw->referenceCompleted(controlImage.astrometryObservations.back().get());
+          controlImage.astroFile->astrometryObjectAdd(controlImage.astrometryObservations.back());
 
-              controlImage.astroFile->isDirty(true);
-              controlImage.astroFile->hasData(true);
-              updateWindowTitle();
+          astrometryReferenceAdd(lastObject);
 
-              targetCount++;
+          targetCount++;
 
-              INFOMESSAGE("Added object " + elem->objectName() + " to astrometry list.");
-            };
-          }
-          {
-              // No centroid found. Note this in the debug log.
+          INFOMESSAGE("Added object " + targets[target]->objectName() + " to astrometry list.");
+        };
+      };
 
-            targetCentroid++;
-            DEBUGMESSAGE("Object " + elem->objectName() + " could not find centroid. Not added to image.");
-          }
-        }
-        else
-        {
-            // Pixel falls outside of the image.  Note it in the debug log.
+      if (lastObject)
+      {
+        dw->addObjects(static_cast<std::size_t>(targetCount));
+        dw->displayAstrometry(lastObject);
+        changeAstrometrySelection(lastObject);
 
-          targetOutside++;
-          DEBUGMESSAGE("Object " + elem->objectName() + " falls outside the image.");
-        }
+        controlImage.astroFile->isDirty(true);
+        controlImage.astroFile->hasData(true);
+        updateWindowTitle();
       };
+
       INFOMESSAGE("Added " + std::to_string(targetCount) + " objects to image.");
       DEBUGMESSAGE("Failed to add " + std::to_string(targetCentroid) + " objects for \"Centroid not found\".");
       DEBUGMESSAGE("Failed to add " + std::to_string(targetOutside) + " objects for \"Object falls Outside the image boundaries\".");
@@ -2355,6 +2395,17 @@ namespace astroManager
 
     /// @brief Function to extract all the objects in the image.
     /// @throws GCL::CCodeError(astroManager)
+    /// @throws GCL::CRuntimeAssert
+    /// @details The FWHM and aperture sums of the objects are measured concurrently in the pixel buffer of the image (a snapshot
+    ///          owned by the workers), so the ACL image is only used on the calling thread. Objects that cannot be measured are
+    ///          discarded. The objects are then added in a single pass.
+    /// @version 2026-10-17/GGB - Measure the FWHM and aperture sums concurrently in the pixel buffer rather than the ACL image.
+    /// @version 2026-10-17/GGB - Measure the FWHM and photometry sequentially. Only runtime errors discard an object. Discarded
+    ///                           objects no longer block their neighbours.
+    /// @version 2026-10-17/GGB - Add the objects to the dock widgets in a single insert.
+    /// @version 2026-10-17/GGB - Measure the FWHM and photometry concurrently.
+    /// @version 2026-10-17/GGB - Convert the centres of the objects with the batched WCS transform.
+    /// @version 2026-10-17/GGB - Use the spatial index to check for objects that are already identified. Each object is checked.
     /// @version 2015-09-20/GGB - (Bug 81) Added try...catch block around pointPhotometry() call as this can throw.
     /// @version 2014-02-09/GGB - Added support for algorithm choice.
     /// @version 2012-07-28/GGB - Function created.
@@ -2400,27 +2451,30 @@ namespace astroManager
 
       if (returnValue)    // Need to add the objects to the relevant list(s).
       {
+          // Convert the centres of all the objects to WCS coordinates.
+
+        std::vector<MCL::TPoint2D<FP_t>> objectCentres;
+
+        for (auto const &imageObject : imageObjectList)
+        {
+          objectCentres.push_back(imageObject->center);
+        };
+
+        std::vector<std::optional<ACL::CAstronomicalCoordinates>> objectCoordinates =
+            controlImage.astroFile->pix2wcsList(controlImage.currentHDB, objectCentres);
 
         if (settings::astroManagerSettings->value(settings::SOURCE_EXTRACTION_ADD_ASTROMETRY, QVariant(false)).toBool())
         {
           DEBUGMESSAGE("Adding objects to Astrometry list...");
 
-          bool bClose = false;
-          ACL::CAstrometryObservation *existingObject;
+          FP_t closeRadius = settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS).toInt();
+          std::size_t objectIndex = 0;
+          std::size_t objectsAdded = 0;
+          astrometry::CAstrometryObservation *lastObject = nullptr;
 
           for (auto iter : imageObjectList)
           {
-            if (controlImage.astroFile->hasAstrometryHDB())
-            {
-              existingObject = controlImage.astroFile->astrometryObjectFirst();
-
-              while ( (existingObject) && !bClose)
-              {
-                bClose = existingObject->isClose(iter->center,
-                                                 settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS).toInt());
-                existingObject = controlImage.astroFile->astrometryObjectNext();
-              };
-            };
+            bool bClose = (controlImage.astroFile->astrometryObjectClose(iter->center, closeRadius) != nullptr);
 
             if (!bClose)
             {
@@ -2429,14 +2483,9 @@ namespace astroManager
 
               controlImage.astrometryObservations.back()->CCDCoordinates(iter->center);
 
-              // Get the image coordinates and convert to WCS coordinates.
-
-              std::optional<ACL::CAstronomicalCoordinates> WCSCoordinates =
-                  controlImage.astroFile->getHDB(controlImage.currentHDB)->pix2wcs(controlImage.astrometryObservations.back()->CCDCoordinates());
-
-              if (WCSCoordinates)
+              if (objectCoordinates[objectIndex])
               {
-                controlImage.astrometryObservations.back()->observedCoordinates(*WCSCoordinates);
+                controlImage.astrometryObservations.back()->observedCoordinates(*objectCoordinates[objectIndex]);
               };
 
               QString objectName = QString("A:%1").arg(controlImage.astroFile->astrometryObjectCount() + 1);
@@ -2452,14 +2501,22 @@ namespace astroManager
               };
 
               controlImage.astroFile->astrometryObjectAdd(controlImage.astrometryObservations.back());
+              lastObject = controlImage.astrometryObservations.back().get();
 
-              changeAstrometrySelection(controlImage.astrometryObservations.back().get());
+              astrometryReferenceAdd(lastObject);
+              ++objectsAdded;
+            };
 
-              adw->addNewObject(controlImage.astrometryObservations.back().get());
-              adw->displayAstrometry(controlImage.astrometryObservations.back().get());
+            ++objectIndex;
+          };
 
-              astrometryReferenceAdd(controlImage.astrometryObservations.back().get());
-            };
+          if (lastObject)
+          {
+              // Update the dock widget once for all the new objects.
+
+            adw->addObjects(objectsAdded);
+            adw->displayAstrometry(lastObject);
+            changeAstrometrySelection(lastObject);
 
             controlImage.astroFile->isDirty(true);
             controlImage.astroFile->hasData(true);
@@ -2473,80 +2530,107 @@ namespace astroManager
         {
           DEBUGMESSAGE("Adding objects to Photometry list...");
 
-          bool bClose = false;
-          ACL::CPhotometryObservation *existingObject;
+            // Measure the FWHM and the aperture sums of all the objects concurrently. The snapshot is taken on this thread and
+            // the workers only read it. An object fails if its aperture or FWHM box is not inside the image.
 
-          for (auto iter : imageObjectList)
+          imaging::CSourceMeasure sourceMeasure(controlImage.pixelData());
+          FP_t radius1 = pdw->getRadius1(), radius2 = pdw->getRadius2(), radius3 = pdw->getRadius3();
+          std::vector<std::optional<imaging::CSourceMeasure::SAperture>> objectApertures(objectCentres.size());
+          std::vector<std::optional<FP_t>> objectFWHM(objectCentres.size());
+
+          imaging::parallelFor(objectCentres.size(), [&](std::size_t objectBegin, std::size_t objectEnd)
           {
-            if (controlImage.astroFile->hasPhotometryHDB())
+            std::vector<float> workspace;
+
+            for (std::size_t object = objectBegin; object < objectEnd; ++object)
             {
-              existingObject = controlImage.astroFile->photometryObjectFirst();
+              objectApertures[object] = sourceMeasure.aperture(objectCentres[object], radius1, radius2, radius3);
 
-              while ( (existingObject) && !bClose)
+              if (objectApertures[object])
               {
-                bClose = existingObject->isClose(iter->center, pdw->getRadius2());
-                existingObject = controlImage.astroFile->photometryObjectNext();
+                objectFWHM[object] = sourceMeasure.FWHM(objectCentres[object], workspace);
               };
             };
+          });
 
-            if (!bClose)
-            {
-                // Object not already in the list. Add object to the list.
+            // Select the objects that are not already in the list. The objects selected are also checked against each other.
+            // Objects that failed are not added to the index, so they do not block their neighbours.
 
+          photometry::DPhotometryObservationStore newObservations;
+          imaging::TSpatialIndex<photometry::CPhotometryObservation> newIndex;
+          std::size_t objectIndex = 0;
+          std::size_t objectsFailed = 0;
+
+          for (auto iter : imageObjectList)
+          {
+            if (!objectApertures[objectIndex] || !objectFWHM[objectIndex])
+            {
+              ++objectsFailed;
+            }
+            else if ( (controlImage.astroFile->photometryObjectClose(iter->center, pdw->getRadius2()) == nullptr) &&
+                      (newIndex.findClose(iter->center, pdw->getRadius2()) == nullptr) )
+            {
               ACL::PPhotometryAperture photometryAperture(new ACL::CPhotometryApertureCircular(pdw->getRadius1(),
                                                                                                pdw->getRadius2(),
                                                                                                pdw->getRadius3()));
 
-              controlImage.photometryObservations.emplace_back(
+              newObservations.emplace_back(
                     std::make_shared<photometry::CPhotometryObservation>(std::make_shared<ACL::CTargetStellar>()));
-              controlImage.photometryObservations.back()->CCDCoordinates(iter->center);
-
-              controlImage.photometryObservations.back()->observedCoordinates() =
-                  controlImage.astroFile->getHDB(controlImage.currentHDB)->pix2wcs(controlImage.photometryObservations.back()->CCDCoordinates());
-
-              controlImage.photometryObservations.back()->photometryAperture(photometryAperture);
-              controlImage.photometryObservations.back()->exposure() = controlImage.astroFile->getHDB(controlImage.currentHDB)->EXPOSURE();
-              controlImage.photometryObservations.back()->gain(static_cast<FP_t>(controlImage.astroFile->getHDB(controlImage.currentHDB)->keywordData(ACL::SBIG_EGAIN)));
-              controlImage.photometryObservations.back()->FWHM(controlImage.astroFile->FWHM(controlImage.currentHDB, iter->center));
+              newObservations.back()->CCDCoordinates(iter->center);
+              newObservations.back()->observedCoordinates() = objectCoordinates[objectIndex];
+              newObservations.back()->photometryAperture(photometryAperture);
+              newObservations.back()->exposure() = controlImage.astroFile->getHDB(controlImage.currentHDB)->EXPOSURE();
+              newObservations.back()->gain(static_cast<FP_t>(controlImage.astroFile->getHDB(controlImage.currentHDB)->keywordData(ACL::SBIG_EGAIN)));
+              newObservations.back()->FWHM(*objectFWHM[objectIndex]);
+              newObservations.back()->sourceADU(objectApertures[objectIndex]->sourceADU);
+              newObservations.back()->sourceArea(objectApertures[objectIndex]->sourceArea);
+              newObservations.back()->skyADU(objectApertures[objectIndex]->skyADU);
+              newObservations.back()->skyArea(objectApertures[objectIndex]->skyArea);
+              newIndex.insert(newObservations.back().get());
+            };
 
-              try
-              {
-                controlImage.astroFile->pointPhotometry(controlImage.currentHDB, *controlImage.photometryObservations.back());    // Now perform the photometry on the object
+            ++objectIndex;
+          };
 
-                  // Give the object a temporary name and add it into the two lists.
+            // Add the objects to the lists in a single pass.
 
-                QString objectName = QString("P:%1").arg(controlImage.astroFile->photometryObjectCount() + 1);
-                controlImage.photometryObservations.back()->objectName(objectName.toStdString());
+          photometry::CPhotometryObservation *lastObject = nullptr;
 
-                  // Add the photometry observation to the reference list.
+          for (auto &newObservation : newObservations)
+          {
+              // Give the object a temporary name and add it into the two lists.
 
-                if ( !controlImage.astroFile->hasPhotometryHDB() )
-                {
-                  ACL::CHDBPhotometry *phdb = controlImage.astroFile->createPhotometryHDB();
-                  phdb->keywordWrite(ACL::HEASARC_CREATOR, CREATOR(), ACL::HEASARC_COMMENT_CREATOR);
-                  phdb->keywordWrite(ACL::FITS_DATE, getDate(), ACL::FITS_COMMENT_DATE);
-                };
+            QString objectName = QString("P:%1").arg(controlImage.astroFile->photometryObjectCount() + 1);
+            newObservation->objectName(objectName.toStdString());
 
-                controlImage.astroFile->photometryObjectAdd(controlImage.photometryObservations.back());
+            if ( !controlImage.astroFile->hasPhotometryHDB() )
+            {
+              ACL::CHDBPhotometry *phdb = controlImage.astroFile->createPhotometryHDB();
+              phdb->keywordWrite(ACL::HEASARC_CREATOR, CREATOR(), ACL::HEASARC_COMMENT_CREATOR);
+              phdb->keywordWrite(ACL::FITS_DATE, getDate(), ACL::FITS_COMMENT_DATE);
+            };
 
-                  // Now draw the photometry indicator
+            controlImage.photometryObservations.push_back(newObservation);
+            controlImage.astroFile->photometryObjectAdd(newObservation);
+            lastObject = newObservation.get();
 
-                changePhotometrySelection(controlImage.photometryObservations.back().get());
+            photometryReferenceAdd(lastObject);
+          };
 
-                  // Update the information in the dockwidget.
+          if (lastObject)
+          {
+              // Update the dock widget once for all the new objects and draw the photometry indicator.
 
-                pdw->addNewObject(controlImage.photometryObservations.back().get());
-                pdw->displayPhotometry(controlImage.photometryObservations.back().get());
+            pdw->addObjects(newObservations.size());
+            changePhotometrySelection(lastObject);
+            pdw->displayPhotometry(lastObject);
+          };
 
-                photometryReferenceAdd(controlImage.photometryObservations.back().get());
-              }
-              catch(...)
-              {
-                  // The pointPhotometry function can throw for out of bounds. In this case, the best response is to do nothing and
-                  // to carry on with the rest of the objects.
-              };
-            };
+          if (objectsFailed != 0)
+          {
+            WARNINGMESSAGE("Photometry failed for " + std::to_string(objectsFailed) + " objects. Objects not added.");
           };
+
           DEBUGMESSAGE("Completed adding objects to Photometry list.");
 
             // Update the image and window characteristics.
@@ -2561,6 +2645,7 @@ namespace astroManager
     }
 
     /// Procedure to handle the mouse press when the window is in Astronometry Mode.
+    /// @version 2026-10-17/GGB - Use the spatial index to check for duplicate objects.
     /// @version 2017-07-03/GGB - Updated to new style dockwidget storage.
     /// @version 2013-08-27/GGB - Added code to prevent duplicate object selection. (Bug #1210902)
     /// @version 2013-08-25/GGB - Changed code to support the changedAstrometrySelection() function.
@@ -2574,7 +2659,6 @@ namespace astroManager
           (dynamic_cast<mdiframe::CFrameWindow *>(nativeParentWidget())->getDockWidget(mdiframe::IDDW_ASTROMETRYCONTROL));
       QPointF point;
       bool bClose;
-      ACL::CAstrometryObservation *existingObject;
 
       ACL::CAstroImage *astroImage = controlImage.astroFile->getAstroImage(controlImage.currentHDB);
       if (!astroImage)
@@ -2599,19 +2683,8 @@ namespace astroManager
         {
           // Check the list for another target that is close.
 
-          bClose = false;
-
-          if (controlImage.astroFile->hasAstrometryHDB())
-          {
-            existingObject = controlImage.astroFile->astrometryObjectFirst();
-
-            while ( (existingObject) && !bClose)
-            {
-              bClose = existingObject->isClose(MCL::TPoint2D<FP_t>(point.x(), point.y()),
-                                               settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS).toInt());
-              existingObject = controlImage.astroFile->astrometryObjectNext();
-            };
-          };
+          bClose = (controlImage.astroFile->astrometryObjectClose(MCL::TPoint2D<FP_t>(point.x(), point.y()),
+                      settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS).toInt()) != nullptr);
 
           if (!bClose)
           {
@@ -2678,6 +2751,7 @@ namespace astroManager
     /// @brief Handles the mouse press event when the window is in the photometry mode.
     /// @param[in] mouseEvent - The mouse event data
     /// @throws GCL::CRuntimeAssert(astroManager)
+    /// @version 2026-10-17/GGB - Use the spatial index to check for duplicate objects.
     /// @version 2013-07-27/GGB - Added code to catch the error when the photometry overlaps the edge. (Bug #1205629)
     /// @version 2011-12-20/GGB - Function created.
 
@@ -2687,7 +2761,6 @@ namespace astroManager
       bool bClose;
       dockwidgets::CPhotometryDockWidget *pw = dynamic_cast<dockwidgets::CPhotometryDockWidget *>
           (dynamic_cast<mdiframe::CFrameWindow *>(nativeParentWidget())->getDockWidget(mdiframe::IDDW_PHOTOMETRYCONTROL));
-      ACL::CPhotometryObservation *existingObject;
 
       switch (mouseEvent->button())
       {
@@ -2708,18 +2781,8 @@ namespace astroManager
 
                 // Check the list for another target that is close.
 
-              bClose = false;
-
-              if (controlImage.astroFile->hasPhotometryHDB())
-              {
-                existingObject = controlImage.astroFile->photometryObjectFirst();
-
-                while ( (existingObject) && !bClose)
-                {
-                  bClose = existingObject->isClose(MCL::TPoint2D<FP_t>(point.x(), point.y()), pw->getRadius2());
-                  existingObject = controlImage.astroFile->photometryObjectNext();
-                };
-              };
+              bClose = (controlImage.astroFile->photometryObjectClose(MCL::TPoint2D<FP_t>(point.x(), point.y()),
+                                                                      pw->getRadius2()) != nullptr);
 
               if (!bClose)
               {
@@ -2888,6 +2951,8 @@ namespace astroManager
 
     /// @brief Function to load photometry targets and apply to current image.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Use the batched WCS transform. Fixed the deletion of targets that are not on the image.
+    /// @version 2026-10-17/GGB - Use the spatial index to check for duplicate objects.
     /// @version 2017-07-03/GGB - Use new style dockwidget storage.
     /// @version 2014-12-30/GGB - Use GCL::logger rather than std::clog.
     /// @version 2013-08-21/GGB - Function created.
@@ -2970,13 +3035,23 @@ namespace astroManager
 
             // Have all the data. Convert the RA/Dec to CCD coordinates
 
-          for (auto targetIterator = photometryTargets.begin(); targetIterator != photometryTargets.end(); ++targetIterator)
+          std::vector<ACL::CAstronomicalCoordinates> targetCoordinates;
+
+          for (auto const &target : photometryTargets)
+          {
+            targetCoordinates.push_back(*target->observedCoordinates());
+          };
+
+          std::vector<std::optional<MCL::TPoint2D<FP_t>>> targetPixels =
+              controlImage.astroFile->wcs2pixList(controlImage.currentHDB, targetCoordinates);
+          auto targetIterator = photometryTargets.begin();
+
+          for (auto const &targetPixel : targetPixels)
           {
-            std::optional<MCL::TPoint2D<FP_t>> result = controlImage.astroFile->wcs2pix(controlImage.currentHDB,
-                                                                                          *(*targetIterator)->observedCoordinates());
-            if (result)
+            if (targetPixel)
             {
-              (*targetIterator)->CCDCoordinates(*result);
+              (*targetIterator)->CCDCoordinates(*targetPixel);
+              ++targetIterator;
             }
             else
             {
@@ -3002,22 +3077,9 @@ namespace astroManager
 
             if (centroid)
             {
-              ACL::CPhotometryObservation *existingObject = nullptr;
-
                 // Check the list for another target that is close.
 
-              bool bClose = false;
-
-              if (controlImage.astroFile->hasPhotometryHDB())
-              {
-                existingObject = controlImage.astroFile->photometryObjectFirst();
-
-                while ( (existingObject) && !bClose)
-                {
-                  bClose = existingObject->isClose(point, pw->getRadius2());
-                  existingObject = controlImage.astroFile->photometryObjectNext();
-                };
-              };
+              bool bClose = (controlImage.astroFile->photometryObjectClose(MCL::TPoint2D<FP_t>(point.x(), point.y()), pw->getRadius2()) != nullptr);
 
               if (!bClose)
               {
@@ -3248,7 +3310,13 @@ namespace astroManager
 
     /// @brief Repaints the image as required.
     /// @note NOTE: This is the routine that changes the image on the screen when the image is updated.
+    /// @details The image is displayed using a tiled image item. Only the visible tiles are drawn, at the resolution that
+    ///          matches the zoom level. If the rendered image has not changed, the existing item (and its tile cache) is reused.
+    ///          If the image has been rendered again at the same size, the existing item is updated with the new image.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Remove the preview once the image has been rendered.
+    /// @version 2026-10-17/GGB - Reuse the item when the image is rendered with a new stretch.
+    /// @version 2026-10-17/GGB - Display the image using CTiledImageItem.
     /// @version 2013-05-20/GGB - Added pixmap to control image.
     /// @version 2013-03-17/GGB - Function created.
 
@@ -3259,8 +3327,32 @@ namespace astroManager
 
         // This is the code that updates the screen when the image needs updating.
 
-      gsImage->clear();         // This invalidates the pixmapItem as the scene owns the pixmapItem.
-      gsImage->addPixmap(*controlImage.pixmap);
+      if (imageItem && controlImage.ScreenImage && ((imageItem->sourceKey() == controlImage.ScreenImage->cacheKey()) ||
+                                                    imageItem->setImage(*controlImage.ScreenImage)))
+      {
+        gsImage->removeItem(imageItem);     // Keep the item, the image has not changed size.
+
+        if (!controlImage.renderPending)
+        {
+          imageItem->setPreview(QImage());
+        };
+      }
+      else
+      {
+        imageItem = nullptr;                // Deleted by gsImage->clear()
+      };
+
+      gsImage->clear();                     // This deletes all the items, as the scene owns the items.
+
+      if (controlImage.ScreenImage)
+      {
+        if (!imageItem)
+        {
+          imageItem = new CTiledImageItem(*controlImage.ScreenImage);
+        };
+        gsImage->addItem(imageItem);
+      };
+
       gvImage->Paint();         // NOTE: Any code that updates the image needs to ensure that this is called!!!
 
       if (pw->getAction(mdiframe::IDA_VIEW_ASTROMETRY)->isChecked())
@@ -3279,6 +3371,19 @@ namespace astroManager
       };
     }
 
+    /// @brief Displays the proxy image in place of the full resolution image.
+    /// @details Called while the stretch is being changed. Only the existing image item is updated, the scene is not rebuilt.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CImageWindow::repaintPreview()
+    {
+      if (imageItem)
+      {
+        imageItem->setPreview(controlImage.proxyImage);
+      };
+    }
+
     /// Function to repaint the photometry indicators when the image is loaded, or redisplayed.
     /// @throws None
     /// @version 2017-06-14/GGB - Updated to Qt5
@@ -3302,6 +3407,7 @@ namespace astroManager
     /// @brief Procedure called when the image is to be resampled.
     /// @throws GCL::CCodeError
     /// @details Brings up the dialog box for the sizing.
+    /// @version 2026-10-17/GGB - Invalidate the object indexes of the file.
     /// @version 2015-08-16/GGB
     ///   @li Use a stack allocation for dlg
     ///   @li Update to use cfitsio
@@ -3331,6 +3437,7 @@ namespace astroManager
       {
         oldBitpix = controlImage.astroFile->getHDB(controlImage.currentHDB)->BITPIX();
         controlImage.astroFile->imageResample(controlImage.currentHDB, dlg.getWidth(), dlg.getHeight());
+        controlImage.astroFile->invalidateObjectIndexes();
         newBitpix = controlImage.astroFile->getHDB(controlImage.currentHDB)->BITPIX();
 
         historyUpdate();
@@ -3380,6 +3487,7 @@ namespace astroManager
     /// @brief Called when the image needs to be rotated by an angle.
     /// @throws None.
     /// @details Dialog box is used to get angle of rotation
+    /// @version 2026-10-17/GGB - Invalidate the object indexes of the file.
     /// @version 2015-09-19/GGB - Use word "degrees" instead of UTF16 character for logging.
     /// @version 2014-12-30/GGB
     ///   @li Use GCL::logger for message logging instead of std::clog.
@@ -3400,6 +3508,7 @@ namespace astroManager
       if (dlg.exec() == QDialog::Accepted)
       {
         controlImage.astroFile->rotateImage(controlImage.currentHDB, angle * DD2R);
+        controlImage.astroFile->invalidateObjectIndexes();
 
         historyUpdate();
 
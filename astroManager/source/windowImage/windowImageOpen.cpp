@@ -0,0 +1,209 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								windowImageOpen
+// SUBSYSTEM:						Placeholder window displayed while an image is opened.
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	Qt, boost
+// NAMESPACE:						AstroManager::imaging
+// AUTHOR:							Gavin Blakeman (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:            The image data is decoded on a worker thread from the global thread pool. The placeholder window shows the
+//                      progress of the load and allows the user to cancel the load. When the load is complete the placeholder
+//                      window closes and the frame window opens the image window.
+//
+// CLASSES INCLUDED:    CImageOpenWindow
+//
+// CLASS HIERARCHY:     QMdiSubWindow
+//                        CMdiSubWindow
+//                          CImageOpenWindow
+//
+// HISTORY:             2026-10-17/GGB - File Created
+//
+//*********************************************************************************************************************************
+
+#include "include/windowImage/windowImageOpen.h"
+
+  // astroManager header files
+
+#include "include/error.h"
+#include "include/FrameWindow.h"
+
+namespace astroManager
+{
+  namespace imaging
+  {
+    /// @brief      Constructor for the class.
+    /// @param[in]  astroFile: The astroFile to load. This must have been constructed with CAstroFile::LM_DEFERRED.
+    /// @param[in]  parent: The parent (owner) window.
+    /// @throws     std::bad_alloc
+    /// @throws     GCL::CRuntimeError(astroManager, ...)
+    /// @version    2026-10-17/GGB - Function created.
+
+    CImageOpenWindow::CImageOpenWindow(std::shared_ptr<CAstroFile> astroFile, QWidget *parent) : CMdiSubWindow(parent),
+      astroFile_(astroFile), loadState_(std::make_shared<SLoadState>()), futureWatcher()
+    {
+      setAttribute(Qt::WA_DeleteOnClose);
+
+      setupUI();
+
+      QString imageName;
+
+      if (astroFile_->fileNameValid())
+      {
+        imageName = QString::fromStdString(astroFile_->getFileName().filename().string());
+      }
+      else
+      {
+        imageName = tr("Image ID: %1").arg(astroFile_->imageID());
+      };
+
+      labelFileName->setText(imageName);
+      setWindowTitle(tr("Opening - %1").arg(imageName));
+    }
+
+    /// @brief      Called when the window is closed.
+    /// @param[in]  event: The close event.
+    /// @details    If the load is still running it is cancelled. The worker holds its own references to the astroFile and load
+    ///             state, so the window can be destroyed while the worker is still running.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageOpenWindow::closeEvent(QCloseEvent *event)
+    {
+      loadState_->cancelled = true;
+
+      CMdiSubWindow::closeEvent(event);
+    }
+
+    /// @brief      Cancels the load and closes the window.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageOpenWindow::eventButtonCancel(bool)
+    {
+      INFOMESSAGE("Image open cancelled: " + labelFileName->text().toStdString());
+
+      close();
+    }
+
+    /// @brief      Called on the GUI thread when the worker has finished.
+    /// @details    The placeholder window is closed and the frame window is called to either display the image, or report the
+    ///             error that occurred while loading.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageOpenWindow::eventLoadFinished()
+    {
+      if (!loadState_->cancelled)
+      {
+        mdiframe::CFrameWindow *frameWindow = dynamic_cast<mdiframe::CFrameWindow *>(nativeParentWidget());
+        std::shared_ptr<CAstroFile> astroFile = astroFile_;
+        std::exception_ptr exception = loadState_->exception;
+
+        RUNTIME_ASSERT(frameWindow != nullptr, "Parent widget cannot be nullptr.");
+
+        close();
+
+        if (exception)
+        {
+          frameWindow->imageOpenError(exception);
+        }
+        else
+        {
+          frameWindow->imageOpenComplete(astroFile);
+        };
+      };
+    }
+
+    /// @brief      Setup up the user interface elements.
+    /// @throws     GCL::CRuntimeError(astroManager, ...)
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageOpenWindow::setupUI()
+    {
+      QUiLoader loader;
+
+        // Create the window details from the template
+
+      QFile file(":/windows/windowImageOpen.ui");
+
+      if (!file.open(QFile::ReadOnly))
+      {
+        ERRORMESSAGE("Unable to open resource :/windows/windowImageOpen.ui");
+        ERROR(astroManager, 0x0001);
+      }
+
+      QWidget *formWidget = loader.load(&file, this);
+      file.close();
+
+      setWidget(formWidget);
+      ASSOCIATE_LABEL(labelFileName, formWidget, "labelFileName");
+      ASSOCIATE_CONTROL(progressBar, formWidget, "progressBar", QProgressBar);
+      ASSOCIATE_PUSHBUTTON(pushButtonCancel, formWidget, "pushButtonCancel");
+
+      progressBar->setRange(0, 0);      // Busy indicator. cfitsio does not report progress.
+
+      connect(pushButtonCancel, SIGNAL(clicked(bool)), this, SLOT(eventButtonCancel(bool)));
+      connect(&futureWatcher, SIGNAL(finished()), this, SLOT(eventLoadFinished()));
+    }
+
+    /// @brief      Starts the load of the image on a worker thread.
+    /// @details    The worker decodes the image data and calculates the image statistics that are needed to display the image.
+    ///             Any database access is done by the frame window on the GUI thread once the worker has finished. The
+    ///             cancellation flag is checked before and after the data is decoded. (cfitsio cannot be interrupted while
+    ///             reading.) Exceptions are captured and rethrown on the GUI thread.
+    /// @throws     None.
+    /// @version    2026-10-17/GGB - Function created.
+
+    void CImageOpenWindow::startLoad()
+    {
+      std::shared_ptr<CAstroFile> astroFile = astroFile_;
+      std::shared_ptr<SLoadState> loadState = loadState_;
+
+      futureWatcher.setFuture(QtConcurrent::run([astroFile, loadState]()
+      {
+        if (loadState->cancelled)
+        {
+          return;
+        };
+
+        try
+        {
+          astroFile->loadData();
+
+          if (!loadState->cancelled && astroFile->HDBCount() != 0 && astroFile->HDBType(0) == ACL::BT_IMAGE)
+          {
+              // Calculate the statistics used for the initial rendering and by the histogram.
+
+            astroFile->imageMin(0);
+            astroFile->imageMax(0);
+            astroFile->blackPoint();
+            astroFile->whitePoint();
+          };
+        }
+        catch(...)
+        {
+          loadState->exception = std::current_exception();
+        };
+      }));
+    }
+
+  } // namespace imaging
+} // namespace astroManager
@@ -46,10 +46,17 @@
 
   // Standard libraries
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <vector>
 
   // Qxt Library
 
+#include <QtConcurrent/QtConcurrent>
 #include <QxtGui/QxtConfirmationMessage>
 
   // astroManager header files
@@ -63,6 +70,12 @@
 #include "include/dockWidgets/dockWidgetMagnify.h"
 #include "include/dockWidgets/dockWidgetNavigator.h"
 #include "include/FrameWindow.h"
+#include "include/imaging/frameLoader.h"
+#include "include/imaging/imageStacker.h"
+#include "include/imaging/liveStacker.h"
+#include "include/imaging/pixelBuffer.h"
+#include "include/imaging/skyFootprint.h"
+#include "include/imaging/starRegistration.h"
 #include "include/settings.h"
 
 namespace astroManager
@@ -88,6 +101,14 @@ namespace astroManager
     int const ROLE_ALIGN2		    = Qt::UserRole + 3;
     int const ROLE_IMAGEID      = Qt::UserRole + 4;
     int const ROLE_OPENFROM     = Qt::UserRole + 5;
+    int const ROLE_LIVESTACKED  = Qt::UserRole + 6;
+    int const ROLE_LIVERETRIES  = Qt::UserRole + 7;
+
+    std::size_t const REGISTRATION_STARS = 100;     ///< Maximum number of stars used to register an image.
+    FP_t const REGISTRATION_SIGMA = 5;              ///< Detection threshold (standard deviations) of the stars.
+    FP_t const REGISTRATION_TOLERANCE = 2;          ///< Maximum difference (pixels) between matched stars.
+    int const LIVE_SETTLE_TIME = 1000;              ///< Time (ms) that the size of a new live file must not change.
+    int const LIVE_LOAD_RETRIES = 3;                ///< Number of times a live image that fails to load is loaded again.
 
     enum
     {
@@ -106,22 +127,25 @@ namespace astroManager
     /// @brief Create the class. Call the setupUI function to get the template and UI setup.
     /// @param[in] aParent - parent of the instance.
     /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Added the frame loader.
     /// @version 2013-06-19/GGB - Added different definitions for windows and other.
     /// @version 2011-02-13/GGB - Function created
 
 #ifdef _WIN32
     CStackImagesWindow::CStackImagesWindow(QWidget *aParent) : CAstroImageWindow(aParent), imageList(),
       cursorAstrometry(QString(":/cursor/cursorAstrometry.bmp")), maskAstrometry(QString(":/cursor/maskAstrometryWindows.bmp")),
-      astrometry(cursorAstrometry, maskAstrometry, 15, 15), imageStack(), outputControlImage(this), alignPoint1(), alignPoint2()
+      astrometry(cursorAstrometry, maskAstrometry, 15, 15), outputControlImage(this), alignPoint1(), alignPoint2()
 #else
     CStackImagesWindow::CStackImagesWindow(QWidget *aParent) : CAstroImageWindow(aParent), imageList(),
       cursorAstrometry(QString(":/cursor/cursorAstrometry.bmp")), maskAstrometry(QString(":/cursor/maskAstrometry.bmp")),
-      astrometry(cursorAstrometry, maskAstrometry, 15, 15), imageStack(), outputControlImage(this), alignPoint1(), alignPoint2(),
+      astrometry(cursorAstrometry, maskAstrometry, 15, 15), outputControlImage(this), alignPoint1(), alignPoint2(),
       addImagesMenu(nullptr)
 #endif
     {
       setAttribute(Qt::WA_DeleteOnClose);
 
+      frameLoader = new CFrameLoader(this);
+
       setupUI();
 
       setWindowTitle(tr("Stack Images"));
@@ -129,10 +153,19 @@ namespace astroManager
 
     /// @brief Ensures that all dyanically allocated memory is correctly returned.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Cancel the background stacks.
     /// @version 2013-03-10/GGB - Function created.
 
     CStackImagesWindow::~CStackImagesWindow()
     {
+        // Cancel the stacks and wait for the running stack to finish.
+
+      for (SStackJob &stackJob : stackQueue_)
+      {
+        stackJob.progress->cancel = true;
+      };
+      stackWatcher_->waitForFinished();
+
       clearImageList();
 
       if (addImagesMenu)
@@ -142,8 +175,158 @@ namespace astroManager
       };
     }
 
+    /// @brief Adds an image file to the list of images.
+    /// @param[in] fileName: The complete path of the image file.
+    /// @details The file name is added to the image list and an item (showing only the file name) is added to listImages. The
+    ///          red icon shows that the image does not have alignment points marked.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created. (Code moved from eventButtonAddImagesFromFolder())
+
+    void CStackImagesWindow::addFileItem(QString const &fileName)
+    {
+      QIcon iconRed(":/images/BMP_IMAGESTACK_RED.bmp");
+      boost::filesystem::path filePath(fileName.toStdString());
+      QListWidgetItem *lwi;
+
+      imageList << fileName;	// Insert the string into the image list.
+
+      lwi = new QListWidgetItem(iconRed, QString::fromStdString(filePath.filename().string()));
+      lwi->setData(ROLE_PATH , QVariant(fileName) );		// Add the complete path as user data.
+      lwi->setData(ROLE_OPENFROM, QVariant(OF_FILE) );		// Indicate that this image opens from a file.
+      lwi->setForeground(Qt::gray);
+      listImages->addItem(lwi);
+    }
+
+    /// @brief Sets the alignment points of the images using the WCS information of the images.
+    /// @param[in] seperationDistance: The fraction of the size of the common overlap between the alignment points.
+    /// @returns true if the alignment points were set. false if the process should be aborted.
+    /// @details The sky footprint of each image (the coordinates of the corners) is found once, and the footprints of all the
+    ///          images are intersected in a single pass. The two alignment points are chosen inside the common overlap, so
+    ///          the coordinates of the alignment points only need to be converted to pixels once for each image. Images
+    ///          without WCS information, or whose corners cannot be converted to sky coordinates, are ignored. (Their alignment
+    ///          points are cleared so they are not stacked.)
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Ignore images whose footprint cannot be found.
+    /// @version 2026-10-17/GGB - Function created.
+
+    bool CStackImagesWindow::alignImagesWCS(FP_t seperationDistance)
+    {
+      bool returnValue = true;
+      int itemCount = listImages->count();
+      std::vector<std::pair<QListWidgetItem *, imaging::SControlImage *>> wcsImages;
+      std::optional<imaging::CSkyFootprint> skyFootprint;
+      std::optional<std::pair<MCL::TPoint2D<FP_t>, MCL::TPoint2D<FP_t>>> alignmentPoints;
+
+      for (int index = 0; index < itemCount; ++index)
+      {
+        QListWidgetItem *selectedItem = listImages->item(index);
+        imaging::SControlImage *controlImage = loadImage(selectedItem);
+
+        if (controlImage->astroFile->hasWCSData(controlImage->currentHDB))
+        {
+          wcsImages.emplace_back(selectedItem, controlImage);
+        }
+        else
+        {
+          INFOMESSAGE("Image #" + std::to_string(index) + " has no WCS information. Ignoring.");
+          selectedItem->setData(ROLE_ALIGN1, QVariant());
+          selectedItem->setData(ROLE_ALIGN2, QVariant());
+        };
+      };
+
+        // Intersect the footprints of the images in the tangent plane at the centre of the first image.
+
+      for (auto wcsImage = wcsImages.begin(); wcsImage != wcsImages.end(); )
+      {
+        imaging::SControlImage *controlImage = wcsImage->second;
+        FP_t width = controlImage->astroFile->imageWidth(controlImage->currentHDB);
+        FP_t height = controlImage->astroFile->imageHeight(controlImage->currentHDB);
+        std::vector<MCL::TPoint2D<FP_t>> corners;
+
+          // The four corners, followed by the centre of the image.
+
+        std::vector<std::optional<ACL::CAstronomicalCoordinates>> coordinates =
+            controlImage->astroFile->pix2wcsList(controlImage->currentHDB, { MCL::TPoint2D<ACL::FP_t>(0, 0),
+                                                                             MCL::TPoint2D<ACL::FP_t>(width - 1, 0),
+                                                                             MCL::TPoint2D<ACL::FP_t>(width - 1, height - 1),
+                                                                             MCL::TPoint2D<ACL::FP_t>(0, height - 1),
+                                                                             MCL::TPoint2D<ACL::FP_t>(width / 2, height / 2) });
+
+        for (std::size_t corner = 0; corner < 4; ++corner)
+        {
+          if (coordinates[corner])
+          {
+            corners.emplace_back(coordinates[corner]->RA().degrees(), coordinates[corner]->DEC().degrees());
+          };
+        };
+
+        if ( (corners.size() != 4) || !coordinates[4] )
+        {
+          INFOMESSAGE("Image " + wcsImage->first->text().toStdString() +
+                      ": The WCS information could not be converted to sky coordinates. Ignoring.");
+          wcsImage->first->setData(ROLE_ALIGN1, QVariant());
+          wcsImage->first->setData(ROLE_ALIGN2, QVariant());
+          wcsImage = wcsImages.erase(wcsImage);
+        }
+        else
+        {
+          if (!skyFootprint)
+          {
+            skyFootprint.emplace(coordinates[4]->RA().degrees(), coordinates[4]->DEC().degrees());
+          };
+
+          skyFootprint->intersect(corners);
+          ++wcsImage;
+        };
+      };
+
+      if (skyFootprint)
+      {
+        alignmentPoints = skyFootprint->alignmentPoints(seperationDistance);
+      };
+
+        // Convert the alignment points to pixels in each image.
+
+      for (auto const &wcsImage : wcsImages)
+      {
+        std::vector<std::optional<MCL::TPoint2D<ACL::FP_t>>> alignPixels;
+
+        if (alignmentPoints)
+        {
+          imaging::SControlImage *controlImage = wcsImage.second;
+
+          alignPixels = controlImage->astroFile->wcs2pixList(controlImage->currentHDB,
+                                                             { ACL::CAstronomicalCoordinates(alignmentPoints->first.x(),
+                                                                                             alignmentPoints->first.y()),
+                                                               ACL::CAstronomicalCoordinates(alignmentPoints->second.x(),
+                                                                                             alignmentPoints->second.y()) });
+        };
+
+        if (alignPixels.empty() || !alignPixels[0] || !alignPixels[1])
+        {
+          returnValue = false;
+          break;
+        };
+
+        wcsImage.first->setData(ROLE_ALIGN1, QVariant(QPointF(alignPixels[0]->x(), alignPixels[0]->y())));  // Save the Align1 position
+        wcsImage.first->setData(ROLE_ALIGN2, QVariant(QPointF(alignPixels[1]->x(), alignPixels[1]->y())));  // Save the Align2 position
+      };
+
+      if (!returnValue || wcsImages.empty())
+      {
+        returnValue = false;
+        QMessageBox::critical(this, tr("Images are not congruent."),
+                              tr("The images do not appear to all be congruent. The process is being aborted."));
+      };
+
+      return returnValue;
+    }
+
     /// @brief Ensures that all the dynamically allocated memory is freed.
     /// @throws None. (This needs to be noexcept as it is called by the destructor.)
+    /// @version 2026-10-17/GGB - Wait for the live stack worker before the live stack is cleared.
+    /// @version 2026-10-17/GGB - Clear the live stack.
+    /// @version 2026-10-17/GGB - Cancel any images that are still being loaded.
     /// @version 2013-07-14/GGB - Added code to disable the zoom actions. (Bug #1195976)
     /// @version 2013-03-10/GGB - Function created.
 
@@ -153,6 +336,8 @@ namespace astroManager
       std::size_t index = 0;
       imaging::SControlImage *controlImage;
 
+      frameLoader->cancelAll();
+
       for (; (index < itemCount) ; index++)
       {
         controlImage = reinterpret_cast<imaging::SControlImage *>(listImages->item(index)->data(ROLE_CONTROLIMAGE).toULongLong());
@@ -166,6 +351,18 @@ namespace astroManager
       imageList.clear();			// Clear the images list.
       listImages->clear();		// Clear the items from the table widget.
 
+      liveStack_.liveWatcher->waitForFinished();
+      liveStack_.frameQueue.clear();
+      liveStack_.liveResult.reset();          // Discard the result of the frames that were cleared.
+      liveStack_.liveException = nullptr;
+      liveStack_.pendingFiles.clear();
+      liveStack_.frameCount = 0;
+
+      if (liveStack_.liveStacker)
+      {
+        liveStack_.liveStacker->clear();      // The next image becomes the reference image of the live stack.
+      };
+
       mdiframe::CFrameWindow *pw = dynamic_cast<mdiframe::CFrameWindow *>(nativeParentWidget());
       if (pw)
       {
@@ -194,12 +391,15 @@ namespace astroManager
     /// @brief Deletes an item from the image list (listImages)
     /// @param[in] toDelete - The item to delete.
     /// @throws None.
+    /// @version 2026-10-17/GGB - Cancel the load of the image if it is still being loaded.
     /// @verison 2017-08-26/GGB - Function created.
 
     void CStackImagesWindow::deleteListItem(QListWidgetItem *toDelete)
     {
       imaging::SControlImage *controlImage;
 
+      frameLoader->cancel(reinterpret_cast<quint64>(toDelete));
+
         // Delete any data stored in the control data.
 
       controlImage = reinterpret_cast<imaging::SControlImage *>(toDelete->data(ROLE_CONTROLIMAGE).toULongLong());
@@ -285,8 +485,70 @@ namespace astroManager
       };
     }
 
+    /// @brief Displays a stacked image as the output image.
+    /// @param[in] outputFile: The temporary FITS file containing the stacked image. The file is deleted.
+    /// @throws ACL::CFITSException
+    /// @throws GCL::CRuntimeError
+    /// @version 2026-10-17/GGB - The image is displayed by displayOutputImage(std::shared_ptr<CAstroFile>).
+    /// @version 2026-10-17/GGB - Function created. (Code moved from stackImages())
+
+    void CStackImagesWindow::displayOutputImage(boost::filesystem::path const &outputFile)
+    {
+      std::shared_ptr<CAstroFile> astroFile;
+
+        // Only the data is loaded. (completeLoad() is not called, the temporary file must not be saved to the database)
+
+      try
+      {
+        astroFile = std::make_shared<CAstroFile>(this, outputFile, CAstroFile::LM_DEFERRED, CAstroFile::HS_PRIMARY);
+        astroFile->loadData();
+      }
+      catch(...)
+      {
+        boost::filesystem::remove(outputFile);
+        throw;
+      };
+      boost::filesystem::remove(outputFile);
+
+      displayOutputImage(astroFile);
+    }
+
+    /// @brief Displays a stacked image as the output image.
+    /// @param[in] astroFile: The stacked image. The image must be loaded.
+    /// @details The image is given a new UUID and is marked as a synthetic image that has not been saved.
+    /// @throws GCL::CRuntimeError
+    /// @version 2026-10-17/GGB - Function created. (Code moved from displayOutputImage(boost::filesystem::path const &))
+
+    void CStackImagesWindow::displayOutputImage(std::shared_ptr<CAstroFile> astroFile)
+    {
+      outputControlImage.astroFile = astroFile;
+      outputControlImage.astroFile->keywordWrite(0, ACL::ASTROMANAGER_UUID, QUuid::createUuid().toString().toUpper().toStdString(),
+                                                 ACL::ASTROMANAGER_COMMENT_UUID);
+      outputControlImage.astroFile->fileNameValid(false);
+      outputControlImage.astroFile->imageIDValid(false);
+      outputControlImage.astroFile->syntheticImage(true);
+
+      outputControlImage.currentHDB = 0;
+
+      outputControlImageValid_ = true;
+
+        // Now need to add the output file to the output window.
+
+      CAstroImageWindow::imageChange(&outputControlImage);
+
+      outputControlImage.pixmap->convertFromImage(*outputControlImage.ScreenImage);
+
+      gsImageOutput->clear();                                     // Remove the previous output image. (Live stacking)
+      gsImageOutput->addPixmap(*outputControlImage.pixmap);      // Draw the main image
+      gvImageOutput->setCursor(Qt::CrossCursor);
+      gvImageOutput->zoomAll();
+      pbOpenInWindow->setEnabled(true);
+      tabWidget->setCurrentIndex(1);
+    }
+
     /// @brief Select images from the ARID database.
     /// @throws None.
+    /// @version 2026-10-17/GGB - In live stack mode the images are loaded and added to the live stack.
     /// @version 2017-08-19/GGB - Function created.
 
     void CStackImagesWindow::eventButtonAddImagesFromDatabase(bool)
@@ -319,6 +581,11 @@ namespace astroManager
         labelCount->setText(QString("%1").arg(listImages->count()));
         btnImageRemove->setEnabled(true);
         btnImageRemoveAll->setEnabled(true);
+
+        if (liveStack_.liveStacker)
+        {
+          queueImages();      // Images are added to the live stack as they are loaded.
+        };
       };
     }
 
@@ -326,6 +593,7 @@ namespace astroManager
     /// @details Opens the file selection dialog and allows the selection of multiple images. Image names are added to the list of
     ///          images. The image list is not cleared.
     /// @throws None.
+    /// @version 2026-10-17/GGB - In live stack mode the images are loaded and added to the live stack.
     /// @version 2013-06/29/GGB - Added support for button remove all.
     /// @version 2013-03-01/GGB - Include the use of the global settings::fileExtensions for the list of file extensions.
     /// @version 2011-06-12/GGB - Function Created
@@ -335,8 +603,6 @@ namespace astroManager
       QStringList::const_iterator constIterator;
       QStringList newImages;
       bool firstPass = true;
-      QListWidgetItem *lwi = nullptr;
-      QIcon iconRed(":/images/BMP_IMAGESTACK_RED.bmp");
       boost::filesystem::path filePath;
 
       settings::astroManagerSettings->setValue(settings::IMAGESTACK_OPENFROMFOLDER, QVariant(true));
@@ -367,23 +633,18 @@ namespace astroManager
             firstPass = false;
           };
 
-          imageList << (*constIterator);	// Insert the string into the image list.
-
-            // Add the filename into the list. Strip off the path and just use the filename.
-            // Add the red icon to show that the image does not have alignment points marked at this stage.
-
-          lwi = new QListWidgetItem(iconRed, QString::fromStdString(filePath.filename().string()));
-          lwi->setData(ROLE_PATH , QVariant(*constIterator) );		// Add the complete path as user data.
-          lwi->setData(ROLE_OPENFROM, QVariant(OF_FILE) );		// Indicate that this image opens from database.
-          lwi->setForeground(Qt::gray);
-          listImages->addItem(lwi);
-          lwi = nullptr;
+          addFileItem(*constIterator);
         };
       };
 
       labelCount->setText(QString("%1").arg(listImages->count()));
       btnImageRemove->setEnabled(true);
       btnImageRemoveAll->setEnabled(true);
+
+      if (liveStack_.liveStacker)
+      {
+        queueImages();      // Images are added to the live stack as they are loaded.
+      };
     }
 
     /// @brief Function to handle the alignment button being unchecked by the user.
@@ -451,8 +712,13 @@ namespace astroManager
     ///          2. The two points are correlated on all the images.
     ///          3. The images are then stacked.
     ///          4. If required, the images are saved.
+    ///          If any of the images do not have WCS information, and IMAGESTACK_AUTO_STARREGISTRATION is set, all the images
+    ///          are registered using their stars instead. (See registerImages())
     /// @note 1. Exceptions are used internally to capture abort conditions. These should not propogate outside the function.
     /// @note 2. Exceptions are also used to propogate errors outside the function.
+    /// @version 2026-10-17/GGB - The alignment points are found from the common overlap of the images. (See alignImagesWCS())
+    /// @version 2026-10-17/GGB - Images without WCS information are registered using their stars.
+    /// @version 2026-10-17/GGB - The images are loaded concurrently by loadImages() before the WCS information is checked.
 
     void CStackImagesWindow::eventButtonAutoStack(bool)
     {
@@ -463,17 +729,33 @@ namespace astroManager
       std::uint_least8_t noWCSAction = settings::astroManagerSettings->value(settings::IMAGESTACK_AUTO_NOWCSACTION,
                                                                      QVariant(NOWCS_IGNORE)).toInt();
       std::vector<QListWidgetItem *> deleteList;
-      bool abortProcess = false;
+      bool starRegistration = settings::astroManagerSettings->value(settings::IMAGESTACK_AUTO_STARREGISTRATION,
+                                                                    QVariant(true)).toBool();
+      bool allWCS = true;
+      bool abortProcess = !loadImages();
 
-        // Load all the images and check they all have WCS information.
+        // Check that all the images have WCS information.
 
       for (int index = 0; (index < itemCount) & !abortProcess; ++index)
       {
         selectedItem = listImages->item(index);
-        controlImage = loadImage(selectedItem);    // Load the image into memory.
+
+        if (selectedItem->data(ROLE_CONTROLIMAGE).isNull())
+        {
+          QMessageBox::critical(this, tr("Image load error."),
+                                tr("The image %1 could not be loaded. The process is being aborted.").arg(selectedItem->text()));
+          abortProcess = true;
+          break;
+        };
+
+        controlImage = loadImage(selectedItem);
         controlImage->currentHDB = 0;
 
-        if (!controlImage->astroFile->hasWCSData(controlImage->currentHDB) )
+        if (!controlImage->astroFile->hasWCSData(controlImage->currentHDB) && starRegistration)
+        {
+          allWCS = false;       // All the images are registered using their stars.
+        }
+        else if (!controlImage->astroFile->hasWCSData(controlImage->currentHDB) )
         {
           if (noWCSAction == NOWCS_DELETE)
           {
@@ -545,84 +827,13 @@ namespace astroManager
         abortProcess = true;
       };
 
-
-      if (!abortProcess)
+      if (!abortProcess && !allWCS)
       {
-        bool outOfBounds = false;
-        MCL::TPoint2D<ACL::FP_t> BL, TR;
-        std::optional<ACL::CAstronomicalCoordinates>  BLC, TRC;
-        int initialIndex = 0;
-
-        do
-        {
-          outOfBounds = false;
-
-            // This loop runs, reducing the seperation distance until all the images have coordinates that match, or
-            // if the seperationDistance falls below 25%, then the abort flag is set and the loop exits.
-
-          selectedItem = listImages->item(initialIndex);
-          controlImage = reinterpret_cast<imaging::SControlImage *>(selectedItem->data(ROLE_CONTROLIMAGE).toULongLong());
-
-          // Determine the top-right and bottom left pixels to use.
-
-          BL.x() = controlImage->astroFile->imageWidth() * ((1 - seperationDistance) / 2);
-          BL.y() = controlImage->astroFile->imageHeight() * ((1 - seperationDistance) / 2);
-          TR.x() = controlImage->astroFile->imageWidth() - (controlImage->astroFile->imageWidth() * ((1 - seperationDistance) / 2));
-          TR.y() = controlImage->astroFile->imageHeight() - (controlImage->astroFile->imageHeight() * ((1 - seperationDistance) / 2));
-
-          // Convert the pixels into coordinates.
-
-          BLC = controlImage->astroFile->pix2wcs(controlImage->currentHDB, BL);
-          TRC = controlImage->astroFile->pix2wcs(controlImage->currentHDB, TR);
-
-          if (!BLC || !TRC)
-          {
-              // This can only occur if the first item has no WCS information. In this case, a mechanism is needed to skip to the
-              // second item.
-              // Update the initialIndex to ignore the first item.
-
-            INFOMESSAGE("Image #" + std::to_string(initialIndex) + " has no WCS information. Skipping to next image.");
-            initialIndex++;
-            outOfBounds = true;
-          };
-
-          selectedItem->setData(ROLE_ALIGN1, QVariant(QPointF(BL.x(), BL.y())));						// Save the Align1 position
-          selectedItem->setData(ROLE_ALIGN2, QVariant(QPointF(TR.x(), TR.y())));						// Save the Align2 position
-
-          for (int index = initialIndex + 1; (index < itemCount) && (!outOfBounds) && (!abortProcess); ++index)
-          {
-            selectedItem = listImages->item(index);
-            controlImage = reinterpret_cast<imaging::SControlImage *>(selectedItem->data(ROLE_CONTROLIMAGE).toULongLong());
-
-              // Note that the variables BL and TR are redefined to a different type in this loop to what they are above.
-
-            std::optional<MCL::TPoint2D<ACL::FP_t>> BL = controlImage->astroFile->wcs2pix(controlImage->currentHDB, *BLC);
-            std::optional<MCL::TPoint2D<ACL::FP_t>> TR = controlImage->astroFile->wcs2pix(controlImage->currentHDB, *TRC);
-
-            if (!BL || !TR)
-            {
-              INFOMESSAGE("Coordinates not found in image. Reducing seperation distance.");
-
-              outOfBounds = true;
-              seperationDistance *= .95;    // Reduce the seperation distance.
-
-              if (seperationDistance < 0.25)
-              {
-                abortProcess = true;
-
-                QMessageBox::critical(this, tr("Images are not congruent."),
-                                      tr("The images do not appear to all be congruent. The process is being aborted."));
-              }
-            }
-            else
-            {
-              selectedItem->setData(ROLE_ALIGN1, QVariant(QPointF(BL->x(), BL->y())));						// Save the Align1 position
-              selectedItem->setData(ROLE_ALIGN2, QVariant(QPointF(TR->x(), TR->y())));						// Save the Align2 position
-            };
-          };
-        }
-        while (outOfBounds && !abortProcess);
-
+        abortProcess = !registerImages(seperationDistance, noWCSAction);
+      }
+      else if (!abortProcess)
+      {
+        abortProcess = !alignImagesWCS(seperationDistance);
       };
 
       if (!abortProcess)
@@ -632,6 +843,19 @@ namespace astroManager
 
     }
 
+    /// @brief Cancels the stack that is running. Queued stacks are started when the stack has stopped.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CStackImagesWindow::eventButtonCancelStack(bool)
+    {
+      if (!stackQueue_.empty())
+      {
+        stackQueue_.front().progress->cancel = true;
+        pushButtonCancelStack_->setEnabled(false);
+      };
+    }
+
     /// @brief When the user presses this button, the images need to be stacked.
     /// @details  1) Check that all the images have both alignment points specified.
     ///           2) Get the status of all the user flags
@@ -814,94 +1038,377 @@ namespace astroManager
       };
     }
 
-    /// @brief Handles the mouse press event from the graphics view window.
-    /// If one of the alignment buttons is pressed (down), then the position is recorded and marked.
-    /// If the Alignment1 button is down, then the Alignment1 button is raised and the Alignement2 button pressed
-    /// If the Alignment2 button is down, then the Alignment2 button is raised.
-    /// If the alignment position already exists, then it is changed.
-    /// @throws
-    /// @version 2013-03-02/GGB - Updated to use SControlImage.
-    /// @version 2011-03-04/GGB - Function Created.
+    /// @brief Called when the frame loader could not load an image.
+    /// @param[in] key: The list item of the image.
+    /// @param[in] message: The error message.
+    /// @details In live stack mode the file may still be being written. The image is loaded again after LIVE_SETTLE_TIME, up to
+    ///          LIVE_LOAD_RETRIES times. It is then marked as processed and is not loaded again.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Retry the load of live stack images.
+    /// @version 2026-10-17/GGB - Function created.
 
-    void CStackImagesWindow::eventMousePress(QMouseEvent *mouseEvent)
+    void CStackImagesWindow::eventFrameFailed(quint64 key, QString message)
     {
-      QPointF point;
-      std::optional<MCL::TPoint2D<ACL::FP_t>> centroid;
-      imaging::SControlImage *controlImage = getControlImage();
-      QIcon iconGreen(":/images/BMP_IMAGESTACK_GREEN.bmp");
+      QListWidgetItem *selectedItem = reinterpret_cast<QListWidgetItem *>(key);
 
-      if (controlImage)
+      selectedItem->setForeground(Qt::red);
+      selectedItem->setToolTip(message);
+
+      if (liveStack_.liveStacker)
       {
-        if ( (btnAlign1->isChecked()) && (mouseEvent->button() == Qt::LeftButton) )
-        {
-            // Alignment 1 button is down.
+        int retries = selectedItem->data(ROLE_LIVERETRIES).toInt();
 
-          point = gvImageInput->mapToScene(mouseEvent->pos());									// Get the image coordinates
+        if ( (selectedItem->data(ROLE_OPENFROM).toUInt() == OF_FILE) && (retries < LIVE_LOAD_RETRIES) )
+        {
+          selectedItem->setData(ROLE_LIVERETRIES, QVariant(retries + 1));
+          liveStack_.retryLoad = true;
+          liveStack_.settleTimer->start();
+        }
+        else
+        {
+          selectedItem->setData(ROLE_LIVESTACKED, QVariant(false));
 
-            // Find the centroid within a reasonable area.
+          INFOMESSAGE("Live stack: The image " + selectedItem->text().toStdString() + " could not be loaded.");
+        };
+      };
+    }
 
-          centroid = controlImage->astroFile->centroid(controlImage->currentHDB,
-                                                       MCL::TPoint2D<ACL::AXIS_t>(point.x(), point.y()),
-                                                       settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS,
-                                                                                     QVariant(20)).toLongLong(),
-                                                       settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_SENSITIVITY,
-                                                                                     QVariant(3)).toInt());
+    /// @brief Called when the frame loader has loaded an image. The image is attached to the list item.
+    /// @param[in] key: The list item of the image.
+    /// @details In live stack mode the image is added to the live stack.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Add the image to the live stack.
+    /// @version 2026-10-17/GGB - Function created.
 
-          if (!centroid)
-          {
-            QMessageBox::information(this, tr("Unable to find centroid."),
-                                     tr("A centroid was not found at the indicated spot."),
-                                     QMessageBox::Ok, QMessageBox::Ok);
-          }
-          else
-          {
-            point = QPointF((*centroid).x(), (*centroid).y());
+    void CStackImagesWindow::eventFrameLoaded(quint64 key)
+    {
+      QListWidgetItem *selectedItem = reinterpret_cast<QListWidgetItem *>(key);
+      std::shared_ptr<CAstroFile> astroFile = frameLoader->takeFrame(key);
 
-            listImages->currentItem()->setData(ROLE_ALIGN1, QVariant(point));							// Save the Align1 position
+      if (astroFile && selectedItem->data(ROLE_CONTROLIMAGE).isNull())
+      {
+        imaging::SControlImage *controlImage = new imaging::SControlImage(this, astroFile);
 
-            labelAlign1->setText(QString("(%1, %2)").arg(point.x(), 0, 'f', 1).arg(point.y(), 0, 'f', 1));
+        controlImage->currentHDB = 0;
+        selectedItem->setData(ROLE_CONTROLIMAGE, QVariant(reinterpret_cast<qulonglong>(controlImage)));
+        selectedItem->setForeground(Qt::black);
+        selectedItem->setToolTip(QString());
 
-              // Draw the alignment points onto the screen
+        if (liveStack_.liveStacker)
+        {
+          liveStackImage(selectedItem);
+        };
+      };
+    }
 
-            displayAlign1( point );
+    /// @brief Called when the contents of the live stack folder change. New image files are added to the live stack.
+    /// @param[in] directory: The live stack folder.
+    /// @details The directory changes when a file is created, before the camera software has finished writing the file. The
+    ///          size and modification time of the new files are recorded, and the files are added to the image list when they
+    ///          have not changed for LIVE_SETTLE_TIME. (eventLiveSettleTimer()) Files that are already in the image list are
+    ///          ignored.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Wait for the new files to be written before they are added.
+    /// @version 2026-10-17/GGB - Function created.
 
-              // Update the buttons
+    void CStackImagesWindow::eventLiveDirectoryChanged(QString const &directory)
+    {
+      QDir liveDirectory(directory);
 
-            btnAlign1->setChecked(false);
+      for (QFileInfo const &fileInfo : liveDirectory.entryInfoList(QDir::Files, QDir::Time | QDir::Reversed))
+      {
+        QString fileName = fileInfo.absoluteFilePath();
 
-            if ( !listImages->currentItem()->data(ROLE_ALIGN2).isNull() )
-            {
-              listImages->currentItem()->setIcon(iconGreen);
-            }
-            else
-            {
-              btnAlign2->setChecked(true);
-            };
-          };
-        }
-        else if ( (btnAlign2->isChecked()) && (mouseEvent->button() == Qt::LeftButton) )
+        if ( CAstroFile::isFITSFile(boost::filesystem::path(fileName.toStdString())) &&
+             !imageList.contains(fileName, Qt::CaseInsensitive) &&
+             (liveStack_.pendingFiles.find(fileName) == liveStack_.pendingFiles.end()) )
         {
-            // Alignment 2 button is down.
+          liveStack_.pendingFiles.emplace(fileName, std::make_pair(fileInfo.size(), fileInfo.lastModified()));
+        };
+      };
 
-          point = gvImageInput->mapToScene(mouseEvent->pos());		// Get the image coordinates
+      if (!liveStack_.pendingFiles.empty())
+      {
+        liveStack_.settleTimer->start();
+      };
+    }
 
-          centroid = controlImage->astroFile->centroid(controlImage->currentHDB,
-                                                       MCL::TPoint2D<ACL::AXIS_t>(point.x(), point.y()),
-                                                       settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS,
-                                                                                     QVariant(20)).toLongLong(),
-                                                       settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_SENSITIVITY,
-                                                                                     QVariant(3)).toInt());
-          if (!centroid)
-          {
-            QMessageBox::information(this, tr("Unable to find centroid."),
-                                     tr("A centroid was not found at the indicated spot."),
-                                     QMessageBox::Ok, QMessageBox::Ok);
-          }
-          else
-          {
-            point = QPointF((*centroid).x(), (*centroid).y());
+    /// @brief Called LIVE_SETTLE_TIME after a live stack file has been found or an image has failed to load.
+    /// @details The new files whose size and modification time have not changed are added to the image list and queued with the
+    ///          frame loader. Each image is added to the live stack when it has been loaded. (eventFrameLoaded()) The timer is
+    ///          restarted while files are still changing. Images that failed to load are queued again.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
 
-            listImages->currentItem()->setData(ROLE_ALIGN2, QVariant(point));
+    void CStackImagesWindow::eventLiveSettleTimer()
+    {
+      bool newImages = false;
+
+      if (liveStack_.liveStacker)
+      {
+        auto iterator = liveStack_.pendingFiles.begin();
+
+        while (iterator != liveStack_.pendingFiles.end())
+        {
+          QFileInfo fileInfo(iterator->first);
+
+          if (!fileInfo.exists())
+          {
+            iterator = liveStack_.pendingFiles.erase(iterator);
+          }
+          else if ( (fileInfo.size() > 0) && (fileInfo.size() == iterator->second.first) &&
+                    (fileInfo.lastModified() == iterator->second.second) )
+          {
+            addFileItem(iterator->first);
+            newImages = true;
+            iterator = liveStack_.pendingFiles.erase(iterator);
+          }
+          else
+          {
+            iterator->second = std::make_pair(fileInfo.size(), fileInfo.lastModified());
+            ++iterator;
+          };
+        };
+
+        if (newImages)
+        {
+          labelCount->setText(QString("%1").arg(listImages->count()));
+          btnImageRemove->setEnabled(true);
+          btnImageRemoveAll->setEnabled(true);
+        };
+
+        if (newImages || liveStack_.retryLoad)
+        {
+          liveStack_.retryLoad = false;
+          queueImages();
+        };
+
+        if (!liveStack_.pendingFiles.empty())
+        {
+          liveStack_.settleTimer->start();
+        };
+      };
+    }
+
+    /// @brief Starts or stops live stacking.
+    /// @param[in] isChecked: true to start live stacking.
+    /// @details When live stacking starts, the user selects the folder that the new images are written to. The images already in
+    ///          the list and in the folder are added to the live stack, then each new image is added as it arrives. (In the
+    ///          folder, or from the database.) The first image added is the reference image. The live stack is displayed as
+    ///          the output image after each image is added. The IMAGESTACK_LIVE_MEDIANSKETCH setting determines if the
+    ///          approximate median is maintained.
+    ///          When live stacking stops, the frames that are still queued are discarded and the output image is kept.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Wait for the live stack worker before the live stack is deleted.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CStackImagesWindow::eventLiveStack(bool isChecked)
+    {
+      if (isChecked && !liveStack_.liveStacker)
+      {
+        QString directory = QFileDialog::getExistingDirectory(this, tr("Live Stack Folder"),
+                              settings::astroManagerSettings->value(settings::IMAGESTACK_LIVE_DIRECTORY,
+                                settings::astroManagerSettings->value(settings::IMAGESTACK_DIRECTORY, QVariant(0))).toString());
+
+        if (directory.isEmpty())
+        {
+          actionLiveStack->setChecked(false);
+        }
+        else
+        {
+          int itemCount = listImages->count();
+
+          settings::astroManagerSettings->setValue(settings::IMAGESTACK_LIVE_DIRECTORY, QVariant(directory));
+
+          liveStack_.liveStacker = std::make_unique<CLiveStacker>(
+                settings::astroManagerSettings->value(settings::IMAGESTACK_LIVE_MEDIANSKETCH, QVariant(true)).toBool());
+          liveStack_.frameCount = 0;
+
+          liveStack_.directoryWatcher = new QFileSystemWatcher(QStringList(directory), this);
+          connect(liveStack_.directoryWatcher, SIGNAL(directoryChanged(QString const &)),
+                  this, SLOT(eventLiveDirectoryChanged(QString const &)));
+
+            // Add the images that are already loaded. The other images are added as they are loaded.
+
+          for (int index = 0; index < itemCount; ++index)
+          {
+            QListWidgetItem *selectedItem = listImages->item(index);
+
+            selectedItem->setData(ROLE_LIVESTACKED, QVariant());
+            selectedItem->setData(ROLE_LIVERETRIES, QVariant());
+            if (!selectedItem->data(ROLE_CONTROLIMAGE).isNull())
+            {
+              liveStackImage(selectedItem);
+            };
+          };
+
+          queueImages();
+          eventLiveDirectoryChanged(directory);
+        };
+      }
+      else if (!isChecked)
+      {
+        if (liveStack_.directoryWatcher)
+        {
+          delete liveStack_.directoryWatcher;
+          liveStack_.directoryWatcher = nullptr;
+        };
+
+        liveStack_.settleTimer->stop();
+        liveStack_.pendingFiles.clear();
+        liveStack_.retryLoad = false;
+
+        liveStack_.liveWatcher->waitForFinished();
+        liveStack_.frameQueue.clear();
+
+        liveStack_.liveStacker.reset();
+        liveStack_.starRegistration.reset();
+        liveStack_.align1Coordinates.reset();
+        liveStack_.align2Coordinates.reset();
+      };
+    }
+
+    /// @brief Called when the live stack worker has finished. The live stack is displayed and the queued frames are started.
+    /// @throws GCL::CCodeError(astroManager)
+    /// @throws GCL::CRuntimeAssert
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CStackImagesWindow::eventLiveStackFinished()
+    {
+      std::shared_ptr<CAstroFile> liveResult = std::move(liveStack_.liveResult);
+      std::exception_ptr exception = liveStack_.liveException;
+
+      liveStack_.liveException = nullptr;
+
+      if (exception)
+      {
+        try
+        {
+          std::rethrow_exception(exception);
+        }
+        catch (GCL::CCodeError &)
+        {
+          throw;    // Propagate code errors.
+        }
+        catch (GCL::CRuntimeAssert &)
+        {
+          throw;    // Propagate runtime assertions.
+        }
+        catch (GCL::CError &error)
+        {
+          WARNINGMESSAGE("Live stack: " + error.errorMessage());
+        }
+        catch (ACL::CFITSException &error)
+        {
+          WARNINGMESSAGE("Live stack: " + error.errorMessage());
+        }
+        catch (std::exception &error)
+        {
+          WARNINGMESSAGE(std::string("Live stack: ") + error.what());
+        };
+      };
+
+      if (liveStack_.liveStacker)
+      {
+        if (liveResult)
+        {
+          displayOutputImage(liveResult);
+
+          INFOMESSAGE("Live stack: " + std::to_string(liveStack_.liveStacker->frameCount()) + " images stacked.");
+        };
+
+        startLiveStack();
+      };
+    }
+
+    /// @brief Handles the mouse press event from the graphics view window.
+    /// If one of the alignment buttons is pressed (down), then the position is recorded and marked.
+    /// If the Alignment1 button is down, then the Alignment1 button is raised and the Alignement2 button pressed
+    /// If the Alignment2 button is down, then the Alignment2 button is raised.
+    /// If the alignment position already exists, then it is changed.
+    /// @throws
+    /// @version 2013-03-02/GGB - Updated to use SControlImage.
+    /// @version 2011-03-04/GGB - Function Created.
+
+    void CStackImagesWindow::eventMousePress(QMouseEvent *mouseEvent)
+    {
+      QPointF point;
+      std::optional<MCL::TPoint2D<ACL::FP_t>> centroid;
+      imaging::SControlImage *controlImage = getControlImage();
+      QIcon iconGreen(":/images/BMP_IMAGESTACK_GREEN.bmp");
+
+      if (controlImage)
+      {
+        if ( (btnAlign1->isChecked()) && (mouseEvent->button() == Qt::LeftButton) )
+        {
+            // Alignment 1 button is down.
+
+          point = gvImageInput->mapToScene(mouseEvent->pos());									// Get the image coordinates
+
+            // Find the centroid within a reasonable area.
+
+          centroid = controlImage->astroFile->centroid(controlImage->currentHDB,
+                                                       MCL::TPoint2D<ACL::AXIS_t>(point.x(), point.y()),
+                                                       settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS,
+                                                                                     QVariant(20)).toLongLong(),
+                                                       settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_SENSITIVITY,
+                                                                                     QVariant(3)).toInt());
+
+          if (!centroid)
+          {
+            QMessageBox::information(this, tr("Unable to find centroid."),
+                                     tr("A centroid was not found at the indicated spot."),
+                                     QMessageBox::Ok, QMessageBox::Ok);
+          }
+          else
+          {
+            point = QPointF((*centroid).x(), (*centroid).y());
+
+            listImages->currentItem()->setData(ROLE_ALIGN1, QVariant(point));							// Save the Align1 position
+
+            labelAlign1->setText(QString("(%1, %2)").arg(point.x(), 0, 'f', 1).arg(point.y(), 0, 'f', 1));
+
+              // Draw the alignment points onto the screen
+
+            displayAlign1( point );
+
+              // Update the buttons
+
+            btnAlign1->setChecked(false);
+
+            if ( !listImages->currentItem()->data(ROLE_ALIGN2).isNull() )
+            {
+              listImages->currentItem()->setIcon(iconGreen);
+            }
+            else
+            {
+              btnAlign2->setChecked(true);
+            };
+          };
+        }
+        else if ( (btnAlign2->isChecked()) && (mouseEvent->button() == Qt::LeftButton) )
+        {
+            // Alignment 2 button is down.
+
+          point = gvImageInput->mapToScene(mouseEvent->pos());		// Get the image coordinates
+
+          centroid = controlImage->astroFile->centroid(controlImage->currentHDB,
+                                                       MCL::TPoint2D<ACL::AXIS_t>(point.x(), point.y()),
+                                                       settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_RADIUS,
+                                                                                     QVariant(20)).toLongLong(),
+                                                       settings::astroManagerSettings->value(settings::ASTROMETRY_CENTROIDSEARCH_SENSITIVITY,
+                                                                                     QVariant(3)).toInt());
+          if (!centroid)
+          {
+            QMessageBox::information(this, tr("Unable to find centroid."),
+                                     tr("A centroid was not found at the indicated spot."),
+                                     QMessageBox::Ok, QMessageBox::Ok);
+          }
+          else
+          {
+            point = QPointF((*centroid).x(), (*centroid).y());
+
+            listImages->currentItem()->setData(ROLE_ALIGN2, QVariant(point));
 
             labelAlign2->setText(QString("(%1, %2)").arg(point.x(), 0, 'f', 1).arg(point.y(), 0, 'f', 1));
 
@@ -964,6 +1471,132 @@ namespace astroManager
       };
     }
 
+    /// @brief Called when the running stack has finished. The output image is displayed and the next stack is started.
+    /// @throws GCL::CCodeError(astroManager)
+    /// @throws GCL::CRuntimeAssert
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CStackImagesWindow::eventStackFinished()
+    {
+      SStackJob stackJob = std::move(stackQueue_.front());
+
+      stackQueue_.pop_front();
+      stackTimer_->stop();
+
+      if (stackException_)
+      {
+        QMessageBox msgBox(this);
+        std::exception_ptr exception = stackException_;
+
+        stackException_ = nullptr;
+        msgBox.setText(tr("Error while stacking the images. (%1)").arg(stackJob.name));
+
+        try
+        {
+          std::rethrow_exception(exception);
+        }
+        catch (GCL::CCodeError &)
+        {
+          throw;    // Propagate code errors.
+        }
+        catch (GCL::CRuntimeAssert &)
+        {
+          throw;    // Propagate runtime assertions.
+        }
+        catch (GCL::CError &error)
+        {
+          msgBox.setInformativeText(QString::fromStdString(error.errorMessage()));
+        }
+        catch (ACL::CFITSException &error)
+        {
+          msgBox.setInformativeText(QString::fromStdString(error.errorMessage()));
+        }
+        catch (std::exception &error)
+        {
+          msgBox.setInformativeText(QString::fromStdString(error.what()));
+        };
+
+        msgBox.setIcon(QMessageBox::Warning);
+        msgBox.exec();
+      }
+      else if (!stackJob.progress->cancel)
+      {
+        displayOutputImage(stackJob.outputFile);
+        INFOMESSAGE("Image stacking: " + stackJob.name.toStdString() + " completed.");
+      };
+
+      if (stackQueue_.empty())
+      {
+        progressBarStack_->setVisible(false);
+        pushButtonCancelStack_->setVisible(false);
+      }
+      else
+      {
+        startStack();
+      };
+    }
+
+    /// @brief Called periodically while a stack is running. Updates the progress and displays the rows stacked so far.
+    /// @details The preview is a linear stretch (minimum to maximum) of the rows that have been stacked. It is only redrawn
+    ///          when more rows have been stacked.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CStackImagesWindow::eventStackTimer()
+    {
+      if (!stackQueue_.empty())
+      {
+        CImageStacker::SProgress &progress = *stackQueue_.front().progress;
+        std::size_t rowsDone = progress.rowsDone;
+
+        progressBarStack_->setFormat(tr("%1 - %p% (%2 queued)").arg(stackQueue_.front().name).arg(stackQueue_.size() - 1));
+
+        if ( (rowsDone != 0) && (rowsDone != stackPreviewRows_) )
+        {
+          std::lock_guard<std::mutex> lock(progress.previewMutex);
+          std::size_t pixelCount = rowsDone * progress.width;
+          float minimum = std::numeric_limits<float>::max();
+          float maximum = std::numeric_limits<float>::lowest();
+          QImage previewImage(static_cast<int>(progress.width), static_cast<int>(progress.height), QImage::Format_Grayscale8);
+
+          for (std::size_t index = 0; index < pixelCount; ++index)
+          {
+            if (!std::isnan(progress.preview[index]))
+            {
+              minimum = std::min(minimum, progress.preview[index]);
+              maximum = std::max(maximum, progress.preview[index]);
+            };
+          };
+
+          float scale = (maximum > minimum) ? 255 / (maximum - minimum) : 0;
+
+          previewImage.fill(0);
+          for (std::size_t row = 0; row < rowsDone; ++row)
+          {
+            uchar *scanLine = previewImage.scanLine(static_cast<int>(row));
+            float const *previewRow = progress.preview.data() + row * progress.width;
+
+            for (std::size_t column = 0; column < progress.width; ++column)
+            {
+              scanLine[column] = std::isnan(previewRow[column]) ? 0 :
+                                                                  static_cast<uchar>((previewRow[column] - minimum) * scale);
+            };
+          };
+
+          gsImageOutput->clear();
+          gsImageOutput->addPixmap(QPixmap::fromImage(previewImage));
+          if (stackPreviewRows_ == 0)
+          {
+            gvImageOutput->zoomAll();
+          };
+
+          stackPreviewRows_ = rowsDone;
+          progressBarStack_->setRange(0, static_cast<int>(progress.height));
+          progressBarStack_->setValue(static_cast<int>(rowsDone));
+        };
+      };
+    }
+
     /// @brief Function called when the tab is changed.
     /// @details Need to update the current image to the relevant image depending on what tab is active.
     ///           @li Tab0 = Input files and images
@@ -1048,6 +1681,120 @@ namespace astroManager
       return controlImage;
     }
 
+    /// @brief Adds an image to the live stack and displays the live stack.
+    /// @param[in] selectedItem: The item of the image. The image must be loaded.
+    /// @details The first image is the reference image. Its alignment points are chosen as for the auto stack, and the stars
+    ///          (and alignment coordinates if the image has WCS information) are saved. The alignment points of the other
+    ///          images are found from the WCS information if possible, otherwise by registering the stars of the image to the
+    ///          reference stars. Images that cannot be registered are marked in the list and are not added.
+    ///          Only the new image is processed, so the time to add an image does not depend on the number of images stacked.
+    ///          The image is added to the live stack, and the live stack is created, on a worker thread. (startLiveStack())
+    ///          The image is then released, so the memory used does not depend on the number of images stacked.
+    /// @throws ACL::CFITSException
+    /// @throws GCL::CRuntimeError
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Added to the live stack on a worker thread. The image is released.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CStackImagesWindow::liveStackImage(QListWidgetItem *selectedItem)
+    {
+      imaging::SControlImage *controlImage = loadImage(selectedItem);
+      ACL::CAstroImage *astroImage = controlImage->astroFile->getAstroImage(controlImage->currentHDB);
+      bool hasWCS = controlImage->astroFile->hasWCSData(controlImage->currentHDB);
+      std::optional<MCL::TPoint2D<ACL::FP_t>> align1, align2;
+
+      if (!selectedItem->data(ROLE_LIVESTACKED).toBool())
+      {
+        if (liveStack_.frameCount == 0)
+        {
+          FP_t seperationDistance = settings::astroManagerSettings->value(settings::IMAGESTACK_AUTO_DISTANCE,
+                                                                           QVariant(0.75)).toFloat();
+          boost::filesystem::path fileName(selectedItem->data(ROLE_PATH).toString().toStdString());
+
+          liveStack_.align1.x() = astroImage->width() * ((1 - seperationDistance) / 2);
+          liveStack_.align1.y() = astroImage->height() * ((1 - seperationDistance) / 2);
+          liveStack_.align2.x() = astroImage->width() - (astroImage->width() * ((1 - seperationDistance) / 2));
+          liveStack_.align2.y() = astroImage->height() - (astroImage->height() * ((1 - seperationDistance) / 2));
+
+          liveStack_.starRegistration = std::make_unique<CStarRegistration>(REGISTRATION_TOLERANCE);
+          liveStack_.starRegistration->referenceStars(CStarRegistration::extractStars(astroImage, REGISTRATION_STARS,
+                                                                                       REGISTRATION_SIGMA));
+          liveStack_.align1Coordinates.reset();
+          liveStack_.align2Coordinates.reset();
+          if (hasWCS)
+          {
+            std::vector<std::optional<ACL::CAstronomicalCoordinates>> alignCoordinates =
+                controlImage->astroFile->pix2wcsList(controlImage->currentHDB, { liveStack_.align1, liveStack_.align2 });
+
+            liveStack_.align1Coordinates = alignCoordinates[0];
+            liveStack_.align2Coordinates = alignCoordinates[1];
+          };
+
+          if ( (selectedItem->data(ROLE_OPENFROM).toUInt() == OF_FILE) && CAstroFile::isFITSFile(fileName) )
+          {
+            liveStack_.keywordFile = fileName;
+          }
+          else
+          {
+            liveStack_.keywordFile.clear();
+          };
+
+          align1 = liveStack_.align1;
+          align2 = liveStack_.align2;
+        }
+        else
+        {
+          if (hasWCS && liveStack_.align1Coordinates && liveStack_.align2Coordinates)
+          {
+            std::vector<std::optional<MCL::TPoint2D<FP_t>>> alignPixels =
+                controlImage->astroFile->wcs2pixList(controlImage->currentHDB, { *liveStack_.align1Coordinates,
+                                                                                 *liveStack_.align2Coordinates });
+
+            align1 = alignPixels[0];
+            align2 = alignPixels[1];
+          };
+
+          if (!align1 || !align2)
+          {
+            std::optional<CStarRegistration::STransform> transform =
+                liveStack_.starRegistration->registerStars(CStarRegistration::extractStars(astroImage, REGISTRATION_STARS,
+                                                                                           REGISTRATION_SIGMA));
+
+            if (transform)
+            {
+              align1 = (*transform)(liveStack_.align1);
+              align2 = (*transform)(liveStack_.align2);
+            };
+          };
+        };
+
+        if (align1 && align2)
+        {
+          selectedItem->setData(ROLE_ALIGN1, QVariant(QPointF(align1->x(), align1->y())));
+          selectedItem->setData(ROLE_ALIGN2, QVariant(QPointF(align2->x(), align2->y())));
+          selectedItem->setData(ROLE_LIVESTACKED, QVariant(true));
+          selectedItem->setIcon(QIcon(":/images/BMP_IMAGESTACK_GREEN.bmp"));
+
+          liveStack_.frameQueue.push_back({ controlImage->astroFile, controlImage->currentHDB, *align1, *align2 });
+          liveStack_.frameCount++;
+
+          INFOMESSAGE("Live stack: Added image " + selectedItem->text().toStdString() + ".");
+
+          startLiveStack();
+        }
+        else
+        {
+          selectedItem->setData(ROLE_LIVESTACKED, QVariant(false));     // Processed. Not loaded again.
+          selectedItem->setForeground(Qt::red);
+          selectedItem->setToolTip(tr("The image could not be registered to the live stack."));
+
+          INFOMESSAGE("Live stack: The image " + selectedItem->text().toStdString() + " could not be registered.");
+        };
+
+        releaseImage(selectedItem);
+      };
+    }
+
     /// @brief Function to load the image.
     /// @details The image may be loaded from file or from database depending on how the image has been selected. This function
     ///          handles the details of the loading.
@@ -1055,6 +1802,9 @@ namespace astroManager
     /// @returns Pointer to the controlImage structure.
     /// @throws GCL::CCodeError(astroManager)
     /// @throws From called functions.
+    /// @note Only the primary HDU of the images is loaded. The extensions are not needed for stacking.
+    /// @version 2026-10-17/GGB - Cancel the image in the frame loader before loading it synchronously.
+    /// @version 2026-10-17/GGB - Only load the primary HDU.
     /// @version 2017-08-27/GGB - Function created.
 
     imaging::SControlImage *CStackImagesWindow::loadImage(QListWidgetItem *selectedItem)
@@ -1064,7 +1814,10 @@ namespace astroManager
 
       if (imageData.isNull() )
       {
-          // The image has not been loaded, it needs to be loaded.
+          // The image has not been loaded, it needs to be loaded. The user is waiting for this image, so it is not worth waiting
+          // for the frame loader.
+
+        frameLoader->cancel(reinterpret_cast<quint64>(selectedItem));
 
         switch (selectedItem->data(ROLE_OPENFROM).toUInt() )
         {
@@ -1074,7 +1827,9 @@ namespace astroManager
 
               // Create the astroFile from the filename.
 
-            controlImage = new imaging::SControlImage(this, std::make_shared<CAstroFile>(this, boost::filesystem::path(fileName)));
+            controlImage = new imaging::SControlImage(this, std::make_shared<CAstroFile>(this, boost::filesystem::path(fileName),
+                                                                                         CAstroFile::LM_IMMEDIATE,
+                                                                                         CAstroFile::HS_PRIMARY));
             break;
           };
           case OF_DATABASE:
@@ -1082,7 +1837,9 @@ namespace astroManager
             database::imageID_t imageID = selectedItem->data(ROLE_IMAGEID).toUInt();
             database::imageVersion_t imageVersion;
             database::databaseARID->versionLatest(imageID, imageVersion);
-            controlImage = new imaging::SControlImage(this, std::make_shared<CAstroFile>(this, imageID, imageVersion));
+            controlImage = new imaging::SControlImage(this, std::make_shared<CAstroFile>(this, imageID, imageVersion,
+                                                                                         CAstroFile::LM_IMMEDIATE,
+                                                                                         CAstroFile::HS_PRIMARY));
             break;
           };
           default:
@@ -1113,6 +1870,280 @@ namespace astroManager
       return controlImage;
     }
 
+    /// @brief Loads all the images in the list that have not already been loaded.
+    /// @details The images are loaded concurrently by the frame loader. A progress dialog is displayed while the images are
+    ///          loading, and the images are attached to the list items as they finish loading.
+    /// @returns true if the images were loaded. false if the user cancelled the load.
+    /// @throws GCL::CCodeError(astroManager)
+    /// @throws From called functions.
+    /// @note Images that cannot be loaded are marked in the list and are not attached to their list items.
+    /// @version 2026-10-17/GGB - The images are queued by queueImages().
+    /// @version 2026-10-17/GGB - Function created.
+
+    bool CStackImagesWindow::loadImages()
+    {
+      std::size_t frameCount;
+      bool returnValue = true;
+
+      queueImages();
+
+      if ((frameCount = frameLoader->pendingCount()) != 0)
+      {
+        QProgressDialog progressDialog(tr("Loading images..."), tr("Cancel"), 0, static_cast<int>(frameCount), this);
+        progressDialog.setWindowModality(Qt::WindowModal);
+        progressDialog.setMinimumDuration(0);
+
+        while ( (frameLoader->pendingCount() != 0) && !progressDialog.wasCanceled())
+        {
+          progressDialog.setValue(static_cast<int>(frameCount - frameLoader->pendingCount()));
+          QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        };
+
+        if (progressDialog.wasCanceled())
+        {
+          frameLoader->cancelAll();
+          returnValue = false;
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Queues all the images in the list that have not already been loaded with the frame loader.
+    /// @details The images are attached to the list items as they finish loading. (eventFrameLoaded()) In live stack mode the
+    ///          images that have been processed by the live stack (and released) are not queued.
+    /// @throws GCL::CCodeError(astroManager)
+    /// @version 2026-10-17/GGB - Do not queue the images processed by the live stack.
+    /// @version 2026-10-17/GGB - Function created. (Code moved from loadImages())
+
+    void CStackImagesWindow::queueImages()
+    {
+      int itemCount = listImages->count();
+      QListWidgetItem *selectedItem;
+      quint64 key;
+
+      for (int index = 0; index < itemCount; ++index)
+      {
+        selectedItem = listImages->item(index);
+        key = reinterpret_cast<quint64>(selectedItem);
+
+        if ( selectedItem->data(ROLE_CONTROLIMAGE).isNull() && !frameLoader->isPending(key) &&
+             (!liveStack_.liveStacker || selectedItem->data(ROLE_LIVESTACKED).isNull()) )
+        {
+          switch (selectedItem->data(ROLE_OPENFROM).toUInt() )
+          {
+            case OF_FILE:
+            {
+              frameLoader->addFile(key, boost::filesystem::path(selectedItem->data(ROLE_PATH).toString().toStdString()));
+              break;
+            };
+            case OF_DATABASE:
+            {
+              database::imageID_t imageID = selectedItem->data(ROLE_IMAGEID).toUInt();
+              database::imageVersion_t imageVersion;
+              database::databaseARID->versionLatest(imageID, imageVersion);
+              frameLoader->addImage(key, imageID, imageVersion);
+              break;
+            };
+            default:
+            {
+              CODE_ERROR;
+              break;
+            };
+          };
+        };
+      };
+    }
+
+    /// @brief Registers the images using the stars in the images.
+    /// @param[in] seperationDistance: The fraction of the image diagonal between the alignment points.
+    /// @param[in] noWCSAction: The action to take for images that cannot be registered.
+    /// @returns true if the images were registered. false if the process should be aborted.
+    /// @details The stars are extracted from all the images in parallel, and each image is then registered (in parallel) to
+    ///          the first image. The alignment points of the first image are on the BL-TR diagonal, and the alignment points
+    ///          of the other images are found with the transform from the first image. Images that cannot be registered are
+    ///          removed from the list, unless the action is to stop or the user chooses to stop.
+    /// @throws GCL::CCodeError(astroManager)
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
+
+    bool CStackImagesWindow::registerImages(FP_t seperationDistance, int noWCSAction)
+    {
+      bool returnValue = true;
+      int itemCount = listImages->count();
+      std::vector<imaging::SControlImage *> controlImages(itemCount);
+      std::vector<std::vector<CStarRegistration::SStar>> stars(itemCount);
+      std::vector<std::optional<CStarRegistration::STransform>> transforms(itemCount);
+      std::vector<std::exception_ptr> errors(itemCount);
+      std::vector<QListWidgetItem *> deleteList;
+      CStarRegistration starRegistration(REGISTRATION_TOLERANCE);
+      MCL::TPoint2D<ACL::FP_t> BL, TR;
+
+      for (int index = 0; index < itemCount; ++index)
+      {
+        controlImages[index] = loadImage(listImages->item(index));
+      };
+
+      QApplication::setOverrideCursor(Qt::WaitCursor);
+
+      parallelFor(controlImages.size(), [&](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t index = begin; index < end; ++index)
+        {
+          try
+          {
+            stars[index] = CStarRegistration::extractStars(
+                  controlImages[index]->astroFile->getAstroImage(controlImages[index]->currentHDB), REGISTRATION_STARS,
+                  REGISTRATION_SIGMA);
+          }
+          catch(...)
+          {
+            errors[index] = std::current_exception();
+          };
+        };
+      });
+
+      for (std::exception_ptr const &error : errors)
+      {
+        if (error)
+        {
+          QApplication::restoreOverrideCursor();
+          std::rethrow_exception(error);
+        };
+      };
+
+      starRegistration.referenceStars(stars.front());
+
+      parallelFor(controlImages.size() - 1, [&](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t index = begin + 1; index < end + 1; ++index)
+        {
+          try
+          {
+            transforms[index] = starRegistration.registerStars(stars[index]);
+          }
+          catch(...)
+          {
+            errors[index] = std::current_exception();
+          };
+        };
+      });
+
+      QApplication::restoreOverrideCursor();
+
+      for (std::exception_ptr const &error : errors)
+      {
+        if (error)
+        {
+          std::rethrow_exception(error);
+        };
+      };
+
+        // The alignment points of the reference image.
+
+      BL.x() = controlImages.front()->astroFile->imageWidth() * ((1 - seperationDistance) / 2);
+      BL.y() = controlImages.front()->astroFile->imageHeight() * ((1 - seperationDistance) / 2);
+      TR.x() = controlImages.front()->astroFile->imageWidth() -
+               (controlImages.front()->astroFile->imageWidth() * ((1 - seperationDistance) / 2));
+      TR.y() = controlImages.front()->astroFile->imageHeight() -
+               (controlImages.front()->astroFile->imageHeight() * ((1 - seperationDistance) / 2));
+
+      listImages->item(0)->setData(ROLE_ALIGN1, QVariant(QPointF(BL.x(), BL.y())));
+      listImages->item(0)->setData(ROLE_ALIGN2, QVariant(QPointF(TR.x(), TR.y())));
+
+      for (int index = 1; index < itemCount; ++index)
+      {
+        QListWidgetItem *selectedItem = listImages->item(index);
+
+        if (transforms[index])
+        {
+          MCL::TPoint2D<ACL::FP_t> align1 = (*transforms[index])(BL);
+          MCL::TPoint2D<ACL::FP_t> align2 = (*transforms[index])(TR);
+
+          selectedItem->setData(ROLE_ALIGN1, QVariant(QPointF(align1.x(), align1.y())));
+          selectedItem->setData(ROLE_ALIGN2, QVariant(QPointF(align2.x(), align2.y())));
+        }
+        else
+        {
+          INFOMESSAGE("The image " + selectedItem->text().toStdString() + " could not be registered. (" +
+                      std::to_string(stars[index].size()) + " stars found.)");
+          deleteList.emplace_back(selectedItem);
+        };
+      };
+
+      INFOMESSAGE("Registered " + std::to_string(itemCount - deleteList.size()) + " of " + std::to_string(itemCount) +
+                  " images using " + std::to_string(stars.front().size()) + " reference stars.");
+
+      if ( (itemCount > 1) && (static_cast<int>(deleteList.size()) == itemCount - 1) )
+      {
+        QMessageBox::critical(this, tr("Images not registered."),
+                              tr("None of the images could be registered to the first image. The process is being aborted."));
+        returnValue = false;
+      }
+      else if (!deleteList.empty())
+      {
+        if (noWCSAction == NOWCS_STOP)
+        {
+          QMessageBox::critical(this, tr("Images not registered."),
+                                tr("%1 images could not be registered. The process is being aborted.").arg(deleteList.size()));
+          returnValue = false;
+        }
+        else if (noWCSAction == NOWCS_ASK)
+        {
+          QMessageBox messageBox(this);
+          QStringList imageNames;
+
+          for (QListWidgetItem *item : deleteList)
+          {
+            imageNames << item->text();
+          };
+
+          messageBox.setIcon(QMessageBox::Question);
+          messageBox.setText(tr("%1 images could not be registered.").arg(deleteList.size()));
+          messageBox.setInformativeText(tr("Remove the images and continue stacking?"));
+          messageBox.setDetailedText(imageNames.join("\n"));
+          messageBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+          messageBox.setDefaultButton(QMessageBox::Yes);
+
+          returnValue = (messageBox.exec() == QMessageBox::Yes);
+        };
+
+          // Images that are not aligned cannot be stacked, so they are removed when the process continues.
+
+        if (returnValue)
+        {
+          for (QListWidgetItem *item : deleteList)
+          {
+            deleteListItem(item);
+          };
+        };
+      };
+
+      return returnValue;
+    }
+
+    /// @brief Releases the image of an item that has been processed by the live stack.
+    /// @param[in] selectedItem: The item of the image.
+    /// @details The image of the current item is kept as it may be displayed. The other images are loaded again if they are
+    ///          selected. (loadImage())
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CStackImagesWindow::releaseImage(QListWidgetItem *selectedItem)
+    {
+      if (selectedItem != listImages->currentItem())
+      {
+        imaging::SControlImage *controlImage =
+            reinterpret_cast<imaging::SControlImage *>(selectedItem->data(ROLE_CONTROLIMAGE).toULongLong());
+
+        if (controlImage)
+        {
+          delete controlImage;
+          selectedItem->setData(ROLE_CONTROLIMAGE, QVariant());
+        };
+      };
+    }
+
     /// @brief Remove and delete the alignment graphics.
     /// @throws None.
     /// @version 2017-08-31/GGB - Function created.
@@ -1284,8 +2315,43 @@ namespace astroManager
       };
     }
 
+    /// @brief Returns the stacking mode selected by the user.
+    /// @returns The stacking mode.
+    /// @throws GCL::CCodeError(astroManager)
+    /// @version 2026-10-17/GGB - Function created. (Code moved from stackImages())
+
+    ACL::CImageStack::EStackMode CStackImagesWindow::selectedStackMode()
+    {
+      ACL::CImageStack::EStackMode returnValue = ACL::CImageStack::SM_MEAN;
+
+      if (widget()->findChild<QRadioButton *>("radioAddCombine")->isChecked())
+      {
+        returnValue = ACL::CImageStack::SM_SUM;
+      }
+      else if (radioMeanCombine->isChecked())
+      {
+        returnValue = ACL::CImageStack::SM_MEAN;
+      }
+      else if (widget()->findChild<QRadioButton *>("radioMedianCombine")->isChecked())
+      {
+        returnValue = ACL::CImageStack::SM_MEDIAN;
+      }
+      else if (widget()->findChild<QRadioButton *>("radioSigmaClip")->isChecked())
+      {
+        returnValue = ACL::CImageStack::SM_SIGMACLIP;
+      }
+      else
+      {
+        CODE_ERROR;
+      };
+
+      return returnValue;
+    }
+
     /// @brief Loads the template for the UI. Populates all required fields
     /// @throws GCL::CError(astroManager, 0x0001)
+    /// @version 2026-10-17/GGB - Added the progress of the background stacks.
+    /// @version 2026-10-17/GGB - Added the live stack action.
     /// @version 2017-07-10/GGB - Bug #90 checking for resource opening succesfully.
     /// @version 2017-06-14/GGB - Updated to Qt5
     /// @version 2013-06-29/GGB - Added support for remove all button.
@@ -1313,12 +2379,19 @@ namespace astroManager
 
       setWidget(formWidget);
 
+      connect(frameLoader, SIGNAL(frameLoaded(quint64)), this, SLOT(eventFrameLoaded(quint64)));
+      connect(frameLoader, SIGNAL(frameFailed(quint64, QString)), this, SLOT(eventFrameFailed(quint64, QString)));
+
       actionSelectFromFolder = new QAction(QIcon(":/icons/folders/folder_add.png"), tr("Select from Folder"), this);
       connect(actionSelectFromFolder, SIGNAL(triggered(bool)), this, SLOT(eventButtonAddImagesFromFolder(bool)));
 
       actionSelectFromDatabase = new QAction(QIcon(":/icons/database/database_add.png"), tr("Select from Database"), this);
       connect(actionSelectFromDatabase, SIGNAL(triggered(bool)), this, SLOT(eventButtonAddImagesFromDatabase(bool)));
 
+      actionLiveStack = new QAction(tr("Live Stack from Folder..."), this);
+      actionLiveStack->setCheckable(true);
+      connect(actionLiveStack, SIGNAL(toggled(bool)), this, SLOT(eventLiveStack(bool)));
+
       ASSOCIATE_CONTROL(tabWidget, formWidget, "tabImages", QTabWidget);
       ASSOCIATE_CONTROL(listImages, formWidget, "listImages", QListWidget);
       ASSOCIATE_CONTROL(pbOpenInWindow, formWidget, "pushButtonOpenInWindow", QPushButton);
@@ -1341,6 +2414,8 @@ namespace astroManager
       addImagesMenu = new QMenu;
       addImagesMenu->addAction(actionSelectFromFolder);
       addImagesMenu->addAction(actionSelectFromDatabase);
+      addImagesMenu->addSeparator();
+      addImagesMenu->addAction(actionLiveStack);
 
         // Set the default menu to use.
 
@@ -1408,6 +2483,35 @@ namespace astroManager
 
       gsImageOutput = new QGraphicsScene();
       gvImageOutput->setScene(gsImageOutput);
+
+        // Progress of the background stacks.
+
+      QHBoxLayout *stackLayout = new QHBoxLayout();
+
+      progressBarStack_ = new QProgressBar(this);
+      progressBarStack_->setVisible(false);
+      stackLayout->addWidget(progressBarStack_);
+
+      pushButtonCancelStack_ = new QPushButton(tr("Cancel"), this);
+      pushButtonCancelStack_->setVisible(false);
+      stackLayout->addWidget(pushButtonCancelStack_);
+
+      glImage->addLayout(stackLayout, 1, 0, 1, 1);
+
+      stackWatcher_ = new QFutureWatcher<void>(this);
+      stackTimer_ = new QTimer(this);
+
+      connect(stackWatcher_, SIGNAL(finished()), this, SLOT(eventStackFinished()));
+
+      liveStack_.liveWatcher = new QFutureWatcher<void>(this);
+      liveStack_.settleTimer = new QTimer(this);
+      liveStack_.settleTimer->setSingleShot(true);
+      liveStack_.settleTimer->setInterval(LIVE_SETTLE_TIME);
+
+      connect(liveStack_.liveWatcher, SIGNAL(finished()), this, SLOT(eventLiveStackFinished()));
+      connect(liveStack_.settleTimer, SIGNAL(timeout()), this, SLOT(eventLiveSettleTimer()));
+      connect(stackTimer_, SIGNAL(timeout()), this, SLOT(eventStackTimer()));
+      connect(pushButtonCancelStack_, SIGNAL(clicked(bool)), this, SLOT(eventButtonCancelStack(bool)));
     }
 
     /// @brief Processes an activated item signal in the image list.
@@ -1525,8 +2629,19 @@ namespace astroManager
     }
 
     /// @brief Performs the actual image stacking.
+    /// @details The images are stacked by CImageStacker. Images opened from FITS files are read from disk a band of rows at a
+    ///          time, so the memory used is limited by the IMAGESTACK_MEMORYBUDGET setting rather than by the number of images.
+    ///          Other images are read from memory. The output is written to a temporary FITS file that is then loaded as the
+    ///          output image.
+    ///          The stack is queued and runs on a worker thread. (See startStack()) Several stacks (for example of images
+    ///          taken with different filters) can be queued, and run one after another.
     /// @pre All images should have alignment points assigned.
-    /// @throws
+    /// @throws ACL::CFITSException
+    /// @throws GCL::CRuntimeError
+    /// @version 2026-10-17/GGB - The stack is queued and runs on a worker thread.
+    /// @version 2026-10-17/GGB - The sigma clip rejection is set from IMAGESTACK_REJECTION.
+    /// @version 2026-10-17/GGB - The output image is displayed by displayOutputImage().
+    /// @version 2026-10-17/GGB - Use the streaming image stacker.
     /// @version 2017-08-27/GGB - Function created.
 
     void CStackImagesWindow::stackImages()
@@ -1541,8 +2656,11 @@ namespace astroManager
       imaging::SControlImage *controlImage;
       std::uint_least8_t missingAlignmentAction = settings::astroManagerSettings->value(settings::IMAGESTACK_MISSINGALIGNMENTACTION,
                                                                                 QVariant(NOWCS_IGNORE)).toUInt();
+      std::unique_ptr<CImageStacker> imageStack = std::make_unique<CImageStacker>(
+            settings::astroManagerSettings->value(settings::IMAGESTACK_MEMORYBUDGET, QVariant(1024)).toULongLong() * 1024 * 1024);
 
-      imageStack.clearFiles();             // Remmove any existing images from the image stacker.
+      imageStack->rejection(static_cast<ERejection>(settings::astroManagerSettings->value(settings::IMAGESTACK_REJECTION,
+                                                                                         QVariant(RJ_MAD)).toInt()));
 
       for (; (index < itemCount) && !bError; index++)
       {
@@ -1569,9 +2687,17 @@ namespace astroManager
           pointF = selectedItem->data(ROLE_ALIGN2).toPointF();
           align2 = MCL::TPoint2D<FP_t>(pointF.x(), pointF.y());
 
-          controlImage = reinterpret_cast<imaging::SControlImage *>(selectedItem->data(ROLE_CONTROLIMAGE).toULongLong());
+          boost::filesystem::path fileName(selectedItem->data(ROLE_PATH).toString().toStdString());
 
-          imageStack.addFile(controlImage->astroFile, align1, align2);
+          if ( (selectedItem->data(ROLE_OPENFROM).toUInt() == OF_FILE) && CAstroFile::isFITSFile(fileName) )
+          {
+            imageStack->addFile(fileName, align1, align2);
+          }
+          else
+          {
+            controlImage = loadImage(selectedItem);
+            imageStack->addImage(controlImage->astroFile, controlImage->currentHDB, align1, align2);
+          };
         };
       };
 
@@ -1603,57 +2729,112 @@ namespace astroManager
           // Flags are assigned.
           // Perform the combine
 
-        if (widget()->findChild<QRadioButton *>("radioAddCombine")->isChecked())
-        {
-          stackMode = ACL::CImageStack::SM_SUM;
-        }
-        else if (radioMeanCombine->isChecked())
-        {
-          stackMode = ACL::CImageStack::SM_MEAN;
-        }
-        else if (widget()->findChild<QRadioButton *>("radioMedianCombine")->isChecked())
-        {
-          stackMode = ACL::CImageStack::SM_MEDIAN;
-        }
-        else if (widget()->findChild<QRadioButton *>("radioSigmaClip")->isChecked())
-        {
-          stackMode = ACL::CImageStack::SM_SIGMACLIP;
-        }
-        else
-        {
-          stackMode = ACL::CImageStack::SM_NONE;
-        };
+        stackMode = selectedStackMode();
 
           // This will delete the previous output image and set the new image.
 
-        std::unique_ptr<ACL::CAstroFile> &outputImage = imageStack.stackImages(stackMode);
-        outputControlImage.astroFile.reset(dynamic_cast<CAstroFile *>(outputImage.release()));
+        boost::filesystem::path outputFile = boost::filesystem::temp_directory_path() /
+                                             boost::filesystem::unique_path("astroManager-stack-%%%%-%%%%-%%%%.fits");
 
-        outputControlImage.astroFile->keywordWrite(0, ACL::ASTROMANAGER_UUID, QUuid::createUuid().toString().toUpper().toStdString(),
-                                                   ACL::ASTROMANAGER_COMMENT_UUID);
-        outputControlImage.astroFile->fileNameValid(false);
-        outputControlImage.astroFile->imageIDValid(false);
-        outputControlImage.astroFile->syntheticImage(true);
+        SStackJob stackJob;
 
-        outputControlImage.currentHDB = 0;
+        stackJob.name = tr("%1 images from %2").arg(imageStack->frameCount()).arg(listImages->item(0)->text());
+        stackJob.progress = std::make_shared<CImageStacker::SProgress>();
+        imageStack->progress(stackJob.progress);
+        stackJob.imageStack = std::move(imageStack);
+        stackJob.stackMode = stackMode;
+        stackJob.outputFile = outputFile;
 
-        outputControlImageValid_ = true;
+        stackQueue_.push_back(std::move(stackJob));
+        startStack();
+      }
+    }
 
-          // Now need to add the output file to the output window.
+    /// @brief Adds the queued frames to the live stack on a worker thread, if the worker is not already running.
+    /// @details The worker also creates the live stack in memory. (CLiveStacker::resultFITS()) eventLiveStackFinished() is
+    ///          called when the worker has finished. Frames that are queued while the worker is running are added by the next
+    ///          run, so only the last live stack is displayed if the images arrive faster than they can be stacked.
+    /// @throws std::bad_alloc
+    /// @version 2026-10-17/GGB - Function created.
 
-        CAstroImageWindow::imageChange(&outputControlImage);
+    void CStackImagesWindow::startLiveStack()
+    {
+      if (liveStack_.liveStacker && !liveStack_.frameQueue.empty() && !liveStack_.liveWatcher->isRunning())
+      {
+        CLiveStacker *liveStacker = liveStack_.liveStacker.get();
+        std::deque<SLiveFrame> frames;
+        ACL::CImageStack::EStackMode stackMode = selectedStackMode();
+        boost::filesystem::path keywordFile = liveStack_.keywordFile;
 
-        outputControlImage.pixmap->convertFromImage(*outputControlImage.ScreenImage);
+        frames.swap(liveStack_.frameQueue);
+        liveStack_.liveResult.reset();
+        liveStack_.liveException = nullptr;
 
-        gsImageOutput->addPixmap(*outputControlImage.pixmap);      // Draw the main image
-        gvImageOutput->setCursor(Qt::CrossCursor);
-        gvImageOutput->zoomAll();
-        pbOpenInWindow->setEnabled(true);
-        tabWidget->setCurrentIndex(1);
-      }
-      else
+        liveStack_.liveWatcher->setFuture(QtConcurrent::run([this, liveStacker, frames, stackMode, keywordFile]()
+        {
+          for (SLiveFrame const &frame : frames)
+          {
+            try
+            {
+              liveStacker->addFrame(frame.astroFile, frame.hdb, frame.align1, frame.align2);
+            }
+            catch(...)
+            {
+              liveStack_.liveException = std::current_exception();
+            };
+          };
+
+          try
+          {
+            if (liveStacker->frameCount() != 0)
+            {
+              QByteArray liveFITS = liveStacker->resultFITS(stackMode, keywordFile);
+
+              liveStack_.liveResult = std::make_shared<CAstroFile>(this, liveFITS, CAstroFile::HS_PRIMARY);
+            };
+          }
+          catch(...)
+          {
+            liveStack_.liveException = std::current_exception();
+          };
+        }));
+      };
+    }
+
+    /// @brief Starts the stack at the front of the queue on a worker thread, if a stack is not already running.
+    /// @details The progress and the preview are updated by eventStackTimer(). eventStackFinished() is called when the stack has
+    ///          finished.
+    /// @throws None.
+    /// @version 2026-10-17/GGB - Function created.
+
+    void CStackImagesWindow::startStack()
+    {
+      if (!stackQueue_.empty() && !stackWatcher_->isRunning())
       {
-        imageStack.clearFiles();
+        SStackJob *stackJob = &stackQueue_.front();
+
+        stackException_ = nullptr;
+        stackPreviewRows_ = 0;
+
+        progressBarStack_->setRange(0, 0);
+        progressBarStack_->setFormat(tr("%1 (%2 queued)").arg(stackJob->name).arg(stackQueue_.size() - 1));
+        progressBarStack_->setVisible(true);
+        pushButtonCancelStack_->setVisible(true);
+        pushButtonCancelStack_->setEnabled(true);
+
+        stackWatcher_->setFuture(QtConcurrent::run([this, stackJob]()
+        {
+          try
+          {
+            stackJob->imageStack->stackImages(stackJob->stackMode, stackJob->outputFile);
+          }
+          catch(...)
+          {
+            stackException_ = std::current_exception();
+          };
+        }));
+
+        stackTimer_->start(settings::astroManagerSettings->value(settings::IMAGESTACK_PREVIEWINTERVAL, QVariant(2)).toInt() * 1000);
       };
     }
 
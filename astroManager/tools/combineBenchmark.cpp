@@ -0,0 +1,368 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								combineBenchmark
+// SUBSYSTEM:						Image stacking. (Benchmark)
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL, GCL, QCL
+// NAMESPACE:						N/A
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Stand alone micro-benchmark of the stacking combine. Not part of the astroManager build.
+//                      Synthetic frames (normal noise with 5% outliers) are combined single threaded by:
+//                        - the per-pixel gather and combine used by CImageStacker before the combine kernels,
+//                        - the combine kernels (CCombineTile, one tile per row, as CImageStacker::combineBand()),
+//                        - the direct (streaming) sum used by CImageStacker::combineBand() for the mean and the sum.
+//                      The time of each method and the largest difference from the per-pixel combine are printed.
+//                      (The winsorized and linear fit rejections clip differently, so their results are expected to differ.)
+//
+//                      Build from the astroManager directory, with the include paths and libraries used by astroManager.pro:
+//                        g++ -std=c++17 -O2 -I. <include paths> tools/combineBenchmark.cpp source/imaging/combineKernels.cpp
+//                            <libraries>
+//                      Usage: combineBenchmark [pixels] [frames...]  (Default 200000 pixels, 5 9 16 24 40 frames)
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/combineKernels.h"
+
+  // Standard C++ library header files
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace astroManager::imaging;
+
+namespace
+{
+  std::size_t const ROW_WIDTH = 1000;             ///< Pixels in each row (tile).
+  double const OUTLIER_FRACTION = 0.05;
+  double const SIGMACLIP_KAPPA = 3;
+  double const MAD_TO_SIGMA = 1.4826;
+  std::size_t const SIGMACLIP_ITERATIONS = 5;
+
+  /// @brief      Median of the values. (As CImageStacker before the combine kernels)
+
+  float referenceMedian(float *values, std::size_t count)
+  {
+    float returnValue;
+    float *middle = values + count / 2;
+
+    std::nth_element(values, middle, values + count);
+    returnValue = *middle;
+
+    if ((count % 2) == 0)
+    {
+      returnValue = (returnValue + *std::max_element(values, middle)) / 2;
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Combine of one pixel. (CImageStacker::combine() before the combine kernels)
+
+  float referenceCombine(float *values, float *scratch, std::size_t count, ACL::CImageStack::EStackMode stackMode)
+  {
+    float returnValue = 0;
+
+    if (count != 0)
+    {
+      switch (stackMode)
+      {
+        case ACL::CImageStack::SM_SUM:
+        {
+          returnValue = static_cast<float>(std::accumulate(values, values + count, 0.0));
+          break;
+        };
+        case ACL::CImageStack::SM_MEAN:
+        {
+          returnValue = static_cast<float>(std::accumulate(values, values + count, 0.0) / count);
+          break;
+        };
+        case ACL::CImageStack::SM_MEDIAN:
+        {
+          returnValue = referenceMedian(values, count);
+          break;
+        };
+        case ACL::CImageStack::SM_SIGMACLIP:
+        {
+          bool clipped = true;
+
+          for (std::size_t iteration = 0; (iteration < SIGMACLIP_ITERATIONS) && clipped && (count > 2); ++iteration)
+          {
+            float median = referenceMedian(values, count);
+            std::size_t kept = 0;
+
+            for (std::size_t index = 0; index < count; ++index)
+            {
+              scratch[index] = std::fabs(values[index] - median);
+            };
+
+            double limit = SIGMACLIP_KAPPA * MAD_TO_SIGMA * referenceMedian(scratch, count);
+
+            for (std::size_t index = 0; index < count; ++index)
+            {
+              if (std::fabs(values[index] - median) <= limit)
+              {
+                values[kept++] = values[index];
+              };
+            };
+
+            clipped = (kept != count) && (kept != 0);
+            if (clipped)
+            {
+              count = kept;
+            };
+          };
+
+          returnValue = static_cast<float>(std::accumulate(values, values + count, 0.0) / count);
+          break;
+        };
+        default:
+        {
+          break;
+        };
+      };
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Per-pixel combine. The values of each pixel are gathered from the frames, then combined.
+
+  void combinePerPixel(std::vector<std::vector<float>> const &frames, ACL::CImageStack::EStackMode stackMode,
+                       std::vector<float> &output)
+  {
+    std::vector<float> values(frames.size());
+    std::vector<float> scratch(frames.size());
+
+    for (std::size_t pixel = 0; pixel < output.size(); ++pixel)
+    {
+      std::size_t count = 0;
+
+      for (std::vector<float> const &frame : frames)
+      {
+        if (!std::isnan(frame[pixel]))
+        {
+          values[count++] = frame[pixel];
+        };
+      };
+
+      output[pixel] = referenceCombine(values.data(), scratch.data(), count, stackMode);
+    };
+  }
+
+  /// @brief      Combine kernels. Each row is a tile, and each frame adds its values along the row.
+
+  void combineTiles(std::vector<std::vector<float>> const &frames, ACL::CImageStack::EStackMode stackMode,
+                    ERejection rejection, std::vector<float> &output)
+  {
+    CCombineTile tile(frames.size(), ROW_WIDTH);
+
+    for (std::size_t rowFirst = 0; rowFirst < output.size(); rowFirst += ROW_WIDTH)
+    {
+      std::size_t rowPixels = std::min(ROW_WIDTH, output.size() - rowFirst);
+
+      tile.clear(rowPixels);
+
+      for (std::vector<float> const &frame : frames)
+      {
+        for (std::size_t pixel = 0; pixel < rowPixels; ++pixel)
+        {
+          tile.addValue(pixel, frame[rowFirst + pixel]);
+        };
+      };
+
+      tile.combine(stackMode, output.data() + rowFirst, rejection);
+    };
+  }
+
+  /// @brief      Direct sum. Each frame is added to the row sums, then the row is divided by the counts.
+
+  void combineStreaming(std::vector<std::vector<float>> const &frames, ACL::CImageStack::EStackMode stackMode,
+                        std::vector<float> &output)
+  {
+    std::vector<double> sums(ROW_WIDTH);
+    std::vector<std::uint32_t> counts(ROW_WIDTH);
+
+    for (std::size_t rowFirst = 0; rowFirst < output.size(); rowFirst += ROW_WIDTH)
+    {
+      std::size_t rowPixels = std::min(ROW_WIDTH, output.size() - rowFirst);
+
+      std::fill(sums.begin(), sums.end(), 0);
+      std::fill(counts.begin(), counts.end(), 0);
+
+      for (std::vector<float> const &frame : frames)
+      {
+        for (std::size_t pixel = 0; pixel < rowPixels; ++pixel)
+        {
+          float value = frame[rowFirst + pixel];
+
+          if (!std::isnan(value))
+          {
+            sums[pixel] += value;
+            counts[pixel]++;
+          };
+        };
+      };
+
+      for (std::size_t pixel = 0; pixel < rowPixels; ++pixel)
+      {
+        if (counts[pixel] == 0)
+        {
+          output[rowFirst + pixel] = 0;
+        }
+        else if (stackMode == ACL::CImageStack::SM_SUM)
+        {
+          output[rowFirst + pixel] = static_cast<float>(sums[pixel]);
+        }
+        else
+        {
+          output[rowFirst + pixel] = static_cast<float>(sums[pixel] / counts[pixel]);
+        };
+      };
+    };
+  }
+
+  /// @brief      Returns the time (ms) taken by the function. The fastest of three runs.
+
+  template<typename F>
+  double timeRun(F function)
+  {
+    double returnValue = 0;
+
+    for (int run = 0; run < 3; ++run)
+    {
+      auto start = std::chrono::steady_clock::now();
+
+      function();
+
+      double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+      returnValue = (run == 0) ? elapsed : std::min(returnValue, elapsed);
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Returns the largest difference between the results.
+
+  double maximumDifference(std::vector<float> const &first, std::vector<float> const &second)
+  {
+    double returnValue = 0;
+
+    for (std::size_t index = 0; index < first.size(); ++index)
+    {
+      returnValue = std::max(returnValue, static_cast<double>(std::fabs(first[index] - second[index])));
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Prints one line of the results.
+
+  void printResult(std::string const &name, double time, double referenceTime, double difference)
+  {
+    std::cout << std::setw(22) << std::left << name << std::right << std::fixed
+              << std::setw(10) << std::setprecision(1) << time << " ms"
+              << std::setw(8) << std::setprecision(2) << time / referenceTime << "x"
+              << std::setw(14) << std::setprecision(6) << difference << std::endl;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  std::size_t pixelCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+  std::vector<std::size_t> frameCounts;
+  std::mt19937 generator(42);
+  std::normal_distribution<float> noise(1000, 10);
+  std::uniform_real_distribution<float> uniform(0, 1);
+
+  for (int argument = 2; argument < argc; ++argument)
+  {
+    frameCounts.push_back(std::strtoul(argv[argument], nullptr, 10));
+  };
+  if (frameCounts.empty())
+  {
+    frameCounts = { 5, 9, 16, 24, 40 };
+  };
+
+  for (std::size_t frameCount : frameCounts)
+  {
+    std::vector<std::vector<float>> frames(frameCount, std::vector<float>(pixelCount));
+    std::vector<float> reference(pixelCount);
+    std::vector<float> output(pixelCount);
+
+    for (std::vector<float> &frame : frames)
+    {
+      for (float &value : frame)
+      {
+        value = noise(generator);
+        if (uniform(generator) < OUTLIER_FRACTION)
+        {
+          value += 500;     // Cosmic ray, satellite trail.
+        };
+      };
+    };
+
+    std::cout << std::endl << pixelCount << " pixels, " << frameCount << " frames" << std::endl;
+    std::cout << std::setw(22) << std::left << "Method" << std::right << std::setw(13) << "Time"
+              << std::setw(9) << "Ratio" << std::setw(14) << "Difference" << std::endl;
+
+    for (ACL::CImageStack::EStackMode stackMode : { ACL::CImageStack::SM_MEAN, ACL::CImageStack::SM_SUM,
+                                                    ACL::CImageStack::SM_MEDIAN, ACL::CImageStack::SM_SIGMACLIP })
+    {
+      std::string modeName = (stackMode == ACL::CImageStack::SM_MEAN) ? "Mean" :
+                             (stackMode == ACL::CImageStack::SM_SUM) ? "Sum" :
+                             (stackMode == ACL::CImageStack::SM_MEDIAN) ? "Median" : "Sigma clip";
+      double referenceTime = timeRun([&]() { combinePerPixel(frames, stackMode, reference); });
+
+      printResult(modeName + " per pixel", referenceTime, referenceTime, 0);
+
+      double time = timeRun([&]() { combineTiles(frames, stackMode, RJ_MAD, output); });
+      printResult(modeName + " tiles", time, referenceTime, maximumDifference(reference, output));
+
+      if ( (stackMode == ACL::CImageStack::SM_MEAN) || (stackMode == ACL::CImageStack::SM_SUM) )
+      {
+        time = timeRun([&]() { combineStreaming(frames, stackMode, output); });
+        printResult(modeName + " streaming", time, referenceTime, maximumDifference(reference, output));
+      }
+      else if (stackMode == ACL::CImageStack::SM_SIGMACLIP)
+      {
+        time = timeRun([&]() { combineTiles(frames, stackMode, RJ_WINSORIZED, output); });
+        printResult("Winsorized tiles", time, referenceTime, maximumDifference(reference, output));
+
+        time = timeRun([&]() { combineTiles(frames, stackMode, RJ_LINEARFIT, output); });
+        printResult("Linear fit tiles", time, referenceTime, maximumDifference(reference, output));
+      };
+    };
+  };
+
+  return 0;
+}
@@ -0,0 +1,171 @@
+﻿//*********************************************************************************************************************************
+//
+// PROJECT:							AstroManager (Astronomy Observation Manager)
+// FILE:								spatialIndexTest
+// SUBSYSTEM:						Spatial index of the objects in an image. (Test)
+// LANGUAGE:						C++
+// TARGET OS:						WINDOWS/UNIX/LINUX/MAC
+// LIBRARY DEPENDANCE:	ACL, QCL
+// NAMESPACE:						N/A
+// AUTHOR:							Gavin Blakeman. (GGB)
+// LICENSE:             GPLv2
+//
+//                      Copyright 2026 Gavin Blakeman.
+//                      This file is part of the Astronomy Manager software (astroManager)
+//
+//                      astroManager is free software: you can redistribute it and/or modify it under the terms of the GNU General
+//                      Public License as published by the Free Software Foundation, either version 2 of the License, or (at your
+//                      option) any later version.
+//
+//                      astroManager is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+//                      the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+//                      License for more details.
+//
+//                      You should have received a copy of the GNU General Public License along with astroManager.  If not,
+//                      see <http://www.gnu.org/licenses/>.
+//
+// OVERVIEW:						Stand alone test of TSpatialIndex. Not part of the astroManager build.
+//                      Follows the sequence used by CAstroFile when an object is renamed from a dock widget: the object is
+//                      renamed (and re-keyed in the index), then removed, then the index is searched. The removed object must
+//                      not be returned, and an unrelated object with the old name must not be removed.
+//                      Each check prints PASS or FAIL. The exit code is the number of failed checks.
+//
+//                      Build from the astroManager directory, with the include paths and libraries used by astroManager.pro:
+//                        g++ -std=c++17 -I. <include paths> tools/spatialIndexTest.cpp <libraries>
+//
+// HISTORY:             2026-10-17 GGB - File created
+//
+//*********************************************************************************************************************************
+
+#include "include/imaging/spatialIndex.h"
+
+  // Standard C++ library header files
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+using astroManager::FP_t;
+using namespace astroManager::imaging;
+
+namespace
+{
+  /// @brief      Object with the interface required by TSpatialIndex.
+
+  class CTestObject
+  {
+  private:
+    MCL::TPoint2D<FP_t> position_;
+    std::string name_;
+
+  public:
+    CTestObject(std::string const &name, FP_t x, FP_t y) : position_(x, y), name_(name) {}
+
+    MCL::TPoint2D<FP_t> CCDCoordinates() const { return position_; }
+    std::string const &objectName() const { return name_; }
+    void objectName(std::string const &name) { name_ = name; }
+
+    bool isClose(MCL::TPoint2D<FP_t> const &point, FP_t radius) const
+    {
+      FP_t dx = point.x() - position_.x();
+      FP_t dy = point.y() - position_.y();
+
+      return ((dx * dx + dy * dy) <= (radius * radius));
+    }
+  };
+
+  int failures = 0;
+
+  /// @brief      Prints the result of a check and counts the failures.
+
+  void check(bool passed, std::string const &description)
+  {
+    std::cout << (passed ? "PASS: " : "FAIL: ") << description << std::endl;
+
+    if (!passed)
+    {
+      ++failures;
+    };
+  }
+
+  /// @brief      Rename, then remove by the new name, then search. (CAstroFile::astrometryObjectRemove(std::string))
+
+  void testRenameRemoveByName()
+  {
+    TSpatialIndex<CTestObject> index;
+    std::unique_ptr<CTestObject> renamed(new CTestObject("A:1", 10, 10));
+    CTestObject other("A:2", 100, 100);
+
+    index.insert(renamed.get());
+    index.insert(&other);
+
+      // Rename. (CAstroFile::astrometryObjectRename)
+
+    renamed->objectName("M31");
+    index.insert(renamed.get());
+
+    check(index.count("A:1") == 0, "rename re-keys the old name");
+    check(index.count("M31") == 1, "rename re-keys the new name");
+
+      // Remove by the new name and free the object, as the dock widget does.
+
+    check(index.erase("M31") == 1, "remove by the new name finds the object");
+    renamed.reset();
+
+    check(index.findClose(MCL::TPoint2D<FP_t>(10, 10), 5) == nullptr, "findClose does not return the removed object");
+    check(index.findClose(MCL::TPoint2D<FP_t>(100, 100), 5) == &other, "findClose returns the remaining object");
+    check(index.size() == 1, "one object remains");
+  }
+
+  /// @brief      Rename, then remove by pointer, then search. (CAstroFile::astrometryObjectRemove(CAstrometryObservation *))
+
+  void testRenameRemoveByPointer()
+  {
+    TSpatialIndex<CTestObject> index;
+    std::unique_ptr<CTestObject> renamed(new CTestObject("A:1", 10, 10));
+    CTestObject unrelated("A:2", 12, 12);
+
+    index.insert(renamed.get());
+
+    renamed->objectName("M31");
+    index.insert(renamed.get());
+
+      // An unrelated object takes the old name of the renamed object.
+
+    unrelated.objectName("A:1");
+    index.insert(&unrelated);
+
+    index.erase(renamed.get());
+    check(index.count("M31") == 0, "remove by pointer removes the new name");
+    renamed.reset();
+
+    check(index.findClose(MCL::TPoint2D<FP_t>(10, 10), 1) == nullptr, "findClose does not return the removed object");
+    check(index.findClose(MCL::TPoint2D<FP_t>(12, 12), 1) == &unrelated, "the object with the old name is not removed");
+    check(index.count("A:1") == 1, "the old name belongs to the unrelated object");
+  }
+
+  /// @brief      Remove by a name that is not in the index. (CAstroFile rebuilds the index in this case)
+
+  void testRemoveUnknownName()
+  {
+    TSpatialIndex<CTestObject> index;
+    CTestObject object("A:1", 10, 10);
+
+    index.insert(&object);
+
+    check(index.erase("M31") == 0, "remove by an unknown name removes nothing");
+    check(index.findClose(MCL::TPoint2D<FP_t>(10, 10), 1) == &object, "findClose still returns the object");
+  }
+
+} // namespace
+
+int main()
+{
+  testRenameRemoveByName();
+  testRenameRemoveByPointer();
+  testRemoveUnknownName();
+
+  std::cout << failures << " checks failed." << std::endl;
+
+  return failures;
+}